@@ -0,0 +1,220 @@
+/*
+ * pb_anim.h - Deterministic tween timeline for match, drop and row animations
+ *
+ * A pb_anim_timeline schedules tweens from game events: a shrinking pop
+ * per matched cell (staggered), a fall per orphaned cell, a slide when a
+ * row is inserted, and a ceiling drop when garbage arrives. Tweens live
+ * in fixed structure-of-arrays pools inside the timeline, and
+ * pb_anim_advance() evaluates all of them in one pass using Q15 easing
+ * tables and Q16.16 values, so every platform computes identical frames.
+ *
+ * Everything is keyed to game frame numbers, never to wall-clock time.
+ * That makes the "animations done" point a pure function of the event
+ * stream: pb_anim_sim_can_continue() answers it from a single stored
+ * frame number, and a headless timeline (config.headless) tracks only
+ * that number without storing tweens. A server can therefore gate play
+ * on animations exactly like its clients without evaluating or waiting
+ * on any of them.
+ *
+ * The timeline never writes game state; whether (and how) play is gated
+ * on pb_anim_sim_can_continue() is the caller's decision.
+ *
+ * Thread safety: a timeline must be used by one thread at a time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_ANIM_H
+#define PB_ANIM_H
+
+#include "pb_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Values and Easing
+ *============================================================================*/
+
+/* Tween values are Q16.16 regardless of the pb_scalar configuration */
+typedef int32_t pb_anim_value;
+
+#define PB_ANIM_ONE             (1 << 16)
+#define PB_ANIM_FROM_INT(x)     ((pb_anim_value)((x) * PB_ANIM_ONE))
+#define PB_ANIM_TO_INT(v)       ((int)((v) >> 16))
+#define PB_ANIM_TO_FLOAT(v)     ((float)(v) / (float)PB_ANIM_ONE)
+
+/* Easing tables have 64 segments; results are Q15 (32768 = 1.0) */
+#define PB_EASE_SEGMENTS        64
+#define PB_EASE_ONE             32768
+
+typedef enum pb_ease {
+    PB_EASE_LINEAR = 0,
+    PB_EASE_IN_QUAD,
+    PB_EASE_OUT_QUAD,
+    PB_EASE_IN_OUT_CUBIC,
+    PB_EASE_OUT_BACK,           /* Overshoots to ~1.1 before settling */
+    PB_EASE_OUT_BOUNCE,
+    PB_EASE_COUNT
+} pb_ease;
+
+/**
+ * Evaluate an easing curve.
+ *
+ * @param ease  Curve
+ * @param phase Progress in [0, 65536] (65536 = end); clamped
+ * @return      Eased progress, Q15
+ */
+int32_t pb_ease_eval(pb_ease ease, uint32_t phase);
+
+/*============================================================================
+ * Tweens
+ *============================================================================*/
+
+typedef enum pb_tween_kind {
+    PB_TWEEN_POP = 0,           /* Scale 1 -> 0 for a matched cell */
+    PB_TWEEN_FALL,              /* Y offset 0 -> fall_distance for an orphan */
+    PB_TWEEN_ROW_SLIDE,         /* Board Y offset -row_height -> 0 */
+    PB_TWEEN_CEILING_DROP,      /* Board Y offset -rows*row_height -> 0 */
+    PB_TWEEN_CUSTOM,
+    PB_TWEEN_KIND_COUNT
+} pb_tween_kind;
+
+/* Tween flags */
+#define PB_TWEEN_BLOCKING   (1 << 0)    /* Counts toward sim_can_continue */
+#define PB_TWEEN_DONE       (1 << 1)    /* Reached its end this frame */
+
+typedef struct pb_tween {
+    pb_tween_kind kind;
+    pb_ease ease;
+    pb_cell_index cell;         /* Board cell (POP/FALL), else 0 */
+    uint8_t color_id;           /* Bubble color for POP/FALL */
+    uint8_t flags;              /* PB_TWEEN_BLOCKING */
+    uint32_t start_frame;       /* First frame of movement */
+    uint16_t duration;          /* Frames, at least 1 */
+    pb_anim_value from;
+    pb_anim_value to;
+} pb_tween;
+
+/*============================================================================
+ * Timeline
+ *============================================================================*/
+
+typedef struct pb_anim_config {
+    bool headless;              /* Track blocking only, store no tweens */
+    uint16_t pop_frames;
+    uint16_t pop_stagger;       /* Frames between successive pops */
+    uint16_t fall_delay;        /* Frames from the drop event to the fall */
+    uint16_t fall_frames;
+    uint16_t row_slide_frames;
+    uint16_t ceiling_drop_frames;
+    pb_anim_value fall_distance;    /* Pixels, Q16.16 */
+    pb_anim_value row_height;       /* Pixels, Q16.16 */
+} pb_anim_config;
+
+/*
+ * Pooled tween storage. Tweens [0, count) are live, in insertion order;
+ * renderers read kind/cell/color/value directly after pb_anim_advance().
+ */
+typedef struct pb_anim_timeline {
+    pb_anim_config config;
+    int count;
+    uint32_t frame;             /* Frame of the last pb_anim_advance() */
+    uint32_t block_until;       /* Blocking tweens are done from this frame */
+    uint32_t dropped;           /* Tweens discarded because the pool was full */
+    int subscription;           /* pb_game_subscribe() id, or -1 */
+    const pb_board* board;      /* Color/width source while attached */
+
+    uint8_t kind[PB_ANIM_MAX_TWEENS];
+    uint8_t ease[PB_ANIM_MAX_TWEENS];
+    uint8_t flags[PB_ANIM_MAX_TWEENS];
+    uint8_t color[PB_ANIM_MAX_TWEENS];
+    pb_cell_index cell[PB_ANIM_MAX_TWEENS];
+    uint16_t duration[PB_ANIM_MAX_TWEENS];
+    uint32_t start[PB_ANIM_MAX_TWEENS];
+    uint32_t rate[PB_ANIM_MAX_TWEENS];      /* 2^24 / duration */
+    pb_anim_value from[PB_ANIM_MAX_TWEENS];
+    pb_anim_value to[PB_ANIM_MAX_TWEENS];
+    pb_anim_value value[PB_ANIM_MAX_TWEENS];
+} pb_anim_timeline;
+
+/**
+ * Default configuration: 10-frame pops staggered by 2, 30-frame falls
+ * after a 6-frame delay, 12-frame row slides, 24-frame ceiling drops,
+ * 16 px bubbles (14 px rows).
+ */
+void pb_anim_config_default(pb_anim_config* config);
+
+/**
+ * Initialize an empty timeline.
+ *
+ * @param config Configuration (NULL for defaults)
+ */
+void pb_anim_init(pb_anim_timeline* timeline, const pb_anim_config* config);
+
+/**
+ * Remove every tween and the blocking horizon (subscription is kept).
+ */
+void pb_anim_clear(pb_anim_timeline* timeline);
+
+/**
+ * Schedule a tween. Blocking tweens extend the blocking horizon even when
+ * the pool is full or the timeline is headless.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY (pool full)
+ */
+pb_result pb_anim_add(pb_anim_timeline* timeline, const pb_tween* tween);
+
+/**
+ * Schedule tweens for a game event (POPPED, DROPPED, ROW_INSERTED,
+ * GARBAGE_RECEIVED; others are ignored). Matches pb_event_fn, with the
+ * timeline as userdata.
+ */
+void pb_anim_on_event(const pb_event* event, void* userdata);
+
+/**
+ * Subscribe the timeline to a game's events. Cell colors and the garbage
+ * row width are read from the game's board.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, PB_ERR_INVALID_STATE (already
+ *         attached), or PB_ERR_NO_MEMORY (no subscriber slots)
+ */
+pb_result pb_anim_attach(pb_anim_timeline* timeline, pb_game_state* state);
+
+/**
+ * Unsubscribe from the attached game (no-op if not attached).
+ */
+void pb_anim_detach(pb_anim_timeline* timeline, pb_game_state* state);
+
+/**
+ * Evaluate every tween at a frame. Tweens that reached their end at the
+ * previous advance are removed first, so a finished tween is visible (at
+ * its end value, flagged PB_TWEEN_DONE) for exactly one frame.
+ */
+void pb_anim_advance(pb_anim_timeline* timeline, uint32_t frame);
+
+/**
+ * True once every blocking tween has finished by the given frame. Always
+ * answered from the stored horizon, without evaluating tweens.
+ */
+bool pb_anim_sim_can_continue(const pb_anim_timeline* timeline, uint32_t frame);
+
+/**
+ * Current value of the first tween of a kind on a cell.
+ *
+ * @return true if such a tween is live (out filled when non-NULL)
+ */
+bool pb_anim_cell_value(const pb_anim_timeline* timeline, pb_tween_kind kind,
+                        pb_cell_index cell, pb_anim_value* out);
+
+/**
+ * Combined vertical board offset from row-slide and ceiling-drop tweens.
+ */
+pb_anim_value pb_anim_board_offset(const pb_anim_timeline* timeline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_ANIM_H */
@@ -0,0 +1,160 @@
+/*
+ * pb_async.h - Cancellable background solvability analysis
+ *
+ * pb_analyze_solvability() and pb_solve_exact() block until their budget is
+ * spent. A level editor needs a verdict after every edit without stalling
+ * its frame loop, so this module runs the analysis on a worker thread:
+ *
+ *   pb_async_start()   hand over a board + queue; cancels any running job
+ *   pb_async_poll()    non-blocking snapshot of the latest progress
+ *   pb_async_cancel()  abandon the running job
+ *   pb_async_wait()    block until the job finishes
+ *
+ * A job runs in two stages. The greedy stage (pb_analyze_solvability_ex)
+ * answers "solvable?" quickly; the optional exact stage (pb_solve_exact)
+ * then refines min_moves into a proven optimum. Both stages check for
+ * cancellation between moves / every few hundred nodes, so a restart
+ * after an edit takes effect almost immediately.
+ *
+ * Reuse across edits:
+ * - Restarting with the board and queue of the last finished job returns
+ *   its result without searching (undo, or dragging a bubble back).
+ * - The exact stage keeps a pb_exact_cache across jobs. While the queue
+ *   and rules stay the same, every refutation proved for an earlier board
+ *   remains valid, so positions that recur after an edit are not searched
+ *   again.
+ *
+ * The progress callback runs on the worker thread; keep it short and
+ * synchronize anything it touches. Without PB_FEATURE_THREADS the job runs
+ * to completion inside pb_async_start() and the callback runs on the
+ * caller's thread.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_ASYNC_H
+#define PB_ASYNC_H
+
+#include "pb_types.h"
+#include "pb_solver.h"
+#include "pb_exact.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct pb_async_solver pb_async_solver;   /* Opaque */
+
+typedef enum pb_async_state {
+    PB_ASYNC_IDLE = 0,          /* Nothing started yet */
+    PB_ASYNC_RUNNING,           /* Worker is searching */
+    PB_ASYNC_DONE,              /* Finished; results are final */
+    PB_ASYNC_CANCELLED,         /* Abandoned; results are partial */
+} pb_async_state;
+
+typedef enum pb_async_stage {
+    PB_ASYNC_STAGE_GREEDY = 0,
+    PB_ASYNC_STAGE_EXACT,
+} pb_async_stage;
+
+typedef struct pb_async_progress {
+    pb_async_state state;
+    pb_async_stage stage;
+    uint32_t generation;        /* Incremented by every pb_async_start() */
+    pb_solvability greedy;      /* Greedy analysis (partial while running) */
+    bool greedy_done;
+    bool exact_done;
+    pb_exact_status exact_status;   /* Valid once exact_done */
+    int exact_min_shots;        /* Best known line, -1 if none */
+    int exact_lower_bound;      /* Proven lower bound */
+    uint64_t nodes;             /* Exact-stage nodes expanded */
+    uint32_t elapsed_ms;        /* Since pb_async_start() */
+    bool reused;                /* Result came from the previous job */
+} pb_async_progress;
+
+/**
+ * Progress callback. Called from the worker after each greedy move and
+ * periodically during the exact stage, and once more when the job ends.
+ */
+typedef void (*pb_async_progress_fn)(const pb_async_progress* progress,
+                                     void* userdata);
+
+typedef struct pb_async_config {
+    int max_search;             /* Greedy iteration budget */
+    bool run_exact;             /* Refine with pb_solve_exact() */
+    pb_exact_config exact;      /* Exact-stage settings (cache and
+                                   on_progress are managed internally) */
+    uint32_t progress_interval_ms;  /* Minimum gap between exact-stage
+                                       callbacks (0 = every check) */
+    pb_async_progress_fn on_progress;
+    void* callback_userdata;
+} pb_async_config;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+/**
+ * Fill config with defaults: 1000 greedy iterations, exact stage enabled
+ * with a 250 ms budget, progress at most every 16 ms.
+ */
+void pb_async_config_default(pb_async_config* config);
+
+/**
+ * Create a solver and its worker thread.
+ *
+ * @param config  Configuration (NULL = defaults), copied
+ * @return Solver, or NULL on failure
+ */
+pb_async_solver* pb_async_create(const pb_async_config* config);
+
+/**
+ * Cancel any running job, join the worker and free the solver.
+ */
+void pb_async_destroy(pb_async_solver* solver);
+
+/**
+ * Start analysing a position. Inputs are copied; a running job is
+ * cancelled and replaced.
+ *
+ * @param solver        Solver
+ * @param board         Board to analyse
+ * @param ruleset       Rules (NULL = defaults), copied
+ * @param queue         Shot queue in firing order (may be NULL)
+ * @param queue_length  Number of queued shots (0..PB_EXACT_MAX_DEPTH)
+ * @return PB_OK or PB_ERR_INVALID_ARG
+ */
+pb_result pb_async_start(pb_async_solver* solver, const pb_board* board,
+                         const pb_ruleset* ruleset,
+                         const pb_bubble* queue, int queue_length);
+
+/**
+ * Copy the latest progress without blocking on the search.
+ *
+ * @param out  Output snapshot (may be NULL)
+ * @return Current state
+ */
+pb_async_state pb_async_poll(pb_async_solver* solver, pb_async_progress* out);
+
+/**
+ * Cancel the running job. No effect when idle or finished.
+ */
+void pb_async_cancel(pb_async_solver* solver);
+
+/**
+ * Block until the current job is done or cancelled.
+ *
+ * @param out  Output final snapshot (may be NULL)
+ * @return Final state
+ */
+pb_async_state pb_async_wait(pb_async_solver* solver, pb_async_progress* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_ASYNC_H */
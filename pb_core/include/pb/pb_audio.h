@@ -0,0 +1,169 @@
+/*
+ * pb_audio.h - Voice-pooled sound scheduler and PCM mixer
+ *
+ * Calling the platform's sound_play once per event starts a mixer
+ * channel per call, so a cascade popping dozens of bubbles in one frame
+ * exhausts channels and bursts work onto the audio thread. pb_audio sits
+ * between the game and the platform instead:
+ *
+ *   - Requests are queued during the frame. Requests for the same sound
+ *     in one frame coalesce into a single voice whose gain is the loudest
+ *     request's volume times sqrt(count), capped at 1, so a bigger cascade
+ *     sounds fuller without getting louder without limit.
+ *   - pb_audio_commit() starts the frame's voices from a fixed pool of
+ *     PB_AUDIO_MAX_VOICES. When the pool is full, a new sound steals the
+ *     voice with the lowest priority, nearest its end among equals, but
+ *     only if that priority is not above its own; otherwise it is dropped.
+ *     Voices started by the same commit are never stolen, so a frame with
+ *     more sounds than voices keeps the first ones it starts (highest
+ *     priority, then lowest id) and drops the rest.
+ *   - Sounds are decoded once, at load time, into mono 16-bit PCM at the
+ *     mixing rate. Voices only reference these shared buffers, and
+ *     pb_audio_mix() adds at most PB_AUDIO_MAX_VOICES of them into the
+ *     output stream.
+ *
+ * Audio cost per callback is therefore bounded by the pool size, however
+ * many events a frame produces.
+ *
+ * With a platform (pb_audio_attach()), the mixer runs as the platform's
+ * PCM stream callback, and pb_audio_commit() updates the voices under
+ * audio_lock. Without one, the owner calls pb_audio_mix() itself.
+ *
+ * Thread safety: pb_audio_play() and pb_audio_commit() belong to one
+ * (game) thread; pb_audio_mix() may run on the audio thread while
+ * attached.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_AUDIO_H
+#define PB_AUDIO_H
+
+#include "pb_types.h"
+#include "pb_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_AUDIO_MAX_SOUNDS     64
+#define PB_AUDIO_DEFAULT_RATE   44100   /* Matches the platform backends */
+
+/* Simultaneous voices (bounds mixing cost per sample) */
+#ifndef PB_AUDIO_MAX_VOICES
+    #if defined(PB_SIZE_MICRO)
+        #define PB_AUDIO_MAX_VOICES 4
+    #elif defined(PB_SIZE_MINI)
+        #define PB_AUDIO_MAX_VOICES 8
+    #elif defined(PB_SIZE_MEDIUM)
+        #define PB_AUDIO_MAX_VOICES 12
+    #else
+        #define PB_AUDIO_MAX_VOICES 16
+    #endif
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct pb_audio pb_audio;   /* Opaque */
+
+typedef struct pb_audio_stats {
+    uint32_t requests;          /* pb_audio_play() calls */
+    uint32_t coalesced;         /* Requests merged into another */
+    uint32_t started;           /* Voices started */
+    uint32_t stolen;            /* Voices cut off to start another */
+    uint32_t dropped;           /* Requests with no voice to take */
+    int active;                 /* Voices playing now */
+} pb_audio_stats;
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+/**
+ * Create a scheduler mixing at a sample rate.
+ *
+ * @return Scheduler, or NULL on bad rate or allocation failure
+ */
+pb_audio* pb_audio_create(int sample_rate);
+
+/**
+ * Destroy (detaching first), freeing PCM decoded by pb_audio_load().
+ */
+void pb_audio_destroy(pb_audio* audio);
+
+/**
+ * Mix into a platform's PCM stream.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, PB_ERR_NOT_IMPLEMENTED (no stream
+ *         support), or PB_ERR_INVALID_STATE (already attached, the stream
+ *         failed to open, or it runs at another sample rate)
+ */
+pb_result pb_audio_attach(pb_audio* audio, pb_platform* platform);
+
+void pb_audio_detach(pb_audio* audio);
+
+/*============================================================================
+ * Sounds
+ *============================================================================*/
+
+/**
+ * Register PCM (mono, signed 16-bit, at the mixing rate). Not copied: the
+ * samples must outlive the scheduler.
+ *
+ * @param priority Higher priorities steal voices from lower ones
+ * @param id       Output: sound id
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY (bank full)
+ */
+pb_result pb_audio_add_pcm(pb_audio* audio, const int16_t* samples,
+                           uint32_t frames, uint8_t priority, int* id);
+
+/**
+ * Decode a sound file through the platform's sound_decode and register
+ * it. The scheduler owns the decoded PCM.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG (including files that fail to
+ *         decode), PB_ERR_NOT_IMPLEMENTED (no decoder), or PB_ERR_NO_MEMORY
+ *         (bank full)
+ */
+pb_result pb_audio_load(pb_audio* audio, pb_platform* platform, const char* path,
+                        uint8_t priority, int* id);
+
+/*============================================================================
+ * Playback
+ *============================================================================*/
+
+/**
+ * Request a sound this frame (volume 0-1). Bad ids are ignored.
+ */
+void pb_audio_play(pb_audio* audio, int id, float volume);
+
+/**
+ * Start the frame's coalesced requests, highest priority first. Call
+ * once per frame, after the game update.
+ */
+void pb_audio_commit(pb_audio* audio);
+
+/**
+ * Silence every voice and forget pending requests.
+ */
+void pb_audio_stop_all(pb_audio* audio);
+
+/**
+ * Add the playing voices into an interleaved stream, saturating; the
+ * same mono signal goes to every channel.
+ */
+void pb_audio_mix(pb_audio* audio, int16_t* out, int frames, int channels);
+
+pb_audio_stats pb_audio_get_stats(const pb_audio* audio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_AUDIO_H */
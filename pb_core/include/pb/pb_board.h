@@ -70,6 +70,41 @@ bool pb_board_set(pb_board* board, pb_offset pos, pb_bubble bubble);
  */
 void pb_board_remove(pb_board* board, pb_offset pos);
 
+/*============================================================================
+ * Neighbor Counts
+ *
+ * With PB_FEATURE_NEIGHBOR_COUNTS a board can maintain, for every cell,
+ * how many of its six neighbors are occupied, how many are wildcards and
+ * how many are colored bubbles of each color. pb_board_set/remove keep
+ * the table current in O(6), turning move-scoring scans into lookups.
+ * Code that writes board->cells directly must call
+ * pb_board_track_neighbors(board, true) again to rebuild.
+ *
+ * The queries below work on any board; untracked boards are scanned.
+ *============================================================================*/
+
+/**
+ * Start (rebuilding the table) or stop maintaining neighbor counts.
+ * No-op when PB_FEATURE_NEIGHBOR_COUNTS is 0.
+ */
+void pb_board_track_neighbors(pb_board* board, bool enable);
+
+/**
+ * Number of PB_KIND_COLORED neighbors of pos with the given color.
+ */
+int pb_board_neighbor_color_count(const pb_board* board, pb_offset pos,
+                                  uint8_t color_id);
+
+/**
+ * Number of PB_KIND_WILDCARD neighbors of pos.
+ */
+int pb_board_neighbor_wildcard_count(const pb_board* board, pb_offset pos);
+
+/**
+ * Number of occupied neighbors of pos (any kind).
+ */
+int pb_board_neighbor_total(const pb_board* board, pb_offset pos);
+
 /*============================================================================
  * Traversal Result
  *============================================================================*/
@@ -170,6 +205,62 @@ int pb_find_anchored(const pb_board* board, pb_visit_result* result);
  */
 int pb_find_orphans(const pb_board* board, pb_visit_result* result);
 
+/*============================================================================
+ * Connected Components
+ *
+ * One scanline union-find pass labels every same-color cluster and every
+ * support component (occupied cells connected to each other, the unit
+ * that stays up or falls together) at once, instead of one BFS per cell.
+ * Color clusters connect PB_KIND_COLORED bubbles of equal color_id only:
+ * a wildcard can join several clusters, so it belongs to none and
+ * pb_find_matches() remains the authority on what a shot pops. Support
+ * components follow pb_find_anchored(): ghosts are skipped and a
+ * component is attached when it touches the ceiling row.
+ *============================================================================*/
+
+#define PB_LABEL_NONE (-1)
+
+typedef struct pb_component {
+    int size;                   /* Cells in the component */
+    uint8_t color_id;           /* Cluster color (color clusters only) */
+    bool attached;              /* Connected to the ceiling */
+    int16_t support;            /* Support component of its first non-ghost
+                                   cell (PB_LABEL_NONE if all ghosts) */
+    int liberties;              /* Empty cells adjacent to the component */
+    int top_row;                /* Highest row occupied */
+    int bottom_row;             /* Lowest row occupied */
+    pb_offset first;            /* First cell in row-major order */
+} pb_component;
+
+typedef struct pb_components {
+    int16_t color_label[PB_MAX_ROWS][PB_MAX_COLS];   /* Index into colors */
+    int16_t support_label[PB_MAX_ROWS][PB_MAX_COLS]; /* Index into supports */
+    pb_component colors[PB_MAX_CELLS];
+    int color_count;
+    pb_component supports[PB_MAX_CELLS];
+    int support_count;
+    int largest_cluster;        /* Size of the biggest color cluster */
+    int attached_cells;         /* Cells in attached support components */
+    int orphan_cells;           /* Cells that would drop (excludes frozen) */
+} pb_components;
+
+/**
+ * Label all color clusters and support components in one pass.
+ * Labels are assigned in row-major order of each component's first cell;
+ * empty cells (and ghosts, for support) get PB_LABEL_NONE.
+ *
+ * @param board  The board
+ * @param out    Output labels and per-component statistics
+ * @return       Number of color clusters
+ */
+int pb_board_label_components(const pb_board* board, pb_components* out);
+
+/**
+ * Size of the largest color cluster (pb_components.largest_cluster)
+ * without the per-component tables, for callers that need only that.
+ */
+int pb_board_largest_cluster(const pb_board* board);
+
 /*============================================================================
  * Batch Operations
  *============================================================================*/
@@ -217,6 +308,17 @@ uint32_t pb_board_checksum(const pb_board* board);
  */
 bool pb_board_insert_row(pb_board* board, pb_rng* rng, uint8_t allowed_colors);
 
+/**
+ * Shift every row down by an even number of rows, leaving the top rows
+ * empty. Moving by row pairs keeps each row's hex parity, so adjacency
+ * is unchanged. Neighbor counts are kept if tracked.
+ *
+ * @param board The board to modify
+ * @param rows  Rows to shift (even, 0 to board->rows)
+ * @return      false if bubbles were pushed off the bottom (or bad rows)
+ */
+bool pb_board_scroll_down(pb_board* board, int rows);
+
 #ifdef __cplusplus
 }
 #endif
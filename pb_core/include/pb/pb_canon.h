@@ -0,0 +1,146 @@
+/*
+ * pb_canon.h - Board canonicalization under mirroring and color relabeling
+ *
+ * Two positions that differ only by a left-right mirror or by a
+ * permutation of color IDs play identically. Mapping each position to a
+ * canonical representative lets transposition tables, the endgame
+ * tablebase and level catalogs treat them as one.
+ *
+ * Symmetries:
+ * - Color relabeling: colors are renumbered 0, 1, 2, ... in order of
+ *   first appearance (board cells in row-major order, then the queue).
+ *   Applies to PB_KIND_COLORED and PB_KIND_SPECIAL bubbles. Disabled when
+ *   a PB_SPECIAL_SHIFTER is present, since color cycling does not commute
+ *   with a permutation.
+ * - Mirror: with odd rows shifted right by half a cell, reflecting about
+ *   the vertical centre line maps the lattice onto itself only when
+ *   cols_odd == cols_even - 1 (the default 8/7 layout). Equal row widths
+ *   are NOT mirror-symmetric. Cell (row, col) maps to
+ *   (row, row_cols - 1 - col). Disabled when a PB_SPECIAL_PORTAL is
+ *   present, since portal payloads address absolute cells.
+ *
+ * The canonical form is the lexicographically smallest relabeled
+ * orientation; ties keep the original orientation.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_CANON_H
+#define PB_CANON_H
+
+#include "pb_types.h"
+#include "pb_board.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_CANON_NO_COLOR   0xFF    /* color_map entry for unused colors */
+
+/*============================================================================
+ * Canonical Form
+ *============================================================================*/
+
+typedef struct pb_canon_form {
+    pb_board board;                     /* Canonical board */
+    pb_bubble queue[PB_MAX_QUEUE];      /* Canonical queue */
+    int queue_length;
+    bool mirrored;                      /* Canonical board is the mirror image */
+    uint8_t color_map[PB_MAX_COLORS];   /* Original color -> canonical */
+    uint8_t color_unmap[PB_MAX_COLORS]; /* Canonical color -> original */
+    uint64_t hash;                      /* 64-bit hash of the canonical form */
+} pb_canon_form;
+
+/**
+ * Check whether the board geometry admits a mirror symmetry.
+ */
+bool pb_canon_can_mirror(const pb_board* board);
+
+/**
+ * Mirror a cell across the vertical centre line (requires
+ * pb_canon_can_mirror). The mapping is its own inverse.
+ */
+pb_offset pb_canon_mirror_cell(const pb_board* board, pb_offset cell);
+
+/**
+ * Compute the canonical form of a board and queue.
+ *
+ * @param board         Board
+ * @param queue         Upcoming shots in firing order (may be NULL)
+ * @param queue_length  Number of shots (0..PB_MAX_QUEUE)
+ * @param out           Output canonical form
+ * @return PB_OK or PB_ERR_INVALID_ARG
+ */
+pb_result pb_canon_compute(const pb_board* board, const pb_bubble* queue,
+                           int queue_length, pb_canon_form* out);
+
+/**
+ * Canonical hash only. Equal for positions related by a symmetry.
+ *
+ * @return Hash, or 0 on invalid arguments
+ */
+uint64_t pb_canon_hash(const pb_board* board, const pb_bubble* queue,
+                       int queue_length);
+
+/**
+ * Map a cell of the original board to the canonical board (and back;
+ * the mapping is an involution).
+ */
+pb_offset pb_canon_map_cell(const pb_canon_form* form, pb_offset cell);
+
+/*============================================================================
+ * Canonical Hash Index
+ *
+ * Open-addressing set of canonical hashes, each tagged with a caller
+ * id (e.g. a level's catalog position). Used to reject duplicate levels
+ * at ingest in O(1) expected time per level.
+ *============================================================================*/
+
+typedef struct pb_canon_index {
+    uint64_t* hashes;
+    int* ids;                   /* -1 marks an empty slot */
+    int capacity;               /* Power of two */
+    int count;
+} pb_canon_index;
+
+/**
+ * Initialize an index sized for about `expected` entries.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY
+ */
+pb_result pb_canon_index_init(pb_canon_index* index, int expected);
+
+/**
+ * Free index storage.
+ */
+void pb_canon_index_free(pb_canon_index* index);
+
+/**
+ * Look up a canonical hash.
+ *
+ * @return Stored id, or -1 if absent
+ */
+int pb_canon_index_find(const pb_canon_index* index, uint64_t hash);
+
+/**
+ * Insert a canonical hash unless already present. Grows as needed.
+ *
+ * @param index     Index
+ * @param hash      Canonical hash
+ * @param id        Id to store (>= 0)
+ * @param out_existing Output: id of the earlier entry, or -1 if inserted
+ *                  (may be NULL)
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY
+ */
+pb_result pb_canon_index_insert(pb_canon_index* index, uint64_t hash, int id,
+                                int* out_existing);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_CANON_H */
@@ -0,0 +1,135 @@
+/*
+ * pb_cga.h - CGA composite artifact-color output filter
+ *
+ * Simulates an IBM CGA card driving an NTSC monitor through its
+ * composite output (docs/CGA_1024_COLORS_RESEARCH.md). Each framebuffer
+ * pixel becomes one composite sample, four to a color subcarrier cycle
+ * as in 640x200 mode, so fine pixel patterns decode as artifact colors
+ * instead of the palette's own RGB.
+ *
+ * Signal model:
+ *   - A pixel's palette index maps to an RGBI color (by default index & 15,
+ *     the layout pb_palette_init_cga() produces; any palette can be mapped
+ *     to its nearest RGBI colors instead).
+ *   - The card's chroma multiplexer outputs a 50% duty square wave per
+ *     color at the doc's phase, shifted by the Reenigne per-color delay.
+ *     A sample is that wave averaged over the pixel, mixed with the RGBI
+ *     bits by the old (0.72 C + 0.28 I) or new CGA output stage.
+ *   - The decoder takes the four samples around a pixel (one subcarrier
+ *     cycle): their mean is Y, demodulating them against the subcarrier
+ *     gives I and Q, and the usual YIQ matrix gives RGB.
+ *
+ * Decoding therefore depends only on the pixel's phase (x mod 4) and the
+ * four sample levels in its window. Levels are quantized to 16 steps, so
+ * every (phase, window) result is precomputed into a 4 x 65536 entry RGB
+ * table when the decoder is configured; presenting a frame is one table
+ * lookup per pixel with a rolling 16-bit window key and no filter maths.
+ *
+ * Allocation: pb_cga_composite_create() allocates the decode table
+ * (1MB). Presenting allocates nothing.
+ *
+ * Thread safety: presenting only reads the decoder, so several threads
+ * may present (e.g. separate row bands) with one decoder as long as none
+ * reconfigures it at the same time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_CGA_H
+#define PB_CGA_H
+
+#include "pb_types.h"
+#include "pb_render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_CGA_COLORS           16      /* RGBI colors */
+#define PB_CGA_PHASES           4       /* Samples per subcarrier cycle */
+#define PB_CGA_LEVELS           16      /* Quantized composite levels */
+#define PB_CGA_WINDOWS          65536   /* PB_CGA_LEVELS ^ PB_CGA_PHASES */
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+/* Composite output stage revision */
+typedef enum pb_cga_variant {
+    PB_CGA_OLD = 0,             /* 1981-83 cards: 0.72 C + 0.28 I */
+    PB_CGA_NEW                  /* 1984+ cards: luma from R, G, B and I too */
+} pb_cga_variant;
+
+typedef struct pb_cga_config {
+    pb_cga_variant variant;
+    float hue;                  /* Degrees added to decoded hue */
+    float saturation;           /* Chroma gain (1 = nominal, 0 = monochrome) */
+    float brightness;           /* Added to Y */
+    float contrast;             /* Y gain about mid-gray */
+    int phase;                  /* Subcarrier phase of column 0 (0-3) */
+} pb_cga_config;
+
+/**
+ * Composite decoder: RGBI mapping and precomputed decode table.
+ */
+typedef struct pb_cga_composite pb_cga_composite;
+
+/*============================================================================
+ * Decoder
+ *============================================================================*/
+
+/**
+ * Default configuration: old CGA, nominal hue, saturation and levels,
+ * phase 0.
+ */
+void pb_cga_config_default(pb_cga_config* config);
+
+/**
+ * Create a decoder with the default index & 15 RGBI mapping.
+ *
+ * @param config Configuration (NULL for defaults)
+ * @return Decoder, or NULL on allocation failure
+ */
+pb_cga_composite* pb_cga_composite_create(const pb_cga_config* config);
+
+void pb_cga_composite_destroy(pb_cga_composite* cga);
+
+/**
+ * Reconfigure, rebuilding the decode table (not for every frame).
+ */
+void pb_cga_composite_configure(pb_cga_composite* cga, const pb_cga_config* config);
+
+/**
+ * Map one palette index to an RGBI color (0-15).
+ */
+void pb_cga_composite_set_index(pb_cga_composite* cga, uint8_t index, uint8_t rgbi);
+
+/**
+ * Map every palette index to the RGBI color nearest its palette RGB, so
+ * a framebuffer drawn with any palette can go through the filter.
+ */
+void pb_cga_composite_map_palette(pb_cga_composite* cga, const pb_palette* pal);
+
+/**
+ * Decode an indexed framebuffer (e.g. pb_render_get_framebuffer()) to
+ * RGBA. Each row is decoded on its own, with black beyond its ends.
+ *
+ * @param cga    Decoder
+ * @param pixels width * height palette indices, row-major
+ * @param width  Framebuffer width
+ * @param height Framebuffer height
+ * @param rgba   Output: width * height pixels, 0xRRGGBBAA (texture_upload
+ *               format), alpha 255
+ */
+void pb_cga_composite_present(const pb_cga_composite* cga, const uint8_t* pixels,
+                              int width, int height, uint32_t* rgba);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_CGA_H */
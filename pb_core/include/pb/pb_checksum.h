@@ -24,13 +24,13 @@ extern "C" {
  * CRC-32 Primitives
  *
  * Uses CRC-32/ISO-HDLC (polynomial 0xEDB88320, same as zlib).
- * Table-driven for performance.
+ * Table-driven, slice-by-8 on tiers with PB_CRC32_SLICES == 8.
  *============================================================================*/
 
 /**
- * Initialize CRC-32 lookup table.
- * Called automatically on first use, but can be called explicitly
- * to ensure table is ready before hot path.
+ * No-op: the CRC-32 table is a compile-time constant, so every checksum
+ * function is safe to call from any thread without initialization.
+ * Kept for source compatibility.
  */
 void pb_crc32_init(void);
 
@@ -96,6 +96,9 @@ pb_rgb8 pb_rgb_to_rgb8(pb_rgb c);
 /** Apply sRGB gamma decoding (sRGB -> Linear RGB) */
 pb_linear_rgb pb_srgb_to_linear(pb_rgb srgb);
 
+/** Decode RGB8 straight to linear RGB (table lookup, no pow) */
+pb_linear_rgb pb_rgb8_to_linear(pb_rgb8 c);
+
 /** Apply sRGB gamma encoding (Linear RGB -> sRGB) */
 pb_rgb pb_linear_to_srgb(pb_linear_rgb linear);
 
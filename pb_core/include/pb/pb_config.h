@@ -299,6 +299,33 @@
     #endif
 #endif
 
+/* Event subscriber slots per game state */
+#ifndef PB_MAX_EVENT_SUBSCRIBERS
+    #define PB_MAX_EVENT_SUBSCRIBERS  8
+#endif
+
+/* CRC-32 slicing tables (1 = 1KB byte table, 8 = 8KB, ~4x faster) */
+#ifndef PB_CRC32_SLICES
+    #if defined(PB_SIZE_MICRO) || defined(PB_SIZE_MINI)
+        #define PB_CRC32_SLICES  1
+    #else
+        #define PB_CRC32_SLICES  8
+    #endif
+#endif
+
+/* Tween pool size per animation timeline */
+#ifndef PB_ANIM_MAX_TWEENS
+    #if defined(PB_SIZE_MICRO)
+        #define PB_ANIM_MAX_TWEENS  32
+    #elif defined(PB_SIZE_MINI)
+        #define PB_ANIM_MAX_TWEENS  64
+    #elif defined(PB_SIZE_MEDIUM)
+        #define PB_ANIM_MAX_TWEENS  128
+    #else
+        #define PB_ANIM_MAX_TWEENS  512  /* Two full cascades in flight */
+    #endif
+#endif
+
 /*============================================================================
  * Feature Flags
  *============================================================================*/
@@ -331,6 +358,16 @@
     #define PB_FEATURE_CVD 0
 #endif
 
+/* Incremental per-cell neighbor color counts in pb_board (+4 bytes/cell).
+ * Counts are packed 3 bits per color, so at most 8 colors fit. */
+#ifndef PB_FEATURE_NEIGHBOR_COUNTS
+    #if PB_FEATURE_SOLVER && PB_MAX_COLORS <= 8
+        #define PB_FEATURE_NEIGHBOR_COUNTS 1
+    #else
+        #define PB_FEATURE_NEIGHBOR_COUNTS 0
+    #endif
+#endif
+
 /*============================================================================
  * Platform Detection
  *============================================================================*/
@@ -373,6 +410,27 @@
     #define PB_PLATFORM_FREESTANDING 0
 #endif
 
+/* Worker threads (POSIX threads on hosted full/medium builds only).
+ * Modules that spawn workers fall back to a serial path when this is 0. */
+#ifndef PB_FEATURE_THREADS
+    #if !PB_PLATFORM_FREESTANDING && PB_FEATURE_SOLVER && \
+        (defined(__unix__) || defined(__APPLE__))
+        #define PB_FEATURE_THREADS 1
+    #else
+        #define PB_FEATURE_THREADS 0
+    #endif
+#endif
+
+/* BSD sockets for the pb_net UDP transport (hosted unix only). Packet
+ * encoding works without them; socket calls report PB_ERR_NOT_IMPLEMENTED. */
+#ifndef PB_FEATURE_NET
+    #if !PB_PLATFORM_FREESTANDING && (defined(__unix__) || defined(__APPLE__))
+        #define PB_FEATURE_NET 1
+    #else
+        #define PB_FEATURE_NET 0
+    #endif
+#endif
+
 /* Default pointer size for 32/64-bit */
 #ifndef PB_POINTER_SIZE
     #if defined(__LP64__) || defined(_LP64) || defined(__x86_64__)
@@ -21,6 +21,9 @@
 /* C standard compatibility shims */
 #include "pb_compat.h"
 
+/* Build-time generated constant tables */
+#include "pb_tables.h"
+
 /* Core type definitions */
 #include "pb_types.h"
 
@@ -33,6 +36,9 @@
 /* Board operations and traversal */
 #include "pb_board.h"
 
+/* Endless scrolling board window */
+#include "pb_endless.h"
+
 /* Shot physics and collision */
 #include "pb_shot.h"
 
@@ -66,18 +72,57 @@
 /* Game session with replay integration */
 #include "pb_session.h"
 
+/* Segment-parallel replay verification */
+#include "pb_verify.h"
+
+/* UDP input-relay transport for versus play */
+#include "pb_net.h"
+
 /* Platform abstraction (SDL2, etc.) */
 #include "pb_platform.h"
 
+/* Voice-pooled sound scheduler and PCM mixer */
+#include "pb_audio.h"
+
+/* Copy-on-write boards with shared rows */
+#include "pb_cow.h"
+
+/* Board canonicalization (mirror + color relabeling) */
+#include "pb_canon.h"
+
 /* Level solver and validator */
 #include "pb_solver.h"
 
+/* Exact minimum-shot solver (IDA*) */
+#include "pb_exact.h"
+
+/* Cancellable background solvability analysis */
+#include "pb_async.h"
+
+/* Endgame tablebase for near-empty boards */
+#include "pb_tablebase.h"
+
 /* A* and JPS pathfinding for hex grids */
 #include "pb_path.h"
 
+/* Bitmap font atlas and cached text layout */
+#include "pb_font.h"
+
+/* Pre-rotated sprites keyed by direction index */
+#include "pb_dirsprite.h"
+
 /* 8-bit/voxel style renderer abstraction */
 #include "pb_render.h"
 
+/* CGA composite artifact-color output filter */
+#include "pb_cga.h"
+
+/* Pooled particle bursts for popped and dropped bubbles */
+#include "pb_particle.h"
+
+/* Deterministic tween timeline for animations */
+#include "pb_anim.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -0,0 +1,138 @@
+/*
+ * pb_cow.h - Copy-on-write boards with reference-counted shared rows
+ *
+ * A pb_board is a flat 2D array, so branching a search copies every row
+ * even though a shot rarely changes more than two or three. A pb_cow_board
+ * instead holds one pointer per row to an immutable, reference-counted
+ * row block. pb_cow_share() copies only the pointers; the first write to a
+ * shared row clones that row alone. Rows that are entirely empty are
+ * stored as NULL and cost nothing.
+ *
+ * A node in a wide beam search therefore costs the row-pointer table plus
+ * the handful of rows its move touched, and siblings share the rest.
+ *
+ * Thread safety: reference counts are atomic, so boards that share rows
+ * may be read, modified and released concurrently from different
+ * threads. A single pb_cow_board value must still be used by one thread
+ * at a time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_COW_H
+#define PB_COW_H
+
+#include "pb_types.h"
+#include "pb_board.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct pb_cow_row pb_cow_row;   /* Opaque row block */
+
+typedef struct pb_cow_board {
+    pb_cow_row* row[PB_MAX_ROWS];       /* NULL = empty row */
+    int cols_even;
+    int cols_odd;
+    int rows;
+    int ceiling_row;
+} pb_cow_board;
+
+/*============================================================================
+ * Lifetime
+ *============================================================================*/
+
+/**
+ * Build a copy-on-write board from a flat board. Rows start unshared.
+ *
+ * @return PB_OK or PB_ERR_NO_MEMORY (out is left empty)
+ */
+pb_result pb_cow_from_board(pb_cow_board* out, const pb_board* board);
+
+/**
+ * Expand into a flat board (neighbor tracking off).
+ */
+void pb_cow_to_board(const pb_cow_board* cow, pb_board* out);
+
+/**
+ * Make dst a second reference to src's rows. O(rows), never allocates.
+ * dst must not hold rows (release it first).
+ */
+void pb_cow_share(pb_cow_board* dst, const pb_cow_board* src);
+
+/**
+ * Drop this board's row references. The board becomes empty.
+ */
+void pb_cow_release(pb_cow_board* cow);
+
+/*============================================================================
+ * Cell Access
+ *============================================================================*/
+
+/**
+ * Read a cell (NULL if out of bounds). Cells of empty rows read as
+ * PB_KIND_NONE.
+ */
+const pb_bubble* pb_cow_get(const pb_cow_board* cow, pb_offset pos);
+
+/**
+ * Write a cell, cloning its row first if it is shared.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG (out of bounds), or PB_ERR_NO_MEMORY
+ */
+pb_result pb_cow_set(pb_cow_board* cow, pb_offset pos, pb_bubble bubble);
+
+/**
+ * Empty a cell. Removing from an empty row never allocates.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY
+ */
+pb_result pb_cow_remove(pb_cow_board* cow, pb_offset pos);
+
+/*============================================================================
+ * Moves
+ *============================================================================*/
+
+/**
+ * Place a colored shot and resolve pops and drops, with the same rules as
+ * pb_exact_play(). Only rows that change are cloned; rows emptied by the
+ * move are released.
+ *
+ * @param cow             Board to modify
+ * @param cell            Landing cell (must be empty)
+ * @param color_id        Shot color
+ * @param match_threshold Pop threshold
+ * @param out_pops        Output: bubbles popped (may be NULL)
+ * @param out_drops       Output: bubbles dropped (may be NULL)
+ * @param out_survived    Output: false if the shot lost the level (last
+ *                        row, nothing popped) (may be NULL)
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY
+ */
+pb_result pb_cow_play(pb_cow_board* cow, pb_offset cell, uint8_t color_id,
+                      int match_threshold, int* out_pops, int* out_drops,
+                      bool* out_survived);
+
+/*============================================================================
+ * Diagnostics
+ *============================================================================*/
+
+/**
+ * Number of boards referencing a row's block (0 for an empty row).
+ */
+int pb_cow_row_refs(const pb_cow_board* cow, int row);
+
+/**
+ * Number of rows two boards share by reference.
+ */
+int pb_cow_shared_rows(const pb_cow_board* a, const pb_cow_board* b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_COW_H */
@@ -0,0 +1,140 @@
+/*
+ * pb_dirsprite.h - Pre-rotated sprites keyed by direction index
+ *
+ * Aim is quantized to PB_DIR_COUNT directions, so anything that turns
+ * with the cannon (barrel, aim arrow) has only 79 distinct images. A
+ * pb_dirsprite_atlas renders each of them once from an upright source
+ * sprite into an 8-bit coverage atlas, filtered (bilinear source
+ * lookups, PB_DIRSPRITE_SUPERSAMPLE^2 samples per pixel) rather than
+ * drawn as aliased lines every frame. Drawing a rotated sprite is then a
+ * single blit of its cell.
+ *
+ * Every direction of a sprite gets a cell of the same size, with the
+ * rotation pivot at the same offset, so a cell is drawn at
+ * (x - pivot_x, y - pivot_y) to put the pivot on (x, y).
+ *
+ * Atlases are eager (every direction rendered when a sprite is added) or
+ * lazy (a direction is rendered by the first pb_dirsprite_get() asking
+ * for it; the source pixels must then stay valid). Like pb_font_atlas,
+ * version is bumped whenever pixels change so a backend knows to upload
+ * the atlas again.
+ *
+ * No allocation: the atlas is a fixed-size value type (about 256KB). A
+ * barrel-sized sprite (5x22) takes a little under half of it.
+ *
+ * Thread safety: an atlas must not be shared between threads without
+ * external locking; lazy lookups write to it.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_DIRSPRITE_H
+#define PB_DIRSPRITE_H
+
+#include "pb_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_DIRSPRITE_ATLAS_W        512
+#define PB_DIRSPRITE_ATLAS_H        512
+#define PB_DIRSPRITE_MAX_SPRITES    4
+#define PB_DIRSPRITE_MAX_SRC        64      /* Source side limit */
+#define PB_DIRSPRITE_SUPERSAMPLE    4       /* Samples per pixel, per axis */
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+/**
+ * Upright source sprite: coverage 0-255, drawn pointing up (toward -y)
+ * from the pivot. The pivot is the center of pixel (pivot_x, pivot_y).
+ */
+typedef struct pb_dirsprite_source {
+    const uint8_t* pixels;      /* w * h, row-major */
+    int w, h;
+    int pivot_x, pivot_y;
+} pb_dirsprite_source;
+
+typedef struct pb_dirsprite_cell {
+    uint16_t x, y;              /* Atlas position */
+    uint8_t w, h;
+    uint8_t pivot_x, pivot_y;   /* Pivot pixel within the cell */
+} pb_dirsprite_cell;
+
+typedef struct pb_dirsprite_atlas {
+    uint8_t pixels[PB_DIRSPRITE_ATLAS_W * PB_DIRSPRITE_ATLAS_H];  /* Coverage */
+    pb_dirsprite_source sources[PB_DIRSPRITE_MAX_SPRITES];
+    pb_dirsprite_cell cells[PB_DIRSPRITE_MAX_SPRITES][PB_DIR_COUNT];
+    bool rendered[PB_DIRSPRITE_MAX_SPRITES][PB_DIR_COUNT];
+    int sprite_count;
+    bool lazy;
+    uint32_t version;           /* Bumped when pixels change (re-upload) */
+
+    /* Shelf packer */
+    int shelf_x, shelf_y, shelf_h;
+} pb_dirsprite_atlas;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+/**
+ * Initialize an empty atlas.
+ *
+ * @param lazy Render directions on first use instead of when added
+ */
+void pb_dirsprite_atlas_init(pb_dirsprite_atlas* atlas, bool lazy);
+
+/**
+ * Add a sprite: reserve a cell per direction and, unless the atlas is
+ * lazy, render them all.
+ *
+ * @param atlas  Atlas
+ * @param source Upright sprite (copied; the pixels are not, and must
+ *               outlive a lazy atlas)
+ * @param id     Output: sprite id
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY (atlas full)
+ */
+pb_result pb_dirsprite_add(pb_dirsprite_atlas* atlas,
+                           const pb_dirsprite_source* source, int* id);
+
+/**
+ * Cell of a sprite at a direction, rendering it first if needed.
+ *
+ * @return Cell, or NULL for a bad id or direction
+ */
+const pb_dirsprite_cell* pb_dirsprite_get(pb_dirsprite_atlas* atlas, int id,
+                                          int dir);
+
+/**
+ * Render every direction not rendered yet (e.g. a lazy atlas at a
+ * loading screen).
+ *
+ * @return Directions rendered
+ */
+int pb_dirsprite_render_all(pb_dirsprite_atlas* atlas);
+
+/**
+ * Nearest direction index to an aim angle, clamped to the valid range.
+ *
+ * This rounds, unlike pb_radians_to_dir() in pb_types.h, which floors.
+ * The result only picks which pre-rotated image to draw for a free aim
+ * angle, and rounding keeps that image within a half step (1 degree) of
+ * the aim instead of up to a full step behind it. Gameplay, replay and
+ * network code that store a direction index should keep using
+ * pb_radians_to_dir(). This helper is also available when
+ * PB_USE_DIRECTION_INDEX is off, where pb_radians_to_dir() is not.
+ */
+int pb_dirsprite_dir(pb_scalar radians);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_DIRSPRITE_H */
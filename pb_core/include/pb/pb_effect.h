@@ -4,6 +4,14 @@
  * Data-driven trigger/effect framework for special bubbles.
  * Effects are triggered by game events and produce actions.
  *
+ * Built-in effects are immutable. Rule variants override them in a
+ * pb_effect_registry owned by the caller (one per match or rule set), so
+ * matches with different special-bubble rules can run on separate threads
+ * without sharing any mutable state.
+ *
+ * Thread safety: the built-in table may be read from any thread. A
+ * registry or queue must not be modified while another thread uses it.
+ *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
@@ -99,16 +107,42 @@ typedef struct pb_effect_result {
  *============================================================================*/
 
 /**
- * Get the default effect for a special bubble type.
+ * Get the built-in effect for a special bubble type.
+ *
+ * @return Immutable definition, or NULL if the type has no effect
  */
 const pb_effect_def* pb_get_special_effect(pb_special_type special);
 
 /**
- * Register a custom effect for a special type.
- * Returns the previous effect definition (for restoration).
+ * Effect table for one rule set: built-in effects with per-type overrides.
+ */
+typedef struct pb_effect_registry {
+    pb_effect_def effects[PB_SPECIAL_COUNT];
+    bool overridden[PB_SPECIAL_COUNT];
+} pb_effect_registry;
+
+/**
+ * Initialize a registry with no overrides.
+ */
+void pb_effect_registry_init(pb_effect_registry* registry);
+
+/**
+ * Effect for a special type: the override if set, else the built-in.
+ *
+ * @return Definition (valid until the next change to this type), or NULL
+ */
+const pb_effect_def* pb_effect_registry_get(const pb_effect_registry* registry,
+                                            pb_special_type special);
+
+/**
+ * Override the effect for a special type, or restore the built-in.
+ *
+ * @param effect Definition to copy, or NULL to remove the override
+ * @return PB_OK or PB_ERR_INVALID_ARG
  */
-const pb_effect_def* pb_register_effect(pb_special_type special,
-                                        const pb_effect_def* effect);
+pb_result pb_effect_registry_set(pb_effect_registry* registry,
+                                 pb_special_type special,
+                                 const pb_effect_def* effect);
 
 /*============================================================================
  * Effect Execution
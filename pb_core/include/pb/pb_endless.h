@@ -0,0 +1,161 @@
+/*
+ * pb_endless.h - Endless scrolling board with windowed row storage
+ *
+ * A climb level can be thousands of rows tall, far more than the
+ * PB_MAX_ROWS a pb_board holds. pb_endless keeps only a window of the
+ * level in an ordinary pb_board (typically the game's own board) and
+ * pulls rows from a level source as the window scrolls. Collision,
+ * matching and orphan detection run on that board unchanged, so memory
+ * and per-shot cost do not depend on the level's length.
+ *
+ * Level rows are numbered by altitude: 0 is the first row pulled in
+ * (the bottom of the level), higher rows come later. The window's top
+ * row holds the highest altitude pulled so far; everything above it is
+ * the rest of the tower, so orphans anchor at the window's top row
+ * (ceiling_row 0). Once the source runs out, the top of the level is in
+ * the window and ceiling_row follows it down as the window scrolls.
+ *
+ * The window always moves by row pairs: shifting by one row would flip
+ * every row's hex parity and with it which cells are adjacent.
+ *
+ * Typical use, once a shot has resolved:
+ *
+ *   pb_endless_refill(&endless);          // climb: bring rows into view
+ *   if (!pb_endless_scroll(&endless)) ... // pressure: ceiling advances
+ *
+ * Thread safety: a pb_endless and its board must be used by one thread
+ * at a time. The built-in sources are read-only and may be shared.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_ENDLESS_H
+#define PB_ENDLESS_H
+
+#include "pb_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Level Sources
+ *============================================================================*/
+
+/**
+ * Fill the cells of the level row at an altitude. Called once per row as
+ * it enters the window, in increasing altitude order.
+ *
+ * @param userdata Source state
+ * @param altitude Level row (0 = bottom)
+ * @param cells    Output: cols cells, zeroed beforehand
+ * @param cols     Cells in the row (window parity decides)
+ * @return         false past the top of the level
+ */
+typedef bool (*pb_level_row_fn)(void* userdata, uint32_t altitude,
+                                pb_bubble* cells, int cols);
+
+typedef struct pb_level_source {
+    pb_level_row_fn row;
+    void* userdata;
+} pb_level_source;
+
+/* Procedural level: every row is a pure function of (seed, altitude) */
+typedef struct pb_level_gen {
+    uint64_t seed;
+    uint8_t allowed_colors;     /* Color bitmask */
+    uint8_t fill_percent;       /* Chance a cell is occupied, 0-100 */
+    uint32_t height;            /* Rows in the level, 0 = endless */
+} pb_level_gen;
+
+/**
+ * pb_level_row_fn for a pb_level_gen (userdata).
+ */
+bool pb_level_gen_row(void* userdata, uint32_t altitude, pb_bubble* cells, int cols);
+
+/* Stored level: height rows of PB_MAX_COLS cells, altitude 0 first */
+typedef struct pb_level_rows {
+    const pb_bubble* cells;
+    uint32_t height;
+} pb_level_rows;
+
+/**
+ * pb_level_row_fn for a pb_level_rows (userdata).
+ */
+bool pb_level_rows_row(void* userdata, uint32_t altitude, pb_bubble* cells, int cols);
+
+/*============================================================================
+ * Window
+ *============================================================================*/
+
+typedef struct pb_endless_config {
+    int window_rows;            /* Even, at most PB_MAX_ROWS */
+    int cols_even;
+    int cols_odd;
+    int initial_rows;           /* Even; rows pulled in at init */
+    int lead_rows;              /* Refill keeps bubbles reaching this deep */
+} pb_endless_config;
+
+typedef struct pb_endless {
+    pb_board* board;            /* Window (not owned) */
+    pb_level_source source;
+    int lead_rows;
+    uint32_t next_altitude;     /* Altitude the next pulled row gets */
+    uint32_t height;            /* Level rows, valid once exhausted */
+    uint32_t rows_scrolled;
+    bool exhausted;             /* Source ran out; the level top is in view */
+} pb_endless;
+
+/**
+ * Default configuration: the default board size (capped to the tier),
+ * top half filled at start, refill keeping bubbles down to the middle.
+ */
+void pb_endless_config_default(pb_endless_config* config);
+
+/**
+ * Reset a board to the window size and pull in the initial rows.
+ *
+ * @param endless Window state
+ * @param board   Board used as the window (e.g. &game.board)
+ * @param source  Level source (copied; its userdata must outlive endless)
+ * @param config  Configuration (NULL for defaults)
+ * @return PB_OK or PB_ERR_INVALID_ARG
+ */
+pb_result pb_endless_init(pb_endless* endless, pb_board* board,
+                          const pb_level_source* source,
+                          const pb_endless_config* config);
+
+/**
+ * Scroll the window up the level by one row pair: rows move down two,
+ * the next two level rows enter at the top. Past the top of the level,
+ * empty rows enter and the ceiling moves down instead.
+ *
+ * @return false if bubbles were pushed off the bottom
+ */
+bool pb_endless_scroll(pb_endless* endless);
+
+/**
+ * Scroll while the lowest bubble is above lead_rows and the level has
+ * rows left. Call after each shot has resolved.
+ *
+ * @return Rows scrolled
+ */
+int pb_endless_refill(pb_endless* endless);
+
+/**
+ * Altitude of a window row.
+ *
+ * @return Altitude, or UINT32_MAX if the row holds no level row
+ */
+uint32_t pb_endless_row_altitude(const pb_endless* endless, int row);
+
+/**
+ * Lowest window row holding a bubble, or -1 if the window is empty.
+ */
+int pb_endless_lowest_row(const pb_endless* endless);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_ENDLESS_H */
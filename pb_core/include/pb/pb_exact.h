@@ -0,0 +1,233 @@
+/*
+ * pb_exact.h - Exact minimum-shot solver for puzzle mode
+ *
+ * pb_analyze_solvability() plays greedily, so its min_moves is only an
+ * upper bound. In PB_MODE_PUZZLE the whole queue is known up front, which
+ * makes the true minimum computable: this module runs IDA* over
+ * (board, queue position) states and returns a proven-optimal line.
+ *
+ * Search model (the same one pb_solver_apply_move uses):
+ * - A shot places a colored bubble in a landing cell; a same-color group
+ *   of at least match_threshold pops and orphans then drop.
+ * - A shot that lands in the last row without popping loses the level.
+ * - With allow_color_switch the preview bubble may be fired instead of
+ *   the current one (equivalent to swap-then-shoot).
+ * - The level is solved when no PB_KIND_COLORED bubble remains.
+ *
+ * Lower bound: a bubble in the ceiling row can never drop, only pop, and a
+ * pop removes one color. Each color c present in the ceiling row therefore
+ * needs at least max(1, threshold - count(c) - wildcards) shots of color c,
+ * and those shots must still be in the queue. Summing over colors gives an
+ * admissible (never overestimating) heuristic. When a tablebase is
+ * supplied, near-empty boards are probed and the table value replaces the
+ * heuristic whenever it is larger (exact in attachable mode, a valid bound
+ * in trajectory mode; ignored when color switching is allowed).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_EXACT_H
+#define PB_EXACT_H
+
+#include "pb_types.h"
+#include "pb_board.h"
+#include "pb_solver.h"
+#include "pb_tablebase.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+/* Longest line the solver will search (one move per queued bubble) */
+#ifndef PB_EXACT_MAX_DEPTH
+#define PB_EXACT_MAX_DEPTH 32
+#endif
+
+/* Maximum worker threads for the root split */
+#ifndef PB_EXACT_MAX_THREADS
+#define PB_EXACT_MAX_THREADS 16
+#endif
+
+/* Default transposition table size (log2 entries, per worker) */
+#ifndef PB_EXACT_DEFAULT_TT_BITS
+#define PB_EXACT_DEFAULT_TT_BITS 16
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/**
+ * How landing cells are generated at each node.
+ */
+typedef enum pb_exact_movegen {
+    PB_EXACT_MOVES_TRAJECTORY = 0,  /* Fire all 79 direction indices */
+    PB_EXACT_MOVES_ATTACHABLE,      /* Every empty cell touching the cluster */
+} pb_exact_movegen;
+
+/**
+ * Snapshot passed to the progress callback.
+ */
+typedef struct pb_exact_progress {
+    int bound;                  /* IDA* bound being searched */
+    int lower_bound;            /* Largest bound fully refuted so far */
+    int upper_bound;            /* Best known line length, or -1 */
+    uint64_t nodes;             /* Nodes expanded so far */
+    uint32_t elapsed_ms;
+} pb_exact_progress;
+
+/**
+ * Progress callback, invoked every few hundred nodes from whichever worker
+ * thread is checking the budget (calls are serialized). Return false to
+ * cancel the search; the result then reports PB_EXACT_TIMEOUT.
+ */
+typedef bool (*pb_exact_progress_fn)(const pb_exact_progress* progress,
+                                     void* userdata);
+
+/**
+ * Transposition table kept alive across solves (opaque). Entries record
+ * "no clearing line within N shots from this state", which stays true for
+ * any root as long as the queue and rules are unchanged, so an editor
+ * re-solving after a small edit starts with everything the previous solve
+ * proved. The table is cleared automatically when the queue, rules or
+ * board geometry change. Used by worker 0 only; one solve at a time.
+ */
+typedef struct pb_exact_cache pb_exact_cache;
+
+typedef struct pb_exact_config {
+    int max_depth;              /* Cap on line length (<= PB_EXACT_MAX_DEPTH) */
+    int threads;                /* Root-split workers (1 = serial) */
+    uint32_t time_budget_ms;    /* Wall-clock budget (0 = unlimited) */
+    uint64_t node_budget;       /* Node expansion budget (0 = unlimited) */
+    int tt_bits;                /* log2 transposition entries per worker */
+    pb_exact_movegen movegen;
+    bool seed_with_greedy;      /* Seed an upper bound with a greedy line */
+    const pb_tablebase* tablebase;  /* Endgame table probed at every node (optional) */
+    pb_exact_cache* cache;      /* Persistent table for worker 0 (optional) */
+    pb_exact_progress_fn on_progress;   /* Progress/cancel hook (optional) */
+    void* progress_userdata;
+} pb_exact_config;
+
+/*============================================================================
+ * Result
+ *============================================================================*/
+
+typedef enum pb_exact_status {
+    PB_EXACT_OPTIMAL = 0,       /* witness is a proven minimum */
+    PB_EXACT_UNSOLVABLE,        /* No clearing line exists for this queue */
+    PB_EXACT_TIMEOUT,           /* Budget hit; witness is best-so-far */
+    PB_EXACT_DEPTH_LIMIT,       /* max_depth exhausted without a solution */
+} pb_exact_status;
+
+typedef struct pb_exact_result {
+    pb_exact_status status;
+    int min_shots;              /* Witness length, or -1 if none known */
+    int lower_bound;            /* Proven lower bound on the optimum */
+    int witness_length;
+    pb_move witness[PB_EXACT_MAX_DEPTH];
+    uint64_t nodes;             /* Nodes expanded over all iterations */
+    uint64_t tt_hits;           /* Subtrees pruned by the transposition table */
+    int iterations;             /* IDA* bounds tried */
+    uint32_t elapsed_ms;
+} pb_exact_result;
+
+/*============================================================================
+ * Solver
+ *============================================================================*/
+
+/**
+ * Fill config with defaults: trajectory move generation, one thread,
+ * no time budget, 2^PB_EXACT_DEFAULT_TT_BITS table entries, greedy seed.
+ */
+void pb_exact_config_default(pb_exact_config* config);
+
+/**
+ * Find the minimum number of shots that clears the board.
+ *
+ * The search is anytime: when a budget expires the result carries the
+ * best line found so far (status PB_EXACT_TIMEOUT) together with the
+ * largest bound that was fully refuted (lower_bound).
+ *
+ * @param board         Initial board
+ * @param ruleset       Rules (NULL = defaults); threshold, geometry, bounces,
+ *                      bubble_radius and allow_color_switch are honoured
+ * @param queue         Full shot queue (queue[0] is the current bubble)
+ * @param queue_length  Number of queued bubbles
+ * @param config        Search configuration (NULL = defaults)
+ * @param result        Output
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY
+ */
+pb_result pb_solve_exact(const pb_board* board, const pb_ruleset* ruleset,
+                         const pb_bubble* queue, int queue_length,
+                         const pb_exact_config* config,
+                         pb_exact_result* result);
+
+/*============================================================================
+ * Persistent Cache
+ *============================================================================*/
+
+/**
+ * Create a transposition cache of 2^tt_bits entries (clamped to 8..26).
+ *
+ * @return Cache, or NULL on allocation failure
+ */
+pb_exact_cache* pb_exact_cache_create(int tt_bits);
+
+/**
+ * Destroy a cache.
+ */
+void pb_exact_cache_destroy(pb_exact_cache* cache);
+
+/**
+ * Forget every entry.
+ */
+void pb_exact_cache_clear(pb_exact_cache* cache);
+
+/*============================================================================
+ * Move Model
+ *============================================================================*/
+
+/**
+ * List every empty cell a shot could stick to: cells in the ceiling row
+ * and cells touching an occupied neighbour.
+ *
+ * @return Number of cells written to out (at most max)
+ */
+int pb_exact_attachable_cells(const pb_board* board, pb_offset* out, int max);
+
+/**
+ * Place a colored shot and resolve pops and drops.
+ *
+ * @param board           Board to modify
+ * @param cell            Landing cell (must be empty)
+ * @param color_id        Shot color
+ * @param match_threshold Pop threshold
+ * @param out_pops        Output: bubbles popped (may be NULL)
+ * @param out_drops       Output: bubbles dropped (may be NULL)
+ * @return false if the shot lost the level (last row, nothing popped)
+ */
+bool pb_exact_play(pb_board* board, pb_offset cell, uint8_t color_id,
+                   int match_threshold, int* out_pops, int* out_drops);
+
+/**
+ * Admissible lower bound used by the search.
+ *
+ * @param board          Board to evaluate
+ * @param match_threshold Pop threshold
+ * @param shots          Remaining shot colors, in firing order
+ * @param shot_count     Number of remaining shots
+ * @return Minimum shots still required, or a value > shot_count when
+ *         the queue cannot supply the colors the ceiling row needs
+ */
+int pb_exact_lower_bound(const pb_board* board, int match_threshold,
+                         const pb_bubble* shots, int shot_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_EXACT_H */
@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <math.h>
+#include "pb_tables.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -346,10 +347,15 @@ static inline fix32_t pb_fix_recip32_q16(fix32_t x) {
     if (x == 0) return PB_FIX_MAX_S32;
     if (x < 0) return -pb_fix_recip32_q16(-x);
 
-    /* Initial estimate: 1/x ≈ 1.0 for small values, scale down for large */
-    /* Use float for initial estimate (will be optimized away on platforms with FPU) */
-    float x_f = (float)x / 65536.0f;
-    fix32_t estimate = (fix32_t)(65536.0f / x_f);
+    /* Initial estimate from the generated seed table (no FPU needed):
+     * x = 2^n * m with m in [1, 2), so 2^32/x = (2^16/m) * 2^(16 - n) */
+    int n = 31 - PB_FIX_CLZ32((uint32_t)x);
+    uint32_t idx = (n >= PB_RECIP_SEED_BITS)
+        ? ((uint32_t)x >> (n - PB_RECIP_SEED_BITS)) & 0xFFu
+        : ((uint32_t)x << (PB_RECIP_SEED_BITS - n)) & 0xFFu;
+    fix64_t seed = pb_recip_seed_q16[idx];
+    fix64_t scaled = (n <= 16) ? seed << (16 - n) : seed >> (n - 16);
+    fix32_t estimate = (scaled > PB_FIX_MAX_S32) ? PB_FIX_MAX_S32 : (fix32_t)scaled;
 
     /* Newton-Raphson iterations: e = e * (2 - x*e) */
     /* Using 64-bit intermediates for precision */
@@ -361,6 +367,12 @@ static inline fix32_t pb_fix_recip32_q16(fix32_t x) {
         estimate = (fix32_t)(((fix64_t)estimate * factor) >> 32);
     }
 
+    /* NR truncates from below; recover the last unit */
+    if (estimate < PB_FIX_MAX_S32 &&
+        (fix64_t)x * (estimate + 1) <= ((fix64_t)1 << 32)) {
+        estimate++;
+    }
+
     return estimate;
 }
 
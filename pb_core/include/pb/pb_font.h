@@ -0,0 +1,189 @@
+/*
+ * pb_font.h - Bitmap font atlas, cached text layout and text batching
+ *
+ * Glyphs are 1-bit bitmaps packed into a single 8-bit coverage atlas
+ * (shelf packing), so a backend uploads one texture and every string
+ * draws from it. A built-in 3x5 font covers digits, upper case (lower
+ * case folds to it) and common punctuation.
+ *
+ * Laying out a string turns it into glyph quads. A pb_text_cache keeps
+ * the quads of recently drawn strings keyed by content, so a HUD that
+ * redraws the same score or label every frame does no glyph lookups;
+ * only strings that changed are laid out again. A pb_text_batch gathers
+ * the quads of every string in a frame, with position and color, for a
+ * single draw: pb_render_text_batch() for the indexed renderer, or one
+ * textured quad list for a GPU backend.
+ *
+ * No allocation: atlas, cache and batch are fixed-size value types.
+ *
+ * Thread safety: none of these objects may be shared between threads
+ * without external locking.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_FONT_H
+#define PB_FONT_H
+
+#include "pb_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_FONT_FIRST_CHAR      32      /* Space */
+#define PB_FONT_GLYPHS          96      /* Codepoints 32-127 */
+#define PB_FONT_ATLAS_W         128
+#define PB_FONT_ATLAS_H         64
+#define PB_FONT_MAX_GLYPH_W     8       /* Glyph rows are one byte */
+#define PB_FONT_MAX_GLYPH_H     16
+
+#define PB_TEXT_MAX_LEN         48      /* Longer strings are truncated */
+#define PB_TEXT_CACHE_SIZE      32      /* Cached layouts (LRU) */
+#define PB_TEXT_BATCH_MAX       512     /* Glyph quads per batch */
+
+/*============================================================================
+ * Font Atlas
+ *============================================================================*/
+
+typedef struct pb_glyph {
+    uint16_t x, y;              /* Atlas position */
+    uint8_t w, h;
+    uint8_t advance;            /* Pen advance in pixels */
+    bool present;
+} pb_glyph;
+
+typedef struct pb_font_atlas {
+    uint8_t pixels[PB_FONT_ATLAS_W * PB_FONT_ATLAS_H];  /* Coverage, 0 or 1 */
+    pb_glyph glyphs[PB_FONT_GLYPHS];
+    int line_height;
+    uint32_t version;           /* Bumped when pixels change (re-upload) */
+
+    /* Shelf packer */
+    int shelf_x, shelf_y, shelf_h;
+} pb_font_atlas;
+
+/**
+ * Initialize an empty atlas.
+ */
+void pb_font_atlas_init(pb_font_atlas* atlas, int line_height);
+
+/**
+ * Initialize an atlas with the built-in 3x5 font (advance 4, line 6).
+ */
+void pb_font_atlas_init_builtin(pb_font_atlas* atlas);
+
+/**
+ * Pack a glyph. Each row is one byte; column x is bit (w - 1 - x), so the
+ * leftmost pixel is the highest used bit. Replacing a glyph packs it anew.
+ *
+ * @param atlas   Atlas
+ * @param ch      Codepoint (32-127)
+ * @param w, h    Size (1-8 by 1-16)
+ * @param rows    h row bytes
+ * @param advance Pen advance
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY (atlas full)
+ */
+pb_result pb_font_atlas_add_glyph(pb_font_atlas* atlas, int ch, int w, int h,
+                                  const uint8_t* rows, int advance);
+
+/**
+ * Glyph used to draw a character: lower case falls back to upper case,
+ * anything else missing to '?'.
+ *
+ * @return Glyph, or NULL if neither exists
+ */
+const pb_glyph* pb_font_atlas_glyph(const pb_font_atlas* atlas, int ch);
+
+/*============================================================================
+ * Layout
+ *============================================================================*/
+
+typedef struct pb_text_quad {
+    int16_t x, y;               /* Destination top-left */
+    uint16_t src_x, src_y;      /* Atlas position */
+    uint8_t w, h;
+    uint8_t color;              /* Palette index (batches only) */
+} pb_text_quad;
+
+/**
+ * Lay out a string at the origin. '\n' starts a new line.
+ *
+ * @param atlas  Atlas
+ * @param text   String (at most PB_TEXT_MAX_LEN characters are used)
+ * @param quads  Output: up to PB_TEXT_MAX_LEN quads
+ * @param width  Output: widest line in pixels (may be NULL)
+ * @param height Output: total height in pixels (may be NULL)
+ * @return       Quad count (spaces produce none)
+ */
+int pb_text_layout(const pb_font_atlas* atlas, const char* text,
+                   pb_text_quad* quads, int* width, int* height);
+
+/*============================================================================
+ * Layout Cache
+ *============================================================================*/
+
+typedef struct pb_text_layout_entry {
+    uint32_t hash;
+    uint32_t last_used;         /* Cache clock at last lookup, 0 = empty */
+    uint32_t atlas_version;
+    uint8_t len;
+    uint8_t quad_count;
+    int16_t width, height;
+    char text[PB_TEXT_MAX_LEN];
+    pb_text_quad quads[PB_TEXT_MAX_LEN];
+} pb_text_layout_entry;
+
+typedef struct pb_text_cache {
+    const pb_font_atlas* atlas;
+    uint32_t clock;
+    uint32_t hits;
+    uint32_t misses;
+    pb_text_layout_entry entries[PB_TEXT_CACHE_SIZE];
+} pb_text_cache;
+
+/**
+ * Initialize an empty cache for an atlas.
+ */
+void pb_text_cache_init(pb_text_cache* cache, const pb_font_atlas* atlas);
+
+/**
+ * Layout of a string, from the cache when its contents and the atlas are
+ * unchanged, otherwise laid out into the least recently used entry.
+ *
+ * @return Layout (valid until the entry is evicted), or NULL on bad args
+ */
+const pb_text_layout_entry* pb_text_cache_get(pb_text_cache* cache, const char* text);
+
+/*============================================================================
+ * Batching
+ *============================================================================*/
+
+typedef struct pb_text_batch {
+    int count;
+    uint32_t dropped;           /* Quads that did not fit */
+    pb_text_quad quads[PB_TEXT_BATCH_MAX];
+} pb_text_batch;
+
+/**
+ * Empty a batch for a new frame.
+ */
+void pb_text_batch_clear(pb_text_batch* batch);
+
+/**
+ * Append a string's quads at a position in a palette color.
+ *
+ * @return String width in pixels
+ */
+int pb_text_batch_add(pb_text_batch* batch, pb_text_cache* cache,
+                      const char* text, int x, int y, uint8_t color);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_FONT_H */
@@ -244,7 +244,7 @@ static const int16_t pb_sin_table[256] = {
  *
  * Uses 79-entry lookup tables covering only firing angles (12°-168°).
  * This saves 70% memory compared to full 256-entry tables.
- * Values extracted from hp48-puzzle-bobble implementation.
+ * Values come from the generated Q16 tables in pb_tables.h.
  *
  * Format: Q12 fixed-point (value * 4096)
  * Index 0 = 12°, Index 78 = 168°, Step = 2°
@@ -252,41 +252,7 @@ static const int16_t pb_sin_table[256] = {
 
 #if PB_USE_GAME_ANGLE_TABLE
 
-/*
- * Sine lookup for firing angles only (12° to 168° in 2° steps)
- * Q12 format: sin(angle) * 4096
- * Index N corresponds to angle (12 + N*2) degrees
- */
-static const int16_t pb_game_sin_table[79] = {
-    /* 12°-26° */   852,  991, 1129, 1266, 1401, 1534, 1666, 1796,
-    /* 28°-42° */  1923, 2048, 2171, 2290, 2407, 2521, 2631, 2739,
-    /* 44°-58° */  2842, 2942, 3039, 3131, 3219, 3303, 3383, 3458,
-    /* 60°-74° */  3528, 3593, 3653, 3708, 3758, 3802, 3841, 3875,
-    /* 76°-90° */  3902, 3924, 3940, 3951, 3956, 3956, 3951, 4096,
-    /* 92°-106° */ 4094, 4086, 4074, 4056, 4034, 4006, 3974, 3937,
-    /* 108°-122° */3895, 3848, 3797, 3742, 3682, 3618, 3550, 3478,
-    /* 124°-138° */3401, 3321, 3237, 3149, 3058, 2963, 2865, 2763,
-    /* 140°-154° */2658, 2550, 2439, 2325, 2209, 2089, 1967, 1843,
-    /* 156°-168° */1716, 1588, 1457, 1325, 1191, 1056,  920
-};
-
-/*
- * Cosine lookup for firing angles only (12° to 168° in 2° steps)
- * Q12 format: cos(angle) * 4096
- * Note: Cosine values go negative after 90°
- */
-static const int16_t pb_game_cos_table[79] = {
-    /* 12°-26° */  4006, 3974, 3937, 3895, 3849, 3798, 3742, 3681,
-    /* 28°-42° */  3617, 3547, 3474, 3396, 3314, 3228, 3138, 3044,
-    /* 44°-58° */  2946, 2845, 2740, 2632, 2521, 2407, 2290, 2171,
-    /* 60°-74° */  2048, 1923, 1796, 1666, 1534, 1401, 1266, 1129,
-    /* 76°-90° */   991,  852,  711,  570,  428,  286,  143,    0,
-    /* 92°-106° */ -143, -286, -428, -570, -711, -852, -991,-1129,
-    /* 108°-122° */-1266,-1401,-1534,-1666,-1796,-1923,-2048,-2170,
-    /* 124°-138° */-2290,-2407,-2521,-2632,-2740,-2845,-2946,-3044,
-    /* 140°-154° */-3138,-3228,-3314,-3396,-3474,-3547,-3617,-3681,
-    /* 156°-168° */-3742,-3798,-3849,-3895,-3937,-3974,-4006
-};
+#include "pb_tables.h"
 
 /*
  * Game-specific trig functions using direction index.
@@ -296,14 +262,19 @@ static const int16_t pb_game_cos_table[79] = {
  * Note: Uses uint8_t instead of pb_direction_index because this header
  * is included before pb_types.h defines that type.
  */
+/* Q16 to Q12, rounded symmetrically so mirrored angles stay exact negatives */
+PB_INLINE int16_t pb_game_q16_to_q12(int32_t v) {
+    return (int16_t)(v >= 0 ? (v + 8) >> 4 : -((-v + 8) >> 4));
+}
+
 PB_INLINE int16_t pb_game_sin(uint8_t idx) {
     if (idx > 78) idx = 78;
-    return pb_game_sin_table[idx];
+    return pb_game_q16_to_q12(pb_dir_sin_q16[idx]);
 }
 
 PB_INLINE int16_t pb_game_cos(uint8_t idx) {
     if (idx > 78) idx = 78;
-    return pb_game_cos_table[idx];
+    return pb_game_q16_to_q12(pb_dir_cos_q16[idx]);
 }
 
 #endif /* PB_USE_GAME_ANGLE_TABLE */
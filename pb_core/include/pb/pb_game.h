@@ -4,6 +4,10 @@
  * Main game loop orchestration: initialization, input handling,
  * shot resolution, match detection, and win/lose conditions.
  *
+ * Thread safety: a game state touches no global state, so separate games
+ * may be ticked on separate threads; one game must be used by one thread
+ * at a time (event subscribers run on that thread).
+ *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
@@ -49,7 +53,8 @@ pb_result pb_game_init(pb_game_state* state, const pb_ruleset* ruleset,
                        uint64_t seed);
 
 /**
- * Reset game state for a new game (preserves ruleset).
+ * Reset game state for a new game (preserves ruleset and event
+ * subscriptions).
  */
 void pb_game_reset(pb_game_state* state, uint64_t seed);
 
@@ -182,10 +187,44 @@ int pb_game_get_events(const pb_game_state* state, int start_idx,
 void pb_game_clear_events(pb_game_state* state);
 
 /**
- * Add event to the log.
+ * Add event to the log and deliver it to matching subscribers.
+ *
+ * Subscribers see the caller's event in place, before it is logged. Events
+ * past the log capacity are still delivered and counted in events_dropped.
  */
 void pb_game_add_event(pb_game_state* state, const pb_event* event);
 
+/**
+ * Register an event observer.
+ *
+ * The callback runs synchronously from pb_game_add_event() for every event
+ * whose type bit is set in type_mask, in slot order. It must not add events
+ * or (un)subscribe. Subscriptions survive pb_game_reset() but not
+ * pb_game_init().
+ *
+ * @param state     Game state
+ * @param type_mask PB_EVENT_MASK() bits, or PB_EVENT_MASK_ALL
+ * @param callback  Observer
+ * @param userdata  Passed to callback
+ * @param out_id    Output: subscription id for pb_game_unsubscribe() (may be NULL)
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY (all slots used)
+ */
+pb_result pb_game_subscribe(pb_game_state* state, uint32_t type_mask,
+                            pb_event_fn callback, void* userdata, int* out_id);
+
+/**
+ * Remove an event observer.
+ *
+ * @return PB_OK or PB_ERR_INVALID_ARG (unknown id)
+ */
+pb_result pb_game_unsubscribe(pb_game_state* state, int id);
+
+/**
+ * Enable or disable the event log. With the log disabled, events reach
+ * subscribers only and long cascades cannot overflow it.
+ */
+void pb_game_set_event_log(pb_game_state* state, bool enabled);
+
 /*============================================================================
  * Garbage Exchange (Versus Mode)
  *============================================================================*/
@@ -0,0 +1,245 @@
+/*
+ * pb_net.h - UDP input-relay transport for lockstep/rollback versus play
+ *
+ * Each peer sends its own inputs and relays nothing else. Every packet
+ * carries all input frames the peer has not yet acknowledged (up to
+ * max_frames of them), packed with pb_event_pack(), so a lost packet is
+ * simply covered by the next one and there is no retransmit logic. If the
+ * peer falls more than max_frames behind, the window starts at its oldest
+ * missing frame, so it always catches up.
+ *
+ * Packets also piggyback the sender's most recent pb_frame_checksum()
+ * values for desync detection, plus timestamps for an RTT and RFC 3550
+ * interarrival-jitter estimate that sizes the input delay.
+ *
+ * All timing uses caller-supplied millisecond clocks, so tests are
+ * deterministic. A loss/latency simulator on the send path holds or drops
+ * outgoing datagrams to exercise the protocol over real loopback sockets.
+ *
+ * Wire format (integers are LEB128 varints unless noted):
+ *   [2] Magic "PN"            [1] Version       [1] Flags
+ *   seq, send_ms, echo_ms, echo_hold_ms
+ *   ack_frames                Peer frames [0, ack_frames) received
+ *   first_frame, frame_span   Inputs cover [first_frame, first_frame + span)
+ *   input_count, inputs...    pb_event_pack(), deltas from first_frame
+ *   [1] checksum_count, then (frame, [4] LE checksum) pairs
+ *
+ * Thread safety: a pb_net must be used by one thread at a time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_NET_H
+#define PB_NET_H
+
+#include "pb_types.h"
+#include "pb_replay.h"
+#include "pb_checksum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_NET_VERSION          1
+#define PB_NET_MAX_PACKET       512     /* Datagram payload limit */
+#define PB_NET_PACKET_INPUTS    40      /* Max inputs per packet (and frame) */
+#define PB_NET_PACKET_CHECKSUMS 4       /* Checksums piggybacked per packet */
+#define PB_NET_HISTORY          256     /* Unacked local / unread remote inputs */
+#define PB_NET_CHECKSUM_HISTORY 32      /* Checksums kept for comparison */
+#define PB_NET_SIM_QUEUE        64      /* Datagrams the simulator can hold */
+
+/* Packet flags */
+#define PB_NET_FLAG_FIXED_POINT (1 << 0)    /* Angles are Q16.16 */
+#define PB_NET_FLAG_ECHO        (1 << 1)    /* echo_ms is valid */
+
+/*============================================================================
+ * Packet Codec
+ *============================================================================*/
+
+typedef struct pb_net_checksum {
+    uint32_t frame;
+    uint32_t value;
+} pb_net_checksum;
+
+typedef struct pb_net_packet {
+    uint8_t flags;
+    uint32_t seq;
+    uint32_t send_ms;           /* Sender clock at send */
+    uint32_t echo_ms;           /* Latest send_ms received from the peer */
+    uint32_t echo_hold_ms;      /* Time echo_ms was held before this send */
+    uint32_t ack_frames;        /* Peer frames [0, ack_frames) received */
+    uint32_t first_frame;
+    uint32_t end_frame;         /* Inputs are final for [first, end) */
+    int input_count;
+    pb_input_event inputs[PB_NET_PACKET_INPUTS];
+    int checksum_count;
+    pb_net_checksum checksums[PB_NET_PACKET_CHECKSUMS];
+} pb_net_packet;
+
+/**
+ * Encode a packet.
+ *
+ * @param packet Packet (inputs sorted by frame, all in [first, end))
+ * @param out    Output buffer
+ * @param cap    Buffer size (PB_NET_MAX_PACKET always suffices)
+ * @return       Bytes written, or 0 if the packet is malformed or too large
+ */
+int pb_net_packet_encode(const pb_net_packet* packet, uint8_t* out, int cap);
+
+/**
+ * Decode and validate a packet.
+ *
+ * @return PB_OK or PB_ERR_INVALID_ARG (truncated, wrong magic/version,
+ *         or inputs outside the frame range)
+ */
+pb_result pb_net_packet_decode(const uint8_t* data, int len, pb_net_packet* packet);
+
+/*============================================================================
+ * Transport
+ *============================================================================*/
+
+typedef struct pb_net pb_net;   /* Opaque */
+
+typedef struct pb_net_config {
+    int max_frames;             /* Redundancy: input frames per packet */
+    bool use_fixed_point;       /* Q16.16 angles on the wire */
+    uint32_t frame_ms;          /* Frame duration, for delay_frames */
+
+    /* Send-path simulator (all zero = off) */
+    uint32_t sim_loss_permille; /* Drop probability, 0-1000 */
+    uint32_t sim_latency_ms;    /* Fixed one-way delay */
+    uint32_t sim_jitter_ms;     /* Extra uniform delay in [0, jitter] */
+    uint64_t sim_seed;
+} pb_net_config;
+
+typedef struct pb_net_stats {
+    uint32_t packets_sent;
+    uint32_t packets_received;
+    uint32_t packets_invalid;   /* Failed to decode */
+    uint32_t packets_lost;      /* Sequence numbers never received */
+    uint32_t packets_stale;     /* Carried no new frames */
+    uint32_t sim_dropped;       /* Discarded by the simulator */
+    uint32_t inputs_received;
+    float jitter_ms;            /* RFC 3550 interarrival jitter */
+    float rtt_ms;               /* Smoothed round-trip time */
+    int delay_frames;           /* Suggested input delay: rtt/2 + 4*jitter */
+} pb_net_stats;
+
+/**
+ * Default configuration: 16 frames of redundancy, 16 ms frames, float
+ * angles, simulator off.
+ */
+void pb_net_config_default(pb_net_config* config);
+
+/**
+ * Create a transport (no socket yet).
+ *
+ * @param config Configuration (NULL for defaults)
+ * @return       Transport, or NULL on allocation failure or bad config
+ */
+pb_net* pb_net_create(const pb_net_config* config);
+
+/**
+ * Close the socket and free the transport.
+ */
+void pb_net_destroy(pb_net* net);
+
+/**
+ * Open a non-blocking IPv4 UDP socket.
+ *
+ * @param host Local address ("127.0.0.1"), or NULL for any
+ * @param port Local port, or 0 for an ephemeral port
+ * @return PB_OK, PB_ERR_INVALID_ARG, PB_ERR_INVALID_STATE (socket error),
+ *         or PB_ERR_NOT_IMPLEMENTED without PB_FEATURE_NET
+ */
+pb_result pb_net_bind(pb_net* net, const char* host, uint16_t port);
+
+/**
+ * Bound local port (0 if not bound).
+ */
+uint16_t pb_net_local_port(const pb_net* net);
+
+/**
+ * Set the peer address. Datagrams from any other address are ignored.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, PB_ERR_INVALID_STATE (not bound),
+ *         or PB_ERR_NOT_IMPLEMENTED
+ */
+pb_result pb_net_connect(pb_net* net, const char* host, uint16_t port);
+
+/**
+ * Queue a local input for sending. Inputs must arrive in frame order, for
+ * frames not yet committed.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG (frame already committed or out of
+ *         order), or PB_ERR_NO_MEMORY (history full: the peer has stopped
+ *         acknowledging, or the frame has PB_NET_PACKET_INPUTS inputs)
+ */
+pb_result pb_net_add_input(pb_net* net, const pb_input_event* input);
+
+/**
+ * Declare local inputs final for all frames up to and including frame.
+ */
+void pb_net_commit_frame(pb_net* net, uint32_t frame);
+
+/**
+ * Record the local checksum for a simulated frame (pb_frame_checksum()).
+ * It is sent to the peer and compared with the peer's value for the frame.
+ */
+void pb_net_add_checksum(pb_net* net, uint32_t frame, uint32_t checksum);
+
+/**
+ * Send one packet with every unacknowledged committed frame (up to
+ * max_frames). Call once per frame.
+ *
+ * @return PB_OK, PB_ERR_INVALID_STATE (not connected or send failed)
+ */
+pb_result pb_net_send(pb_net* net, uint32_t now_ms);
+
+/**
+ * Release simulated datagrams that are due, then receive and apply every
+ * pending datagram. Call once per frame, even when not sending.
+ *
+ * @return Number of packets applied
+ */
+int pb_net_poll(pb_net* net, uint32_t now_ms);
+
+/**
+ * Pop the next remote input in frame order.
+ *
+ * @return true if an input was returned
+ */
+bool pb_net_pop_input(pb_net* net, pb_input_event* out);
+
+/**
+ * Remote inputs are final for frames [0, pb_net_remote_frames()). Lockstep
+ * may simulate those frames; rollback predicts beyond them.
+ */
+uint32_t pb_net_remote_frames(const pb_net* net);
+
+/**
+ * Frames the peer has acknowledged receiving from us.
+ */
+uint32_t pb_net_acked_frames(const pb_net* net);
+
+/**
+ * First checksum mismatch seen, if any.
+ *
+ * @return true if a desync was detected (info filled when non-NULL)
+ */
+bool pb_net_desync(const pb_net* net, pb_desync_info* info);
+
+/**
+ * Transfer, loss and timing statistics.
+ */
+void pb_net_get_stats(const pb_net* net, pb_net_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_NET_H */
@@ -0,0 +1,203 @@
+/*
+ * pb_particle.h - Pooled particle bursts for popped and dropped bubbles
+ *
+ * A pb_particles pool is a fixed-capacity structure of arrays (x, y, vx,
+ * vy, life, palette index) allocated once at creation. Nothing is
+ * allocated afterwards: spawning into a full pool discards the new
+ * particles and counts them, so a worst-case cascade degrades visually
+ * instead of stalling the frame.
+ *
+ * Particles are spawned from PB_EVENT_BUBBLES_POPPED and
+ * PB_EVENT_BUBBLES_DROPPED events. pb_particles_attach() subscribes the
+ * pool to a game, and reads each removed cell's color_id from the board
+ * (removal clears only the kind, so the color survives until the cell
+ * is reused).
+ *
+ * The update integrates four particles per step (SSE2 or NEON when
+ * available, plain loops otherwise) and culls expired or offscreen
+ * particles a block at a time, so fully live blocks cost one compare.
+ * Rendering is one pb_render_indexed_sprite_batch() call over an
+ * instance array the pool owns, or a backend can read the arrays through
+ * pb_particles_view() and submit them as a single geometry batch.
+ *
+ * Thread safety: a pb_particles pool must be used by one thread at a time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_PARTICLE_H
+#define PB_PARTICLE_H
+
+#include "pb_types.h"
+#include "pb_render.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_PARTICLE_LANES       4       /* Particles per update step */
+#define PB_PARTICLE_MAX_BURST   32      /* Max particles per removed cell */
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct pb_particles pb_particles;   /* Opaque */
+
+typedef struct pb_particle_config {
+    int capacity;               /* Pool size, rounded up to PB_PARTICLE_LANES */
+
+    /* Board-to-screen mapping */
+    float origin_x, origin_y;   /* Screen position of the board origin */
+    float bubble_radius;        /* Pixels, as passed to pb_offset_to_pixel() */
+
+    /* Cull rectangle: particles leaving [min, max) are removed */
+    float view_min_x, view_min_y;
+    float view_max_x, view_max_y;
+
+    /* Bursts (speeds in pixels/frame, lifetimes in frames) */
+    int per_pop;                /* Particles per popped cell */
+    int per_drop;               /* Particles per dropped cell */
+    float pop_speed;            /* Radial burst speed */
+    float drop_speed;           /* Initial downward speed */
+    float life_pop;
+    float life_drop;
+    float gravity;              /* Pixels/frame^2, positive is down */
+    float drag;                 /* Velocity fraction lost per frame (0-1) */
+
+    /* Rendering */
+    const pb_indexed_sprite* sprite;    /* Particle sprite (centered) */
+    uint8_t palette_base;       /* palette_offset = palette_base + color_id */
+    int layer;                  /* Sprite layer for the batch */
+
+    uint64_t seed;              /* Burst direction/speed jitter */
+} pb_particle_config;
+
+typedef struct pb_particle_stats {
+    int active;                 /* Live particles */
+    int capacity;
+    uint32_t spawned;           /* Total particles spawned */
+    uint32_t rejected;          /* Spawns discarded because the pool was full */
+    uint32_t expired;           /* Removed at end of life */
+    uint32_t culled;            /* Removed for leaving the view */
+} pb_particle_stats;
+
+/*
+ * Read-only view of the live particles, for backends that draw them
+ * directly. Arrays hold count entries and are valid until the next
+ * spawn, update or clear.
+ */
+typedef struct pb_particle_view {
+    int count;
+    const float* x;
+    const float* y;
+    const float* life;          /* Frames left */
+    const uint8_t* palette;     /* palette_base + color_id */
+} pb_particle_view;
+
+/*============================================================================
+ * Lifetime
+ *============================================================================*/
+
+/**
+ * Default configuration: 4096 particles, 6 per pop, 2 per drop, demo
+ * board layout (origin 64,16, radius 8) and a 256x224 view.
+ */
+void pb_particle_config_default(pb_particle_config* config);
+
+/**
+ * Create a particle pool. All memory is allocated here.
+ *
+ * @param config Configuration (NULL for defaults)
+ * @return       Pool, or NULL on allocation failure or bad config
+ */
+pb_particles* pb_particles_create(const pb_particle_config* config);
+
+/**
+ * Free a pool. Detach it from any game first.
+ */
+void pb_particles_destroy(pb_particles* particles);
+
+/**
+ * Remove every particle (statistics are kept).
+ */
+void pb_particles_clear(pb_particles* particles);
+
+/*============================================================================
+ * Spawning
+ *============================================================================*/
+
+/**
+ * Spawn a burst for one removed cell.
+ *
+ * @param particles Pool
+ * @param type      PB_EVENT_BUBBLES_POPPED or PB_EVENT_BUBBLES_DROPPED
+ * @param cell      Board cell (screen position from the config mapping)
+ * @param color_id  Bubble color
+ * @return          Particles spawned (fewer than requested if the pool filled)
+ */
+int pb_particles_burst(pb_particles* particles, pb_event_type type,
+                       pb_offset cell, uint8_t color_id);
+
+/**
+ * Spawn bursts for every cell in a popped or dropped event. Other event
+ * types are ignored. Cells are drawn in color 0 unless a board is attached.
+ * Matches pb_event_fn, with the pool as userdata.
+ */
+void pb_particles_on_event(const pb_event* event, void* userdata);
+
+/**
+ * Subscribe the pool to a game's popped and dropped events. Burst colors
+ * are read from the game's board.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, PB_ERR_INVALID_STATE (already
+ *         attached), or PB_ERR_NO_MEMORY (no subscriber slots)
+ */
+pb_result pb_particles_attach(pb_particles* particles, pb_game_state* state);
+
+/**
+ * Unsubscribe from the attached game (no-op if not attached).
+ */
+void pb_particles_detach(pb_particles* particles, pb_game_state* state);
+
+/*============================================================================
+ * Simulation and Rendering
+ *============================================================================*/
+
+/**
+ * Advance every particle by dt frames, then cull expired and offscreen
+ * particles. Survivors keep their relative order.
+ */
+void pb_particles_update(pb_particles* particles, float dt);
+
+/**
+ * Build the sprite batch for the live particles, in pool order. The
+ * instances are owned by the pool and valid until the next spawn, update
+ * or clear; pass them to pb_render_indexed_sprite_batch().
+ *
+ * @param particles Pool
+ * @param out       Output: instance array
+ * @return          Instance count
+ */
+int pb_particles_build_batch(pb_particles* particles,
+                             const pb_indexed_sprite_instance** out);
+
+/**
+ * Read-only view of the live particle arrays.
+ */
+pb_particle_view pb_particles_view(const pb_particles* particles);
+
+/**
+ * Pool statistics.
+ */
+void pb_particles_get_stats(const pb_particles* particles, pb_particle_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_PARTICLE_H */
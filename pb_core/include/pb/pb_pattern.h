@@ -113,13 +113,13 @@ typedef struct pb_pattern_def {
     const char* name;
 
     /* Geometry (normalized to unit square, centered at 0.5, 0.5) */
-    pb_polygon2d* polygons;    /* Array of polygons */
+    const pb_polygon2d* polygons;   /* Array of polygons */
     int polygon_count;
 
-    pb_line2d* lines;          /* Array of lines */
+    const pb_line2d* lines;         /* Array of lines */
     int line_count;
 
-    pb_circle2d* circles;      /* Array of circles */
+    const pb_circle2d* circles;     /* Array of circles */
     int circle_count;
 
     /* Rendering hints */
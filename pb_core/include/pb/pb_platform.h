@@ -11,6 +11,8 @@
 #define PB_PLATFORM_H
 
 #include "pb_types.h"
+#include "pb_font.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -102,6 +104,13 @@ typedef struct pb_sound* pb_sound;
 /* Music handle (opaque) */
 typedef struct pb_music* pb_music;
 
+/**
+ * PCM stream callback: add (not overwrite) frames of interleaved signed
+ * 16-bit audio into out. Runs on the audio thread.
+ */
+typedef void (*pb_audio_stream_fn)(void* userdata, int16_t* out, int frames,
+                                   int channels);
+
 /*============================================================================
  * Platform Interface (vtable)
  *============================================================================*/
@@ -145,6 +154,13 @@ typedef struct pb_platform {
                          int src_x, int src_y, int src_w, int src_h,
                          int dst_x, int dst_y, int dst_w, int dst_h);
     void (*texture_draw_ex)(struct pb_platform* p, const pb_sprite* sprite);
+    void (*texture_upload)(struct pb_platform* p, pb_texture tex,
+                           const uint32_t* pixels);  /* w*h, 0xRRGGBBAA */
+
+    /* Text: every quad of a batch in one draw, sampling a font atlas
+     * texture; quad colors index the colors table */
+    void (*draw_text)(struct pb_platform* p, pb_texture atlas,
+                      const pb_text_batch* batch, const pb_color_srgb8* colors);
 
     /* Audio (optional) */
     pb_sound (*sound_load)(struct pb_platform* p, const char* path);
@@ -156,6 +172,18 @@ typedef struct pb_platform {
     void (*music_stop)(struct pb_platform* p);
     void (*music_set_volume)(struct pb_platform* p, float volume);
 
+    /* PCM mixing (optional): one stream callback mixed over the output;
+     * audio_lock(true) keeps it from running until audio_lock(false) */
+    bool (*audio_stream_open)(struct pb_platform* p, pb_audio_stream_fn fn,
+                              void* userdata, int* sample_rate, int* channels);
+    void (*audio_stream_close)(struct pb_platform* p);
+    void (*audio_lock)(struct pb_platform* p, bool lock);
+
+    /* Decode a sound file to mono 16-bit PCM at a sample rate (optional;
+     * malloc'd, caller frees) */
+    int16_t* (*sound_decode)(struct pb_platform* p, const char* path,
+                             int sample_rate, uint32_t* frames);
+
 } pb_platform;
 
 /*============================================================================
@@ -168,6 +196,81 @@ typedef struct pb_platform {
  */
 pb_platform* pb_platform_sdl2_create(void);
 
+/**
+ * Create headless platform backend.
+ *
+ * Renders into an in-memory RGBA framebuffer (logical size, or window size
+ * when no logical size is set) with no display, audio device or wall
+ * clock: time advances by exactly one frame per end_frame() plus any
+ * delay(), input comes from a key script, and sounds are counted rather
+ * than played. An open PCM stream is pulled for exactly one frame's worth
+ * of samples (44.1kHz stereo) at each end_frame() and discarded. Output
+ * is a pure function of the draw calls, so frames can be captured and
+ * compared in CI and draw-path benchmarks measure only CPU work. Same
+ * lifecycle as the SDL2 backend.
+ */
+pb_platform* pb_platform_headless_create(void);
+
+/* Scripted key transition, applied by the first poll_input() of its frame */
+typedef struct pb_headless_key_event {
+    uint32_t frame;             /* Frame index (count of begin_frame() - 1) */
+    pb_key key;
+    bool down;
+} pb_headless_key_event;
+
+typedef struct pb_headless_stats {
+    uint32_t frames;            /* Completed end_frame() calls */
+    uint32_t presents;
+    uint32_t draw_calls;
+    uint64_t pixels_written;
+    uint32_t sounds_played;
+    uint64_t clock_ms;          /* Virtual clock */
+    uint64_t audio_frames;      /* PCM frames pulled from the stream */
+} pb_headless_stats;
+
+/**
+ * Set the input script. Events must be sorted by frame; the array is not
+ * copied and must outlive its use. Replaces any previous script.
+ *
+ * @return PB_OK, or PB_ERR_INVALID_ARG (not headless, bad args, unsorted)
+ */
+pb_result pb_platform_headless_set_script(pb_platform* p,
+                                          const pb_headless_key_event* events,
+                                          int count);
+
+/**
+ * Framebuffer of an initialized headless platform, row-major, one
+ * 0xRRGGBBAA word per pixel.
+ *
+ * @return Pixels, or NULL if not headless/initialized
+ */
+const uint32_t* pb_platform_headless_framebuffer(const pb_platform* p,
+                                                 int* width, int* height);
+
+/**
+ * Encode the framebuffer as binary PPM (P6, alpha dropped).
+ *
+ * @param out      Output buffer, or NULL to query the size
+ * @param capacity Output capacity
+ * @return         Encoded size, or 0 if not headless/initialized or too small
+ */
+size_t pb_platform_headless_encode_ppm(const pb_platform* p, uint8_t* out,
+                                       size_t capacity);
+
+/**
+ * Write the framebuffer to a PPM file.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG (bad argument, or the file could
+ *         not be written), PB_ERR_INVALID_STATE (not initialized), or
+ *         PB_ERR_NO_MEMORY
+ */
+pb_result pb_platform_headless_capture_ppm(const pb_platform* p, const char* path);
+
+/**
+ * Counters since init.
+ */
+void pb_platform_headless_get_stats(const pb_platform* p, pb_headless_stats* out);
+
 /**
  * Free platform backend.
  */
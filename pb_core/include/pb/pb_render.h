@@ -15,6 +15,8 @@
 
 #include "pb_types.h"
 #include "pb_color.h"
+#include "pb_cvd.h"
+#include "pb_font.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -110,6 +112,55 @@ void pb_palette_init_gameboy(pb_palette* pal);
  */
 void pb_palette_apply_cvd(pb_palette* pal, pb_cvd_type type, float severity);
 
+/*============================================================================
+ * Palette Cycling
+ *============================================================================*/
+
+/*
+ * Animating by rotating palette ranges: pixels keep their indices and
+ * only the palette changes, so an animated scene draws exactly like a
+ * static one. A two-entry ping-pong range is a flash (PB_EFFECT_FLASH
+ * warnings); a longer forward range is a shimmer or a flowing background.
+ */
+
+/* Cycle ranges per render context */
+#define PB_MAX_PALETTE_CYCLES 16
+
+typedef enum pb_cycle_mode {
+    PB_CYCLE_FORWARD = 0,    /* Colors move toward higher indices */
+    PB_CYCLE_REVERSE,        /* Colors move toward lower indices */
+    PB_CYCLE_PINGPONG        /* Forward count-1 steps, then back */
+} pb_cycle_mode;
+
+/**
+ * One cycling range [first, first + count).
+ */
+typedef struct pb_palette_cycle {
+    uint8_t first;           /* First palette index */
+    uint8_t count;           /* Range length (2 or more, within the palette) */
+    uint8_t mode;            /* pb_cycle_mode */
+    uint16_t period;         /* Frames per one-entry step (1 or more) */
+    uint32_t start_frame;    /* Frame the range is at rest */
+} pb_palette_cycle;
+
+/**
+ * Rotation of a range at a frame, in [0, count).
+ */
+int pb_palette_cycle_offset(const pb_palette_cycle* cycle, uint32_t frame);
+
+/**
+ * Write base with every cycle applied at a frame into out. Only entries
+ * inside the ranges are rewritten; overlapping ranges apply in order.
+ *
+ * @param base   Unanimated palette
+ * @param cycles Ranges (invalid ones are skipped)
+ * @param count  Number of ranges
+ * @param frame  Frame number
+ * @param out    Output palette (may equal base only when count is 0)
+ */
+void pb_palette_cycle_apply(const pb_palette* base, const pb_palette_cycle* cycles,
+                            int count, uint32_t frame, pb_palette* out);
+
 /*============================================================================
  * Dithering Patterns
  *============================================================================*/
@@ -118,16 +169,19 @@ void pb_palette_apply_cvd(pb_palette* pal, pb_cvd_type type, float severity);
  * Dither pattern types for gradients and shading.
  */
 typedef enum pb_dither_type {
-    PB_DITHER_NONE = 0,
+    PB_DITHER_NONE = 0,         /* Hard switch at 50% */
     PB_DITHER_BAYER2X2,
     PB_DITHER_BAYER4X4,
     PB_DITHER_BAYER8X8,
-    PB_DITHER_ORDERED,
-    PB_DITHER_HALFTONE,
-    PB_DITHER_CHECKERBOARD,
-    PB_DITHER_NOISE
+    PB_DITHER_ORDERED,          /* 4x4 diagonal line screen */
+    PB_DITHER_HALFTONE,         /* 4x4 clustered dot */
+    PB_DITHER_CHECKERBOARD,     /* color_a, checker, color_b */
+    PB_DITHER_NOISE             /* Per-pixel hash, not periodic */
 } pb_dither_type;
 
+/* Blend factors quantize to 0..PB_DITHER_LEVELS (all color_b) */
+#define PB_DITHER_LEVELS 64
+
 /**
  * Get dithered color index for a position and blend factor.
  *
@@ -141,6 +195,30 @@ typedef enum pb_dither_type {
 uint8_t pb_dither_blend(int x, int y, uint8_t color_a, uint8_t color_b,
                         pb_scalar blend, pb_dither_type type);
 
+/**
+ * Quantize a blend factor (0.0 to 1.0) to a dither level.
+ */
+int pb_dither_level(pb_scalar blend);
+
+/**
+ * Pattern bits for the 8 pixels x & ~7 .. (x & ~7) + 7 of row y: bit i
+ * set means pixel (x & ~7) + i takes color_b. Every pattern but
+ * PB_DITHER_NOISE repeats every 8 pixels, so one mask serves a whole row.
+ */
+uint8_t pb_dither_mask(pb_dither_type type, int level, int x, int y);
+
+/**
+ * Fill a run of pixels with a dithered blend, as pb_dither_blend() would
+ * per pixel. The row pattern is built once and stored 8 pixels at a time.
+ *
+ * @param dst     Pixel at (x, y)
+ * @param x, y    Screen position of dst (selects the pattern phase)
+ * @param width   Pixels to write
+ * @param level   Dither level (0..PB_DITHER_LEVELS)
+ */
+void pb_dither_span(uint8_t* dst, int x, int y, int width, uint8_t color_a,
+                    uint8_t color_b, int level, pb_dither_type type);
+
 /*============================================================================
  * Sprite/Tile System
  *============================================================================*/
@@ -166,6 +244,7 @@ typedef struct pb_indexed_sprite {
     int width;
     int height;
     uint8_t transparent;     /* Transparent palette index (usually 0) */
+    bool opaque;             /* No pixel uses transparent: rows are copied */
 } pb_indexed_sprite;
 
 /**
@@ -187,7 +266,9 @@ typedef struct pb_indexed_sprite_instance {
 #define PB_MAX_LAYERS 8
 
 /**
- * Layer configuration for voxel-style depth.
+ * Layer configuration for voxel-style depth. The software renderer
+ * applies y_offset to every sprite drawn on the layer; scale, shadow and
+ * ambient are left to backends that can filter or light.
  */
 typedef struct pb_layer_config {
     int y_offset;            /* Vertical offset (parallax) */
@@ -224,7 +305,9 @@ typedef struct pb_render_stats {
 } pb_render_stats;
 
 /**
- * Abstract render context (implemented by platform backend).
+ * Render context: an indexed framebuffer plus palette state. A platform
+ * backend presents it by converting pb_render_get_framebuffer() through
+ * pb_render_get_display_palette().
  */
 typedef struct pb_render_context pb_render_context;
 
@@ -253,6 +336,31 @@ void pb_render_set_palette(pb_render_context* ctx, const pb_palette* pal);
  */
 const pb_render_config* pb_render_get_config(const pb_render_context* ctx);
 
+/**
+ * Add a palette cycle, applied from the next pb_render_begin_frame().
+ *
+ * @return Cycle id, or -1 if the range is invalid or all
+ *         PB_MAX_PALETTE_CYCLES slots are used
+ */
+int pb_render_add_palette_cycle(pb_render_context* ctx, const pb_palette_cycle* cycle);
+
+/**
+ * Remove a palette cycle; its range returns to the base palette.
+ */
+void pb_render_remove_palette_cycle(pb_render_context* ctx, int id);
+
+/**
+ * Palette for display: the active palette with cycles applied at the
+ * current frame.
+ */
+const pb_palette* pb_render_get_display_palette(const pb_render_context* ctx);
+
+/**
+ * Incremented whenever the display palette changes, so a backend uploads
+ * it only when needed.
+ */
+uint32_t pb_render_palette_version(const pb_render_context* ctx);
+
 /*============================================================================
  * Frame Operations
  *============================================================================*/
@@ -277,6 +385,17 @@ void pb_render_end_frame(pb_render_context* ctx);
  */
 pb_render_stats pb_render_get_stats(const pb_render_context* ctx);
 
+/**
+ * Current frame number (starts at 0, advanced by pb_render_begin_frame()).
+ */
+uint32_t pb_render_get_frame(const pb_render_context* ctx);
+
+/**
+ * Indexed framebuffer (width * height bytes, row-major) for the backend
+ * to convert through the display palette.
+ */
+const uint8_t* pb_render_get_framebuffer(const pb_render_context* ctx);
+
 /*============================================================================
  * Primitive Drawing
  *============================================================================*/
@@ -326,30 +445,80 @@ void pb_render_circle(pb_render_context* ctx, int cx, int cy, int radius,
 void pb_render_circle_fill(pb_render_context* ctx, int cx, int cy, int radius,
                            uint8_t color);
 
+/**
+ * Draw a dithered horizontal span, clipped to the screen.
+ *
+ * @param blend Blend factor (0.0 = color_a, 1.0 = color_b)
+ */
+void pb_render_dither_span(pb_render_context* ctx, int x, int y, int width,
+                           uint8_t color_a, uint8_t color_b, pb_scalar blend,
+                           pb_dither_type type);
+
+/**
+ * Draw a rectangle filled with one dithered blend, clipped to the screen.
+ */
+void pb_render_dither_rect(pb_render_context* ctx, int x, int y, int w, int h,
+                           uint8_t color_a, uint8_t color_b, pb_scalar blend,
+                           pb_dither_type type);
+
 /*============================================================================
  * Sprite Drawing
  *============================================================================*/
 
 /**
- * Draw indexed sprite at position.
+ * Set a sprite's opaque flag by scanning its pixels for the transparent
+ * index. Opaque sprites drawn unflipped are copied a row at a time.
+ *
+ * @return The flag's new value
+ */
+bool pb_indexed_sprite_mark_opaque(pb_indexed_sprite* sprite);
+
+/**
+ * Configure a depth layer (all layers start with no offset, scale 1 and
+ * full ambient). Out-of-range layers are ignored.
+ */
+void pb_render_set_layer(pb_render_context* ctx, int layer,
+                         const pb_layer_config* config);
+
+/**
+ * Draw indexed sprite at position, offset by its layer's y_offset and
+ * clipped to the screen. Layers outside 0..PB_MAX_LAYERS-1 are clamped.
  */
 void pb_render_indexed_sprite(pb_render_context* ctx,
                                const pb_indexed_sprite_instance* inst);
 
 /**
- * Draw indexed sprite batch (sorted by layer for depth).
+ * Draw indexed sprite batch back to front: layer 0 first, then each
+ * higher layer, then PB_SPRITE_PRIORITY sprites on top. Sprites in the
+ * same bucket keep submission order. Bucketing is a counting sort, so a
+ * batch costs O(count) however its layers are mixed. Counts as a single
+ * draw call.
  */
 void pb_render_indexed_sprite_batch(pb_render_context* ctx,
                                      const pb_indexed_sprite_instance* sprites,
                                      int count);
 
+/*============================================================================
+ * Text
+ *============================================================================*/
+
+/**
+ * Draw every glyph quad of a text batch in one pass: atlas pixels with
+ * coverage are written in the quad's palette color, clipped to the
+ * screen. Counts as a single draw call.
+ */
+void pb_render_text_batch(pb_render_context* ctx, const pb_font_atlas* atlas,
+                          const pb_text_batch* batch);
+
 /*============================================================================
  * Bubble-Specific Rendering
  *============================================================================*/
 
 /**
  * Draw a bubble with 8-bit shading.
- * Renders with highlight, base color, and shadow for 3D appearance.
+ * Renders with highlight, base color, and shadow for 3D appearance:
+ * color+1 at the top blends into color at the middle and color+2 at the
+ * bottom, dithered with the context's pattern, one span per row.
  *
  * @param ctx      Render context
  * @param cx, cy   Center position
@@ -383,7 +552,8 @@ void pb_render_background_tiled(pb_render_context* ctx,
                                  int offset_x, int offset_y);
 
 /**
- * Draw gradient background with dithering.
+ * Draw gradient background with dithering: one span per row, blending
+ * from color_top on the first row to color_bottom on the last.
  */
 void pb_render_background_gradient(pb_render_context* ctx, uint8_t color_top,
                                     uint8_t color_bottom, pb_dither_type dither);
@@ -8,6 +8,9 @@
  * - Playing back recorded replays
  * - Verifying determinism between sessions
  *
+ * Thread safety: as for pb_game_state, sessions are independent of each
+ * other; one session must be used by one thread at a time.
+ *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
@@ -58,6 +61,7 @@ typedef struct pb_session_config {
     /* Playback options */
     int playback_speed;             /* Speed percent (100 = normal) */
     bool verify_checksums;          /* Verify against recorded checksums */
+    bool skip_frame_checksums;      /* Fast-forward: no per-frame checksum ring */
 
     /* Callbacks */
     pb_desync_callback on_desync;
@@ -46,6 +46,22 @@ extern "C" {
 /* Minimum distance to avoid singularity (clamped) */
 #define PB_MAGNETIC_MIN_DISTANCE      PB_FLOAT_TO_FIXED(4.0f)
 
+/* Finest magnet field node spacing, as log2 pixels (4px) */
+#ifndef PB_MAGNET_FIELD_MIN_SHIFT
+#define PB_MAGNET_FIELD_MIN_SHIFT 2
+#endif
+
+/* Magnet field node budget; spacing doubles until the field fits */
+#ifndef PB_MAGNET_FIELD_MAX_NODES
+    #if defined(PB_SIZE_MICRO) || defined(PB_SIZE_MINI)
+        #define PB_MAGNET_FIELD_MAX_NODES 256
+    #elif defined(PB_SIZE_MEDIUM)
+        #define PB_MAGNET_FIELD_MAX_NODES 1024
+    #else
+        #define PB_MAGNET_FIELD_MAX_NODES 4096
+    #endif
+#endif
+
 /*============================================================================
  * Collision Result
  *============================================================================*/
@@ -230,6 +246,99 @@ pb_vec2 pb_magnetic_force(pb_point shot_pos, pb_point magnet_pos,
 void pb_apply_magnetic_forces(pb_shot* shot, const pb_board* board,
                               pb_scalar radius);
 
+/*============================================================================
+ * Magnet Field Grid
+ *
+ * pb_apply_magnetic_forces() scans the board and evaluates every magnet at
+ * every step. A pb_magnet_field samples the summed field once, onto a
+ * Q16.16 vector grid covering the magnets' reach, and a step becomes one
+ * bilinear lookup of four nodes, independent of the number of magnets.
+ * Node spacing is a power of two, so locating a cell is a shift.
+ *
+ * Node spacing h starts at 4px (PB_MAGNET_FIELD_MIN_SHIFT) and doubles
+ * until the magnets' reach fits the tier's node budget, so it depends on
+ * the tier and on how far apart the magnets are; the built spacing is
+ * 1 << shift. Magnets spread over a 12-row board give h = 8 on the full
+ * tier, 16 on medium and 32 on mini.
+ *
+ * Error against the exact sum, per force component, at a point whose grid
+ * cell lies at least d pixels from every magnet (magnet strength s):
+ *
+ *   - inside a magnet's radius: at most 1.3 * h^2 * s / d^4 per magnet
+ *     (bilinear error h^2/8 * (|f_xx| + |f_yy|), with |f_xx| <= 6s/d^4 and
+ *     |f_yy| <= 4.2s/d^4 for f = s*x/d^3). With s = 100, a shot touching
+ *     a 16px magnet (d = 32) sees under 0.002 px/frame^2 at h = 4 and
+ *     under 0.008 at h = 8, against a shot speed of 8 px/frame.
+ *   - in a cell the radius cutoff passes through: at most s / R^2 per
+ *     magnet (0.016 with the defaults), as the lookup blends the field's
+ *     last value with zero instead of stepping.
+ *   - plus 2^-17 per magnet from rounding the nodes (2^-16 in fixed
+ *     point, where the force itself is truncated).
+ *
+ * Outside the grid the field is exactly zero.
+ *============================================================================*/
+
+typedef struct pb_magnet_field {
+    int32_t origin_x;           /* Node (0, 0), Q16.16 pixels */
+    int32_t origin_y;
+    int shift;                  /* Node spacing is 1 << shift pixels */
+    int cols;                   /* Nodes per grid row */
+    int rows;
+    int magnets;                /* Magnets sampled (0 = empty field) */
+    int32_t force[PB_MAGNET_FIELD_MAX_NODES][2];  /* Q16.16 x, y */
+
+    /* Layout the field was built from, compared by update() */
+    bool built;
+    int32_t layout_radius;      /* Q16.16 */
+    int layout_rows;
+    int layout_cols_even;
+    int layout_cols_odd;
+    int layout_count;
+    uint16_t layout_cell[PB_MAX_CELLS];     /* row * PB_MAX_COLS + col */
+    uint8_t layout_strength[PB_MAX_CELLS];
+} pb_magnet_field;
+
+/**
+ * Initialize an empty field (no magnets, nothing built). Required before
+ * the first pb_magnet_field_update(); pb_magnet_field_build() needs no
+ * initialization.
+ */
+void pb_magnet_field_init(pb_magnet_field* field);
+
+/**
+ * Sample the summed field of every magnet on the board.
+ *
+ * @param field  Output (about 32KB on the full tier; keep it off small stacks)
+ * @param board  Board containing magnetic bubbles
+ * @param radius Bubble radius (for pixel coordinate conversion)
+ * @return       Number of magnets sampled
+ */
+int pb_magnet_field_build(pb_magnet_field* field, const pb_board* board,
+                          pb_scalar radius);
+
+/**
+ * Rebuild the field only if the board's magnets (position or strength),
+ * its dimensions or the radius changed since the last build. The layout
+ * is compared exactly, so a changed board is never mistaken for the old
+ * one. Call after the board changes,
+ * e.g. once per resolved shot. The field must have been initialized
+ * with pb_magnet_field_init() or built at least once.
+ *
+ * @return true if the field was rebuilt
+ */
+bool pb_magnet_field_update(pb_magnet_field* field, const pb_board* board,
+                            pb_scalar radius);
+
+/**
+ * Bilinear field lookup at a point.
+ */
+pb_vec2 pb_magnet_field_sample(const pb_magnet_field* field, pb_point pos);
+
+/**
+ * Grid equivalent of pb_apply_magnetic_forces().
+ */
+void pb_apply_magnet_field(pb_shot* shot, const pb_magnet_field* field);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,7 @@
 #define PB_SOFTMATH_H
 
 #include <stdint.h>
+#include "pb_tables.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -391,6 +392,17 @@ static inline int pb_softmath_clz32(uint32_t x) {
 #endif
 }
 
+/*
+ * High 32 bits of a 32x32 product, from 16x16 multiplies only.
+ */
+static inline uint32_t pb_softmath_mulhi32(uint32_t a, uint32_t b) {
+    uint32_t al = a & 0xFFFFu, ah = a >> 16;
+    uint32_t bl = b & 0xFFFFu, bh = b >> 16;
+    uint32_t mid1 = ah * bl + ((al * bl) >> 16);
+    uint32_t mid2 = al * bh + (mid1 & 0xFFFFu);
+    return ah * bh + (mid1 >> 16) + (mid2 >> 16);
+}
+
 /*
  * Integer reciprocal: compute floor(2^32 / x)
  *
@@ -422,46 +434,45 @@ static inline uint32_t pb_softmath_recip32(uint32_t x) {
     }
 #else
     {
-        /* 32-bit only: CLZ-based estimate + Newton-Raphson */
-        int shift = pb_softmath_clz32(x);
-
-        /* Initial estimate: for x with MSB at position (31-shift),
-         * reciprocal ≈ 2^(32 - (32-shift)) = 2^shift
-         * Refine with linear interpolation based on lower bits
-         */
-        estimate = 1u << shift;
-
-        /* Refine estimate using bits below MSB */
-        /* If x = 2^n * (1 + f) where 0 <= f < 1,
-         * then 1/x ≈ 2^(-n) * (1 - f) ≈ 2^(-n) - 2^(-n) * f
-         */
-        if (shift > 0) {
-            uint32_t x_frac = (x << shift) >> 1;  /* Fractional part in high bits */
-            estimate -= (estimate >> 16) * (x_frac >> 16);
+        /* 32-bit only: table seed + Newton-Raphson.
+         * x = 2^n * m with m in [1, 2), so 2^32/x = (2^16/m) << (16 - n),
+         * and 2^16/m comes from the 8 bits below the leading one. */
+        int n = 31 - pb_softmath_clz32(x);
+        uint32_t idx = (n >= PB_RECIP_SEED_BITS)
+            ? (x >> (n - PB_RECIP_SEED_BITS)) & 0xFFu
+            : (x << (PB_RECIP_SEED_BITS - n)) & 0xFFu;
+        uint32_t seed = pb_recip_seed_q16[idx];
+        estimate = (n <= 16) ? seed << (16 - n) : seed >> (n - 16);
+
+        /* Newton-Raphson: e' = e * (2 - x*e / 2^32) = e - e*d / 2^32,
+         * where x*e = 2^32 + d. The seed is within 2^-8, so |d| < 2^31
+         * and the low word of x*e alone gives d. */
+        for (i = 0; i < PB_SOFTMATH_NR_ITER; i++) {
+            uint32_t d = x * estimate;
+            if (d < 0x80000000u) {
+                estimate -= pb_softmath_mulhi32(estimate, d);
+            } else {
+                estimate += pb_softmath_mulhi32(estimate, 0u - d);
+            }
         }
 
-        /* Newton-Raphson iterations */
-        /* Formula: e_new = e * (2 - x*e)
-         * But we need to handle the Q-format carefully.
-         * We want: e_new = e + e - e*x*e = 2e - e²x
-         */
-        for (i = 0; i < PB_SOFTMATH_NR_ITER; i++) {
-            /* Approximate x*e in high precision using 16x16 multiplies */
-            uint32_t e_hi = estimate >> 16;
-            uint32_t e_lo = estimate & 0xFFFF;
-            uint32_t x_hi = x >> 16;
-            uint32_t x_lo = x & 0xFFFF;
-
-            /* x*e (we only need high 32 bits of the 64-bit result) */
-            uint32_t xe_hi = x_hi * e_hi;
-            uint32_t xe_mid = x_hi * e_lo + x_lo * e_hi;
-            xe_hi += (xe_mid >> 16);
-
-            /* 2 - x*e in the same format (saturate negative to 0) */
-            uint32_t two_minus_xe = (xe_hi < 0x00020000u) ? (0x00020000u - xe_hi) : 0;
-
-            /* e * (2 - x*e), extract high part */
-            estimate = (e_hi * two_minus_xe + ((e_lo * two_minus_xe) >> 16)) >> 1;
+        /* Settle the last unit so that x*e <= 2^32 < x*(e + 1) */
+        for (;;) {
+            uint32_t hi = pb_softmath_mulhi32(x, estimate);
+            if (hi > 1u || (hi == 1u && x * estimate != 0u)) {
+                estimate--;
+            } else {
+                break;
+            }
+        }
+        for (;;) {
+            uint32_t next = estimate + 1u;
+            uint32_t hi = pb_softmath_mulhi32(x, next);
+            if (hi == 0u || (hi == 1u && x * next == 0u)) {
+                estimate = next;
+            } else {
+                break;
+            }
         }
     }
 #endif
@@ -50,7 +50,7 @@ typedef struct pb_board_stats {
     int total_bubbles;
     int color_counts[PB_MAX_COLORS];
     int special_counts[PB_SPECIAL_COUNT];
-    int max_group_size;         /* Largest same-color group */
+    int max_group_size;         /* Largest connected same-color cluster */
     int orphan_count;           /* Bubbles not attached to ceiling */
     int blocker_count;          /* Indestructible blockers */
     float density;              /* Bubble count / total cells */
@@ -197,6 +197,30 @@ bool pb_analyze_solvability(const pb_board* board,
                             int max_search,
                             pb_solvability* result);
 
+/**
+ * Step callback for pb_analyze_solvability_ex(), called after each greedy
+ * move that leaves bubbles on the board, with the analysis so far
+ * (min_moves and solution reflect the moves played).
+ * Return false to stop the analysis early.
+ */
+typedef bool (*pb_solvability_step_fn)(const pb_solvability* partial,
+                                       void* userdata);
+
+/**
+ * pb_analyze_solvability() with a per-move callback for progress reporting
+ * and cancellation.
+ *
+ * @param on_step   Step callback (may be NULL)
+ * @param userdata  Passed to on_step
+ * @return          True if analysis completed, false if on_step stopped it
+ */
+bool pb_analyze_solvability_ex(const pb_board* board,
+                               const pb_ruleset* ruleset,
+                               const pb_bubble* queue, int queue_length,
+                               int max_search,
+                               pb_solvability_step_fn on_step, void* userdata,
+                               pb_solvability* result);
+
 /*============================================================================
  * Difficulty Estimation
  *============================================================================*/
@@ -0,0 +1,162 @@
+/*
+ * pb_tablebase.h - Endgame tablebase for near-empty boards
+ *
+ * Boards with only a handful of bubbles left recur constantly in bot play
+ * and in the leaves of the exact solver. The tablebase stores, for every
+ * stable configuration of up to max_bubbles colored bubbles hanging from
+ * the ceiling, the minimum number of shots that clears it for each
+ * possible window of the next `horizon` queued colors.
+ *
+ * Indexing:
+ * - Positions are reduced with pb_canon_compute(): colors are relabeled
+ *   by first appearance (board cells in row-major order, then the queue
+ *   window) and the left-right mirror is folded, so boards that differ
+ *   only by color IDs or by mirroring share one entry.
+ * - A board key packs (count, cell index, label) for every bubble into a
+ *   64-bit integer; keys are stored sorted and probed by binary search.
+ * - Each entry holds colors^horizon value bytes indexed by the relabeled
+ *   queue window in base `colors`.
+ *
+ * Values are exact for the attachable-cell move model without color
+ * switching (see PB_EXACT_MOVES_ATTACHABLE). Trajectory-limited play can
+ * only need more shots, so a probe is always an admissible lower bound.
+ *
+ * File format (native byte order, `endian` field detects mismatches):
+ *   pb_tablebase_header | uint64_t keys[entry_count] |
+ *   uint8_t values[entry_count * value_stride]
+ * The layout is position-independent so the file can be mapped directly.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_TABLEBASE_H
+#define PB_TABLEBASE_H
+
+#include "pb_types.h"
+#include "pb_board.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define PB_TB_MAGIC         0x42544250u     /* "PBTB" */
+#define PB_TB_VERSION       2   /* 2: mirror-folded keys */
+#define PB_TB_ENDIAN_MARK   0x0102u
+
+#define PB_TB_MAX_BUBBLES   6   /* 10 bits per bubble + 4-bit count in 64 */
+#define PB_TB_MAX_HORIZON   4
+#define PB_TB_MAX_COLORS    PB_MAX_COLORS
+
+/* Value bytes */
+#define PB_TB_UNSOLVED      0xFE    /* Not clearable within the horizon */
+#define PB_TB_NOT_STORED    0xFF    /* Non-canonical queue window */
+
+/* Probe results other than a shot count */
+#define PB_TB_PROBE_MISS    (-1)    /* Board or window not covered */
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct pb_tablebase_config {
+    int max_bubbles;            /* K: largest board stored (1..6) */
+    int horizon;                /* Queue window length (1..4) */
+    int colors;                 /* Distinct labels per window (2..8) */
+    int match_threshold;        /* Pop threshold (0 = default) */
+} pb_tablebase_config;
+
+typedef struct pb_tablebase_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t endian;
+    uint8_t cols_even;
+    uint8_t cols_odd;
+    uint8_t rows;
+    uint8_t match_threshold;
+    uint8_t max_bubbles;
+    uint8_t horizon;
+    uint8_t colors;
+    uint8_t flags;
+    uint32_t entry_count;
+    uint32_t value_stride;      /* colors^horizon */
+    uint64_t keys_offset;       /* Byte offset of keys[] from file start */
+    uint64_t values_offset;     /* Byte offset of values[] from file start */
+} pb_tablebase_header;
+
+typedef struct pb_tablebase {
+    const pb_tablebase_header* header;
+    const uint64_t* keys;
+    const uint8_t* values;
+    void* storage;              /* Owned heap block or mapping */
+    size_t storage_size;
+    bool mapped;
+} pb_tablebase;
+
+/*============================================================================
+ * Generation and I/O
+ *============================================================================*/
+
+/**
+ * Fill config with defaults (K=3, horizon 3, 4 colors, threshold 3).
+ */
+void pb_tablebase_config_default(pb_tablebase_config* config);
+
+/**
+ * Exhaustively solve every stable configuration on the default 8/7
+ * geometry and build an in-memory tablebase.
+ *
+ * @return PB_OK, PB_ERR_INVALID_ARG, or PB_ERR_NO_MEMORY
+ */
+pb_result pb_tablebase_generate(pb_tablebase* tb, const pb_tablebase_config* config);
+
+/**
+ * Write a tablebase to disk.
+ */
+pb_result pb_tablebase_save(const pb_tablebase* tb, const char* path);
+
+/**
+ * Open a tablebase file. Uses mmap() where available, otherwise reads
+ * the file into memory.
+ */
+pb_result pb_tablebase_open(pb_tablebase* tb, const char* path);
+
+/**
+ * Attach to a tablebase image already in memory (not copied; the
+ * buffer must outlive the tablebase and be 8-byte aligned).
+ */
+pb_result pb_tablebase_from_memory(pb_tablebase* tb, const void* data, size_t size);
+
+/**
+ * Release storage owned by the tablebase.
+ */
+void pb_tablebase_close(pb_tablebase* tb);
+
+/*============================================================================
+ * Probing
+ *============================================================================*/
+
+/**
+ * Look up the minimum shots to clear a board.
+ *
+ * @param tb          Tablebase
+ * @param board       Board (geometry must match the tablebase)
+ * @param shots       Upcoming shots in firing order
+ * @param shot_count  Number of upcoming shots (at least the horizon)
+ * @return 0..horizon  exact minimum,
+ *         horizon + 1 when no line within the horizon clears the board,
+ *         PB_TB_PROBE_MISS when the position is not covered
+ */
+int pb_tablebase_probe(const pb_tablebase* tb, const pb_board* board,
+                       const pb_bubble* shots, int shot_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_TABLEBASE_H */
@@ -0,0 +1,44 @@
+/*
+ * pb_tables.h - Build-time generated constant tables
+ *
+ * GENERATED by tools/gen/pb_gentables.c - do not edit.
+ * Regenerate with `make tables`.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_TABLES_H
+#define PB_TABLES_H
+
+#include "pb_config.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if PB_CRC32_SLICES != 1 && PB_CRC32_SLICES != 8
+#error "PB_CRC32_SLICES must be 1 or 8"
+#endif
+
+/* CRC-32/ISO-HDLC; [0] is the byte table, [k] advances k more bytes */
+extern const uint32_t pb_crc32_table[PB_CRC32_SLICES][256];
+
+/* sin/cos of direction index d, angle (12 + 2*d) degrees, Q16.16 */
+#define PB_DIR_TABLE_SIZE 79
+extern const int32_t pb_dir_sin_q16[PB_DIR_TABLE_SIZE];
+extern const int32_t pb_dir_cos_q16[PB_DIR_TABLE_SIZE];
+
+/* sRGB code value 0-255 to linear light 0-1 */
+extern const float pb_srgb8_linear[256];
+
+/* round(2^16 / m) for m = 1 + (i + 0.5) / 256: 1/x seed from the 8 bits
+ * below the leading one of x (about 9 correct bits) */
+#define PB_RECIP_SEED_BITS 8
+extern const uint16_t pb_recip_seed_q16[256];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_TABLES_H */
@@ -19,6 +19,7 @@
 
 /* Freestanding-compatible math functions */
 #include "pb_freestanding.h"
+#include "pb_tables.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -280,6 +281,10 @@ typedef uint8_t pb_direction_index;
 /* Wall reflection: simple subtraction */
 #define PB_DIR_REFLECT(idx) (PB_DIR_MAX - (idx))
 
+#if PB_DIR_TABLE_SIZE != PB_DIR_COUNT
+#error "pb_tables.h is stale: regenerate with `make tables`"
+#endif
+
 /* Convert between direction index and radians */
 #if PB_USE_DIRECTION_INDEX
 /* Index to radians: (12 + index*2) * PI/180 */
@@ -454,6 +459,12 @@ typedef struct pb_board {
     int cols_odd;               /* Columns in odd rows */
     int rows;                   /* Total rows */
     int ceiling_row;            /* Current ceiling position (for pressure) */
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    /* Packed counts of occupied neighbors per cell (see pb_board.h),
+     * maintained by pb_board_set/remove while track_neighbors is set */
+    bool track_neighbors;
+    uint32_t neighbor_counts[PB_MAX_ROWS][PB_MAX_COLS];
+#endif
 } pb_board;
 
 /*============================================================================
@@ -575,6 +586,22 @@ typedef struct pb_event {
     } data;
 } pb_event;
 
+/* Event type mask bits for pb_game_subscribe() */
+#define PB_EVENT_MASK(type)  (1u << (type))
+#define PB_EVENT_MASK_ALL    ((1u << PB_EVENT_COUNT) - 1u)
+
+/*
+ * Event observer. The event pointer is only valid for the duration of the
+ * call; copy it if it must outlive the callback.
+ */
+typedef void (*pb_event_fn)(const pb_event* event, void* userdata);
+
+typedef struct pb_event_subscriber {
+    pb_event_fn callback;       /* NULL = free slot */
+    void* userdata;
+    uint32_t type_mask;         /* PB_EVENT_MASK() bits to deliver */
+} pb_event_subscriber;
+
 /*============================================================================
  * Scoring Constants (from implementation analysis synthesis)
  *============================================================================*/
@@ -657,6 +684,11 @@ typedef struct pb_game_state {
     /* Event log for replay */
     pb_event events[256];
     int event_count;
+    uint32_t events_dropped;    /* Events not logged because the log was full */
+    bool event_log_disabled;    /* Subscribers only, nothing is logged */
+
+    /* Event observers, called from pb_game_add_event() */
+    pb_event_subscriber subscribers[PB_MAX_EVENT_SUBSCRIBERS];
 
     /* Checksum for sync verification */
     uint32_t checksum;
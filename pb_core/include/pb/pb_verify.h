@@ -0,0 +1,116 @@
+/*
+ * pb_verify.h - Segment-parallel replay verification
+ *
+ * Verifying a replay with pb_session_run() is one long serial chain of
+ * frames. This module splits the work in two passes:
+ *
+ *   1. Fast-forward: play the replay once without checking anything and
+ *      without per-frame checksums, keeping a compact snapshot of the game
+ *      state every segment_frames ticks.
+ *   2. Verify: workers take segments from a shared counter, restore each
+ *      segment's snapshot and re-simulate it in a verification session,
+ *      checking the replay's recorded checkpoints on the way. A segment
+ *      also checks that it ends in the state the next snapshot recorded.
+ *
+ * Pass 1 costs less than a serial verification and pass 2 runs on every
+ * worker at once, so wall-clock time approaches pass 1 plus one segment.
+ *
+ * The verdict is the one pb_session_run() would give in
+ * PB_SESSION_VERIFICATION mode: the earliest checkpoint whose checksums
+ * differ, with the same frame, expected and actual values. Segments past
+ * a known failure are skipped.
+ *
+ * Snapshots hold the game state up to its event log (about a third of
+ * pb_game_state); the log is disabled during both passes, as nothing in
+ * the simulation reads it.
+ *
+ * Without PB_FEATURE_THREADS the segments run on the caller's thread.
+ *
+ * Thread safety: pb_verify_replay() only reads the replay, so any number
+ * of verifications may run at once.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PB_VERIFY_H
+#define PB_VERIFY_H
+
+#include "pb_types.h"
+#include "pb_replay.h"
+#include "pb_checksum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+/* Maximum segment workers */
+#ifndef PB_VERIFY_MAX_THREADS
+#define PB_VERIFY_MAX_THREADS 64
+#endif
+
+/* Default ticks between snapshots (10 seconds at 60fps) */
+#ifndef PB_VERIFY_DEFAULT_SEGMENT
+#define PB_VERIFY_DEFAULT_SEGMENT 600
+#endif
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+typedef struct pb_verify_config {
+    int threads;                /* Segment workers (1 = serial) */
+    uint32_t segment_frames;    /* Ticks per segment (0 = default) */
+    uint32_t max_frames;        /* Stop after this many ticks (0 = replay end) */
+} pb_verify_config;
+
+/*============================================================================
+ * Result
+ *============================================================================*/
+
+typedef struct pb_verify_result {
+    bool ok;                    /* Every checkpoint and boundary matched */
+    pb_desync_info desync;      /* Earliest mismatch when !ok */
+    uint32_t frames;            /* Ticks simulated by the fast-forward pass */
+    uint32_t segments;          /* Segments the replay was split into */
+    uint32_t segments_verified; /* Segments re-simulated (others skipped) */
+    uint32_t checkpoints_verified;
+    uint32_t threads_used;
+} pb_verify_result;
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+/**
+ * Default configuration: one thread, PB_VERIFY_DEFAULT_SEGMENT ticks per
+ * segment, whole replay.
+ */
+void pb_verify_config_default(pb_verify_config* config);
+
+/**
+ * Verify a replay against its recorded checkpoints.
+ *
+ * A mismatch at a segment boundary (the re-simulated state differs from
+ * the fast-forward pass) reports component "segment"; it means the
+ * simulation is not deterministic, which serial verification cannot see.
+ *
+ * @param replay   Replay with checkpoints
+ * @param ruleset  Ruleset (NULL for defaults, as for playback sessions)
+ * @param config   Configuration (NULL for defaults)
+ * @param result   Output
+ * @return PB_OK (verdict in result->ok), PB_ERR_INVALID_ARG, or
+ *         PB_ERR_NO_MEMORY
+ */
+pb_result pb_verify_replay(const pb_replay* replay, const pb_ruleset* ruleset,
+                           const pb_verify_config* config,
+                           pb_verify_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PB_VERIFY_H */
@@ -0,0 +1,376 @@
+/*
+ * pb_anim.c - Deterministic tween timeline for match, drop and row animations
+ *
+ * Easing tables are Q15 samples of the standard Penner curves at 65
+ * evenly spaced points; pb_ease_eval() interpolates linearly between
+ * them, which keeps every curve within 0.2% of its closed form. The
+ * bounce curve has cusps between samples, so it is evaluated piecewise
+ * instead of from a table.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_anim.h"
+#include "pb/pb_game.h"
+
+#include <string.h>
+
+/*============================================================================
+ * Easing
+ *============================================================================*/
+
+static const uint16_t ease_table[PB_EASE_COUNT][PB_EASE_SEGMENTS + 1] = {
+    [PB_EASE_LINEAR] = {
+            0,   512,  1024,  1536,  2048,  2560,  3072,  3584,  4096,
+         4608,  5120,  5632,  6144,  6656,  7168,  7680,  8192,  8704,
+         9216,  9728, 10240, 10752, 11264, 11776, 12288, 12800, 13312,
+        13824, 14336, 14848, 15360, 15872, 16384, 16896, 17408, 17920,
+        18432, 18944, 19456, 19968, 20480, 20992, 21504, 22016, 22528,
+        23040, 23552, 24064, 24576, 25088, 25600, 26112, 26624, 27136,
+        27648, 28160, 28672, 29184, 29696, 30208, 30720, 31232, 31744,
+        32256, 32768
+    },
+    [PB_EASE_IN_QUAD] = {
+            0,     8,    32,    72,   128,   200,   288,   392,   512,
+          648,   800,   968,  1152,  1352,  1568,  1800,  2048,  2312,
+         2592,  2888,  3200,  3528,  3872,  4232,  4608,  5000,  5408,
+         5832,  6272,  6728,  7200,  7688,  8192,  8712,  9248,  9800,
+        10368, 10952, 11552, 12168, 12800, 13448, 14112, 14792, 15488,
+        16200, 16928, 17672, 18432, 19208, 20000, 20808, 21632, 22472,
+        23328, 24200, 25088, 25992, 26912, 27848, 28800, 29768, 30752,
+        31752, 32768
+    },
+    [PB_EASE_OUT_QUAD] = {
+            0,  1016,  2016,  3000,  3968,  4920,  5856,  6776,  7680,
+         8568,  9440, 10296, 11136, 11960, 12768, 13560, 14336, 15096,
+        15840, 16568, 17280, 17976, 18656, 19320, 19968, 20600, 21216,
+        21816, 22400, 22968, 23520, 24056, 24576, 25080, 25568, 26040,
+        26496, 26936, 27360, 27768, 28160, 28536, 28896, 29240, 29568,
+        29880, 30176, 30456, 30720, 30968, 31200, 31416, 31616, 31800,
+        31968, 32120, 32256, 32376, 32480, 32568, 32640, 32696, 32736,
+        32760, 32768
+    },
+    [PB_EASE_IN_OUT_CUBIC] = {
+            0,     0,     4,    14,    32,    62,   108,   172,   256,
+          364,   500,   666,   864,  1098,  1372,  1688,  2048,  2456,
+         2916,  3430,  4000,  4630,  5324,  6084,  6912,  7812,  8788,
+         9842, 10976, 12194, 13500, 14896, 16384, 17872, 19268, 20574,
+        21792, 22926, 23980, 24956, 25856, 26684, 27444, 28138, 28768,
+        29338, 29852, 30312, 30720, 31080, 31396, 31670, 31904, 32102,
+        32268, 32404, 32512, 32596, 32660, 32706, 32736, 32754, 32764,
+        32768, 32768
+    },
+    [PB_EASE_OUT_BACK] = {
+            0,  2356,  4612,  6770,  8831, 10798, 12672, 14456, 16152,
+        17762, 19287, 20731, 22094, 23379, 24587, 25722, 26785, 27778,
+        28702, 29561, 30356, 31088, 31761, 32376, 32936, 33441, 33895,
+        34298, 34654, 34965, 35231, 35456, 35642, 35789, 35902, 35980,
+        36027, 36045, 36035, 35999, 35941, 35860, 35761, 35644, 35511,
+        35366, 35209, 35043, 34870, 34691, 34509, 34327, 34145, 33966,
+        33792, 33624, 33466, 33319, 33185, 33066, 32964, 32881, 32820,
+        32781, 32768
+    },
+};
+
+/*
+ * Penner's out-bounce: four parabolas (2.75t - c)^2 + k, each with
+ * curvature 7.5625, meeting at t = 1/2.75, 2/2.75 and 2.5/2.75.
+ */
+static int32_t ease_out_bounce(uint32_t phase)
+{
+    int64_t u = (int64_t)phase * 11 / 4;        /* 2.75t, Q16 */
+    int64_t v;
+    int32_t k;
+    if (u < 65536) {
+        v = u;
+        k = 0;
+    } else if (u < 2 * 65536) {
+        v = u - 98304;                          /* 1.5 */
+        k = 24576;                              /* 0.75 */
+    } else if (u < 163840) {                    /* 2.5 */
+        v = u - 147456;                         /* 2.25 */
+        k = 30720;                              /* 0.9375 */
+    } else {
+        v = u - 172032;                         /* 2.625 */
+        k = 32256;                              /* 0.984375 */
+    }
+    return k + (int32_t)((v * v + (1 << 16)) >> 17);
+}
+
+int32_t pb_ease_eval(pb_ease ease, uint32_t phase)
+{
+    if ((unsigned)ease >= PB_EASE_COUNT) ease = PB_EASE_LINEAR;
+    if (phase > 65536u) phase = 65536u;
+    if (ease == PB_EASE_OUT_BOUNCE) return ease_out_bounce(phase);
+    if (phase == 65536u) return ease_table[ease][PB_EASE_SEGMENTS];
+
+    const uint16_t* table = ease_table[ease];
+    uint32_t seg = phase >> 10;
+    int32_t frac = (int32_t)(phase & 1023u);
+    int32_t a = table[seg];
+    int32_t b = table[seg + 1];
+    return a + (((b - a) * frac) >> 10);
+}
+
+/*============================================================================
+ * Timeline
+ *============================================================================*/
+
+void pb_anim_config_default(pb_anim_config* config)
+{
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->headless = false;
+    config->pop_frames = 10;
+    config->pop_stagger = 2;
+    config->fall_delay = 6;
+    config->fall_frames = 30;
+    config->row_slide_frames = 12;
+    config->ceiling_drop_frames = 24;
+    config->fall_distance = PB_ANIM_FROM_INT(224);
+    config->row_height = PB_ANIM_FROM_INT(14);
+}
+
+void pb_anim_init(pb_anim_timeline* timeline, const pb_anim_config* config)
+{
+    if (!timeline) return;
+    memset(timeline, 0, sizeof(*timeline));
+    if (config) {
+        timeline->config = *config;
+    } else {
+        pb_anim_config_default(&timeline->config);
+    }
+    timeline->subscription = -1;
+}
+
+void pb_anim_clear(pb_anim_timeline* timeline)
+{
+    if (!timeline) return;
+    timeline->count = 0;
+    timeline->block_until = 0;
+}
+
+pb_result pb_anim_add(pb_anim_timeline* timeline, const pb_tween* tween)
+{
+    if (!timeline || !tween || tween->duration == 0 ||
+        (unsigned)tween->kind >= PB_TWEEN_KIND_COUNT ||
+        (unsigned)tween->ease >= PB_EASE_COUNT) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    if (tween->flags & PB_TWEEN_BLOCKING) {
+        uint32_t end = tween->start_frame + tween->duration;
+        if (end > timeline->block_until) timeline->block_until = end;
+    }
+    if (timeline->config.headless) return PB_OK;
+
+    if (timeline->count >= PB_ANIM_MAX_TWEENS) {
+        timeline->dropped++;
+        return PB_ERR_NO_MEMORY;
+    }
+
+    int i = timeline->count++;
+    timeline->kind[i] = (uint8_t)tween->kind;
+    timeline->ease[i] = (uint8_t)tween->ease;
+    timeline->flags[i] = tween->flags & PB_TWEEN_BLOCKING;
+    timeline->color[i] = tween->color_id;
+    timeline->cell[i] = tween->cell;
+    timeline->duration[i] = tween->duration;
+    timeline->start[i] = tween->start_frame;
+    timeline->rate[i] = (1u << 24) / tween->duration;
+    timeline->from[i] = tween->from;
+    timeline->to[i] = tween->to;
+    timeline->value[i] = tween->from;
+    return PB_OK;
+}
+
+/*============================================================================
+ * Event Scheduling
+ *============================================================================*/
+
+static uint8_t cell_color(const pb_anim_timeline* timeline, pb_cell_index index)
+{
+    const pb_board* board = timeline->board;
+    if (!board) return 0;
+    pb_offset cell = {PB_INDEX_TO_ROW(index), PB_INDEX_TO_COL(index)};
+    if (!pb_board_in_bounds(board, cell)) return 0;
+    /* Removal clears only the kind, so the color is still there */
+    return board->cells[cell.row][cell.col].color_id;
+}
+
+static void schedule_cells(pb_anim_timeline* timeline, const pb_event* event,
+                           const pb_cell_index* cells, int count)
+{
+    const pb_anim_config* cfg = &timeline->config;
+    bool pop = (event->type == PB_EVENT_BUBBLES_POPPED);
+
+    pb_tween tween = {
+        .kind = pop ? PB_TWEEN_POP : PB_TWEEN_FALL,
+        .ease = PB_EASE_IN_QUAD,
+        .flags = PB_TWEEN_BLOCKING,
+        .duration = pop ? cfg->pop_frames : cfg->fall_frames,
+        .from = pop ? PB_ANIM_ONE : 0,
+        .to = pop ? 0 : cfg->fall_distance,
+    };
+    if (tween.duration == 0) return;
+
+    for (int i = 0; i < count; i++) {
+        tween.cell = cells[i];
+        tween.color_id = cell_color(timeline, cells[i]);
+        tween.start_frame = pop ? event->frame + (uint32_t)i * cfg->pop_stagger
+                                : event->frame + cfg->fall_delay;
+        pb_anim_add(timeline, &tween);
+    }
+}
+
+void pb_anim_on_event(const pb_event* event, void* userdata)
+{
+    pb_anim_timeline* timeline = userdata;
+    if (!event || !timeline) return;
+    const pb_anim_config* cfg = &timeline->config;
+
+    switch (event->type) {
+    case PB_EVENT_BUBBLES_POPPED:
+        schedule_cells(timeline, event, event->data.popped.cells,
+                       event->data.popped.count);
+        break;
+
+    case PB_EVENT_BUBBLES_DROPPED:
+        schedule_cells(timeline, event, event->data.dropped.cells,
+                       event->data.dropped.count);
+        break;
+
+    case PB_EVENT_ROW_INSERTED:
+    case PB_EVENT_GARBAGE_RECEIVED: {
+        bool garbage = (event->type == PB_EVENT_GARBAGE_RECEIVED);
+        int rows = 1;
+        if (garbage) {
+            int width = (timeline->board && timeline->board->cols_even > 0)
+                        ? timeline->board->cols_even : 8;
+            rows = (event->data.garbage.count + width - 1) / width;
+            if (rows <= 0) return;
+        }
+        pb_tween tween = {
+            .kind = garbage ? PB_TWEEN_CEILING_DROP : PB_TWEEN_ROW_SLIDE,
+            .ease = garbage ? PB_EASE_OUT_BOUNCE : PB_EASE_OUT_BACK,
+            .flags = PB_TWEEN_BLOCKING,
+            .start_frame = event->frame,
+            .duration = garbage ? cfg->ceiling_drop_frames : cfg->row_slide_frames,
+            .from = -cfg->row_height * rows,
+            .to = 0,
+        };
+        if (tween.duration > 0) pb_anim_add(timeline, &tween);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+pb_result pb_anim_attach(pb_anim_timeline* timeline, pb_game_state* state)
+{
+    if (!timeline || !state) return PB_ERR_INVALID_ARG;
+    if (timeline->subscription >= 0) return PB_ERR_INVALID_STATE;
+
+    uint32_t mask = PB_EVENT_MASK(PB_EVENT_BUBBLES_POPPED) |
+                    PB_EVENT_MASK(PB_EVENT_BUBBLES_DROPPED) |
+                    PB_EVENT_MASK(PB_EVENT_ROW_INSERTED) |
+                    PB_EVENT_MASK(PB_EVENT_GARBAGE_RECEIVED);
+    int id;
+    pb_result result = pb_game_subscribe(state, mask, pb_anim_on_event, timeline, &id);
+    if (result != PB_OK) return result;
+
+    timeline->subscription = id;
+    timeline->board = &state->board;
+    return PB_OK;
+}
+
+void pb_anim_detach(pb_anim_timeline* timeline, pb_game_state* state)
+{
+    if (!timeline || !state || timeline->subscription < 0) return;
+    pb_game_unsubscribe(state, timeline->subscription);
+    timeline->subscription = -1;
+    timeline->board = NULL;
+}
+
+/*============================================================================
+ * Evaluation
+ *============================================================================*/
+
+static void remove_done(pb_anim_timeline* t)
+{
+    int out = 0;
+    for (int i = 0; i < t->count; i++) {
+        if (t->flags[i] & PB_TWEEN_DONE) continue;
+        if (out != i) {
+            t->kind[out] = t->kind[i];
+            t->ease[out] = t->ease[i];
+            t->flags[out] = t->flags[i];
+            t->color[out] = t->color[i];
+            t->cell[out] = t->cell[i];
+            t->duration[out] = t->duration[i];
+            t->start[out] = t->start[i];
+            t->rate[out] = t->rate[i];
+            t->from[out] = t->from[i];
+            t->to[out] = t->to[i];
+            t->value[out] = t->value[i];
+        }
+        out++;
+    }
+    t->count = out;
+}
+
+void pb_anim_advance(pb_anim_timeline* timeline, uint32_t frame)
+{
+    if (!timeline) return;
+    pb_anim_timeline* t = timeline;
+
+    remove_done(t);
+    t->frame = frame;
+
+    for (int i = 0; i < t->count; i++) {
+        /* Elapsed frames, clamped to [0, duration] */
+        int64_t elapsed = (int64_t)frame - (int64_t)t->start[i];
+        if (elapsed < 0) elapsed = 0;
+        bool done = elapsed >= t->duration[i];
+        uint32_t phase = done ? 65536u
+                              : (uint32_t)(((uint64_t)elapsed * t->rate[i]) >> 8);
+
+        int32_t eased = pb_ease_eval((pb_ease)t->ease[i], phase);
+        int64_t span = (int64_t)t->to[i] - t->from[i];
+        t->value[i] = t->from[i] + (pb_anim_value)((span * eased) / PB_EASE_ONE);
+        if (done) t->flags[i] |= PB_TWEEN_DONE;
+    }
+}
+
+bool pb_anim_sim_can_continue(const pb_anim_timeline* timeline, uint32_t frame)
+{
+    return !timeline || frame >= timeline->block_until;
+}
+
+bool pb_anim_cell_value(const pb_anim_timeline* timeline, pb_tween_kind kind,
+                        pb_cell_index cell, pb_anim_value* out)
+{
+    if (!timeline) return false;
+    for (int i = 0; i < timeline->count; i++) {
+        if (timeline->kind[i] == kind && timeline->cell[i] == cell) {
+            if (out) *out = timeline->value[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+pb_anim_value pb_anim_board_offset(const pb_anim_timeline* timeline)
+{
+    if (!timeline) return 0;
+    pb_anim_value offset = 0;
+    for (int i = 0; i < timeline->count; i++) {
+        if (timeline->kind[i] == PB_TWEEN_ROW_SLIDE ||
+            timeline->kind[i] == PB_TWEEN_CEILING_DROP) {
+            offset += timeline->value[i];
+        }
+    }
+    return offset;
+}
@@ -0,0 +1,509 @@
+/*
+ * pb_async.c - Cancellable background solvability analysis
+ *
+ * One long-lived worker thread sleeps on a condition variable until
+ * pb_async_start() hands it a job. Each job is tagged with a generation;
+ * progress from a job whose generation is no longer current, or that was
+ * cancelled, is dropped, so a restart never shows stale results.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_async.h"
+
+#include <stdlib.h>
+#include <time.h>
+#include "pb/pb_freestanding.h"
+
+#if PB_FEATURE_THREADS
+#include <pthread.h>
+#endif
+
+/*============================================================================
+ * Internal Types
+ *============================================================================*/
+
+typedef struct async_input {
+    pb_board board;
+    pb_ruleset ruleset;
+    bool has_ruleset;
+    pb_bubble queue[PB_EXACT_MAX_DEPTH];
+    int queue_length;
+} async_input;
+
+struct pb_async_solver {
+    pb_async_config config;
+    pb_exact_cache* cache;
+
+    /* Worker-owned */
+    async_input job;
+    uint32_t job_generation;
+    uint64_t job_start_ms;
+    uint64_t last_callback_ms;
+
+    /* Guarded by lock when threaded */
+    pb_async_progress progress;
+    async_input pending;
+    bool has_pending;
+    bool cancel;
+    bool shutdown;
+    bool has_last;              /* last/last_result describe a DONE job */
+    async_input last;
+    pb_async_progress last_result;
+
+#if PB_FEATURE_THREADS
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        /* Worker: new job or shutdown */
+    pthread_cond_t finished;    /* Waiters: job left RUNNING */
+    pthread_t thread;
+#endif
+};
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static void async_lock(pb_async_solver* s)
+{
+#if PB_FEATURE_THREADS
+    pthread_mutex_lock(&s->lock);
+#else
+    (void)s;
+#endif
+}
+
+static void async_unlock(pb_async_solver* s)
+{
+#if PB_FEATURE_THREADS
+    pthread_mutex_unlock(&s->lock);
+#else
+    (void)s;
+#endif
+}
+
+static void async_signal_finished(pb_async_solver* s)
+{
+#if PB_FEATURE_THREADS
+    pthread_cond_broadcast(&s->finished);
+#else
+    (void)s;
+#endif
+}
+
+static uint64_t now_ms(void)
+{
+#if defined(TIME_UTC)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#else
+    return (uint64_t)clock() * 1000u / CLOCKS_PER_SEC;
+#endif
+}
+
+static bool same_bubble(const pb_bubble* a, const pb_bubble* b)
+{
+    if (a->kind != b->kind) return false;
+    if (a->kind == PB_KIND_NONE) return true;
+    return a->color_id == b->color_id && a->special == b->special &&
+           (a->flags & 0x3F) == (b->flags & 0x3F) &&
+           a->payload.timer == b->payload.timer;
+}
+
+static bool same_input(const async_input* a, const async_input* b)
+{
+    if (a->board.rows != b->board.rows ||
+        a->board.cols_even != b->board.cols_even ||
+        a->board.cols_odd != b->board.cols_odd ||
+        a->board.ceiling_row != b->board.ceiling_row ||
+        a->queue_length != b->queue_length ||
+        a->has_ruleset != b->has_ruleset) {
+        return false;
+    }
+
+    if (a->has_ruleset) {
+        const pb_ruleset* ra = &a->ruleset;
+        const pb_ruleset* rb = &b->ruleset;
+        if (ra->mode != rb->mode || ra->match_threshold != rb->match_threshold ||
+            ra->max_bounces != rb->max_bounces ||
+            ra->bubble_radius != rb->bubble_radius ||
+            ra->allow_color_switch != rb->allow_color_switch) {
+            return false;
+        }
+    }
+
+    for (int row = 0; row < a->board.rows; row++) {
+        int cols = pb_row_cols(row, a->board.cols_even, a->board.cols_odd);
+        for (int col = 0; col < cols; col++) {
+            if (!same_bubble(&a->board.cells[row][col], &b->board.cells[row][col])) {
+                return false;
+            }
+        }
+    }
+    for (int i = 0; i < a->queue_length; i++) {
+        if (!same_bubble(&a->queue[i], &b->queue[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Caller holds the lock */
+static bool job_is_live(const pb_async_solver* s)
+{
+    return !s->cancel && s->progress.generation == s->job_generation &&
+           s->progress.state == PB_ASYNC_RUNNING;
+}
+
+static void notify(pb_async_solver* s, const pb_async_progress* snapshot)
+{
+    if (s->config.on_progress) {
+        s->config.on_progress(snapshot, s->config.callback_userdata);
+    }
+}
+
+/*============================================================================
+ * Stages
+ *============================================================================*/
+
+static bool greedy_step(const pb_solvability* partial, void* userdata)
+{
+    pb_async_solver* s = userdata;
+    pb_async_progress snapshot;
+    bool live;
+
+    async_lock(s);
+    live = job_is_live(s);
+    if (live) {
+        s->progress.greedy = *partial;
+        s->progress.elapsed_ms = (uint32_t)(now_ms() - s->job_start_ms);
+        snapshot = s->progress;
+    }
+    async_unlock(s);
+
+    if (live) {
+        notify(s, &snapshot);
+    }
+    return live;
+}
+
+static bool exact_step(const pb_exact_progress* progress, void* userdata)
+{
+    pb_async_solver* s = userdata;
+    pb_async_progress snapshot;
+    bool live;
+    bool report = false;
+    uint64_t now = now_ms();
+
+    async_lock(s);
+    live = job_is_live(s);
+    if (live) {
+        if (progress->upper_bound >= 0) {
+            s->progress.exact_min_shots = progress->upper_bound;
+        }
+        s->progress.exact_lower_bound = progress->lower_bound;
+        s->progress.nodes = progress->nodes;
+        s->progress.elapsed_ms = (uint32_t)(now - s->job_start_ms);
+        if (now - s->last_callback_ms >= s->config.progress_interval_ms) {
+            s->last_callback_ms = now;
+            snapshot = s->progress;
+            report = true;
+        }
+    }
+    async_unlock(s);
+
+    if (report) {
+        notify(s, &snapshot);
+    }
+    return live;
+}
+
+/* Publish the end of the current job (unless superseded) */
+static void finish_job(pb_async_solver* s, const pb_async_progress* result)
+{
+    pb_async_progress snapshot;
+    bool current;
+
+    async_lock(s);
+    current = s->progress.generation == s->job_generation;
+    if (current) {
+        if (s->progress.state == PB_ASYNC_RUNNING && !s->cancel) {
+            s->progress = *result;
+            s->progress.state = PB_ASYNC_DONE;
+            s->progress.elapsed_ms = (uint32_t)(now_ms() - s->job_start_ms);
+            s->last = s->job;
+            s->last_result = s->progress;
+            s->has_last = true;
+        } else {
+            s->progress.state = PB_ASYNC_CANCELLED;
+        }
+        snapshot = s->progress;
+        async_signal_finished(s);
+    }
+    async_unlock(s);
+
+    if (current) {
+        notify(s, &snapshot);
+    }
+}
+
+static void run_job(pb_async_solver* s)
+{
+    const async_input* in = &s->job;
+    const pb_ruleset* ruleset = in->has_ruleset ? &in->ruleset : NULL;
+    pb_async_progress result;
+
+    async_lock(s);
+    bool reuse = s->has_last && same_input(&s->last, in);
+    if (reuse) {
+        result = s->last_result;
+        result.generation = s->job_generation;
+        result.reused = true;
+    } else {
+        result = s->progress;
+    }
+    async_unlock(s);
+
+    if (reuse) {
+        finish_job(s, &result);
+        return;
+    }
+
+    /* Greedy stage */
+    if (!pb_analyze_solvability_ex(&in->board, ruleset, in->queue,
+                                   in->queue_length, s->config.max_search,
+                                   greedy_step, s, &result.greedy)) {
+        finish_job(s, &result);
+        return;
+    }
+    result.greedy_done = true;
+
+    async_lock(s);
+    bool live = job_is_live(s);
+    if (live) {
+        s->progress.greedy = result.greedy;
+        s->progress.greedy_done = true;
+        s->progress.stage = PB_ASYNC_STAGE_EXACT;
+    }
+    async_unlock(s);
+
+    if (!live || !s->config.run_exact || in->queue_length == 0) {
+        finish_job(s, &result);
+        return;
+    }
+
+    /* Exact stage */
+    pb_exact_config exact = s->config.exact;
+    exact.cache = s->cache;
+    exact.on_progress = exact_step;
+    exact.progress_userdata = s;
+
+    pb_exact_result er;
+    result.stage = PB_ASYNC_STAGE_EXACT;
+    if (pb_solve_exact(&in->board, ruleset, in->queue, in->queue_length,
+                       &exact, &er) == PB_OK) {
+        result.exact_done = true;
+        result.exact_status = er.status;
+        result.exact_min_shots = er.min_shots;
+        result.exact_lower_bound = er.lower_bound;
+        result.nodes = er.nodes;
+    }
+    finish_job(s, &result);
+}
+
+/* Caller holds the lock; moves the pending job into the worker's slot */
+static void take_pending(pb_async_solver* s)
+{
+    s->job = s->pending;
+    s->job_generation = s->progress.generation;
+    s->job_start_ms = now_ms();
+    s->last_callback_ms = 0;
+    s->has_pending = false;
+    s->cancel = false;
+}
+
+#if PB_FEATURE_THREADS
+static void* worker_main(void* arg)
+{
+    pb_async_solver* s = arg;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->has_pending && !s->shutdown) {
+            pthread_cond_wait(&s->wake, &s->lock);
+        }
+        if (s->shutdown) {
+            break;
+        }
+        take_pending(s);
+        pthread_mutex_unlock(&s->lock);
+
+        run_job(s);
+
+        pthread_mutex_lock(&s->lock);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+#endif
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void pb_async_config_default(pb_async_config* config)
+{
+    memset(config, 0, sizeof(*config));
+    config->max_search = 1000;
+    config->run_exact = true;
+    pb_exact_config_default(&config->exact);
+    config->exact.time_budget_ms = 250;
+    config->progress_interval_ms = 16;
+}
+
+pb_async_solver* pb_async_create(const pb_async_config* config)
+{
+    pb_async_solver* s = calloc(1, sizeof(*s));
+    if (!s) {
+        return NULL;
+    }
+
+    if (config) {
+        s->config = *config;
+    } else {
+        pb_async_config_default(&s->config);
+    }
+    s->progress.state = PB_ASYNC_IDLE;
+    s->progress.exact_min_shots = -1;
+
+    if (s->config.run_exact) {
+        s->cache = pb_exact_cache_create(s->config.exact.tt_bits);
+        if (!s->cache) {
+            free(s);
+            return NULL;
+        }
+    }
+
+#if PB_FEATURE_THREADS
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->wake, NULL);
+    pthread_cond_init(&s->finished, NULL);
+    if (pthread_create(&s->thread, NULL, worker_main, s) != 0) {
+        pthread_cond_destroy(&s->finished);
+        pthread_cond_destroy(&s->wake);
+        pthread_mutex_destroy(&s->lock);
+        pb_exact_cache_destroy(s->cache);
+        free(s);
+        return NULL;
+    }
+#endif
+
+    return s;
+}
+
+void pb_async_destroy(pb_async_solver* solver)
+{
+    if (!solver) return;
+
+#if PB_FEATURE_THREADS
+    pthread_mutex_lock(&solver->lock);
+    solver->shutdown = true;
+    solver->cancel = true;
+    pthread_cond_signal(&solver->wake);
+    pthread_mutex_unlock(&solver->lock);
+    pthread_join(solver->thread, NULL);
+
+    pthread_cond_destroy(&solver->finished);
+    pthread_cond_destroy(&solver->wake);
+    pthread_mutex_destroy(&solver->lock);
+#endif
+
+    pb_exact_cache_destroy(solver->cache);
+    free(solver);
+}
+
+pb_result pb_async_start(pb_async_solver* solver, const pb_board* board,
+                         const pb_ruleset* ruleset,
+                         const pb_bubble* queue, int queue_length)
+{
+    if (!solver || !board || queue_length < 0 ||
+        queue_length > PB_EXACT_MAX_DEPTH || (queue_length > 0 && !queue)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    async_lock(solver);
+    async_input* in = &solver->pending;
+    in->board = *board;
+    in->has_ruleset = ruleset != NULL;
+    if (ruleset) {
+        in->ruleset = *ruleset;
+    }
+    in->queue_length = queue_length;
+    if (queue_length > 0) {
+        memcpy(in->queue, queue, (size_t)queue_length * sizeof(pb_bubble));
+    }
+    solver->has_pending = true;
+    solver->cancel = true;      /* Abandon the job in flight, if any */
+
+    uint32_t generation = solver->progress.generation + 1;
+    memset(&solver->progress, 0, sizeof(solver->progress));
+    solver->progress.state = PB_ASYNC_RUNNING;
+    solver->progress.generation = generation;
+    solver->progress.exact_min_shots = -1;
+
+#if PB_FEATURE_THREADS
+    pthread_cond_signal(&solver->wake);
+    async_unlock(solver);
+#else
+    take_pending(solver);
+    async_unlock(solver);
+    run_job(solver);
+#endif
+
+    return PB_OK;
+}
+
+pb_async_state pb_async_poll(pb_async_solver* solver, pb_async_progress* out)
+{
+    if (!solver) return PB_ASYNC_IDLE;
+
+    async_lock(solver);
+    pb_async_state state = solver->progress.state;
+    if (out) {
+        *out = solver->progress;
+    }
+    async_unlock(solver);
+    return state;
+}
+
+void pb_async_cancel(pb_async_solver* solver)
+{
+    if (!solver) return;
+
+    async_lock(solver);
+    if (solver->progress.state == PB_ASYNC_RUNNING) {
+        solver->cancel = true;
+        solver->has_pending = false;
+        solver->progress.state = PB_ASYNC_CANCELLED;
+        async_signal_finished(solver);
+    }
+    async_unlock(solver);
+}
+
+pb_async_state pb_async_wait(pb_async_solver* solver, pb_async_progress* out)
+{
+    if (!solver) return PB_ASYNC_IDLE;
+
+    async_lock(solver);
+#if PB_FEATURE_THREADS
+    while (solver->progress.state == PB_ASYNC_RUNNING) {
+        pthread_cond_wait(&solver->finished, &solver->lock);
+    }
+#endif
+    pb_async_state state = solver->progress.state;
+    if (out) {
+        *out = solver->progress;
+    }
+    async_unlock(solver);
+    return state;
+}
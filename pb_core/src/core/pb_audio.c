@@ -0,0 +1,320 @@
+/*
+ * pb_audio.c - Voice-pooled sound scheduler and PCM mixer
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_audio.h"
+#include "pb/pb_freestanding.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MIX_CHUNK       256     /* Frames accumulated per pass */
+#define GAIN_ONE        65536   /* Q16 unity gain */
+
+typedef struct audio_sound {
+    const int16_t* samples;
+    uint32_t frames;
+    uint8_t priority;
+    bool owned;                 /* Decoded by pb_audio_load() */
+
+    /* This frame's requests */
+    int pending;
+    float loudest;
+} audio_sound;
+
+typedef struct audio_voice {
+    int sound;                  /* -1 when free */
+    uint32_t pos;
+    int32_t gain;               /* Q16 */
+} audio_voice;
+
+struct pb_audio {
+    int sample_rate;
+    audio_sound sounds[PB_AUDIO_MAX_SOUNDS];
+    int sound_count;
+    uint64_t pending_mask;      /* Sounds with requests this frame */
+
+    audio_voice voices[PB_AUDIO_MAX_VOICES];
+    pb_platform* platform;      /* Attached stream, or NULL */
+    pb_audio_stats stats;
+};
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+pb_audio* pb_audio_create(int sample_rate)
+{
+    if (sample_rate <= 0) return NULL;
+    pb_audio* audio = calloc(1, sizeof(*audio));
+    if (!audio) return NULL;
+
+    audio->sample_rate = sample_rate;
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+        audio->voices[i].sound = -1;
+    }
+    return audio;
+}
+
+void pb_audio_destroy(pb_audio* audio)
+{
+    if (!audio) return;
+    pb_audio_detach(audio);
+    for (int i = 0; i < audio->sound_count; i++) {
+        if (audio->sounds[i].owned) free((void*)audio->sounds[i].samples);
+    }
+    free(audio);
+}
+
+static void stream_callback(void* userdata, int16_t* out, int frames, int channels)
+{
+    pb_audio_mix(userdata, out, frames, channels);
+}
+
+pb_result pb_audio_attach(pb_audio* audio, pb_platform* platform)
+{
+    if (!audio || !platform) return PB_ERR_INVALID_ARG;
+    if (audio->platform) return PB_ERR_INVALID_STATE;
+    if (!platform->audio_stream_open || !platform->audio_stream_close ||
+        !platform->audio_lock) {
+        return PB_ERR_NOT_IMPLEMENTED;
+    }
+
+    int rate = 0, channels = 0;
+    if (!platform->audio_stream_open(platform, stream_callback, audio, &rate, &channels)) {
+        return PB_ERR_INVALID_STATE;
+    }
+    if (rate != audio->sample_rate) {
+        platform->audio_stream_close(platform);
+        return PB_ERR_INVALID_STATE;
+    }
+    audio->platform = platform;
+    return PB_OK;
+}
+
+void pb_audio_detach(pb_audio* audio)
+{
+    if (!audio || !audio->platform) return;
+    audio->platform->audio_stream_close(audio->platform);
+    audio->platform = NULL;
+}
+
+/*============================================================================
+ * Sounds
+ *============================================================================*/
+
+pb_result pb_audio_add_pcm(pb_audio* audio, const int16_t* samples,
+                           uint32_t frames, uint8_t priority, int* id)
+{
+    if (!audio || !samples || frames == 0 || !id) return PB_ERR_INVALID_ARG;
+    if (audio->sound_count >= PB_AUDIO_MAX_SOUNDS) return PB_ERR_NO_MEMORY;
+
+    int index = audio->sound_count++;
+    audio_sound* snd = &audio->sounds[index];
+    memset(snd, 0, sizeof(*snd));
+    snd->samples = samples;
+    snd->frames = frames;
+    snd->priority = priority;
+    *id = index;
+    return PB_OK;
+}
+
+pb_result pb_audio_load(pb_audio* audio, pb_platform* platform, const char* path,
+                        uint8_t priority, int* id)
+{
+    if (!audio || !platform || !path || !id) return PB_ERR_INVALID_ARG;
+    if (!platform->sound_decode) return PB_ERR_NOT_IMPLEMENTED;
+    if (audio->sound_count >= PB_AUDIO_MAX_SOUNDS) return PB_ERR_NO_MEMORY;
+
+    uint32_t frames = 0;
+    int16_t* samples = platform->sound_decode(platform, path, audio->sample_rate, &frames);
+    if (!samples || frames == 0) {
+        free(samples);
+        return PB_ERR_INVALID_ARG;
+    }
+
+    pb_result result = pb_audio_add_pcm(audio, samples, frames, priority, id);
+    if (result != PB_OK) {
+        free(samples);
+        return result;
+    }
+    audio->sounds[*id].owned = true;
+    return PB_OK;
+}
+
+/*============================================================================
+ * Scheduling
+ *============================================================================*/
+
+void pb_audio_play(pb_audio* audio, int id, float volume)
+{
+    if (!audio || id < 0 || id >= audio->sound_count) return;
+    if (volume <= 0.0f) return;
+    if (volume > 1.0f) volume = 1.0f;
+
+    audio_sound* snd = &audio->sounds[id];
+    audio->stats.requests++;
+    if (snd->pending > 0) audio->stats.coalesced++;
+    snd->pending++;
+    if (volume > snd->loudest) snd->loudest = volume;
+    audio->pending_mask |= (uint64_t)1 << id;
+}
+
+/*
+ * Voice to start a sound of a priority on, or -1 to drop it. Voices
+ * started earlier in the same commit (fresh) are never stolen: they have
+ * not played a sample yet.
+ */
+static int pick_voice(const pb_audio* audio, const bool* fresh, uint8_t priority,
+                      bool* stolen)
+{
+    int victim = -1;
+    uint8_t victim_priority = 0;
+    uint32_t victim_left = 0;
+
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+        const audio_voice* v = &audio->voices[i];
+        if (v->sound < 0) {
+            *stolen = false;
+            return i;
+        }
+        if (fresh[i]) {
+            continue;
+        }
+        const audio_sound* snd = &audio->sounds[v->sound];
+        uint32_t left = snd->frames - v->pos;
+        if (victim < 0 || snd->priority < victim_priority ||
+            (snd->priority == victim_priority && left < victim_left)) {
+            victim = i;
+            victim_priority = snd->priority;
+            victim_left = left;
+        }
+    }
+    if (victim < 0 || victim_priority > priority) return -1;
+    *stolen = true;
+    return victim;
+}
+
+void pb_audio_commit(pb_audio* audio)
+{
+    if (!audio || audio->pending_mask == 0) return;
+
+    /* Gather the frame's sounds, highest priority first (insertion sort;
+     * stable, so equal priorities keep id order) */
+    int order[PB_AUDIO_MAX_SOUNDS];
+    int count = 0;
+    for (int id = 0; id < audio->sound_count; id++) {
+        if (!(audio->pending_mask & ((uint64_t)1 << id))) continue;
+        uint8_t priority = audio->sounds[id].priority;
+        int j = count++;
+        while (j > 0 && audio->sounds[order[j - 1]].priority < priority) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = id;
+    }
+
+    bool fresh[PB_AUDIO_MAX_VOICES] = {false};
+    if (audio->platform) audio->platform->audio_lock(audio->platform, true);
+    for (int k = 0; k < count; k++) {
+        audio_sound* snd = &audio->sounds[order[k]];
+        bool stolen = false;
+        int slot = pick_voice(audio, fresh, snd->priority, &stolen);
+        if (slot < 0) {
+            audio->stats.dropped += (uint32_t)snd->pending;
+        } else {
+            float gain = snd->loudest * pb_sqrtf((float)snd->pending);
+            if (gain > 1.0f) gain = 1.0f;
+            audio_voice* v = &audio->voices[slot];
+            v->sound = order[k];
+            v->pos = 0;
+            v->gain = (int32_t)(gain * (float)GAIN_ONE + 0.5f);
+            fresh[slot] = true;
+            audio->stats.started++;
+            if (stolen) audio->stats.stolen++;
+        }
+        snd->pending = 0;
+        snd->loudest = 0.0f;
+    }
+    if (audio->platform) audio->platform->audio_lock(audio->platform, false);
+    audio->pending_mask = 0;
+}
+
+void pb_audio_stop_all(pb_audio* audio)
+{
+    if (!audio) return;
+    if (audio->platform) audio->platform->audio_lock(audio->platform, true);
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+        audio->voices[i].sound = -1;
+    }
+    if (audio->platform) audio->platform->audio_lock(audio->platform, false);
+
+    for (int id = 0; id < audio->sound_count; id++) {
+        audio->sounds[id].pending = 0;
+        audio->sounds[id].loudest = 0.0f;
+    }
+    audio->pending_mask = 0;
+}
+
+/*============================================================================
+ * Mixing
+ *============================================================================*/
+
+void pb_audio_mix(pb_audio* audio, int16_t* out, int frames, int channels)
+{
+    if (!audio || !out || frames <= 0 || channels <= 0) return;
+
+    int32_t acc[MIX_CHUNK];
+    while (frames > 0) {
+        int n = frames < MIX_CHUNK ? frames : MIX_CHUNK;
+        memset(acc, 0, sizeof(acc[0]) * (size_t)n);
+
+        bool any = false;
+        for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+            audio_voice* v = &audio->voices[i];
+            if (v->sound < 0) continue;
+            const audio_sound* snd = &audio->sounds[v->sound];
+            uint32_t left = snd->frames - v->pos;
+            int len = left < (uint32_t)n ? (int)left : n;
+            const int16_t* src = snd->samples + v->pos;
+            for (int f = 0; f < len; f++) {
+                acc[f] += (int32_t)(((int64_t)src[f] * v->gain) >> 16);
+            }
+            v->pos += (uint32_t)len;
+            if (v->pos >= snd->frames) v->sound = -1;
+            any = true;
+        }
+
+        if (any) {
+            int16_t* dst = out;
+            for (int f = 0; f < n; f++) {
+                for (int c = 0; c < channels; c++) {
+                    int32_t s = dst[c] + acc[f];
+                    if (s > 32767) s = 32767;
+                    if (s < -32768) s = -32768;
+                    dst[c] = (int16_t)s;
+                }
+                dst += channels;
+            }
+        }
+        out += (size_t)n * (size_t)channels;
+        frames -= n;
+    }
+}
+
+pb_audio_stats pb_audio_get_stats(const pb_audio* audio)
+{
+    pb_audio_stats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!audio) return stats;
+
+    if (audio->platform) audio->platform->audio_lock(audio->platform, true);
+    stats = audio->stats;
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+        if (audio->voices[i].sound >= 0) stats.active++;
+    }
+    if (audio->platform) audio->platform->audio_lock(audio->platform, false);
+    return stats;
+}
@@ -9,6 +9,69 @@
 
 #include "pb/pb_board.h"
 #include "pb/pb_rng.h"
+#include "pb/pb_compat.h"
+
+/*============================================================================
+ * Neighbor Count Packing
+ *
+ * One uint32_t per cell: 3 bits per color (bits 0..3*PB_MAX_COLORS-1),
+ * then 3 bits of wildcard count, then 3 bits of occupied count. A count
+ * never exceeds 6, so fields never carry into each other.
+ *============================================================================*/
+
+#if PB_FEATURE_NEIGHBOR_COUNTS
+#define NB_FIELD_BITS       3
+#define NB_FIELD_MASK       0x7u
+#define NB_WILDCARD_SHIFT   (PB_MAX_COLORS * NB_FIELD_BITS)
+#define NB_TOTAL_SHIFT      (NB_WILDCARD_SHIFT + NB_FIELD_BITS)
+
+PB_STATIC_ASSERT(NB_TOTAL_SHIFT + NB_FIELD_BITS <= 32,
+                 "neighbor counts must pack into 32 bits");
+
+/* What a bubble adds to each neighbor's packed counts */
+static uint32_t nb_contribution(const pb_bubble* b)
+{
+    if (b->kind == PB_KIND_NONE) {
+        return 0;
+    }
+    uint32_t c = 1u << NB_TOTAL_SHIFT;
+    if (b->kind == PB_KIND_COLORED && b->color_id < PB_MAX_COLORS) {
+        c += 1u << (b->color_id * NB_FIELD_BITS);
+    } else if (b->kind == PB_KIND_WILDCARD) {
+        c += 1u << NB_WILDCARD_SHIFT;
+    }
+    return c;
+}
+
+static void nb_update(pb_board* board, pb_offset pos, uint32_t before, uint32_t after)
+{
+    if (before == after) {
+        return;
+    }
+
+    pb_offset nb[6];
+    pb_hex_neighbors_offset(pos, nb);
+    for (int i = 0; i < 6; i++) {
+        if (pb_board_in_bounds(board, nb[i])) {
+            /* Subtract first: every field of `before` is already counted */
+            uint32_t* slot = &board->neighbor_counts[nb[i].row][nb[i].col];
+            *slot = *slot - before + after;
+        }
+    }
+}
+
+static void nb_rebuild(pb_board* board)
+{
+    memset(board->neighbor_counts, 0, sizeof(board->neighbor_counts));
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            pb_offset pos = {row, col};
+            nb_update(board, pos, 0, nb_contribution(&board->cells[row][col]));
+        }
+    }
+}
+#endif
 
 
 /*============================================================================
@@ -33,6 +96,9 @@ void pb_board_init_custom(pb_board* board, int rows, int cols_even, int cols_odd
 void pb_board_clear(pb_board* board)
 {
     memset(board->cells, 0, sizeof(board->cells));
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    memset(board->neighbor_counts, 0, sizeof(board->neighbor_counts));
+#endif
 }
 
 /*============================================================================
@@ -71,6 +137,12 @@ bool pb_board_set(pb_board* board, pb_offset pos, pb_bubble bubble)
     if (!pb_board_in_bounds(board, pos)) {
         return false;
     }
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    if (board->track_neighbors) {
+        nb_update(board, pos, nb_contribution(&board->cells[pos.row][pos.col]),
+                  nb_contribution(&bubble));
+    }
+#endif
     board->cells[pos.row][pos.col] = bubble;
     return true;
 }
@@ -78,10 +150,87 @@ bool pb_board_set(pb_board* board, pb_offset pos, pb_bubble bubble)
 void pb_board_remove(pb_board* board, pb_offset pos)
 {
     if (pb_board_in_bounds(board, pos)) {
+#if PB_FEATURE_NEIGHBOR_COUNTS
+        if (board->track_neighbors) {
+            nb_update(board, pos, nb_contribution(&board->cells[pos.row][pos.col]), 0);
+        }
+#endif
         board->cells[pos.row][pos.col].kind = PB_KIND_NONE;
     }
 }
 
+/*============================================================================
+ * Neighbor Counts
+ *============================================================================*/
+
+void pb_board_track_neighbors(pb_board* board, bool enable)
+{
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    board->track_neighbors = enable;
+    if (enable) {
+        nb_rebuild(board);
+    }
+#else
+    (void)board;
+    (void)enable;
+#endif
+}
+
+/* Fallback for untracked boards: scan the six neighbors */
+static int scan_neighbors(const pb_board* board, pb_offset pos,
+                          pb_bubble_kind kind, int color_id)
+{
+    pb_offset nb[6];
+    pb_hex_neighbors_offset(pos, nb);
+
+    int count = 0;
+    for (int i = 0; i < 6; i++) {
+        if (!pb_board_in_bounds(board, nb[i])) continue;
+        const pb_bubble* b = &board->cells[nb[i].row][nb[i].col];
+        if (b->kind == PB_KIND_NONE) continue;
+        if (kind == PB_KIND_NONE ||
+            (b->kind == kind && (color_id < 0 || b->color_id == color_id))) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int pb_board_neighbor_color_count(const pb_board* board, pb_offset pos,
+                                  uint8_t color_id)
+{
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    if (board->track_neighbors && color_id < PB_MAX_COLORS &&
+        pb_board_in_bounds(board, pos)) {
+        return (int)((board->neighbor_counts[pos.row][pos.col] >>
+                      (color_id * NB_FIELD_BITS)) & NB_FIELD_MASK);
+    }
+#endif
+    return scan_neighbors(board, pos, PB_KIND_COLORED, color_id);
+}
+
+int pb_board_neighbor_wildcard_count(const pb_board* board, pb_offset pos)
+{
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    if (board->track_neighbors && pb_board_in_bounds(board, pos)) {
+        return (int)((board->neighbor_counts[pos.row][pos.col] >>
+                      NB_WILDCARD_SHIFT) & NB_FIELD_MASK);
+    }
+#endif
+    return scan_neighbors(board, pos, PB_KIND_WILDCARD, -1);
+}
+
+int pb_board_neighbor_total(const pb_board* board, pb_offset pos)
+{
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    if (board->track_neighbors && pb_board_in_bounds(board, pos)) {
+        return (int)((board->neighbor_counts[pos.row][pos.col] >>
+                      NB_TOTAL_SHIFT) & NB_FIELD_MASK);
+    }
+#endif
+    return scan_neighbors(board, pos, PB_KIND_NONE, -1);
+}
+
 /*============================================================================
  * Unified BFS Traversal
  *============================================================================*/
@@ -339,6 +488,255 @@ int pb_find_orphans(const pb_board* board, pb_visit_result* result)
     return result->count;
 }
 
+/*============================================================================
+ * Connected Components
+ *============================================================================*/
+
+#define CC_INDEX(row, col) ((row) * PB_MAX_COLS + (col))
+
+static int cc_find(int16_t* parent, int i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];  /* Path halving */
+        i = parent[i];
+    }
+    return i;
+}
+
+/* The smaller index stays root, so a root is its component's first cell */
+static void cc_union(int16_t* parent, int a, int b)
+{
+    a = cc_find(parent, a);
+    b = cc_find(parent, b);
+    if (a < b) {
+        parent[b] = (int16_t)a;
+    } else if (b < a) {
+        parent[a] = (int16_t)b;
+    }
+}
+
+static bool cc_is_support(const pb_bubble* b)
+{
+    return b->kind != PB_KIND_NONE && !(b->flags & PB_FLAG_GHOST);
+}
+
+static void cc_component_init(pb_component* c, pb_offset pos, const pb_bubble* b)
+{
+    c->size = 0;
+    c->color_id = b->color_id;
+    c->attached = false;
+    c->support = PB_LABEL_NONE;
+    c->liberties = 0;
+    c->top_row = pos.row;
+    c->bottom_row = pos.row;
+    c->first = pos;
+}
+
+/* Add one to each distinct label in labels[0..n) */
+static void cc_add_liberty(pb_component* comps, const int16_t* labels, int n)
+{
+    for (int i = 0; i < n; i++) {
+        bool seen = false;
+        for (int j = 0; j < i; j++) {
+            if (labels[j] == labels[i]) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            comps[labels[i]].liberties++;
+        }
+    }
+}
+
+int pb_board_label_components(const pb_board* board, pb_components* out)
+{
+    int16_t color_parent[PB_MAX_ROWS * PB_MAX_COLS];
+    int16_t support_parent[PB_MAX_ROWS * PB_MAX_COLS];
+
+    out->color_count = 0;
+    out->support_count = 0;
+    out->largest_cluster = 0;
+    out->attached_cells = 0;
+    out->orphan_cells = 0;
+
+    /* Pass 1: union each cell with its already-scanned neighbors (left and
+     * the two above) */
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            int idx = CC_INDEX(row, col);
+            color_parent[idx] = (int16_t)idx;
+            support_parent[idx] = (int16_t)idx;
+            if (!cc_is_support(b) && b->kind != PB_KIND_COLORED) {
+                continue;
+            }
+
+            pb_offset neighbors[6];
+            pb_hex_neighbors_offset((pb_offset){row, col}, neighbors);
+            for (int i = 0; i < 6; i++) {
+                pb_offset n = neighbors[i];
+                if (n.row > row || (n.row == row && n.col > col) ||
+                    !pb_board_in_bounds(board, n)) {
+                    continue;
+                }
+                const pb_bubble* nb = &board->cells[n.row][n.col];
+                int nidx = CC_INDEX(n.row, n.col);
+                if (cc_is_support(b) && cc_is_support(nb)) {
+                    cc_union(support_parent, idx, nidx);
+                }
+                if (b->kind == PB_KIND_COLORED && nb->kind == PB_KIND_COLORED &&
+                    b->color_id == nb->color_id) {
+                    cc_union(color_parent, idx, nidx);
+                }
+            }
+        }
+    }
+
+    /* Pass 2: roots are first cells, so labels come out in row-major order */
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            pb_offset pos = {row, col};
+            int idx = CC_INDEX(row, col);
+
+            out->support_label[row][col] = PB_LABEL_NONE;
+            out->color_label[row][col] = PB_LABEL_NONE;
+
+            if (cc_is_support(b)) {
+                int root = cc_find(support_parent, idx);
+                int16_t label;
+                if (root == idx) {
+                    label = (int16_t)out->support_count++;
+                    cc_component_init(&out->supports[label], pos, b);
+                    out->supports[label].support = label;
+                } else {
+                    label = out->support_label[root / PB_MAX_COLS][root % PB_MAX_COLS];
+                }
+                pb_component* c = &out->supports[label];
+                out->support_label[row][col] = label;
+                c->size++;
+                c->bottom_row = row;
+                if (row == board->ceiling_row) {
+                    c->attached = true;
+                }
+            }
+
+            if (b->kind == PB_KIND_COLORED) {
+                int root = cc_find(color_parent, idx);
+                int16_t label;
+                if (root == idx) {
+                    label = (int16_t)out->color_count++;
+                    cc_component_init(&out->colors[label], pos, b);
+                } else {
+                    label = out->color_label[root / PB_MAX_COLS][root % PB_MAX_COLS];
+                }
+                pb_component* c = &out->colors[label];
+                out->color_label[row][col] = label;
+                c->size++;
+                c->bottom_row = row;
+                if (c->support == PB_LABEL_NONE) {
+                    c->support = out->support_label[row][col];
+                }
+            }
+        }
+    }
+
+    /* Pass 3: attachment, liberties and totals */
+    for (int i = 0; i < out->color_count; i++) {
+        pb_component* c = &out->colors[i];
+        c->attached = c->support != PB_LABEL_NONE && out->supports[c->support].attached;
+        if (c->size > out->largest_cluster) {
+            out->largest_cluster = c->size;
+        }
+    }
+
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+
+            if (b->kind != PB_KIND_NONE) {
+                int16_t s = out->support_label[row][col];
+                if (s != PB_LABEL_NONE && out->supports[s].attached) {
+                    out->attached_cells++;
+                } else if (!(b->flags & PB_FLAG_FROZEN)) {
+                    out->orphan_cells++;
+                }
+                continue;
+            }
+
+            int16_t colors[6], supports[6];
+            int nc = 0, ns = 0;
+            pb_offset neighbors[6];
+            pb_hex_neighbors_offset((pb_offset){row, col}, neighbors);
+            for (int i = 0; i < 6; i++) {
+                if (!pb_board_in_bounds(board, neighbors[i])) {
+                    continue;
+                }
+                int16_t cl = out->color_label[neighbors[i].row][neighbors[i].col];
+                int16_t sl = out->support_label[neighbors[i].row][neighbors[i].col];
+                if (cl != PB_LABEL_NONE) colors[nc++] = cl;
+                if (sl != PB_LABEL_NONE) supports[ns++] = sl;
+            }
+            cc_add_liberty(out->colors, colors, nc);
+            cc_add_liberty(out->supports, supports, ns);
+        }
+    }
+
+    return out->color_count;
+}
+
+int pb_board_largest_cluster(const pb_board* board)
+{
+    int16_t parent[PB_MAX_ROWS * PB_MAX_COLS];
+    int16_t size[PB_MAX_ROWS * PB_MAX_COLS];
+    int largest = 0;
+
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            int idx = CC_INDEX(row, col);
+            parent[idx] = (int16_t)idx;
+            size[idx] = 0;
+            if (b->kind != PB_KIND_COLORED) {
+                continue;
+            }
+
+            pb_offset neighbors[6];
+            pb_hex_neighbors_offset((pb_offset){row, col}, neighbors);
+            for (int i = 0; i < 6; i++) {
+                pb_offset n = neighbors[i];
+                if (n.row > row || (n.row == row && n.col > col) ||
+                    !pb_board_in_bounds(board, n)) {
+                    continue;
+                }
+                const pb_bubble* nb = &board->cells[n.row][n.col];
+                if (nb->kind == PB_KIND_COLORED && nb->color_id == b->color_id) {
+                    cc_union(parent, idx, CC_INDEX(n.row, n.col));
+                }
+            }
+        }
+    }
+
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            if (board->cells[row][col].kind != PB_KIND_COLORED) {
+                continue;
+            }
+            int root = cc_find(parent, CC_INDEX(row, col));
+            if (++size[root] > largest) {
+                largest = size[root];
+            }
+        }
+    }
+    return largest;
+}
+
 /*============================================================================
  * Batch Operations
  *============================================================================*/
@@ -477,5 +875,46 @@ bool pb_board_insert_row(pb_board* board, pb_rng* rng, uint8_t allowed_colors)
         };
     }
 
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    if (board->track_neighbors) {
+        nb_rebuild(board);
+    }
+#endif
+
     return !will_overflow;
 }
+
+bool pb_board_scroll_down(pb_board* board, int rows)
+{
+    if (rows < 0 || rows > board->rows || (rows & 1)) {
+        return false;
+    }
+    if (rows == 0) {
+        return true;
+    }
+
+    bool overflow = false;
+    for (int row = board->rows - rows; row < board->rows && !overflow; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            if (board->cells[row][col].kind != PB_KIND_NONE) {
+                overflow = true;
+                break;
+            }
+        }
+    }
+
+    /* Whole rows move; parity (and so each row's width) is preserved */
+    size_t keep = (size_t)(board->rows - rows);
+    memmove(&board->cells[rows][0], &board->cells[0][0],
+            keep * sizeof(board->cells[0]));
+    memset(&board->cells[0][0], 0, (size_t)rows * sizeof(board->cells[0]));
+
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    if (board->track_neighbors) {
+        nb_rebuild(board);
+    }
+#endif
+
+    return !overflow;
+}
@@ -0,0 +1,362 @@
+/*
+ * pb_canon.c - Board canonicalization under mirroring and color relabeling
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_canon.h"
+
+#include <stdlib.h>
+#include "pb/pb_freestanding.h"
+
+/* Flags that describe the bubble rather than an in-progress traversal */
+#define CANON_PERSISTENT_FLAGS  0x3Fu
+
+#define FNV_OFFSET  14695981039346656037ULL
+#define FNV_PRIME   1099511628211ULL
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static bool is_relabeled_kind(pb_bubble_kind kind)
+{
+    return kind == PB_KIND_COLORED || kind == PB_KIND_SPECIAL;
+}
+
+/* Everything that distinguishes two bubbles, with the color remapped
+ * through map (NULL = as stored) */
+static uint64_t cell_code(const pb_bubble* b, const uint8_t* map)
+{
+    if (b->kind == PB_KIND_NONE) {
+        return 0;
+    }
+
+    uint8_t color = b->color_id;
+    if (map && is_relabeled_kind(b->kind) && color < PB_MAX_COLORS) {
+        color = map[color];
+    }
+    return ((uint64_t)b->kind << 32) |
+           ((uint64_t)(b->special & 0xFF) << 24) |
+           ((uint64_t)(b->flags & CANON_PERSISTENT_FLAGS) << 16) |
+           ((uint64_t)b->payload.timer << 8) |
+           color;
+}
+
+static bool contains_special(const pb_board* board, const pb_bubble* queue,
+                             int queue_length, pb_special_type special)
+{
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            if (b->kind == PB_KIND_SPECIAL && b->special == special) {
+                return true;
+            }
+        }
+    }
+    for (int i = 0; i < queue_length; i++) {
+        if (queue[i].kind == PB_KIND_SPECIAL && queue[i].special == special) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void note_color(const pb_bubble* b, uint8_t* map, int* next)
+{
+    if (is_relabeled_kind(b->kind) && b->color_id < PB_MAX_COLORS &&
+        map[b->color_id] == PB_CANON_NO_COLOR) {
+        map[b->color_id] = (uint8_t)(*next)++;
+    }
+}
+
+/* Label colors by first appearance in the (possibly mirrored) scan order */
+static void build_map(const pb_board* board, const pb_bubble* queue,
+                      int queue_length, bool mirror, bool relabel,
+                      uint8_t map[PB_MAX_COLORS])
+{
+    if (!relabel) {
+        for (int c = 0; c < PB_MAX_COLORS; c++) map[c] = (uint8_t)c;
+        return;
+    }
+
+    memset(map, PB_CANON_NO_COLOR, PB_MAX_COLORS);
+    int next = 0;
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            int src = mirror ? cols - 1 - col : col;
+            note_color(&board->cells[row][src], map, &next);
+        }
+    }
+    for (int i = 0; i < queue_length; i++) {
+        note_color(&queue[i], map, &next);
+    }
+}
+
+/* Is the mirrored orientation strictly smaller than the original? */
+static bool mirror_is_smaller(const pb_board* board, const pb_bubble* queue,
+                              int queue_length, const uint8_t* map_id,
+                              const uint8_t* map_mirror)
+{
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            uint64_t a = cell_code(&board->cells[row][col], map_id);
+            uint64_t b = cell_code(&board->cells[row][cols - 1 - col], map_mirror);
+            if (a != b) {
+                return b < a;
+            }
+        }
+    }
+    for (int i = 0; i < queue_length; i++) {
+        uint64_t a = cell_code(&queue[i], map_id);
+        uint64_t b = cell_code(&queue[i], map_mirror);
+        if (a != b) {
+            return b < a;
+        }
+    }
+    return false;
+}
+
+static pb_bubble remap_bubble(const pb_bubble* b, const uint8_t* map)
+{
+    pb_bubble out = *b;
+    if (b->kind == PB_KIND_NONE) {
+        memset(&out, 0, sizeof(out));
+    } else if (is_relabeled_kind(b->kind) && b->color_id < PB_MAX_COLORS) {
+        out.color_id = map[b->color_id];
+    }
+    return out;
+}
+
+static uint64_t mix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t form_hash(const pb_canon_form* form)
+{
+    const pb_board* board = &form->board;
+    uint64_t h = FNV_OFFSET;
+
+    h = (h ^ (uint64_t)board->cols_even) * FNV_PRIME;
+    h = (h ^ (uint64_t)board->cols_odd) * FNV_PRIME;
+    h = (h ^ (uint64_t)board->rows) * FNV_PRIME;
+    h = (h ^ (uint64_t)board->ceiling_row) * FNV_PRIME;
+
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            h = (h ^ cell_code(&board->cells[row][col], NULL)) * FNV_PRIME;
+        }
+    }
+    h = (h ^ (uint64_t)form->queue_length) * FNV_PRIME;
+    for (int i = 0; i < form->queue_length; i++) {
+        h = (h ^ cell_code(&form->queue[i], NULL)) * FNV_PRIME;
+    }
+
+    return mix64(h);
+}
+
+/*============================================================================
+ * Canonical Form
+ *============================================================================*/
+
+bool pb_canon_can_mirror(const pb_board* board)
+{
+    return board && board->cols_odd == board->cols_even - 1;
+}
+
+pb_offset pb_canon_mirror_cell(const pb_board* board, pb_offset cell)
+{
+    int cols = pb_row_cols(cell.row, board->cols_even, board->cols_odd);
+    pb_offset out = {cell.row, cols - 1 - cell.col};
+    return out;
+}
+
+pb_offset pb_canon_map_cell(const pb_canon_form* form, pb_offset cell)
+{
+    return form->mirrored ? pb_canon_mirror_cell(&form->board, cell) : cell;
+}
+
+pb_result pb_canon_compute(const pb_board* board, const pb_bubble* queue,
+                           int queue_length, pb_canon_form* out)
+{
+    if (!board || !out || queue_length < 0 || queue_length > PB_MAX_QUEUE ||
+        (queue_length > 0 && !queue)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    bool relabel = !contains_special(board, queue, queue_length, PB_SPECIAL_SHIFTER);
+    bool mirror = pb_canon_can_mirror(board) &&
+                  !contains_special(board, queue, queue_length, PB_SPECIAL_PORTAL);
+
+    uint8_t map[PB_MAX_COLORS];
+    build_map(board, queue, queue_length, false, relabel, map);
+    out->mirrored = false;
+
+    if (mirror) {
+        uint8_t map_mirror[PB_MAX_COLORS];
+        build_map(board, queue, queue_length, true, relabel, map_mirror);
+        if (mirror_is_smaller(board, queue, queue_length, map, map_mirror)) {
+            memcpy(map, map_mirror, sizeof(map));
+            out->mirrored = true;
+        }
+    }
+
+    pb_board_init_custom(&out->board, board->rows, board->cols_even, board->cols_odd);
+    out->board.ceiling_row = board->ceiling_row;
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            int src = out->mirrored ? cols - 1 - col : col;
+            out->board.cells[row][col] = remap_bubble(&board->cells[row][src], map);
+        }
+    }
+
+    out->queue_length = queue_length;
+    for (int i = 0; i < queue_length; i++) {
+        out->queue[i] = remap_bubble(&queue[i], map);
+    }
+
+    memcpy(out->color_map, map, sizeof(map));
+    memset(out->color_unmap, PB_CANON_NO_COLOR, sizeof(out->color_unmap));
+    for (int c = 0; c < PB_MAX_COLORS; c++) {
+        if (map[c] != PB_CANON_NO_COLOR) {
+            out->color_unmap[map[c]] = (uint8_t)c;
+        }
+    }
+
+    out->hash = form_hash(out);
+    return PB_OK;
+}
+
+uint64_t pb_canon_hash(const pb_board* board, const pb_bubble* queue,
+                       int queue_length)
+{
+    pb_canon_form form;
+    if (pb_canon_compute(board, queue, queue_length, &form) != PB_OK) {
+        return 0;
+    }
+    return form.hash;
+}
+
+/*============================================================================
+ * Canonical Hash Index
+ *============================================================================*/
+
+static int index_slot(const pb_canon_index* index, uint64_t hash)
+{
+    uint32_t mask = (uint32_t)index->capacity - 1;
+    uint32_t i = (uint32_t)mix64(hash) & mask;
+    while (index->ids[i] >= 0 && index->hashes[i] != hash) {
+        i = (i + 1) & mask;
+    }
+    return (int)i;
+}
+
+static pb_result index_alloc(pb_canon_index* index, int capacity)
+{
+    index->hashes = malloc((size_t)capacity * sizeof(uint64_t));
+    index->ids = malloc((size_t)capacity * sizeof(int));
+    if (!index->hashes || !index->ids) {
+        free(index->hashes);
+        free(index->ids);
+        index->hashes = NULL;
+        index->ids = NULL;
+        return PB_ERR_NO_MEMORY;
+    }
+    for (int i = 0; i < capacity; i++) {
+        index->ids[i] = -1;
+    }
+    index->capacity = capacity;
+    index->count = 0;
+    return PB_OK;
+}
+
+pb_result pb_canon_index_init(pb_canon_index* index, int expected)
+{
+    if (!index || expected < 0 || expected > (1 << 28)) {
+        return PB_ERR_INVALID_ARG;
+    }
+    memset(index, 0, sizeof(*index));
+
+    int capacity = 16;
+    while (capacity < expected * 2) {
+        capacity *= 2;
+    }
+    return index_alloc(index, capacity);
+}
+
+void pb_canon_index_free(pb_canon_index* index)
+{
+    if (!index) return;
+    free(index->hashes);
+    free(index->ids);
+    memset(index, 0, sizeof(*index));
+}
+
+int pb_canon_index_find(const pb_canon_index* index, uint64_t hash)
+{
+    if (!index || !index->ids) {
+        return -1;
+    }
+    return index->ids[index_slot(index, hash)];
+}
+
+static pb_result index_grow(pb_canon_index* index)
+{
+    pb_canon_index old = *index;
+    pb_result r = index_alloc(index, old.capacity * 2);
+    if (r != PB_OK) {
+        *index = old;
+        return r;
+    }
+    for (int i = 0; i < old.capacity; i++) {
+        if (old.ids[i] >= 0) {
+            int slot = index_slot(index, old.hashes[i]);
+            index->hashes[slot] = old.hashes[i];
+            index->ids[slot] = old.ids[i];
+            index->count++;
+        }
+    }
+    free(old.hashes);
+    free(old.ids);
+    return PB_OK;
+}
+
+pb_result pb_canon_index_insert(pb_canon_index* index, uint64_t hash, int id,
+                                int* out_existing)
+{
+    if (!index || !index->ids || id < 0) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    int slot = index_slot(index, hash);
+    if (index->ids[slot] >= 0) {
+        if (out_existing) *out_existing = index->ids[slot];
+        return PB_OK;
+    }
+
+    /* Keep the load factor at or below one half */
+    if ((index->count + 1) * 2 > index->capacity) {
+        pb_result r = index_grow(index);
+        if (r != PB_OK) {
+            return r;
+        }
+        slot = index_slot(index, hash);
+    }
+
+    index->hashes[slot] = hash;
+    index->ids[slot] = id;
+    index->count++;
+    if (out_existing) *out_existing = -1;
+    return PB_OK;
+}
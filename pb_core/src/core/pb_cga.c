@@ -0,0 +1,271 @@
+/*
+ * pb_cga.c - CGA composite artifact-color output filter
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_cga.h"
+#include "pb/pb_freestanding.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct pb_cga_composite {
+    pb_cga_config config;
+    uint8_t rgbi[PB_PALETTE_SIZE];                      /* Index -> RGBI */
+    uint8_t levels[PB_PALETTE_SIZE][PB_CGA_PHASES];     /* Index -> level */
+    uint32_t lut[PB_CGA_PHASES][PB_CGA_WINDOWS];        /* Decoded RGBA */
+};
+
+/*============================================================================
+ * RGBI Colors
+ *============================================================================*/
+
+/* Canonical RGBI to RGB (IBM 5153 digital input, brown fixed up) */
+static const pb_palette_entry cga_rgb[PB_CGA_COLORS] = {
+    {0x00, 0x00, 0x00, 0}, {0x00, 0x00, 0xAA, 0}, {0x00, 0xAA, 0x00, 0}, {0x00, 0xAA, 0xAA, 0},
+    {0xAA, 0x00, 0x00, 0}, {0xAA, 0x00, 0xAA, 0}, {0xAA, 0x55, 0x00, 0}, {0xAA, 0xAA, 0xAA, 0},
+    {0x55, 0x55, 0x55, 0}, {0x55, 0x55, 0xFF, 0}, {0x55, 0xFF, 0x55, 0}, {0x55, 0xFF, 0xFF, 0},
+    {0xFF, 0x55, 0x55, 0}, {0xFF, 0x55, 0xFF, 0}, {0xFF, 0xFF, 0x55, 0}, {0xFF, 0xFF, 0xFF, 0},
+};
+
+/* Declared in pb_render.h: the 16 RGBI colors repeated over the palette */
+void pb_palette_init_cga(pb_palette* pal)
+{
+    if (!pal) return;
+    memset(pal, 0, sizeof(*pal));
+    for (int i = 0; i < PB_PALETTE_SIZE; i++) {
+        pal->colors[i] = cga_rgb[i % PB_CGA_COLORS];
+    }
+    memcpy(pal->name, "CGA", 4);
+}
+
+/*============================================================================
+ * Composite Encoding
+ *============================================================================*/
+
+/* Chroma multiplexer phase per color, degrees (Reenigne model) */
+static const float chroma_phase[PB_CGA_COLORS] = {
+    0, 240, 120, 180, 0, 300, 60, 0, 0, 240, 120, 180, 0, 300, 60, 0,
+};
+
+/* Extra delay through the multiplexer per color, ns */
+static const float chroma_delay[PB_CGA_COLORS] = {
+    0, 35.0f, 44.5f, 39.5f, 35.0f, 35.0f, 44.5f, 0, 0, 35.0f, 44.5f, 39.5f, 35.0f,
+    35.0f, 44.5f, 0,
+};
+
+/* Subcarrier degrees per ns (360 degrees per 279.4ns cycle) */
+#define DEG_PER_NS (567.0f / 440.0f)
+
+#define DEG_TO_RAD (3.14159265f / 180.0f)
+
+static float overlap(float a0, float a1, float b0, float b1)
+{
+    float lo = a0 > b0 ? a0 : b0;
+    float hi = a1 < b1 ? a1 : b1;
+    return hi > lo ? hi - lo : 0.0f;
+}
+
+/* Fraction of a pixel (a quarter cycle) the color's chroma wave is high */
+static float chroma_duty(int rgbi, int phase)
+{
+    if (rgbi == 0 || rgbi == 8) return 0.0f;
+    if (rgbi == 7 || rgbi == 15) return 1.0f;
+
+    float start = chroma_phase[rgbi] + chroma_delay[rgbi] * DEG_PER_NS;
+    float a0 = (float)phase * 90.0f;
+    float high = 0.0f;
+    for (int k = -1; k <= 1; k++) {
+        float b0 = start + 360.0f * (float)k;
+        high += overlap(a0, a0 + 90.0f, b0, b0 + 180.0f);
+    }
+    return high / 90.0f;
+}
+
+/* Composite level (0..PB_CGA_LEVELS-1) of a color at a sample phase */
+static uint8_t sample_level(pb_cga_variant variant, int rgbi, int phase)
+{
+    float c = chroma_duty(rgbi, phase);
+    float r = (float)((rgbi >> 2) & 1);
+    float g = (float)((rgbi >> 1) & 1);
+    float b = (float)(rgbi & 1);
+    float i = (float)((rgbi >> 3) & 1);
+
+    float v = (variant == PB_CGA_NEW)
+        ? 0.29f * c + 0.10f * r + 0.22f * g + 0.07f * b + 0.32f * i
+        : 0.72f * c + 0.28f * i;
+    return (uint8_t)(v * (float)(PB_CGA_LEVELS - 1) + 0.5f);
+}
+
+static void build_levels(pb_cga_composite* cga)
+{
+    for (int i = 0; i < PB_PALETTE_SIZE; i++) {
+        for (int p = 0; p < PB_CGA_PHASES; p++) {
+            cga->levels[i][p] = sample_level(cga->config.variant, cga->rgbi[i], p);
+        }
+    }
+}
+
+/*============================================================================
+ * Composite Decoding
+ *============================================================================*/
+
+/* NTSC red sits 19.5 degrees into the IQ plane */
+#define RED_IQ_DEG 19.5f
+
+static uint8_t to_byte(float v)
+{
+    if (v <= 0.0f) return 0;
+    if (v >= 1.0f) return 255;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+/*
+ * Decode pixel x from the window of samples x-1 .. x+2 (oldest in the
+ * top nibble of the key), x being at subcarrier phase p.
+ */
+static uint32_t decode_window(const pb_cga_config* config, float cos_h, float sin_h,
+                              int p, unsigned key)
+{
+    float y = 0.0f, cx = 0.0f, cy = 0.0f;
+    for (int k = 0; k < PB_CGA_PHASES; k++) {
+        float v = (float)((key >> (12 - 4 * k)) & 15) / (float)(PB_CGA_LEVELS - 1);
+        float theta = ((float)((p + k + 3) & 3) * 90.0f + 45.0f) * DEG_TO_RAD;
+        y += v;
+        cx += v * pb_cosf(theta);
+        cy += v * pb_sinf(theta);
+    }
+    y *= 1.0f / PB_CGA_PHASES;
+    cx *= 2.0f / PB_CGA_PHASES;
+    cy *= 2.0f / PB_CGA_PHASES;
+
+    /* Reference phase: IQ hue = reference - carrier phase */
+    float i = (cos_h * cx + sin_h * cy) * config->saturation;
+    float q = (sin_h * cx - cos_h * cy) * config->saturation;
+    y = (y - 0.5f) * config->contrast + 0.5f + config->brightness;
+
+    uint8_t r = to_byte(y + 0.956f * i + 0.621f * q);
+    uint8_t g = to_byte(y - 0.272f * i - 0.647f * q);
+    uint8_t b = to_byte(y - 1.106f * i + 1.703f * q);
+    return ((uint32_t)r << 24) | ((uint32_t)g << 16) | ((uint32_t)b << 8) | 0xFFu;
+}
+
+static void build_lut(pb_cga_composite* cga)
+{
+    /* Solid red (a wave centered 90 degrees after it starts) decodes to
+     * NTSC red */
+    float ref = RED_IQ_DEG + 90.0f + chroma_phase[4] + chroma_delay[4] * DEG_PER_NS +
+                cga->config.hue;
+    float cos_h = pb_cosf(ref * DEG_TO_RAD);
+    float sin_h = pb_sinf(ref * DEG_TO_RAD);
+
+    for (int p = 0; p < PB_CGA_PHASES; p++) {
+        for (unsigned key = 0; key < PB_CGA_WINDOWS; key++) {
+            cga->lut[p][key] = decode_window(&cga->config, cos_h, sin_h, p, key);
+        }
+    }
+}
+
+/*============================================================================
+ * Decoder
+ *============================================================================*/
+
+void pb_cga_config_default(pb_cga_config* config)
+{
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->variant = PB_CGA_OLD;
+    config->saturation = 1.0f;
+    config->contrast = 1.0f;
+}
+
+pb_cga_composite* pb_cga_composite_create(const pb_cga_config* config)
+{
+    pb_cga_composite* cga = calloc(1, sizeof(*cga));
+    if (!cga) return NULL;
+
+    for (int i = 0; i < PB_PALETTE_SIZE; i++) {
+        cga->rgbi[i] = (uint8_t)(i & (PB_CGA_COLORS - 1));
+    }
+    pb_cga_config defaults;
+    if (!config) {
+        pb_cga_config_default(&defaults);
+        config = &defaults;
+    }
+    pb_cga_composite_configure(cga, config);
+    return cga;
+}
+
+void pb_cga_composite_destroy(pb_cga_composite* cga)
+{
+    free(cga);
+}
+
+void pb_cga_composite_configure(pb_cga_composite* cga, const pb_cga_config* config)
+{
+    if (!cga || !config) return;
+    cga->config = *config;
+    cga->config.phase &= PB_CGA_PHASES - 1;
+    build_levels(cga);
+    build_lut(cga);
+}
+
+void pb_cga_composite_set_index(pb_cga_composite* cga, uint8_t index, uint8_t rgbi)
+{
+    if (!cga) return;
+    cga->rgbi[index] = rgbi & (PB_CGA_COLORS - 1);
+    for (int p = 0; p < PB_CGA_PHASES; p++) {
+        cga->levels[index][p] = sample_level(cga->config.variant, cga->rgbi[index], p);
+    }
+}
+
+void pb_cga_composite_map_palette(pb_cga_composite* cga, const pb_palette* pal)
+{
+    if (!cga || !pal) return;
+    for (int i = 0; i < PB_PALETTE_SIZE; i++) {
+        const pb_palette_entry* c = &pal->colors[i];
+        int best = 0, best_dist = 0x7FFFFFFF;
+        for (int k = 0; k < PB_CGA_COLORS; k++) {
+            int dr = c->r - cga_rgb[k].r;
+            int dg = c->g - cga_rgb[k].g;
+            int db = c->b - cga_rgb[k].b;
+            int dist = dr * dr + dg * dg + db * db;
+            if (dist < best_dist) {
+                best_dist = dist;
+                best = k;
+            }
+        }
+        cga->rgbi[i] = (uint8_t)best;
+    }
+    build_levels(cga);
+}
+
+void pb_cga_composite_present(const pb_cga_composite* cga, const uint8_t* pixels,
+                              int width, int height, uint32_t* rgba)
+{
+    if (!cga || !pixels || !rgba || width <= 0 || height <= 0) return;
+    const int phase = cga->config.phase;
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels + (size_t)y * (size_t)width;
+        uint32_t* out = rgba + (size_t)y * (size_t)width;
+
+        /* Prime the window with samples -1 (black) .. 2 */
+        unsigned key = 0;
+        for (int x = 0; x < 3; x++) {
+            unsigned level = x < width ? cga->levels[row[x]][(x + phase) & 3] : 0;
+            key = (key << 4) | level;
+        }
+
+        int x = 0;
+        for (; x + 3 < width; x++) {
+            out[x] = cga->lut[(x + phase) & 3][key];
+            key = ((key << 4) | cga->levels[row[x + 3]][(x + 3 + phase) & 3]) & 0xFFFFu;
+        }
+        for (; x < width; x++) {
+            out[x] = cga->lut[(x + phase) & 3][key];
+            key = (key << 4) & 0xFFFFu;
+        }
+    }
+}
@@ -7,45 +7,49 @@
 
 #include "pb/pb_checksum.h"
 #include "pb/pb_board.h"
+#include "pb/pb_tables.h"
 
 
 /*============================================================================
- * CRC-32 Table (ISO-HDLC polynomial 0xEDB88320)
+ * CRC-32 (ISO-HDLC polynomial 0xEDB88320)
+ *
+ * Tables come from pb_tables.c (generated, immutable), so checksums may run
+ * on any number of threads at once.
  *============================================================================*/
 
-static uint32_t crc32_table[256];
-static bool crc32_table_initialized = false;
-
 void pb_crc32_init(void)
 {
-    if (crc32_table_initialized) return;
-
-    for (uint32_t i = 0; i < 256; i++) {
-        uint32_t crc = i;
-        for (int j = 0; j < 8; j++) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ 0xEDB88320;
-            } else {
-                crc >>= 1;
-            }
-        }
-        crc32_table[i] = crc;
-    }
-
-    crc32_table_initialized = true;
+    /* Table is constant; kept for API compatibility */
 }
 
 uint32_t pb_crc32_update(uint32_t crc, const void* data, size_t len)
 {
-    if (!crc32_table_initialized) {
-        pb_crc32_init();
-    }
-
     const uint8_t* buf = (const uint8_t*)data;
     crc ^= 0xFFFFFFFF;
 
+#if PB_CRC32_SLICES == 8
+    /* Slice-by-8: eight table lookups per 8 bytes, no serial byte chain.
+     * Byte loads keep it alignment- and endian-neutral. */
+    while (len >= 8) {
+        uint32_t lo = crc ^ ((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+                             ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24));
+        uint32_t hi = (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) |
+                      ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 24);
+        crc = pb_crc32_table[7][lo & 0xFF] ^
+              pb_crc32_table[6][(lo >> 8) & 0xFF] ^
+              pb_crc32_table[5][(lo >> 16) & 0xFF] ^
+              pb_crc32_table[4][lo >> 24] ^
+              pb_crc32_table[3][hi & 0xFF] ^
+              pb_crc32_table[2][(hi >> 8) & 0xFF] ^
+              pb_crc32_table[1][(hi >> 16) & 0xFF] ^
+              pb_crc32_table[0][hi >> 24];
+        buf += 8;
+        len -= 8;
+    }
+#endif
+
     for (size_t i = 0; i < len; i++) {
-        crc = (crc >> 8) ^ crc32_table[(crc ^ buf[i]) & 0xFF];
+        crc = (crc >> 8) ^ pb_crc32_table[0][(crc ^ buf[i]) & 0xFF];
     }
 
     return crc ^ 0xFFFFFFFF;
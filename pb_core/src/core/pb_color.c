@@ -8,6 +8,7 @@
 
 #include "pb/pb_color.h"
 #include "pb/pb_freestanding.h"
+#include "pb/pb_tables.h"
 
 #include <ctype.h>
 
@@ -180,7 +181,20 @@ pb_rgb8 pb_rgb_to_rgb8(pb_rgb c) {
  * Gamma Conversions
  * ============================================================================ */
 
+/* Channels that came from 8-bit values (the common case) hit the table */
+static bool srgb8_lookup(float c, float* out) {
+    if (!(c >= 0.0f && c <= 1.0f)) return false;
+    int i = (int)(c * 255.0f + 0.5f);
+    if ((float)i / 255.0f != c) return false;
+    *out = pb_srgb8_linear[i];
+    return true;
+}
+
 static float srgb_to_linear_channel(float c) {
+    float lin;
+    if (srgb8_lookup(c, &lin)) {
+        return lin;
+    }
     if (c <= SRGB_GAMMA_THRESHOLD) {
         return c / SRGB_LINEAR_SCALE;
     }
@@ -202,6 +216,14 @@ pb_linear_rgb pb_srgb_to_linear(pb_rgb srgb) {
     return out;
 }
 
+pb_linear_rgb pb_rgb8_to_linear(pb_rgb8 c) {
+    pb_linear_rgb out;
+    out.r = pb_srgb8_linear[c.r];
+    out.g = pb_srgb8_linear[c.g];
+    out.b = pb_srgb8_linear[c.b];
+    return out;
+}
+
 pb_rgb pb_linear_to_srgb(pb_linear_rgb linear) {
     pb_rgb out;
     out.r = linear_to_srgb_channel(linear.r);
@@ -308,7 +330,12 @@ void pb_oklch_to_hex(pb_oklch lch, char* out) {
  * ============================================================================ */
 
 static float wcag_srgb_to_linear_channel(float c) {
-    /* WCAG uses 0.03928 threshold (historical spec) */
+    /* WCAG uses 0.03928 threshold (historical spec). No 8-bit value lies
+     * between it and 0.04045, so the sRGB table serves both. */
+    float lin;
+    if (srgb8_lookup(c, &lin)) {
+        return lin;
+    }
     if (c <= WCAG_GAMMA_THRESHOLD) {
         return c / SRGB_LINEAR_SCALE;
     }
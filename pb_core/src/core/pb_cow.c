@@ -0,0 +1,396 @@
+/*
+ * pb_cow.c - Copy-on-write boards with reference-counted shared rows
+ *
+ * A row block is immutable while its count is above one. A board whose
+ * count on a row is exactly one owns that row and writes it in place; the
+ * acquire load in row_refs() pairs with the acq_rel decrement in
+ * row_drop() by the last other owner, so its final reads happen before
+ * our writes.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_cow.h"
+
+#include <stdlib.h>
+#include "pb/pb_freestanding.h"
+
+#if PB_FEATURE_THREADS && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define COW_ATOMIC 1
+#else
+#define COW_ATOMIC 0
+#endif
+
+/*============================================================================
+ * Row Blocks
+ *============================================================================*/
+
+struct pb_cow_row {
+#if COW_ATOMIC
+    atomic_int refs;
+#else
+    int refs;
+#endif
+    pb_bubble cells[PB_MAX_COLS];
+};
+
+static const pb_bubble empty_cell;
+
+static pb_cow_row* row_alloc(const pb_bubble* cells)
+{
+    pb_cow_row* r = malloc(sizeof(*r));
+    if (!r) {
+        return NULL;
+    }
+#if COW_ATOMIC
+    atomic_init(&r->refs, 1);
+#else
+    r->refs = 1;
+#endif
+    if (cells) {
+        memcpy(r->cells, cells, sizeof(r->cells));
+    } else {
+        memset(r->cells, 0, sizeof(r->cells));
+    }
+    return r;
+}
+
+static void row_retain(pb_cow_row* r)
+{
+#if COW_ATOMIC
+    atomic_fetch_add_explicit(&r->refs, 1, memory_order_relaxed);
+#else
+    r->refs++;
+#endif
+}
+
+static void row_drop(pb_cow_row* r)
+{
+    if (!r) return;
+#if COW_ATOMIC
+    if (atomic_fetch_sub_explicit(&r->refs, 1, memory_order_acq_rel) == 1) {
+        free(r);
+    }
+#else
+    if (--r->refs == 0) {
+        free(r);
+    }
+#endif
+}
+
+static int row_refs(const pb_cow_row* r)
+{
+#if COW_ATOMIC
+    return atomic_load_explicit(&((pb_cow_row*)r)->refs, memory_order_acquire);
+#else
+    return r->refs;
+#endif
+}
+
+static bool row_is_empty(const pb_cow_row* r, int cols)
+{
+    for (int col = 0; col < cols; col++) {
+        if (r->cells[col].kind != PB_KIND_NONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Cells of `row` ready for writing: allocated, and cloned if shared */
+static pb_bubble* row_mutable(pb_cow_board* cow, int row)
+{
+    pb_cow_row* r = cow->row[row];
+    if (!r) {
+        r = row_alloc(NULL);
+    } else if (row_refs(r) > 1) {
+        pb_cow_row* copy = row_alloc(r->cells);
+        if (copy) {
+            row_drop(r);
+        }
+        r = copy;
+    }
+    if (!r) {
+        return NULL;
+    }
+    cow->row[row] = r;
+    return r->cells;
+}
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static bool cow_in_bounds(const pb_cow_board* cow, pb_offset pos)
+{
+    return pb_offset_in_bounds(pos, cow->rows, cow->cols_even, cow->cols_odd);
+}
+
+static const pb_bubble* cow_cell(const pb_cow_board* cow, int row, int col)
+{
+    const pb_cow_row* r = cow->row[row];
+    return r ? &r->cells[col] : &empty_cell;
+}
+
+static bool is_support(const pb_bubble* b)
+{
+    return b->kind != PB_KIND_NONE && !(b->flags & PB_FLAG_GHOST);
+}
+
+/* Same acceptance rule as pb_find_matches() */
+static bool matches_color(const pb_bubble* b, uint8_t color_id)
+{
+    return (b->kind == PB_KIND_COLORED && b->color_id == color_id) ||
+           b->kind == PB_KIND_WILDCARD ||
+           (b->kind == PB_KIND_SPECIAL && b->special == PB_SPECIAL_RAINBOW);
+}
+
+/*============================================================================
+ * Lifetime
+ *============================================================================*/
+
+pb_result pb_cow_from_board(pb_cow_board* out, const pb_board* board)
+{
+    if (!out || !board) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->cols_even = board->cols_even;
+    out->cols_odd = board->cols_odd;
+    out->rows = board->rows;
+    out->ceiling_row = board->ceiling_row;
+
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        bool empty = true;
+        for (int col = 0; col < cols && empty; col++) {
+            empty = board->cells[row][col].kind == PB_KIND_NONE;
+        }
+        if (empty) {
+            continue;
+        }
+        out->row[row] = row_alloc(board->cells[row]);
+        if (!out->row[row]) {
+            pb_cow_release(out);
+            return PB_ERR_NO_MEMORY;
+        }
+    }
+    return PB_OK;
+}
+
+void pb_cow_to_board(const pb_cow_board* cow, pb_board* out)
+{
+    pb_board_init_custom(out, cow->rows, cow->cols_even, cow->cols_odd);
+    out->ceiling_row = cow->ceiling_row;
+    for (int row = 0; row < cow->rows; row++) {
+        if (cow->row[row]) {
+            memcpy(out->cells[row], cow->row[row]->cells, sizeof(out->cells[row]));
+        }
+    }
+}
+
+void pb_cow_share(pb_cow_board* dst, const pb_cow_board* src)
+{
+    *dst = *src;
+    for (int row = 0; row < src->rows; row++) {
+        if (src->row[row]) {
+            row_retain(src->row[row]);
+        }
+    }
+}
+
+void pb_cow_release(pb_cow_board* cow)
+{
+    if (!cow) return;
+    for (int row = 0; row < PB_MAX_ROWS; row++) {
+        row_drop(cow->row[row]);
+        cow->row[row] = NULL;
+    }
+}
+
+/*============================================================================
+ * Cell Access
+ *============================================================================*/
+
+const pb_bubble* pb_cow_get(const pb_cow_board* cow, pb_offset pos)
+{
+    if (!cow_in_bounds(cow, pos)) {
+        return NULL;
+    }
+    return cow_cell(cow, pos.row, pos.col);
+}
+
+pb_result pb_cow_set(pb_cow_board* cow, pb_offset pos, pb_bubble bubble)
+{
+    if (!cow_in_bounds(cow, pos)) {
+        return PB_ERR_INVALID_ARG;
+    }
+    pb_bubble* cells = row_mutable(cow, pos.row);
+    if (!cells) {
+        return PB_ERR_NO_MEMORY;
+    }
+    cells[pos.col] = bubble;
+    return PB_OK;
+}
+
+pb_result pb_cow_remove(pb_cow_board* cow, pb_offset pos)
+{
+    if (!cow_in_bounds(cow, pos)) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (!cow->row[pos.row] || cow_cell(cow, pos.row, pos.col)->kind == PB_KIND_NONE) {
+        return PB_OK;
+    }
+    return pb_cow_set(cow, pos, empty_cell);
+}
+
+/*============================================================================
+ * Moves
+ *============================================================================*/
+
+pb_result pb_cow_play(pb_cow_board* cow, pb_offset cell, uint8_t color_id,
+                      int match_threshold, int* out_pops, int* out_drops,
+                      bool* out_survived)
+{
+    if (!cow || !cow_in_bounds(cow, cell)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    if (out_pops) *out_pops = 0;
+    if (out_drops) *out_drops = 0;
+    if (out_survived) *out_survived = true;
+
+    pb_bubble shot = {
+        .kind = PB_KIND_COLORED,
+        .color_id = color_id,
+        .flags = 0,
+        .special = PB_SPECIAL_NONE,
+        .payload = {0}
+    };
+    pb_result r = pb_cow_set(cow, cell, shot);
+    if (r != PB_OK) {
+        return r;
+    }
+
+    /* Match: BFS over read-only rows */
+    bool marked[PB_MAX_ROWS][PB_MAX_COLS];
+    pb_offset queue[PB_MAX_CELLS];
+    int head = 0, tail = 0;
+
+    memset(marked, 0, sizeof(marked));
+    marked[cell.row][cell.col] = true;
+    queue[tail++] = cell;
+    while (head < tail) {
+        pb_offset neighbors[6];
+        pb_hex_neighbors_offset(queue[head++], neighbors);
+        for (int i = 0; i < 6; i++) {
+            pb_offset n = neighbors[i];
+            if (!cow_in_bounds(cow, n) || marked[n.row][n.col] ||
+                !matches_color(cow_cell(cow, n.row, n.col), color_id)) {
+                continue;
+            }
+            marked[n.row][n.col] = true;
+            queue[tail++] = n;
+        }
+    }
+
+    int match_count = tail;
+    if (match_count < match_threshold) {
+        if (out_survived) *out_survived = cell.row < cow->rows - 1;
+        return PB_OK;
+    }
+
+    uint64_t touched = 0;
+    for (int i = 0; i < match_count; i++) {
+        r = pb_cow_remove(cow, queue[i]);
+        if (r != PB_OK) {
+            return r;
+        }
+        touched |= (uint64_t)1 << queue[i].row;
+    }
+
+    /* Anchored set: BFS from the ceiling row through non-ghost bubbles */
+    memset(marked, 0, sizeof(marked));
+    head = tail = 0;
+    int ceiling_cols = pb_row_cols(cow->ceiling_row, cow->cols_even, cow->cols_odd);
+    for (int col = 0; col < ceiling_cols; col++) {
+        if (is_support(cow_cell(cow, cow->ceiling_row, col))) {
+            marked[cow->ceiling_row][col] = true;
+            queue[tail++] = (pb_offset){cow->ceiling_row, col};
+        }
+    }
+    while (head < tail) {
+        pb_offset neighbors[6];
+        pb_hex_neighbors_offset(queue[head++], neighbors);
+        for (int i = 0; i < 6; i++) {
+            pb_offset n = neighbors[i];
+            if (!cow_in_bounds(cow, n) || marked[n.row][n.col] ||
+                !is_support(cow_cell(cow, n.row, n.col))) {
+                continue;
+            }
+            marked[n.row][n.col] = true;
+            queue[tail++] = n;
+        }
+    }
+
+    /* Drop everything unanchored except frozen bubbles */
+    int drops = 0;
+    for (int row = 0; row < cow->rows; row++) {
+        if (!cow->row[row]) continue;
+        int cols = pb_row_cols(row, cow->cols_even, cow->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = cow_cell(cow, row, col);
+            if (b->kind == PB_KIND_NONE || marked[row][col] ||
+                (b->flags & PB_FLAG_FROZEN)) {
+                continue;
+            }
+            r = pb_cow_remove(cow, (pb_offset){row, col});
+            if (r != PB_OK) {
+                return r;
+            }
+            touched |= (uint64_t)1 << row;
+            drops++;
+        }
+    }
+
+    /* Release rows the move emptied */
+    for (int row = 0; row < cow->rows; row++) {
+        if ((touched >> row) & 1) {
+            int cols = pb_row_cols(row, cow->cols_even, cow->cols_odd);
+            if (cow->row[row] && row_is_empty(cow->row[row], cols)) {
+                row_drop(cow->row[row]);
+                cow->row[row] = NULL;
+            }
+        }
+    }
+
+    if (out_pops) *out_pops = match_count;
+    if (out_drops) *out_drops = drops;
+    return PB_OK;
+}
+
+/*============================================================================
+ * Diagnostics
+ *============================================================================*/
+
+int pb_cow_row_refs(const pb_cow_board* cow, int row)
+{
+    if (!cow || row < 0 || row >= cow->rows || !cow->row[row]) {
+        return 0;
+    }
+    return row_refs(cow->row[row]);
+}
+
+int pb_cow_shared_rows(const pb_cow_board* a, const pb_cow_board* b)
+{
+    int shared = 0;
+    int rows = a->rows < b->rows ? a->rows : b->rows;
+    for (int row = 0; row < rows; row++) {
+        if (a->row[row] && a->row[row] == b->row[row]) {
+            shared++;
+        }
+    }
+    return shared;
+}
@@ -14,6 +14,7 @@
 
 #include "pb/pb_cvd.h"
 #include "pb/pb_freestanding.h"
+#include "pb/pb_tables.h"
 
 
 /* ============================================================================
@@ -111,6 +112,10 @@ static void vec3_lerp(const float a[3], const float b[3], float t, float out[3])
 
 /* Gamma functions (same as pb_color.c) */
 static float srgb_to_linear_channel(float c) {
+    if (c >= 0.0f && c <= 1.0f) {
+        int i = (int)(c * 255.0f + 0.5f);
+        if ((float)i / 255.0f == c) return pb_srgb8_linear[i];
+    }
     if (c <= 0.04045f) return c / 12.92f;
     return powf((c + 0.055f) / 1.055f, 2.4f);
 }
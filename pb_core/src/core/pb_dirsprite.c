@@ -0,0 +1,210 @@
+/*
+ * pb_dirsprite.c - Pre-rotated sprites keyed by direction index
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_dirsprite.h"
+#include "pb/pb_freestanding.h"
+
+#include <string.h>
+
+/*============================================================================
+ * Rotation
+ *============================================================================*/
+
+/*
+ * Direction d points at angle (12 + 2d) degrees, i.e. (cos, -sin) on
+ * screen. The rotation taking the source's up (0, -1) there is
+ *
+ *   dest = [ s  -c ] src        src = [  s  c ] dest
+ *          [ c   s ]                  [ -c  s ]
+ */
+static void dir_basis(int dir, float* c, float* s)
+{
+    *c = (float)pb_dir_cos_q16[dir] * (1.0f / 65536.0f);
+    *s = (float)pb_dir_sin_q16[dir] * (1.0f / 65536.0f);
+}
+
+/* Bilinear coverage at a continuous source position (0 outside) */
+static float sample_source(const pb_dirsprite_source* src, float u, float v)
+{
+    float fx = u - 0.5f;
+    float fy = v - 0.5f;
+    int x0 = (int)pb_floorf(fx);
+    int y0 = (int)pb_floorf(fy);
+    float tx = fx - (float)x0;
+    float ty = fy - (float)y0;
+
+    float texel[2][2];
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            int x = x0 + i, y = y0 + j;
+            texel[j][i] = (x >= 0 && y >= 0 && x < src->w && y < src->h)
+                ? (float)src->pixels[y * src->w + x] : 0.0f;
+        }
+    }
+    float top = texel[0][0] + (texel[0][1] - texel[0][0]) * tx;
+    float bottom = texel[1][0] + (texel[1][1] - texel[1][0]) * tx;
+    return top + (bottom - top) * ty;
+}
+
+static void render_cell(pb_dirsprite_atlas* atlas, int id, int dir)
+{
+    const pb_dirsprite_source* src = &atlas->sources[id];
+    const pb_dirsprite_cell* cell = &atlas->cells[id][dir];
+    const int n = PB_DIRSPRITE_SUPERSAMPLE;
+    const float step = 1.0f / (float)n;
+    float c, s;
+    dir_basis(dir, &c, &s);
+
+    float pivot_u = (float)src->pivot_x + 0.5f;
+    float pivot_v = (float)src->pivot_y + 0.5f;
+
+    for (int y = 0; y < cell->h; y++) {
+        uint8_t* dst = &atlas->pixels[(cell->y + y) * PB_DIRSPRITE_ATLAS_W + cell->x];
+        for (int x = 0; x < cell->w; x++) {
+            float acc = 0.0f;
+            for (int sy = 0; sy < n; sy++) {
+                float oy = (float)(y - cell->pivot_y) + ((float)sy + 0.5f) * step - 0.5f;
+                for (int sx = 0; sx < n; sx++) {
+                    float ox = (float)(x - cell->pivot_x) + ((float)sx + 0.5f) * step - 0.5f;
+                    acc += sample_source(src, s * ox + c * oy + pivot_u,
+                                         -c * ox + s * oy + pivot_v);
+                }
+            }
+            dst[x] = (uint8_t)(acc / (float)(n * n) + 0.5f);
+        }
+    }
+    atlas->rendered[id][dir] = true;
+}
+
+/*============================================================================
+ * API
+ *============================================================================*/
+
+void pb_dirsprite_atlas_init(pb_dirsprite_atlas* atlas, bool lazy)
+{
+    if (!atlas) return;
+    memset(atlas, 0, sizeof(*atlas));
+    atlas->lazy = lazy;
+}
+
+pb_result pb_dirsprite_add(pb_dirsprite_atlas* atlas,
+                           const pb_dirsprite_source* source, int* id)
+{
+    if (!atlas || !source || !source->pixels || !id ||
+        source->w < 1 || source->h < 1 ||
+        source->w > PB_DIRSPRITE_MAX_SRC || source->h > PB_DIRSPRITE_MAX_SRC ||
+        source->pivot_x < 0 || source->pivot_x >= source->w ||
+        source->pivot_y < 0 || source->pivot_y >= source->h) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (atlas->sprite_count >= PB_DIRSPRITE_MAX_SPRITES) {
+        return PB_ERR_NO_MEMORY;
+    }
+
+    /* One cell size for every direction: the union of the rotated bounds */
+    float left = -((float)source->pivot_x + 0.5f);
+    float top = -((float)source->pivot_y + 0.5f);
+    float right = (float)source->w + left;
+    float bottom = (float)source->h + top;
+    const float corners[4][2] = {{left, top}, {right, top}, {left, bottom}, {right, bottom}};
+
+    float min_x = 0.0f, max_x = 0.0f, min_y = 0.0f, max_y = 0.0f;
+    for (int dir = 0; dir < PB_DIR_COUNT; dir++) {
+        float c, s;
+        dir_basis(dir, &c, &s);
+        for (int i = 0; i < 4; i++) {
+            float x = s * corners[i][0] - c * corners[i][1];
+            float y = c * corners[i][0] + s * corners[i][1];
+            if (x < min_x) min_x = x;
+            if (x > max_x) max_x = x;
+            if (y < min_y) min_y = y;
+            if (y > max_y) max_y = y;
+        }
+    }
+
+    /* A pixel of margin each side for the filter's reach */
+    int pivot_x = (int)-pb_floorf(min_x) + 1;
+    int pivot_y = (int)-pb_floorf(min_y) + 1;
+    int w = pivot_x + (int)-pb_floorf(-max_x) + 2;
+    int h = pivot_y + (int)-pb_floorf(-max_y) + 2;
+
+    /* Reserve every direction's cell up front (shelf packing, 1px gutter) */
+    pb_dirsprite_cell cells[PB_DIR_COUNT];
+    int x = atlas->shelf_x, y = atlas->shelf_y;
+    int shelf_h = atlas->shelf_h;
+    for (int dir = 0; dir < PB_DIR_COUNT; dir++) {
+        if (x + w + 1 > PB_DIRSPRITE_ATLAS_W) {
+            x = 0;
+            y += shelf_h;
+            shelf_h = 0;
+        }
+        if (y + h + 1 > PB_DIRSPRITE_ATLAS_H) return PB_ERR_NO_MEMORY;
+
+        cells[dir].x = (uint16_t)x;
+        cells[dir].y = (uint16_t)y;
+        cells[dir].w = (uint8_t)w;
+        cells[dir].h = (uint8_t)h;
+        cells[dir].pivot_x = (uint8_t)pivot_x;
+        cells[dir].pivot_y = (uint8_t)pivot_y;
+        x += w + 1;
+        if (h + 1 > shelf_h) shelf_h = h + 1;
+    }
+    atlas->shelf_x = x;
+    atlas->shelf_y = y;
+    atlas->shelf_h = shelf_h;
+
+    int index = atlas->sprite_count++;
+    atlas->sources[index] = *source;
+    memcpy(atlas->cells[index], cells, sizeof(cells));
+
+    if (!atlas->lazy) {
+        for (int dir = 0; dir < PB_DIR_COUNT; dir++) {
+            render_cell(atlas, index, dir);
+        }
+        atlas->version++;
+    }
+    *id = index;
+    return PB_OK;
+}
+
+const pb_dirsprite_cell* pb_dirsprite_get(pb_dirsprite_atlas* atlas, int id,
+                                          int dir)
+{
+    if (!atlas || id < 0 || id >= atlas->sprite_count ||
+        dir < 0 || dir >= PB_DIR_COUNT) {
+        return NULL;
+    }
+    if (!atlas->rendered[id][dir]) {
+        render_cell(atlas, id, dir);
+        atlas->version++;
+    }
+    return &atlas->cells[id][dir];
+}
+
+int pb_dirsprite_render_all(pb_dirsprite_atlas* atlas)
+{
+    if (!atlas) return 0;
+    int rendered = 0;
+    for (int id = 0; id < atlas->sprite_count; id++) {
+        for (int dir = 0; dir < PB_DIR_COUNT; dir++) {
+            if (!atlas->rendered[id][dir]) {
+                render_cell(atlas, id, dir);
+                rendered++;
+            }
+        }
+    }
+    if (rendered > 0) atlas->version++;
+    return rendered;
+}
+
+int pb_dirsprite_dir(pb_scalar radians)
+{
+    float deg = PB_FIXED_TO_FLOAT(radians) * (180.0f / 3.14159265f);
+    int dir = (int)pb_floorf((deg - (float)PB_DIR_BASE_DEG) / (float)PB_DIR_STEP_DEG + 0.5f);
+    if (dir < PB_DIR_MIN) dir = PB_DIR_MIN;
+    if (dir > PB_DIR_MAX) dir = PB_DIR_MAX;
+    return dir;
+}
@@ -9,6 +9,7 @@
 
 #include "pb/pb_effect.h"
 #include "pb/pb_hex.h"
+#include <string.h>
 
 
 /*============================================================================
@@ -122,10 +123,6 @@ static const pb_effect_def* default_effects[PB_SPECIAL_COUNT] = {
     [PB_SPECIAL_LOCK] = NULL,    /* Handled in match logic */
 };
 
-/* Custom effect overrides */
-static pb_effect_def custom_effects[PB_SPECIAL_COUNT];
-static bool custom_effect_set[PB_SPECIAL_COUNT] = {false};
-
 /*============================================================================
  * Effect Registration
  *============================================================================*/
@@ -136,30 +133,46 @@ const pb_effect_def* pb_get_special_effect(pb_special_type special)
         return NULL;
     }
 
-    if (custom_effect_set[special]) {
-        return &custom_effects[special];
-    }
-
     return default_effects[special];
 }
 
-const pb_effect_def* pb_register_effect(pb_special_type special,
-                                        const pb_effect_def* effect)
+void pb_effect_registry_init(pb_effect_registry* registry)
 {
-    if (special >= PB_SPECIAL_COUNT) {
+    if (!registry) return;
+    memset(registry, 0, sizeof(*registry));
+}
+
+const pb_effect_def* pb_effect_registry_get(const pb_effect_registry* registry,
+                                            pb_special_type special)
+{
+    if (!registry || special >= PB_SPECIAL_COUNT) {
         return NULL;
     }
 
-    const pb_effect_def* previous = pb_get_special_effect(special);
+    if (registry->overridden[special]) {
+        return &registry->effects[special];
+    }
+
+    return default_effects[special];
+}
+
+pb_result pb_effect_registry_set(pb_effect_registry* registry,
+                                 pb_special_type special,
+                                 const pb_effect_def* effect)
+{
+    if (!registry || special >= PB_SPECIAL_COUNT) {
+        return PB_ERR_INVALID_ARG;
+    }
 
     if (effect == NULL) {
-        custom_effect_set[special] = false;
+        registry->overridden[special] = false;
+        memset(&registry->effects[special], 0, sizeof(registry->effects[special]));
     } else {
-        custom_effects[special] = *effect;
-        custom_effect_set[special] = true;
+        registry->effects[special] = *effect;
+        registry->overridden[special] = true;
     }
 
-    return previous;
+    return PB_OK;
 }
 
 /*============================================================================
@@ -333,10 +346,12 @@ pb_result pb_execute_effect(pb_board* board, pb_offset origin,
 
     case PB_ACTION_CHANGE_COLOR:
         for (int i = 0; i < result->affected.count; i++) {
-            pb_bubble* b = pb_board_get(board, result->affected.cells[i]);
+            const pb_bubble* b = pb_board_get_const(board, result->affected.cells[i]);
             if (b && b->kind == PB_KIND_COLORED) {
-                /* Cycle color */
-                b->color_id = (uint8_t)((b->color_id + effect->value) % PB_MAX_COLORS);
+                /* Cycle color (through pb_board_set to keep neighbor counts) */
+                pb_bubble changed = *b;
+                changed.color_id = (uint8_t)((b->color_id + effect->value) % PB_MAX_COLORS);
+                pb_board_set(board, result->affected.cells[i], changed);
                 result->board_changed = true;
             }
         }
@@ -344,12 +359,14 @@ pb_result pb_execute_effect(pb_board* board, pb_offset origin,
 
     case PB_ACTION_CONVERT:
         for (int i = 0; i < result->affected.count; i++) {
-            pb_bubble* b = pb_board_get(board, result->affected.cells[i]);
+            const pb_bubble* b = pb_board_get_const(board, result->affected.cells[i]);
             if (b && b->kind == PB_KIND_SPECIAL) {
                 /* Convert to regular colored bubble */
-                b->kind = PB_KIND_COLORED;
-                b->special = PB_SPECIAL_NONE;
-                b->flags = 0;
+                pb_bubble changed = *b;
+                changed.kind = PB_KIND_COLORED;
+                changed.special = PB_SPECIAL_NONE;
+                changed.flags = 0;
+                pb_board_set(board, result->affected.cells[i], changed);
                 result->board_changed = true;
             }
         }
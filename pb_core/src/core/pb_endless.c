@@ -0,0 +1,200 @@
+/*
+ * pb_endless.c - Endless scrolling board with windowed row storage
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_endless.h"
+#include "pb/pb_board.h"
+#include "pb/pb_rng.h"
+
+#include <string.h>
+
+/*============================================================================
+ * Level Sources
+ *============================================================================*/
+
+bool pb_level_gen_row(void* userdata, uint32_t altitude, pb_bubble* cells, int cols)
+{
+    const pb_level_gen* gen = (const pb_level_gen*)userdata;
+    if (gen->height != 0 && altitude >= gen->height) {
+        return false;
+    }
+
+    /* Seeded per row, so any row can be regenerated on its own */
+    pb_rng rng;
+    pb_rng_seed(&rng, gen->seed ^ ((uint64_t)altitude * 0x9E3779B97F4A7C15ULL));
+
+    for (int col = 0; col < cols; col++) {
+        if (pb_rng_range(&rng, 100) >= gen->fill_percent) continue;
+        cells[col].kind = PB_KIND_COLORED;
+        cells[col].color_id = (uint8_t)pb_rng_pick_color(&rng, gen->allowed_colors);
+    }
+    return true;
+}
+
+bool pb_level_rows_row(void* userdata, uint32_t altitude, pb_bubble* cells, int cols)
+{
+    const pb_level_rows* rows = (const pb_level_rows*)userdata;
+    if (altitude >= rows->height) {
+        return false;
+    }
+    memcpy(cells, rows->cells + (size_t)altitude * PB_MAX_COLS,
+           (size_t)cols * sizeof(pb_bubble));
+    return true;
+}
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+/* Pull the next level row into a (freshly emptied) window row */
+static void pull_row(pb_endless* endless, int row)
+{
+    pb_board* board = endless->board;
+    uint32_t altitude = endless->next_altitude++;
+    if (endless->exhausted) {
+        return;
+    }
+
+    pb_bubble cells[PB_MAX_COLS];
+    memset(cells, 0, sizeof(cells));
+    int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+    if (!endless->source.row(endless->source.userdata, altitude, cells, cols)) {
+        endless->exhausted = true;
+        endless->height = altitude;
+        return;
+    }
+
+    for (int col = 0; col < cols; col++) {
+        if (cells[col].kind != PB_KIND_NONE) {
+            pb_board_set(board, (pb_offset){row, col}, cells[col]);
+        }
+    }
+}
+
+/* Anchor at the level top once it is in view, else at the window top */
+static void update_ceiling(pb_endless* endless)
+{
+    pb_board* board = endless->board;
+    if (!endless->exhausted || endless->height == 0) {
+        board->ceiling_row = 0;
+        return;
+    }
+    uint32_t row = endless->next_altitude - endless->height;
+    board->ceiling_row = row < (uint32_t)board->rows ? (int)row : board->rows - 1;
+}
+
+/*============================================================================
+ * Window
+ *============================================================================*/
+
+void pb_endless_config_default(pb_endless_config* config)
+{
+    memset(config, 0, sizeof(*config));
+    int rows = PB_DEFAULT_ROWS < PB_MAX_ROWS ? PB_DEFAULT_ROWS : PB_MAX_ROWS;
+    config->window_rows = rows & ~1;
+    config->cols_even = PB_DEFAULT_COLS_EVEN < PB_MAX_COLS ? PB_DEFAULT_COLS_EVEN
+                                                           : PB_MAX_COLS;
+    config->cols_odd = config->cols_even - 1;
+    config->initial_rows = (config->window_rows / 2) & ~1;
+    config->lead_rows = config->window_rows / 2;
+}
+
+pb_result pb_endless_init(pb_endless* endless, pb_board* board,
+                          const pb_level_source* source,
+                          const pb_endless_config* config)
+{
+    pb_endless_config defaults;
+    if (!config) {
+        pb_endless_config_default(&defaults);
+        config = &defaults;
+    }
+    if (!endless || !board || !source || !source->row) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (config->window_rows < 4 || config->window_rows > PB_MAX_ROWS ||
+        (config->window_rows & 1) ||
+        config->cols_even < 1 || config->cols_even > PB_MAX_COLS ||
+        config->cols_odd < 1 || config->cols_odd > PB_MAX_COLS ||
+        config->initial_rows < 0 || config->initial_rows > config->window_rows ||
+        (config->initial_rows & 1)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    memset(endless, 0, sizeof(*endless));
+    endless->board = board;
+    endless->source = *source;
+
+    /* Refill must never push bubbles off: keep the bottom pair clear */
+    int lead = config->lead_rows;
+    if (lead < 0) lead = 0;
+    if (lead > config->window_rows - 3) lead = config->window_rows - 3;
+    endless->lead_rows = lead;
+
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    bool track = board->track_neighbors;
+#endif
+    pb_board_init_custom(board, config->window_rows,
+                         config->cols_even, config->cols_odd);
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    pb_board_track_neighbors(board, track);
+#endif
+
+    /* Altitude 0 lands on the lowest filled row */
+    for (int row = config->initial_rows - 1; row >= 0; row--) {
+        pull_row(endless, row);
+    }
+    update_ceiling(endless);
+    return PB_OK;
+}
+
+bool pb_endless_scroll(pb_endless* endless)
+{
+    bool ok = pb_board_scroll_down(endless->board, 2);
+    pull_row(endless, 1);
+    pull_row(endless, 0);
+    endless->rows_scrolled += 2;
+    update_ceiling(endless);
+    return ok;
+}
+
+int pb_endless_refill(pb_endless* endless)
+{
+    int scrolled = 0;
+
+    /* Bounded so an all-empty stretch of level cannot spin forever */
+    while (!endless->exhausted && scrolled < endless->board->rows &&
+           pb_endless_lowest_row(endless) < endless->lead_rows) {
+        pb_endless_scroll(endless);
+        scrolled += 2;
+    }
+    return scrolled;
+}
+
+uint32_t pb_endless_row_altitude(const pb_endless* endless, int row)
+{
+    if (row < 0 || row >= endless->board->rows ||
+        (uint32_t)row >= endless->next_altitude) {
+        return UINT32_MAX;
+    }
+    uint32_t altitude = endless->next_altitude - 1 - (uint32_t)row;
+    if (endless->exhausted && altitude >= endless->height) {
+        return UINT32_MAX;
+    }
+    return altitude;
+}
+
+int pb_endless_lowest_row(const pb_endless* endless)
+{
+    const pb_board* board = endless->board;
+    for (int row = board->rows - 1; row >= 0; row--) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            if (board->cells[row][col].kind != PB_KIND_NONE) {
+                return row;
+            }
+        }
+    }
+    return -1;
+}
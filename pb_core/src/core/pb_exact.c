@@ -0,0 +1,965 @@
+/*
+ * pb_exact.c - Exact minimum-shot solver (IDA*)
+ *
+ * Each worker owns a stack of search frames (one board copy per ply) and a
+ * private transposition table. Root children are handed out to workers one
+ * at a time; when a worker finds a line, workers on later root children
+ * abandon theirs so the reported witness is the one the serial search would
+ * have found first, independent of thread count.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_exact.h"
+#include "pb/pb_canon.h"
+#include "pb/pb_shot.h"
+#include "pb/pb_game.h"
+
+#include <stdlib.h>
+#include <time.h>
+#include "pb/pb_freestanding.h"
+
+#if PB_FEATURE_THREADS
+#include <pthread.h>
+#endif
+
+/*============================================================================
+ * Internal Types
+ *============================================================================*/
+
+#define EXACT_INF       0x7FFF
+#define EXACT_FOUND     (-1)
+#define EXACT_ABORT     (-2)
+#define EXACT_NO_ROOT   0x7FFFFFFF
+
+/* Nodes between budget checks */
+#define EXACT_CHECK_INTERVAL 256
+
+typedef struct exact_landing {
+    pb_offset cell;
+    pb_scalar angle;
+} exact_landing;
+
+typedef struct exact_child {
+    int16_t landing;            /* Index into frame landings */
+    uint8_t use_preview;        /* Fire queue[next] instead of held */
+    int score;                  /* Move-ordering key (higher first) */
+} exact_child;
+
+typedef struct exact_frame {
+    pb_board board;
+    pb_bubble held;             /* Bubble in the cannon (kind NONE = empty) */
+    int next;                   /* Next queue index */
+    int landing_count;
+    exact_landing landings[PB_MAX_CELLS];
+    int child_count;
+    exact_child children[2 * PB_MAX_CELLS];
+} exact_frame;
+
+typedef struct exact_tt_entry {
+    uint64_t key;
+    int32_t budget;             /* Largest remaining budget proven to fail */
+} exact_tt_entry;
+
+struct pb_exact_cache {
+    exact_tt_entry* tt;
+    uint32_t tt_mask;
+    uint64_t fingerprint;       /* Queue and rules the entries are valid for */
+};
+
+typedef struct exact_shared {
+    const pb_bubble* queue;
+    int queue_length;
+    int threshold;
+    int max_depth;
+    bool allow_swap;
+    pb_exact_movegen movegen;
+    const pb_tablebase* tablebase;  /* NULL unless usable for this search */
+    pb_playfield field;
+    int max_bounces;
+    pb_vec2 velocity[PB_DIR_COUNT];
+    pb_scalar angle[PB_DIR_COUNT];
+
+    uint64_t node_budget;
+    uint32_t time_budget_ms;
+    uint64_t start_ms;
+    uint64_t fingerprint;
+    pb_exact_progress_fn on_progress;
+    void* progress_userdata;
+
+    /* Written between iterations, read under lock */
+    int bound;
+    int lower_bound;
+    int upper_bound;
+
+    /* Guarded by lock when threaded */
+    bool stop;
+    bool timed_out;
+    uint64_t nodes;
+    int next_root;
+    int found_root;
+    int found_length;
+    pb_move found_line[PB_EXACT_MAX_DEPTH];
+#if PB_FEATURE_THREADS
+    pthread_mutex_t lock;
+#endif
+} exact_shared;
+
+typedef struct exact_worker {
+    exact_shared* sh;
+    exact_frame* frames;        /* [max_depth + 3] */
+    exact_tt_entry* tt;
+    uint32_t tt_mask;
+    uint64_t pending_nodes;     /* Not yet folded into sh->nodes */
+    uint64_t tt_hits;
+    int root;                   /* Root child currently searched */
+    int bound;
+    int min_exceeded;
+    int found_length;
+    pb_move line[PB_EXACT_MAX_DEPTH];
+} exact_worker;
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static void shared_lock(exact_shared* sh)
+{
+#if PB_FEATURE_THREADS
+    pthread_mutex_lock(&sh->lock);
+#else
+    (void)sh;
+#endif
+}
+
+static void shared_unlock(exact_shared* sh)
+{
+#if PB_FEATURE_THREADS
+    pthread_mutex_unlock(&sh->lock);
+#else
+    (void)sh;
+#endif
+}
+
+static uint64_t now_ms(void)
+{
+#if defined(TIME_UTC)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#else
+    return (uint64_t)clock() * 1000u / CLOCKS_PER_SEC;
+#endif
+}
+
+/* FNV-1a over occupied cells plus the queue position */
+static uint64_t state_key(const pb_board* board, pb_bubble held, int next)
+{
+    uint64_t h = 14695981039346656037ULL;
+
+    for (int row = board->ceiling_row; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            uint8_t v = (uint8_t)((b->kind << 4) | (b->color_id & 0x0F));
+            h = (h ^ v) * 1099511628211ULL;
+        }
+    }
+    h = (h ^ (uint64_t)((held.kind << 4) | (held.color_id & 0x0F))) * 1099511628211ULL;
+    h = (h ^ (uint64_t)next) * 1099511628211ULL;
+
+    return h | 1u;  /* 0 marks an empty slot */
+}
+
+/*
+ * Attachable move generation is exactly symmetric under mirroring and
+ * color relabeling, so in that mode states share table entries through
+ * their canonical hash. Trajectory mode keeps the plain key: fixed-point
+ * paths are not guaranteed to mirror bit-for-bit.
+ */
+static uint64_t node_key(const exact_shared* sh, const exact_frame* f,
+                         const pb_bubble* shots, int shot_count)
+{
+    if (sh->movegen == PB_EXACT_MOVES_ATTACHABLE && !sh->allow_swap &&
+        shot_count <= PB_MAX_QUEUE) {
+        return pb_canon_hash(&f->board, shots, shot_count) | 1u;
+    }
+    return state_key(&f->board, f->held, f->next);
+}
+
+static int remaining_shots(const exact_shared* sh, const exact_frame* f)
+{
+    return (f->held.kind != PB_KIND_NONE ? 1 : 0) + (sh->queue_length - f->next);
+}
+
+static int frame_shots(const exact_shared* sh, const exact_frame* f,
+                       pb_bubble shots[PB_EXACT_MAX_DEPTH + 1])
+{
+    int n = 0;
+    if (f->held.kind != PB_KIND_NONE) {
+        shots[n++] = f->held;
+    }
+    for (int i = f->next; i < sh->queue_length && n <= PB_EXACT_MAX_DEPTH; i++) {
+        shots[n++] = sh->queue[i];
+    }
+    return n;
+}
+
+/*============================================================================
+ * Lower Bound
+ *============================================================================*/
+
+int pb_exact_lower_bound(const pb_board* board, int match_threshold,
+                         const pb_bubble* shots, int shot_count)
+{
+    int counts[PB_MAX_COLORS] = {0};
+    int wild = 0;
+    int colored = 0;
+    uint32_t ceiling_colors = 0;
+
+    for (int row = board->ceiling_row; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            /* Same any-color rule as pb_find_matches() */
+            if (b->kind == PB_KIND_WILDCARD ||
+                (b->kind == PB_KIND_SPECIAL && b->special == PB_SPECIAL_RAINBOW)) {
+                wild++;
+            } else if (b->kind == PB_KIND_COLORED && b->color_id < PB_MAX_COLORS) {
+                counts[b->color_id]++;
+                colored++;
+                if (row == board->ceiling_row) {
+                    ceiling_colors |= 1u << b->color_id;
+                }
+            }
+        }
+    }
+
+    if (colored == 0) {
+        return 0;
+    }
+
+    int available[PB_MAX_COLORS] = {0};
+    for (int i = 0; i < shot_count; i++) {
+        if (shots[i].kind != PB_KIND_COLORED) {
+            /* Non-colored shots match anything: only "at least one" holds */
+            return 1;
+        }
+        if (shots[i].color_id < PB_MAX_COLORS) {
+            available[shots[i].color_id]++;
+        }
+    }
+
+    int bound = 0;
+    for (int c = 0; c < PB_MAX_COLORS; c++) {
+        if (!(ceiling_colors & (1u << c))) continue;
+
+        int need = match_threshold - counts[c] - wild;
+        if (need < 1) need = 1;
+        if (need > available[c]) {
+            return shot_count + 1;
+        }
+        bound += need;
+    }
+
+    /* Colored bubbles hanging from blockers still need one shot */
+    return bound > 0 ? bound : 1;
+}
+
+/*============================================================================
+ * Persistent Cache
+ *============================================================================*/
+
+pb_exact_cache* pb_exact_cache_create(int tt_bits)
+{
+    if (tt_bits < 8) tt_bits = 8;
+    if (tt_bits > 26) tt_bits = 26;
+
+    pb_exact_cache* cache = malloc(sizeof(*cache));
+    if (!cache) {
+        return NULL;
+    }
+    cache->tt = calloc((size_t)1 << tt_bits, sizeof(exact_tt_entry));
+    if (!cache->tt) {
+        free(cache);
+        return NULL;
+    }
+    cache->tt_mask = ((uint32_t)1 << tt_bits) - 1;
+    cache->fingerprint = 0;
+    return cache;
+}
+
+void pb_exact_cache_destroy(pb_exact_cache* cache)
+{
+    if (!cache) return;
+    free(cache->tt);
+    free(cache);
+}
+
+void pb_exact_cache_clear(pb_exact_cache* cache)
+{
+    if (!cache) return;
+    memset(cache->tt, 0, ((size_t)cache->tt_mask + 1) * sizeof(exact_tt_entry));
+}
+
+/*============================================================================
+ * Move Model
+ *============================================================================*/
+
+int pb_exact_attachable_cells(const pb_board* board, pb_offset* out, int max)
+{
+    int n = 0;
+
+    for (int row = board->ceiling_row; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols && n < max; col++) {
+            if (board->cells[row][col].kind != PB_KIND_NONE) continue;
+
+            pb_offset pos = {row, col};
+            bool attach = (row == board->ceiling_row);
+            if (!attach) {
+                pb_offset nb[6];
+                pb_hex_neighbors_offset(pos, nb);
+                for (int i = 0; i < 6 && !attach; i++) {
+                    attach = pb_board_in_bounds(board, nb[i]) &&
+                             !pb_board_is_empty(board, nb[i]);
+                }
+            }
+            if (attach) {
+                out[n++] = pos;
+            }
+        }
+    }
+    return n;
+}
+
+bool pb_exact_play(pb_board* board, pb_offset cell, uint8_t color_id,
+                   int match_threshold, int* out_pops, int* out_drops)
+{
+    pb_bubble b = {
+        .kind = PB_KIND_COLORED,
+        .color_id = color_id,
+        .flags = 0,
+        .special = PB_SPECIAL_NONE,
+        .payload = {0}
+    };
+    pb_board_set(board, cell, b);
+
+    if (out_pops) *out_pops = 0;
+    if (out_drops) *out_drops = 0;
+
+    pb_visit_result matches;
+    int match_count = pb_find_matches(board, cell, &matches);
+    if (match_count < match_threshold) {
+        return cell.row < board->rows - 1;
+    }
+
+    pb_board_remove_cells(board, &matches);
+    pb_visit_result orphans;
+    int drops = pb_find_orphans(board, &orphans);
+    pb_board_remove_cells(board, &orphans);
+
+    if (out_pops) *out_pops = match_count;
+    if (out_drops) *out_drops = drops;
+    return true;
+}
+
+/*============================================================================
+ * Move Generation
+ *============================================================================*/
+
+static void gen_landings(const exact_shared* sh, exact_frame* f)
+{
+    const pb_board* board = &f->board;
+    f->landing_count = 0;
+
+    if (sh->movegen == PB_EXACT_MOVES_ATTACHABLE) {
+        pb_offset cells[PB_MAX_CELLS];
+        int n = pb_exact_attachable_cells(board, cells, PB_MAX_CELLS);
+        for (int i = 0; i < n; i++) {
+            f->landings[i].cell = cells[i];
+            f->landings[i].angle = 0;
+        }
+        f->landing_count = n;
+        return;
+    }
+
+    bool seen[PB_MAX_ROWS][PB_MAX_COLS];
+    memset(seen, 0, sizeof(seen));
+
+    for (int d = 0; d < PB_DIR_COUNT; d++) {
+        pb_collision hit = pb_shot_simulate(
+            sh->field.cannon_pos, sh->velocity[d], board,
+            sh->field.bubble_radius, sh->field.left_wall, sh->field.right_wall,
+            sh->field.ceiling, sh->max_bounces, NULL, NULL, 0);
+
+        if (hit.type != PB_COLLISION_BUBBLE && hit.type != PB_COLLISION_CEILING) {
+            continue;
+        }
+
+        pb_offset snap = pb_find_snap_cell(board, hit.hit_point,
+                                           sh->field.bubble_radius);
+        if (snap.row < 0 || snap.col < 0 || seen[snap.row][snap.col]) {
+            continue;
+        }
+        seen[snap.row][snap.col] = true;
+        f->landings[f->landing_count].cell = snap;
+        f->landings[f->landing_count].angle = sh->angle[d];
+        f->landing_count++;
+    }
+}
+
+/* Same-color neighbours of a landing cell; drives move ordering */
+static int landing_score(const pb_board* board, pb_offset cell, uint8_t color)
+{
+    int same = pb_board_neighbor_color_count(board, cell, color) +
+               pb_board_neighbor_wildcard_count(board, cell);
+    return same * 64 - cell.row;
+}
+
+static void gen_children(const exact_shared* sh, exact_frame* f)
+{
+    f->child_count = 0;
+    if (f->held.kind == PB_KIND_NONE) {
+        return;
+    }
+
+    gen_landings(sh, f);
+
+    bool preview = sh->allow_swap && f->next < sh->queue_length &&
+                   (sh->queue[f->next].kind != f->held.kind ||
+                    sh->queue[f->next].color_id != f->held.color_id);
+
+    for (int opt = 0; opt < (preview ? 2 : 1); opt++) {
+        uint8_t color = opt ? sh->queue[f->next].color_id : f->held.color_id;
+        for (int i = 0; i < f->landing_count; i++) {
+            exact_child c;
+            c.landing = (int16_t)i;
+            c.use_preview = (uint8_t)opt;
+            c.score = landing_score(&f->board, f->landings[i].cell, color);
+
+            /* Insertion sort, stable on generation order */
+            int j = f->child_count++;
+            while (j > 0 && f->children[j - 1].score < c.score) {
+                f->children[j] = f->children[j - 1];
+                j--;
+            }
+            f->children[j] = c;
+        }
+    }
+}
+
+/*
+ * Play one child of `parent` into `child`. Returns false if the shot loses
+ * the level (lands in the last row without popping).
+ */
+static bool apply_child(const exact_shared* sh, const exact_frame* parent,
+                        const exact_child* c, exact_frame* child, pb_move* move)
+{
+    const exact_landing* land = &parent->landings[c->landing];
+    pb_bubble shot = c->use_preview ? sh->queue[parent->next] : parent->held;
+
+    child->board = parent->board;
+    if (c->use_preview) {
+        child->held = parent->held;
+    } else if (parent->next < sh->queue_length) {
+        child->held = sh->queue[parent->next];
+    } else {
+        child->held.kind = PB_KIND_NONE;
+    }
+    child->next = parent->next < sh->queue_length ? parent->next + 1 : parent->next;
+
+    move->angle = land->angle;
+    move->color_id = shot.color_id;
+    move->target = land->cell;
+    move->score = 0.0f;
+
+    return pb_exact_play(&child->board, land->cell, shot.color_id, sh->threshold,
+                         &move->expected_pops, &move->expected_drops);
+}
+
+/*============================================================================
+ * Search
+ *============================================================================*/
+
+static bool worker_should_stop(exact_worker* w)
+{
+    exact_shared* sh = w->sh;
+    bool stop;
+
+    shared_lock(sh);
+    sh->nodes += w->pending_nodes;
+    w->pending_nodes = 0;
+    if (!sh->stop) {
+        if (sh->node_budget && sh->nodes >= sh->node_budget) {
+            sh->stop = true;
+            sh->timed_out = true;
+        } else if (sh->time_budget_ms &&
+                   now_ms() - sh->start_ms >= sh->time_budget_ms) {
+            sh->stop = true;
+            sh->timed_out = true;
+        }
+    }
+    if (!sh->stop && sh->on_progress) {
+        pb_exact_progress p;
+        p.bound = sh->bound;
+        p.lower_bound = sh->lower_bound;
+        p.upper_bound = sh->upper_bound;
+        p.nodes = sh->nodes;
+        p.elapsed_ms = (uint32_t)(now_ms() - sh->start_ms);
+        if (!sh->on_progress(&p, sh->progress_userdata)) {
+            sh->stop = true;
+            sh->timed_out = true;
+        }
+    }
+    stop = sh->stop || w->root > sh->found_root;
+    shared_unlock(sh);
+
+    return stop;
+}
+
+static int search(exact_worker* w, int depth, int g)
+{
+    exact_shared* sh = w->sh;
+    exact_frame* f = &w->frames[depth];
+
+    if (++w->pending_nodes >= EXACT_CHECK_INTERVAL && worker_should_stop(w)) {
+        return EXACT_ABORT;
+    }
+
+    pb_bubble shots[PB_EXACT_MAX_DEPTH + 1];
+    int shot_count = frame_shots(sh, f, shots);
+    int h = pb_exact_lower_bound(&f->board, sh->threshold, shots, shot_count);
+
+    if (h == 0) {
+        w->found_length = g;
+        return EXACT_FOUND;
+    }
+    if (sh->tablebase) {
+        int v = pb_tablebase_probe(sh->tablebase, &f->board, shots, shot_count);
+        if (v > h) h = v;
+    }
+    if (h > shot_count) {
+        return EXACT_INF;
+    }
+    if (g + h > w->bound) {
+        return g + h;
+    }
+
+    int budget = w->bound - g;
+    uint64_t key = node_key(sh, f, shots, shot_count);
+    exact_tt_entry* slot = &w->tt[key & w->tt_mask];
+    if (slot->key == key && slot->budget >= budget) {
+        w->tt_hits++;
+        return w->bound + 1;
+    }
+
+    gen_children(sh, f);
+
+    int min_f = EXACT_INF;
+    exact_frame* child = &w->frames[depth + 1];
+    for (int i = 0; i < f->child_count; i++) {
+        if (!apply_child(sh, f, &f->children[i], child, &w->line[g])) {
+            continue;
+        }
+        int t = search(w, depth + 1, g + 1);
+        if (t == EXACT_FOUND || t == EXACT_ABORT) {
+            return t;
+        }
+        if (t < min_f) min_f = t;
+    }
+
+    slot->key = key;
+    slot->budget = budget;
+    return min_f;
+}
+
+/* Search the subtree under root child `index` at the current bound */
+static void search_root(exact_worker* w, int index)
+{
+    exact_shared* sh = w->sh;
+    exact_frame* root = &w->frames[0];
+
+    w->root = index;
+    if (!apply_child(sh, root, &root->children[index], &w->frames[1], &w->line[0])) {
+        return;
+    }
+
+    int t = search(w, 1, 1);
+    if (t == EXACT_FOUND) {
+        shared_lock(sh);
+        if (index < sh->found_root) {
+            sh->found_root = index;
+            sh->found_length = w->found_length;
+            memcpy(sh->found_line, w->line,
+                   (size_t)w->found_length * sizeof(pb_move));
+        }
+        shared_unlock(sh);
+    } else if (t != EXACT_ABORT && t < w->min_exceeded) {
+        w->min_exceeded = t;
+    }
+}
+
+static void worker_run(exact_worker* w)
+{
+    exact_shared* sh = w->sh;
+
+    for (;;) {
+        int index;
+        bool stop;
+
+        shared_lock(sh);
+        index = sh->next_root++;
+        stop = sh->stop || index > sh->found_root;
+        shared_unlock(sh);
+
+        if (stop || index >= w->frames[0].child_count) {
+            break;
+        }
+        search_root(w, index);
+    }
+
+    shared_lock(sh);
+    sh->nodes += w->pending_nodes;
+    w->pending_nodes = 0;
+    shared_unlock(sh);
+}
+
+#if PB_FEATURE_THREADS
+static void* worker_thread(void* arg)
+{
+    worker_run((exact_worker*)arg);
+    return NULL;
+}
+#endif
+
+/*============================================================================
+ * Greedy Seed
+ *============================================================================*/
+
+/* Play the largest-removal move each turn; returns line length or -1 */
+static int greedy_line(const exact_shared* sh, exact_frame* a, exact_frame* b,
+                       pb_move* line)
+{
+    for (int g = 0; g < sh->max_depth; g++) {
+        pb_bubble shots[PB_EXACT_MAX_DEPTH + 1];
+        int h = pb_exact_lower_bound(&a->board, sh->threshold, shots,
+                                     frame_shots(sh, a, shots));
+        if (h == 0) {
+            return g;
+        }
+
+        gen_children(sh, a);
+
+        int best = -1;
+        int best_removed = -1;
+        for (int i = 0; i < a->child_count; i++) {
+            pb_move m;
+            if (!apply_child(sh, a, &a->children[i], b, &m)) continue;
+            if (m.expected_pops + m.expected_drops > best_removed) {
+                best_removed = m.expected_pops + m.expected_drops;
+                best = i;
+            }
+        }
+        if (best < 0) {
+            return -1;
+        }
+
+        apply_child(sh, a, &a->children[best], b, &line[g]);
+        exact_frame* t = a;
+        a = b;
+        b = t;
+    }
+
+    pb_bubble shots[PB_EXACT_MAX_DEPTH + 1];
+    return pb_exact_lower_bound(&a->board, sh->threshold, shots,
+                                frame_shots(sh, a, shots)) == 0 ? sh->max_depth : -1;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void pb_exact_config_default(pb_exact_config* config)
+{
+    memset(config, 0, sizeof(*config));
+    config->max_depth = PB_EXACT_MAX_DEPTH;
+    config->threads = 1;
+    config->tt_bits = PB_EXACT_DEFAULT_TT_BITS;
+    config->movegen = PB_EXACT_MOVES_TRAJECTORY;
+    config->seed_with_greedy = true;
+}
+
+/* Everything besides the root board that a table entry depends on */
+static uint64_t search_fingerprint(const exact_shared* sh, const pb_board* board,
+                                   pb_scalar radius)
+{
+    uint64_t h = 14695981039346656037ULL;
+    const int64_t fields[] = {
+        board->rows, board->cols_even, board->cols_odd, board->ceiling_row,
+        sh->threshold, sh->max_bounces, sh->allow_swap, sh->movegen,
+        (int64_t)radius, sh->queue_length,
+    };
+
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        h = (h ^ (uint64_t)fields[i]) * 1099511628211ULL;
+    }
+    for (int i = 0; i < sh->queue_length; i++) {
+        const pb_bubble* b = &sh->queue[i];
+        uint64_t v = ((uint64_t)b->kind << 16) | ((uint64_t)(b->special & 0xFF) << 8) |
+                     b->color_id;
+        h = (h ^ v) * 1099511628211ULL;
+    }
+    return h;
+}
+
+static void shared_init(exact_shared* sh, const pb_board* board,
+                        const pb_ruleset* ruleset, const pb_bubble* queue,
+                        int queue_length, const pb_exact_config* config)
+{
+    memset(sh, 0, sizeof(*sh));
+
+    pb_scalar radius = PB_FLOAT_TO_FIXED(16.0f);
+    sh->threshold = PB_DEFAULT_MATCH_THRESHOLD;
+    sh->max_bounces = PB_DEFAULT_MAX_BOUNCES;
+    if (ruleset) {
+        if (ruleset->bubble_radius > 0) radius = ruleset->bubble_radius;
+        if (ruleset->match_threshold > 0) sh->threshold = ruleset->match_threshold;
+        if (ruleset->max_bounces > 0) sh->max_bounces = ruleset->max_bounces;
+        sh->allow_swap = ruleset->allow_color_switch;
+    }
+
+    sh->queue = queue;
+    sh->queue_length = queue_length;
+    sh->max_depth = config->max_depth;
+    if (sh->max_depth <= 0 || sh->max_depth > PB_EXACT_MAX_DEPTH) {
+        sh->max_depth = PB_EXACT_MAX_DEPTH;
+    }
+    if (sh->max_depth > queue_length) {
+        sh->max_depth = queue_length;
+    }
+    sh->movegen = config->movegen;
+    /* Table values assume no color switching; a probe is otherwise unsound */
+    if (config->tablebase && config->tablebase->header && !sh->allow_swap &&
+        config->tablebase->header->match_threshold == sh->threshold) {
+        sh->tablebase = config->tablebase;
+    }
+    sh->node_budget = config->node_budget;
+    sh->time_budget_ms = config->time_budget_ms;
+    sh->start_ms = now_ms();
+    sh->found_root = EXACT_NO_ROOT;
+    sh->upper_bound = -1;
+    sh->on_progress = config->on_progress;
+    sh->progress_userdata = config->progress_userdata;
+    sh->fingerprint = search_fingerprint(sh, board, radius);
+
+    pb_playfield_calc(&sh->field, board, radius);
+    for (int d = 0; d < PB_DIR_COUNT; d++) {
+        float deg = (float)(PB_DIR_BASE_DEG + d * PB_DIR_STEP_DEG);
+        pb_scalar angle = PB_FLOAT_TO_FIXED(deg * 3.14159265f / 180.0f);
+        sh->angle[d] = angle;
+        sh->velocity[d].x = PB_FIXED_MUL(PB_SCALAR_COS(angle), PB_DEFAULT_SHOT_SPEED);
+        sh->velocity[d].y = -PB_FIXED_MUL(PB_SCALAR_SIN(angle), PB_DEFAULT_SHOT_SPEED);
+    }
+}
+
+static void root_frame_init(exact_frame* f, const pb_board* board,
+                            const exact_shared* sh)
+{
+    f->board = *board;
+    pb_board_track_neighbors(&f->board, true);
+    f->held.kind = PB_KIND_NONE;
+    f->next = 0;
+    if (sh->queue_length > 0) {
+        f->held = sh->queue[0];
+        f->next = 1;
+    }
+}
+
+pb_result pb_solve_exact(const pb_board* board, const pb_ruleset* ruleset,
+                         const pb_bubble* queue, int queue_length,
+                         const pb_exact_config* config,
+                         pb_exact_result* result)
+{
+    if (!board || !result || queue_length < 0 || (queue_length > 0 && !queue)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    pb_exact_config defaults;
+    if (!config) {
+        pb_exact_config_default(&defaults);
+        config = &defaults;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->min_shots = -1;
+
+    exact_shared* sh = malloc(sizeof(*sh));
+    if (!sh) {
+        return PB_ERR_NO_MEMORY;
+    }
+    shared_init(sh, board, ruleset, queue, queue_length, config);
+
+    int threads = config->threads;
+    if (threads < 1) threads = 1;
+    if (threads > PB_EXACT_MAX_THREADS) threads = PB_EXACT_MAX_THREADS;
+#if !PB_FEATURE_THREADS
+    threads = 1;
+#endif
+
+    int tt_bits = config->tt_bits;
+    if (tt_bits < 8) tt_bits = 8;
+    if (tt_bits > 26) tt_bits = 26;
+
+    exact_worker workers[PB_EXACT_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+    pb_result status = PB_OK;
+
+    for (int t = 0; t < threads; t++) {
+        workers[t].sh = sh;
+        /* One frame per ply plus a spare pair for the greedy seed */
+        workers[t].frames = malloc((size_t)(sh->max_depth + 3) * sizeof(exact_frame));
+        if (t == 0 && config->cache) {
+            if (config->cache->fingerprint != sh->fingerprint) {
+                pb_exact_cache_clear(config->cache);
+                config->cache->fingerprint = sh->fingerprint;
+            }
+            workers[t].tt = config->cache->tt;
+            workers[t].tt_mask = config->cache->tt_mask;
+        } else {
+            workers[t].tt = calloc((size_t)1 << tt_bits, sizeof(exact_tt_entry));
+            workers[t].tt_mask = ((uint32_t)1 << tt_bits) - 1;
+        }
+        if (!workers[t].frames || !workers[t].tt) {
+            status = PB_ERR_NO_MEMORY;
+        }
+    }
+#if PB_FEATURE_THREADS
+    pthread_mutex_init(&sh->lock, NULL);
+#endif
+
+    if (status != PB_OK) {
+        goto cleanup;
+    }
+
+    /* Root state, shared by every worker's frame 0 */
+    exact_frame* root = &workers[0].frames[0];
+    root_frame_init(root, board, sh);
+
+    pb_bubble shots[PB_EXACT_MAX_DEPTH + 1];
+    int h0 = pb_exact_lower_bound(&root->board, sh->threshold, shots,
+                                  frame_shots(sh, root, shots));
+    result->lower_bound = h0 <= remaining_shots(sh, root) ? h0 : 0;
+    sh->lower_bound = result->lower_bound;
+
+    if (h0 == 0) {
+        result->status = PB_EXACT_OPTIMAL;
+        result->min_shots = 0;
+        goto cleanup;
+    }
+
+    /* Anytime upper bound */
+    int upper = EXACT_INF;
+    if (config->seed_with_greedy) {
+        exact_frame* a = &workers[0].frames[1];
+        exact_frame* b = &workers[0].frames[2];
+        root_frame_init(a, board, sh);
+        int len = greedy_line(sh, a, b, result->witness);
+        if (len > 0) {
+            upper = len;
+            sh->upper_bound = len;
+            result->witness_length = len;
+            result->min_shots = len;
+        }
+    }
+
+    gen_children(sh, root);
+    for (int t = 1; t < threads; t++) {
+        memcpy(&workers[t].frames[0], root, sizeof(exact_frame));
+    }
+
+    int limit = sh->max_depth;
+    if (upper != EXACT_INF && upper - 1 < limit) {
+        limit = upper - 1;
+    }
+
+    int bound = h0;
+    bool found = false;
+    while (bound <= limit && !found && !sh->timed_out) {
+        result->iterations++;
+        sh->next_root = 0;
+        sh->bound = bound;
+        for (int t = 0; t < threads; t++) {
+            workers[t].bound = bound;
+            workers[t].min_exceeded = EXACT_INF;
+        }
+
+#if PB_FEATURE_THREADS
+        pthread_t tids[PB_EXACT_MAX_THREADS];
+        int spawned = 1;
+        for (int t = 1; t < threads; t++) {
+            if (pthread_create(&tids[t], NULL, worker_thread, &workers[t]) != 0) {
+                break;
+            }
+            spawned++;
+        }
+        worker_run(&workers[0]);
+        for (int t = 1; t < spawned; t++) {
+            pthread_join(tids[t], NULL);
+        }
+#else
+        worker_run(&workers[0]);
+#endif
+
+        if (sh->found_root != EXACT_NO_ROOT) {
+            found = true;
+            break;
+        }
+        if (sh->timed_out) {
+            break;
+        }
+
+        int next = EXACT_INF;
+        for (int t = 0; t < threads; t++) {
+            if (workers[t].min_exceeded < next) next = workers[t].min_exceeded;
+        }
+        result->lower_bound = next < EXACT_INF ? next : bound + 1;
+        sh->lower_bound = result->lower_bound;
+        bound = next;
+    }
+
+    if (found) {
+        result->status = PB_EXACT_OPTIMAL;
+        result->min_shots = sh->found_length;
+        result->lower_bound = sh->found_length;
+        result->witness_length = sh->found_length;
+        memcpy(result->witness, sh->found_line,
+               (size_t)sh->found_length * sizeof(pb_move));
+    } else if (sh->timed_out) {
+        result->status = PB_EXACT_TIMEOUT;
+    } else if (upper != EXACT_INF) {
+        /* Every shorter line was refuted: the greedy line is optimal */
+        result->status = PB_EXACT_OPTIMAL;
+        result->lower_bound = upper;
+    } else if (sh->max_depth < queue_length && bound != EXACT_INF) {
+        result->status = PB_EXACT_DEPTH_LIMIT;
+    } else {
+        result->status = PB_EXACT_UNSOLVABLE;
+    }
+
+cleanup:
+    for (int t = 0; t < threads; t++) {
+        result->tt_hits += workers[t].tt_hits;
+        free(workers[t].frames);
+        if (t > 0 || !config->cache) {
+            free(workers[t].tt);
+        }
+    }
+    result->nodes = sh->nodes;
+    result->elapsed_ms = (uint32_t)(now_ms() - sh->start_ms);
+#if PB_FEATURE_THREADS
+    pthread_mutex_destroy(&sh->lock);
+#endif
+    free(sh);
+    return status;
+}
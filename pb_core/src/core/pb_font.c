@@ -0,0 +1,294 @@
+/*
+ * pb_font.c - Bitmap font atlas, cached text layout and text batching
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_font.h"
+
+#include <string.h>
+
+/*============================================================================
+ * Built-in Font
+ *============================================================================*/
+
+/* 3x5 glyphs, one row per byte, bit 2 = left column */
+static const struct {
+    char ch;
+    uint8_t rows[5];
+} builtin_glyphs[] = {
+    {' ',  {0x0, 0x0, 0x0, 0x0, 0x0}},
+    {'!',  {0x2, 0x2, 0x2, 0x0, 0x2}},
+    {'"',  {0x5, 0x5, 0x0, 0x0, 0x0}},
+    {'#',  {0x5, 0x7, 0x5, 0x7, 0x5}},
+    {'%',  {0x5, 0x1, 0x2, 0x4, 0x5}},
+    {'\'', {0x2, 0x2, 0x0, 0x0, 0x0}},
+    {'(',  {0x1, 0x2, 0x2, 0x2, 0x1}},
+    {')',  {0x4, 0x2, 0x2, 0x2, 0x4}},
+    {'*',  {0x0, 0x5, 0x2, 0x5, 0x0}},
+    {'+',  {0x0, 0x2, 0x7, 0x2, 0x0}},
+    {',',  {0x0, 0x0, 0x0, 0x2, 0x4}},
+    {'-',  {0x0, 0x0, 0x7, 0x0, 0x0}},
+    {'.',  {0x0, 0x0, 0x0, 0x0, 0x2}},
+    {'/',  {0x1, 0x1, 0x2, 0x4, 0x4}},
+    {'0',  {0x7, 0x5, 0x5, 0x5, 0x7}},
+    {'1',  {0x2, 0x6, 0x2, 0x2, 0x7}},
+    {'2',  {0x7, 0x1, 0x7, 0x4, 0x7}},
+    {'3',  {0x7, 0x1, 0x3, 0x1, 0x7}},
+    {'4',  {0x5, 0x5, 0x7, 0x1, 0x1}},
+    {'5',  {0x7, 0x4, 0x7, 0x1, 0x7}},
+    {'6',  {0x7, 0x4, 0x7, 0x5, 0x7}},
+    {'7',  {0x7, 0x1, 0x2, 0x2, 0x2}},
+    {'8',  {0x7, 0x5, 0x7, 0x5, 0x7}},
+    {'9',  {0x7, 0x5, 0x7, 0x1, 0x7}},
+    {':',  {0x0, 0x2, 0x0, 0x2, 0x0}},
+    {';',  {0x0, 0x2, 0x0, 0x2, 0x4}},
+    {'<',  {0x1, 0x2, 0x4, 0x2, 0x1}},
+    {'=',  {0x0, 0x7, 0x0, 0x7, 0x0}},
+    {'>',  {0x4, 0x2, 0x1, 0x2, 0x4}},
+    {'?',  {0x7, 0x1, 0x3, 0x0, 0x2}},
+    {'A',  {0x2, 0x5, 0x7, 0x5, 0x5}},
+    {'B',  {0x6, 0x5, 0x6, 0x5, 0x6}},
+    {'C',  {0x3, 0x4, 0x4, 0x4, 0x3}},
+    {'D',  {0x6, 0x5, 0x5, 0x5, 0x6}},
+    {'E',  {0x7, 0x4, 0x6, 0x4, 0x7}},
+    {'F',  {0x7, 0x4, 0x6, 0x4, 0x4}},
+    {'G',  {0x3, 0x4, 0x5, 0x5, 0x3}},
+    {'H',  {0x5, 0x5, 0x7, 0x5, 0x5}},
+    {'I',  {0x7, 0x2, 0x2, 0x2, 0x7}},
+    {'J',  {0x1, 0x1, 0x1, 0x5, 0x2}},
+    {'K',  {0x5, 0x5, 0x6, 0x5, 0x5}},
+    {'L',  {0x4, 0x4, 0x4, 0x4, 0x7}},
+    {'M',  {0x5, 0x7, 0x7, 0x5, 0x5}},
+    {'N',  {0x6, 0x5, 0x5, 0x5, 0x5}},
+    {'O',  {0x2, 0x5, 0x5, 0x5, 0x2}},
+    {'P',  {0x6, 0x5, 0x6, 0x4, 0x4}},
+    {'Q',  {0x2, 0x5, 0x5, 0x6, 0x3}},
+    {'R',  {0x6, 0x5, 0x6, 0x5, 0x5}},
+    {'S',  {0x3, 0x4, 0x2, 0x1, 0x6}},
+    {'T',  {0x7, 0x2, 0x2, 0x2, 0x2}},
+    {'U',  {0x5, 0x5, 0x5, 0x5, 0x7}},
+    {'V',  {0x5, 0x5, 0x5, 0x5, 0x2}},
+    {'W',  {0x5, 0x5, 0x7, 0x7, 0x5}},
+    {'X',  {0x5, 0x5, 0x2, 0x5, 0x5}},
+    {'Y',  {0x5, 0x5, 0x2, 0x2, 0x2}},
+    {'Z',  {0x7, 0x1, 0x2, 0x4, 0x7}},
+    {'[',  {0x6, 0x4, 0x4, 0x4, 0x6}},
+    {']',  {0x3, 0x1, 0x1, 0x1, 0x3}},
+    {'_',  {0x0, 0x0, 0x0, 0x0, 0x7}},
+};
+
+/*============================================================================
+ * Font Atlas
+ *============================================================================*/
+
+void pb_font_atlas_init(pb_font_atlas* atlas, int line_height)
+{
+    if (!atlas) return;
+    memset(atlas, 0, sizeof(*atlas));
+    atlas->line_height = line_height;
+    atlas->version = 1;
+}
+
+void pb_font_atlas_init_builtin(pb_font_atlas* atlas)
+{
+    if (!atlas) return;
+    pb_font_atlas_init(atlas, 6);
+    int n = (int)(sizeof(builtin_glyphs) / sizeof(builtin_glyphs[0]));
+    for (int i = 0; i < n; i++) {
+        pb_font_atlas_add_glyph(atlas, builtin_glyphs[i].ch, 3, 5,
+                                builtin_glyphs[i].rows, 4);
+    }
+}
+
+pb_result pb_font_atlas_add_glyph(pb_font_atlas* atlas, int ch, int w, int h,
+                                  const uint8_t* rows, int advance)
+{
+    if (!atlas || !rows || ch < PB_FONT_FIRST_CHAR ||
+        ch >= PB_FONT_FIRST_CHAR + PB_FONT_GLYPHS ||
+        w < 1 || w > PB_FONT_MAX_GLYPH_W || h < 1 || h > PB_FONT_MAX_GLYPH_H ||
+        advance < 0 || advance > 255) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    /* Shelf packing with a one-pixel gutter against sampling bleed */
+    int cell_w = w + 1, cell_h = h + 1;
+    int x = atlas->shelf_x, y = atlas->shelf_y;
+    int shelf_h = atlas->shelf_h;
+    if (x + cell_w > PB_FONT_ATLAS_W) {
+        x = 0;
+        y += shelf_h;
+        shelf_h = 0;
+    }
+    if (y + cell_h > PB_FONT_ATLAS_H) return PB_ERR_NO_MEMORY;
+
+    for (int row = 0; row < h; row++) {
+        uint8_t* dst = &atlas->pixels[(y + row) * PB_FONT_ATLAS_W + x];
+        for (int col = 0; col < w; col++) {
+            dst[col] = (uint8_t)((rows[row] >> (w - 1 - col)) & 1u);
+        }
+    }
+
+    atlas->shelf_x = x + cell_w;
+    atlas->shelf_y = y;
+    atlas->shelf_h = (cell_h > shelf_h) ? cell_h : shelf_h;
+
+    pb_glyph* glyph = &atlas->glyphs[ch - PB_FONT_FIRST_CHAR];
+    glyph->x = (uint16_t)x;
+    glyph->y = (uint16_t)y;
+    glyph->w = (uint8_t)w;
+    glyph->h = (uint8_t)h;
+    glyph->advance = (uint8_t)advance;
+    glyph->present = true;
+    atlas->version++;
+    return PB_OK;
+}
+
+const pb_glyph* pb_font_atlas_glyph(const pb_font_atlas* atlas, int ch)
+{
+    if (!atlas) return NULL;
+    if (ch >= 'a' && ch <= 'z' &&
+        !atlas->glyphs[ch - PB_FONT_FIRST_CHAR].present) {
+        ch -= 'a' - 'A';
+    }
+    if (ch >= PB_FONT_FIRST_CHAR && ch < PB_FONT_FIRST_CHAR + PB_FONT_GLYPHS &&
+        atlas->glyphs[ch - PB_FONT_FIRST_CHAR].present) {
+        return &atlas->glyphs[ch - PB_FONT_FIRST_CHAR];
+    }
+    const pb_glyph* fallback = &atlas->glyphs['?' - PB_FONT_FIRST_CHAR];
+    return fallback->present ? fallback : NULL;
+}
+
+/*============================================================================
+ * Layout
+ *============================================================================*/
+
+int pb_text_layout(const pb_font_atlas* atlas, const char* text,
+                   pb_text_quad* quads, int* width, int* height)
+{
+    if (width) *width = 0;
+    if (height) *height = 0;
+    if (!atlas || !text || !quads) return 0;
+
+    int count = 0, pen_x = 0, pen_y = 0, widest = 0;
+    for (int i = 0; i < PB_TEXT_MAX_LEN && text[i]; i++) {
+        int ch = (unsigned char)text[i];
+        if (ch == '\n') {
+            if (pen_x > widest) widest = pen_x;
+            pen_x = 0;
+            pen_y += atlas->line_height;
+            continue;
+        }
+
+        const pb_glyph* glyph = pb_font_atlas_glyph(atlas, ch);
+        if (ch == ' ' || !glyph) {
+            pen_x += glyph ? glyph->advance : atlas->line_height / 2;
+            continue;
+        }
+
+        pb_text_quad* q = &quads[count++];
+        q->x = (int16_t)pen_x;
+        q->y = (int16_t)pen_y;
+        q->src_x = glyph->x;
+        q->src_y = glyph->y;
+        q->w = glyph->w;
+        q->h = glyph->h;
+        q->color = 0;
+        pen_x += glyph->advance;
+    }
+    if (pen_x > widest) widest = pen_x;
+
+    if (width) *width = widest;
+    if (height) *height = pen_y + atlas->line_height;
+    return count;
+}
+
+/*============================================================================
+ * Layout Cache
+ *============================================================================*/
+
+/* FNV-1a over the used prefix */
+static uint32_t text_hash(const char* text, int* len)
+{
+    uint32_t h = 2166136261u;
+    int n = 0;
+    while (n < PB_TEXT_MAX_LEN && text[n]) {
+        h = (h ^ (uint8_t)text[n]) * 16777619u;
+        n++;
+    }
+    *len = n;
+    return h;
+}
+
+void pb_text_cache_init(pb_text_cache* cache, const pb_font_atlas* atlas)
+{
+    if (!cache) return;
+    memset(cache, 0, sizeof(*cache));
+    cache->atlas = atlas;
+}
+
+const pb_text_layout_entry* pb_text_cache_get(pb_text_cache* cache, const char* text)
+{
+    if (!cache || !cache->atlas || !text) return NULL;
+
+    int len;
+    uint32_t hash = text_hash(text, &len);
+    uint32_t now = ++cache->clock;
+
+    pb_text_layout_entry* victim = &cache->entries[0];
+    for (int i = 0; i < PB_TEXT_CACHE_SIZE; i++) {
+        pb_text_layout_entry* e = &cache->entries[i];
+        if (e->last_used != 0 && e->hash == hash && e->len == len &&
+            e->atlas_version == cache->atlas->version &&
+            memcmp(e->text, text, (size_t)len) == 0) {
+            e->last_used = now;
+            cache->hits++;
+            return e;
+        }
+        if (e->last_used < victim->last_used) victim = e;
+    }
+
+    cache->misses++;
+    int w, h;
+    victim->quad_count = (uint8_t)pb_text_layout(cache->atlas, text, victim->quads, &w, &h);
+    victim->hash = hash;
+    victim->len = (uint8_t)len;
+    victim->width = (int16_t)w;
+    victim->height = (int16_t)h;
+    victim->atlas_version = cache->atlas->version;
+    victim->last_used = now;
+    memcpy(victim->text, text, (size_t)len);
+    return victim;
+}
+
+/*============================================================================
+ * Batching
+ *============================================================================*/
+
+void pb_text_batch_clear(pb_text_batch* batch)
+{
+    if (!batch) return;
+    batch->count = 0;
+    batch->dropped = 0;
+}
+
+int pb_text_batch_add(pb_text_batch* batch, pb_text_cache* cache,
+                      const char* text, int x, int y, uint8_t color)
+{
+    if (!batch) return 0;
+    const pb_text_layout_entry* layout = pb_text_cache_get(cache, text);
+    if (!layout) return 0;
+
+    for (int i = 0; i < layout->quad_count; i++) {
+        if (batch->count >= PB_TEXT_BATCH_MAX) {
+            batch->dropped += (uint32_t)(layout->quad_count - i);
+            break;
+        }
+        pb_text_quad* q = &batch->quads[batch->count++];
+        *q = layout->quads[i];
+        q->x = (int16_t)(q->x + x);
+        q->y = (int16_t)(q->y + y);
+        q->color = color;
+    }
+    return layout->width;
+}
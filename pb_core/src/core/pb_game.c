@@ -252,7 +252,14 @@ pb_result pb_game_init(pb_game_state* state, const pb_ruleset* ruleset,
 void pb_game_reset(pb_game_state* state, uint64_t seed)
 {
     pb_ruleset saved_ruleset = state->ruleset;
+    pb_event_subscriber saved_subscribers[PB_MAX_EVENT_SUBSCRIBERS];
+    bool saved_log_disabled = state->event_log_disabled;
+    memcpy(saved_subscribers, state->subscribers, sizeof(saved_subscribers));
+
     pb_game_init(state, &saved_ruleset, seed);
+
+    memcpy(state->subscribers, saved_subscribers, sizeof(saved_subscribers));
+    state->event_log_disabled = saved_log_disabled;
 }
 
 pb_result pb_game_load_board(pb_game_state* state, const pb_bubble* bubbles,
@@ -727,9 +734,57 @@ void pb_game_clear_events(pb_game_state* state)
 
 void pb_game_add_event(pb_game_state* state, const pb_event* event)
 {
+    uint32_t bit = PB_EVENT_MASK(event->type);
+    for (int i = 0; i < PB_MAX_EVENT_SUBSCRIBERS; i++) {
+        const pb_event_subscriber* sub = &state->subscribers[i];
+        if (sub->callback && (sub->type_mask & bit)) {
+            sub->callback(event, sub->userdata);
+        }
+    }
+
+    if (state->event_log_disabled) {
+        return;
+    }
     if (state->event_count < 256) {
         state->events[state->event_count++] = *event;
+    } else {
+        state->events_dropped++;
+    }
+}
+
+pb_result pb_game_subscribe(pb_game_state* state, uint32_t type_mask,
+                            pb_event_fn callback, void* userdata, int* out_id)
+{
+    if (!state || !callback || (type_mask & PB_EVENT_MASK_ALL) == 0) {
+        return PB_ERR_INVALID_ARG;
     }
+
+    for (int i = 0; i < PB_MAX_EVENT_SUBSCRIBERS; i++) {
+        pb_event_subscriber* sub = &state->subscribers[i];
+        if (sub->callback == NULL) {
+            sub->callback = callback;
+            sub->userdata = userdata;
+            sub->type_mask = type_mask;
+            if (out_id) *out_id = i;
+            return PB_OK;
+        }
+    }
+    return PB_ERR_NO_MEMORY;
+}
+
+pb_result pb_game_unsubscribe(pb_game_state* state, int id)
+{
+    if (!state || id < 0 || id >= PB_MAX_EVENT_SUBSCRIBERS ||
+        state->subscribers[id].callback == NULL) {
+        return PB_ERR_INVALID_ARG;
+    }
+    memset(&state->subscribers[id], 0, sizeof(state->subscribers[id]));
+    return PB_OK;
+}
+
+void pb_game_set_event_log(pb_game_state* state, bool enabled)
+{
+    state->event_log_disabled = !enabled;
 }
 
 /*============================================================================
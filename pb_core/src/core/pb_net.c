@@ -0,0 +1,785 @@
+/*
+ * pb_net.c - UDP input-relay transport for lockstep/rollback versus play
+ *
+ * Redundancy comes from the acknowledgement window rather than from
+ * retransmits: every packet restates all frames the peer has not acked,
+ * and a packet is applied only if it starts at or before the first frame
+ * we are missing. Anything else is stale and dropped.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "pb/pb_net.h"
+#include "pb/pb_rng.h"
+
+#include <stdlib.h>
+#include "pb/pb_freestanding.h"
+
+#if PB_FEATURE_NET
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+/*============================================================================
+ * Internal Types
+ *============================================================================*/
+
+typedef struct net_sum {
+    uint32_t frame;
+    uint32_t value;
+    bool valid;
+} net_sum;
+
+typedef struct sim_datagram {
+    uint32_t due_ms;
+    int len;
+    uint8_t data[PB_NET_MAX_PACKET];
+} sim_datagram;
+
+struct pb_net {
+    pb_net_config config;
+    int fd;
+    bool connected;
+    uint16_t local_port;
+
+    /* Outgoing: committed frames [0, local_frames), peer has [0, peer_ack) */
+    pb_input_event local[PB_NET_HISTORY];
+    int local_head;
+    int local_count;
+    uint32_t local_frames;
+    uint32_t peer_ack;
+    uint32_t seq;
+
+    /* Incoming: remote frames [0, remote_frames) are final */
+    pb_input_event remote[PB_NET_HISTORY];
+    int remote_head;
+    int remote_count;
+    uint32_t remote_frames;
+
+    /* Checksums */
+    net_sum local_sums[PB_NET_CHECKSUM_HISTORY];
+    net_sum remote_sums[PB_NET_CHECKSUM_HISTORY];
+    pb_net_checksum recent[PB_NET_PACKET_CHECKSUMS];
+    int recent_count;
+    pb_desync_info desync;
+
+    /* Timing */
+    bool remote_seen;
+    uint32_t remote_max_seq;
+    uint32_t remote_send_ms;
+    uint32_t remote_recv_ms;
+    bool have_transit;
+    int32_t prev_transit;
+    bool have_rtt;
+    float jitter_ms;
+    float rtt_ms;
+
+    /* Simulator */
+    pb_rng sim_rng;
+    sim_datagram sim[PB_NET_SIM_QUEUE];
+    int sim_count;
+
+    pb_net_stats stats;
+};
+
+/*============================================================================
+ * Byte Helpers
+ *============================================================================*/
+
+static void put_le32(uint8_t* out, uint32_t v)
+{
+    out[0] = (uint8_t)(v & 0xFF);
+    out[1] = (uint8_t)((v >> 8) & 0xFF);
+    out[2] = (uint8_t)((v >> 16) & 0xFF);
+    out[3] = (uint8_t)((v >> 24) & 0xFF);
+}
+
+static uint32_t get_le32(const uint8_t* in)
+{
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static bool get_varint(const uint8_t* data, int len, int* pos, uint32_t* out)
+{
+    int n = pb_varint_decode(data + *pos, len - *pos, out);
+    if (n == 0) {
+        return false;
+    }
+    *pos += n;
+    return true;
+}
+
+/* Wrap-safe "a is after b" for sequence numbers and clocks */
+static bool seq_after(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) > 0;
+}
+
+/*============================================================================
+ * Packet Codec
+ *============================================================================*/
+
+int pb_net_packet_encode(const pb_net_packet* packet, uint8_t* out, int cap)
+{
+    if (!packet || !out ||
+        packet->input_count < 0 || packet->input_count > PB_NET_PACKET_INPUTS ||
+        packet->checksum_count < 0 ||
+        packet->checksum_count > PB_NET_PACKET_CHECKSUMS ||
+        seq_after(packet->first_frame, packet->end_frame)) {
+        return 0;
+    }
+
+    /* Worst case is well under PB_NET_MAX_PACKET */
+    uint8_t buf[PB_NET_MAX_PACKET];
+    bool fixed = (packet->flags & PB_NET_FLAG_FIXED_POINT) != 0;
+    int n = 0;
+
+    buf[n++] = 'P';
+    buf[n++] = 'N';
+    buf[n++] = PB_NET_VERSION;
+    buf[n++] = packet->flags;
+    n += pb_varint_encode(packet->seq, buf + n);
+    n += pb_varint_encode(packet->send_ms, buf + n);
+    n += pb_varint_encode(packet->echo_ms, buf + n);
+    n += pb_varint_encode(packet->echo_hold_ms, buf + n);
+    n += pb_varint_encode(packet->ack_frames, buf + n);
+    n += pb_varint_encode(packet->first_frame, buf + n);
+    n += pb_varint_encode(packet->end_frame - packet->first_frame, buf + n);
+    n += pb_varint_encode((uint32_t)packet->input_count, buf + n);
+
+    uint32_t prev = packet->first_frame;
+    for (int i = 0; i < packet->input_count; i++) {
+        const pb_input_event* in = &packet->inputs[i];
+        if (seq_after(prev, in->frame) || !seq_after(packet->end_frame, in->frame) ||
+            in->type >= PB_INPUT_COUNT) {
+            return 0;
+        }
+        n += pb_event_pack(in, prev, buf + n, fixed);
+        prev = in->frame;
+    }
+
+    buf[n++] = (uint8_t)packet->checksum_count;
+    for (int i = 0; i < packet->checksum_count; i++) {
+        n += pb_varint_encode(packet->checksums[i].frame, buf + n);
+        put_le32(buf + n, packet->checksums[i].value);
+        n += 4;
+    }
+
+    if (n > cap) {
+        return 0;
+    }
+    memcpy(out, buf, (size_t)n);
+    return n;
+}
+
+pb_result pb_net_packet_decode(const uint8_t* data, int len, pb_net_packet* packet)
+{
+    if (!data || !packet || len < 4 || len > PB_NET_MAX_PACKET ||
+        data[0] != 'P' || data[1] != 'N' || data[2] != PB_NET_VERSION) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    memset(packet, 0, sizeof(*packet));
+    packet->flags = data[3];
+    bool fixed = (packet->flags & PB_NET_FLAG_FIXED_POINT) != 0;
+    int pos = 4;
+
+    uint32_t span, count;
+    if (!get_varint(data, len, &pos, &packet->seq) ||
+        !get_varint(data, len, &pos, &packet->send_ms) ||
+        !get_varint(data, len, &pos, &packet->echo_ms) ||
+        !get_varint(data, len, &pos, &packet->echo_hold_ms) ||
+        !get_varint(data, len, &pos, &packet->ack_frames) ||
+        !get_varint(data, len, &pos, &packet->first_frame) ||
+        !get_varint(data, len, &pos, &span) ||
+        !get_varint(data, len, &pos, &count) ||
+        span > INT32_MAX || count > PB_NET_PACKET_INPUTS) {
+        return PB_ERR_INVALID_ARG;
+    }
+    packet->end_frame = packet->first_frame + span;
+    packet->input_count = (int)count;
+
+    uint32_t prev = packet->first_frame;
+    for (int i = 0; i < packet->input_count; i++) {
+        pb_input_event* in = &packet->inputs[i];
+        int used = pb_event_unpack(data + pos, len - pos, prev, in, fixed);
+        if (used == 0 || in->type >= PB_INPUT_COUNT ||
+            in->frame - packet->first_frame >= span ||
+            in->frame - packet->first_frame < prev - packet->first_frame) {
+            return PB_ERR_INVALID_ARG;
+        }
+        pos += used;
+        prev = in->frame;
+    }
+
+    if (pos >= len || data[pos] > PB_NET_PACKET_CHECKSUMS) {
+        return PB_ERR_INVALID_ARG;
+    }
+    packet->checksum_count = data[pos++];
+    for (int i = 0; i < packet->checksum_count; i++) {
+        if (!get_varint(data, len, &pos, &packet->checksums[i].frame) ||
+            len - pos < 4) {
+            return PB_ERR_INVALID_ARG;
+        }
+        packet->checksums[i].value = get_le32(data + pos);
+        pos += 4;
+    }
+
+    return pos == len ? PB_OK : PB_ERR_INVALID_ARG;
+}
+
+/*============================================================================
+ * Sockets
+ *============================================================================*/
+
+#if PB_FEATURE_NET
+static bool parse_addr(const char* host, uint16_t port, struct sockaddr_in* addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
+    if (!host) {
+        addr->sin_addr.s_addr = htonl(INADDR_ANY);
+        return true;
+    }
+    return inet_pton(AF_INET, host, &addr->sin_addr) == 1;
+}
+#endif
+
+pb_result pb_net_bind(pb_net* net, const char* host, uint16_t port)
+{
+    if (!net) {
+        return PB_ERR_INVALID_ARG;
+    }
+#if PB_FEATURE_NET
+    struct sockaddr_in addr;
+    if (!parse_addr(host, port, &addr)) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (net->fd >= 0) {
+        close(net->fd);
+        net->fd = -1;
+        net->connected = false;
+        net->local_port = 0;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return PB_ERR_INVALID_STATE;
+    }
+    socklen_t addr_len = sizeof(addr);
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0 ||
+        getsockname(fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        close(fd);
+        return PB_ERR_INVALID_STATE;
+    }
+
+    net->fd = fd;
+    net->local_port = ntohs(addr.sin_port);
+    return PB_OK;
+#else
+    (void)host;
+    (void)port;
+    return PB_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+uint16_t pb_net_local_port(const pb_net* net)
+{
+    return net ? net->local_port : 0;
+}
+
+pb_result pb_net_connect(pb_net* net, const char* host, uint16_t port)
+{
+    if (!net || !host) {
+        return PB_ERR_INVALID_ARG;
+    }
+#if PB_FEATURE_NET
+    struct sockaddr_in addr;
+    if (!parse_addr(host, port, &addr)) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (net->fd < 0) {
+        return PB_ERR_INVALID_STATE;
+    }
+    /* A connected UDP socket only receives from the peer */
+    if (connect(net->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        return PB_ERR_INVALID_STATE;
+    }
+    net->connected = true;
+    return PB_OK;
+#else
+    (void)port;
+    return PB_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+static pb_result raw_send(pb_net* net, const uint8_t* data, int len)
+{
+#if PB_FEATURE_NET
+    if (send(net->fd, data, (size_t)len, 0) < 0 &&
+        errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNREFUSED) {
+        return PB_ERR_INVALID_STATE;
+    }
+    return PB_OK;
+#else
+    (void)net;
+    (void)data;
+    (void)len;
+    return PB_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+/* Next pending datagram, or -1 when none is waiting */
+static int raw_recv(pb_net* net, uint8_t* buf, int cap)
+{
+#if PB_FEATURE_NET
+    for (;;) {
+        ssize_t got = recv(net->fd, buf, (size_t)cap, 0);
+        if (got >= 0) {
+            return (int)got;
+        }
+        if (errno != ECONNREFUSED && errno != EINTR) {
+            return -1;
+        }
+        /* ICMP from an earlier send; not fatal */
+    }
+#else
+    (void)net;
+    (void)buf;
+    (void)cap;
+    return -1;
+#endif
+}
+
+/*============================================================================
+ * Simulator
+ *============================================================================*/
+
+static bool sim_enabled(const pb_net* net)
+{
+    return net->config.sim_loss_permille > 0 || net->config.sim_latency_ms > 0 ||
+           net->config.sim_jitter_ms > 0;
+}
+
+static void sim_enqueue(pb_net* net, const uint8_t* data, int len, uint32_t now_ms)
+{
+    if (pb_rng_range_int(&net->sim_rng, 0, 999) < (int)net->config.sim_loss_permille ||
+        net->sim_count == PB_NET_SIM_QUEUE) {
+        net->stats.sim_dropped++;
+        return;
+    }
+
+    uint32_t delay = net->config.sim_latency_ms;
+    if (net->config.sim_jitter_ms > 0) {
+        delay += (uint32_t)pb_rng_range_int(&net->sim_rng, 0,
+                                            (int)net->config.sim_jitter_ms);
+    }
+
+    sim_datagram* d = &net->sim[net->sim_count++];
+    d->due_ms = now_ms + delay;
+    d->len = len;
+    memcpy(d->data, data, (size_t)len);
+}
+
+/* Send every due datagram; later ones keep their queue order */
+static pb_result sim_flush(pb_net* net, uint32_t now_ms)
+{
+    pb_result result = PB_OK;
+    int kept = 0;
+    for (int i = 0; i < net->sim_count; i++) {
+        sim_datagram* d = &net->sim[i];
+        if (seq_after(d->due_ms, now_ms)) {
+            if (kept != i) {
+                net->sim[kept] = *d;
+            }
+            kept++;
+        } else if (raw_send(net, d->data, d->len) != PB_OK) {
+            result = PB_ERR_INVALID_STATE;
+        }
+    }
+    net->sim_count = kept;
+    return result;
+}
+
+/*============================================================================
+ * Checksums
+ *============================================================================*/
+
+static void check_desync(pb_net* net, uint32_t frame)
+{
+    const net_sum* mine = &net->local_sums[frame % PB_NET_CHECKSUM_HISTORY];
+    const net_sum* theirs = &net->remote_sums[frame % PB_NET_CHECKSUM_HISTORY];
+    if (net->desync.detected || !mine->valid || !theirs->valid ||
+        mine->frame != frame || theirs->frame != frame || mine->value == theirs->value) {
+        return;
+    }
+    net->desync.detected = true;
+    net->desync.frame = frame;
+    net->desync.expected = mine->value;
+    net->desync.actual = theirs->value;
+    net->desync.component = "frame";
+}
+
+void pb_net_add_checksum(pb_net* net, uint32_t frame, uint32_t checksum)
+{
+    net_sum* s = &net->local_sums[frame % PB_NET_CHECKSUM_HISTORY];
+    s->frame = frame;
+    s->value = checksum;
+    s->valid = true;
+
+    /* Most recent first */
+    if (net->recent_count < PB_NET_PACKET_CHECKSUMS) {
+        net->recent_count++;
+    }
+    for (int i = net->recent_count - 1; i > 0; i--) {
+        net->recent[i] = net->recent[i - 1];
+    }
+    net->recent[0].frame = frame;
+    net->recent[0].value = checksum;
+
+    check_desync(net, frame);
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+void pb_net_config_default(pb_net_config* config)
+{
+    memset(config, 0, sizeof(*config));
+    config->max_frames = 16;
+    config->use_fixed_point = false;
+    config->frame_ms = 16;
+    config->sim_seed = 1;
+}
+
+pb_net* pb_net_create(const pb_net_config* config)
+{
+    pb_net_config cfg;
+    if (config) {
+        cfg = *config;
+    } else {
+        pb_net_config_default(&cfg);
+    }
+    if (cfg.max_frames < 1 || cfg.frame_ms == 0 || cfg.sim_loss_permille > 1000 ||
+        cfg.sim_jitter_ms > INT32_MAX) {
+        return NULL;
+    }
+
+    pb_net* net = calloc(1, sizeof(*net));
+    if (!net) {
+        return NULL;
+    }
+    net->config = cfg;
+    net->fd = -1;
+    pb_rng_seed(&net->sim_rng, cfg.sim_seed);
+    return net;
+}
+
+void pb_net_destroy(pb_net* net)
+{
+    if (!net) return;
+#if PB_FEATURE_NET
+    if (net->fd >= 0) {
+        close(net->fd);
+    }
+#endif
+    free(net);
+}
+
+/*============================================================================
+ * Local Inputs
+ *============================================================================*/
+
+static const pb_input_event* local_at(const pb_net* net, int i)
+{
+    return &net->local[(net->local_head + i) % PB_NET_HISTORY];
+}
+
+pb_result pb_net_add_input(pb_net* net, const pb_input_event* input)
+{
+    if (!net || !input || input->type >= PB_INPUT_COUNT ||
+        seq_after(net->local_frames, input->frame)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    int same_frame = 0;
+    for (int i = net->local_count - 1; i >= 0; i--) {
+        uint32_t frame = local_at(net, i)->frame;
+        if (seq_after(frame, input->frame)) {
+            return PB_ERR_INVALID_ARG;
+        }
+        if (frame != input->frame) {
+            break;
+        }
+        same_frame++;
+    }
+    if (net->local_count == PB_NET_HISTORY || same_frame == PB_NET_PACKET_INPUTS) {
+        return PB_ERR_NO_MEMORY;
+    }
+
+    net->local[(net->local_head + net->local_count) % PB_NET_HISTORY] = *input;
+    net->local_count++;
+    return PB_OK;
+}
+
+void pb_net_commit_frame(pb_net* net, uint32_t frame)
+{
+    if (!seq_after(net->local_frames, frame)) {
+        net->local_frames = frame + 1;
+    }
+}
+
+/*============================================================================
+ * Send
+ *============================================================================*/
+
+pb_result pb_net_send(pb_net* net, uint32_t now_ms)
+{
+    if (!net || !net->connected) {
+        return PB_ERR_INVALID_STATE;
+    }
+
+    pb_net_packet packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.flags = net->config.use_fixed_point ? PB_NET_FLAG_FIXED_POINT : 0;
+    packet.seq = net->seq++;
+    packet.send_ms = now_ms;
+    if (net->remote_seen) {
+        packet.flags |= PB_NET_FLAG_ECHO;
+        packet.echo_ms = net->remote_send_ms;
+        packet.echo_hold_ms = now_ms - net->remote_recv_ms;
+    }
+    packet.ack_frames = net->remote_frames;
+
+    /* Window: oldest unacked committed frames, at most max_frames */
+    packet.first_frame = net->peer_ack;
+    packet.end_frame = net->local_frames;
+    if (packet.end_frame - packet.first_frame > (uint32_t)net->config.max_frames) {
+        packet.end_frame = packet.first_frame + (uint32_t)net->config.max_frames;
+    }
+
+    for (int i = 0; i < net->local_count; i++) {
+        const pb_input_event* in = local_at(net, i);
+        if (!seq_after(packet.end_frame, in->frame)) {
+            break;
+        }
+        if (packet.input_count == PB_NET_PACKET_INPUTS) {
+            /* Cut before this frame; frames must go out whole */
+            packet.end_frame = in->frame;
+            while (packet.input_count > 0 &&
+                   packet.inputs[packet.input_count - 1].frame == in->frame) {
+                packet.input_count--;
+            }
+            break;
+        }
+        packet.inputs[packet.input_count++] = *in;
+    }
+
+    packet.checksum_count = net->recent_count;
+    memcpy(packet.checksums, net->recent,
+           sizeof(net->recent[0]) * (size_t)net->recent_count);
+
+    uint8_t buf[PB_NET_MAX_PACKET];
+    int len = pb_net_packet_encode(&packet, buf, (int)sizeof(buf));
+    if (len == 0) {
+        return PB_ERR_INVALID_STATE;
+    }
+
+    net->stats.packets_sent++;
+    if (sim_enabled(net)) {
+        sim_enqueue(net, buf, len, now_ms);
+        return sim_flush(net, now_ms);
+    }
+    return raw_send(net, buf, len);
+}
+
+/*============================================================================
+ * Receive
+ *============================================================================*/
+
+static void apply_timing(pb_net* net, const pb_net_packet* packet, uint32_t now_ms)
+{
+    net->remote_send_ms = packet->send_ms;
+    net->remote_recv_ms = now_ms;
+
+    /* RFC 3550: J += (|D| - J) / 16, D = change in relative transit time */
+    int32_t transit = (int32_t)(now_ms - packet->send_ms);
+    if (net->have_transit) {
+        int32_t d = transit - net->prev_transit;
+        float abs_d = (float)(d < 0 ? -d : d);
+        net->jitter_ms += (abs_d - net->jitter_ms) / 16.0f;
+    }
+    net->prev_transit = transit;
+    net->have_transit = true;
+
+    if (packet->flags & PB_NET_FLAG_ECHO) {
+        int32_t rtt = (int32_t)(now_ms - packet->echo_ms - packet->echo_hold_ms);
+        if (rtt >= 0) {
+            if (net->have_rtt) {
+                net->rtt_ms += ((float)rtt - net->rtt_ms) / 8.0f;
+            } else {
+                net->rtt_ms = (float)rtt;
+                net->have_rtt = true;
+            }
+        }
+    }
+}
+
+static void apply_ack(pb_net* net, uint32_t ack_frames)
+{
+    if (!seq_after(ack_frames, net->peer_ack) || seq_after(ack_frames, net->local_frames)) {
+        return;
+    }
+    net->peer_ack = ack_frames;
+    while (net->local_count > 0 && seq_after(ack_frames, local_at(net, 0)->frame)) {
+        net->local_head = (net->local_head + 1) % PB_NET_HISTORY;
+        net->local_count--;
+    }
+}
+
+static void apply_inputs(pb_net* net, const pb_net_packet* packet)
+{
+    /* Usable only if it starts at or before our first missing frame */
+    if (seq_after(packet->first_frame, net->remote_frames) ||
+        !seq_after(packet->end_frame, net->remote_frames)) {
+        net->stats.packets_stale++;
+        return;
+    }
+
+    int first_new = 0;
+    while (first_new < packet->input_count &&
+           seq_after(net->remote_frames, packet->inputs[first_new].frame)) {
+        first_new++;
+    }
+    int fresh = packet->input_count - first_new;
+    if (net->remote_count + fresh > PB_NET_HISTORY) {
+        return;     /* Reader is behind; a later packet restates these */
+    }
+
+    for (int i = first_new; i < packet->input_count; i++) {
+        net->remote[(net->remote_head + net->remote_count) % PB_NET_HISTORY] =
+            packet->inputs[i];
+        net->remote_count++;
+    }
+    net->remote_frames = packet->end_frame;
+    net->stats.inputs_received += (uint32_t)fresh;
+}
+
+static void apply_packet(pb_net* net, const pb_net_packet* packet, uint32_t now_ms)
+{
+    net->stats.packets_received++;
+    if (!net->remote_seen || seq_after(packet->seq, net->remote_max_seq)) {
+        net->remote_max_seq = packet->seq;
+        net->remote_seen = true;
+        apply_timing(net, packet, now_ms);
+    }
+
+    apply_ack(net, packet->ack_frames);
+    apply_inputs(net, packet);
+
+    for (int i = 0; i < packet->checksum_count; i++) {
+        uint32_t frame = packet->checksums[i].frame;
+        net_sum* s = &net->remote_sums[frame % PB_NET_CHECKSUM_HISTORY];
+        s->frame = frame;
+        s->value = packet->checksums[i].value;
+        s->valid = true;
+        check_desync(net, frame);
+    }
+}
+
+int pb_net_poll(pb_net* net, uint32_t now_ms)
+{
+    if (!net || net->fd < 0) {
+        return 0;
+    }
+    sim_flush(net, now_ms);
+
+    int applied = 0;
+    uint8_t buf[PB_NET_MAX_PACKET + 1];
+    int got;
+    while ((got = raw_recv(net, buf, (int)sizeof(buf))) >= 0) {
+        pb_net_packet packet;
+        if (pb_net_packet_decode(buf, got, &packet) != PB_OK) {
+            net->stats.packets_invalid++;
+            continue;
+        }
+        apply_packet(net, &packet, now_ms);
+        applied++;
+    }
+    return applied;
+}
+
+/*============================================================================
+ * Remote Inputs
+ *============================================================================*/
+
+bool pb_net_pop_input(pb_net* net, pb_input_event* out)
+{
+    if (!net || net->remote_count == 0) {
+        return false;
+    }
+    if (out) {
+        *out = net->remote[net->remote_head];
+    }
+    net->remote_head = (net->remote_head + 1) % PB_NET_HISTORY;
+    net->remote_count--;
+    return true;
+}
+
+uint32_t pb_net_remote_frames(const pb_net* net)
+{
+    return net ? net->remote_frames : 0;
+}
+
+uint32_t pb_net_acked_frames(const pb_net* net)
+{
+    return net ? net->peer_ack : 0;
+}
+
+/*============================================================================
+ * Diagnostics
+ *============================================================================*/
+
+bool pb_net_desync(const pb_net* net, pb_desync_info* info)
+{
+    if (!net) {
+        return false;
+    }
+    if (info) {
+        *info = net->desync;
+    }
+    return net->desync.detected;
+}
+
+void pb_net_get_stats(const pb_net* net, pb_net_stats* stats)
+{
+    *stats = net->stats;
+    stats->jitter_ms = net->jitter_ms;
+    stats->rtt_ms = net->rtt_ms;
+
+    if (net->remote_seen) {
+        uint32_t expected = net->remote_max_seq + 1;
+        stats->packets_lost = expected > net->stats.packets_received ?
+                              expected - net->stats.packets_received : 0;
+    }
+
+    float delay_ms = net->rtt_ms / 2.0f + 4.0f * net->jitter_ms;
+    float frames = delay_ms / (float)net->config.frame_ms;
+    stats->delay_frames = (int)frames;
+    if ((float)stats->delay_frames < frames) {
+        stats->delay_frames++;
+    }
+}
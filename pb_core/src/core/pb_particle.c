@@ -0,0 +1,459 @@
+/*
+ * pb_particle.c - Pooled particle bursts for popped and dropped bubbles
+ *
+ * Invariant: every slot at or beyond count is zero. Zero life marks a
+ * lane dead, so the padding lanes of the last block never survive a cull
+ * and never need special casing in the vector step.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_particle.h"
+#include "pb/pb_game.h"
+#include "pb/pb_hex.h"
+#include "pb/pb_rng.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "pb/pb_freestanding.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SSE2 1
+#include <emmintrin.h>
+#else
+#define PARTICLE_SSE2 0
+#endif
+
+#if !PARTICLE_SSE2 && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define PARTICLE_NEON 1
+#include <arm_neon.h>
+#else
+#define PARTICLE_NEON 0
+#endif
+
+#define TWO_PI 6.28318531f
+
+struct pb_particles {
+    pb_particle_config config;
+    int capacity;
+    int count;
+
+    /* Structure of arrays, capacity entries each */
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float* life;
+    uint8_t* palette;
+
+    pb_indexed_sprite_instance* batch;
+
+    const pb_board* board;      /* Color source while attached */
+    int subscription;           /* -1 when detached */
+    pb_rng rng;
+
+    uint32_t spawned;
+    uint32_t rejected;
+    uint32_t expired;
+    uint32_t culled;
+};
+
+/*============================================================================
+ * Lifetime
+ *============================================================================*/
+
+void pb_particle_config_default(pb_particle_config* config)
+{
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->capacity = 4096;
+    config->origin_x = 64.0f;
+    config->origin_y = 16.0f;
+    config->bubble_radius = 8.0f;
+    config->view_min_x = 0.0f;
+    config->view_min_y = 0.0f;
+    config->view_max_x = 256.0f;
+    config->view_max_y = 224.0f;
+    config->per_pop = 6;
+    config->per_drop = 2;
+    config->pop_speed = 2.0f;
+    config->drop_speed = 0.5f;
+    config->life_pop = 24.0f;
+    config->life_drop = 60.0f;
+    config->gravity = 0.15f;
+    config->drag = 0.04f;
+    config->sprite = NULL;
+    config->palette_base = PB_PAL_BUBBLE_RED;
+    config->layer = PB_MAX_LAYERS - 1;
+    config->seed = 0x9A27C1E5ULL;
+}
+
+pb_particles* pb_particles_create(const pb_particle_config* config)
+{
+    pb_particle_config defaults;
+    if (!config) {
+        pb_particle_config_default(&defaults);
+        config = &defaults;
+    }
+    if (config->capacity <= 0 || config->capacity > (1 << 20) ||
+        config->per_pop < 0 || config->per_pop > PB_PARTICLE_MAX_BURST ||
+        config->per_drop < 0 || config->per_drop > PB_PARTICLE_MAX_BURST ||
+        config->drag < 0.0f || config->drag > 1.0f ||
+        config->view_max_x <= config->view_min_x ||
+        config->view_max_y <= config->view_min_y) {
+        return NULL;
+    }
+
+    int capacity = (config->capacity + PB_PARTICLE_LANES - 1) &
+                   ~(PB_PARTICLE_LANES - 1);
+
+    pb_particles* p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+
+    /* One block for the float arrays, so they stay adjacent in memory */
+    float* block = calloc((size_t)capacity * 5, sizeof(float));
+    p->palette = calloc((size_t)capacity, 1);
+    p->batch = calloc((size_t)capacity, sizeof(*p->batch));
+    if (!block || !p->palette || !p->batch) {
+        free(block);
+        free(p->palette);
+        free(p->batch);
+        free(p);
+        return NULL;
+    }
+
+    p->config = *config;
+    p->capacity = capacity;
+    p->x = block;
+    p->y = block + capacity;
+    p->vx = block + capacity * 2;
+    p->vy = block + capacity * 3;
+    p->life = block + capacity * 4;
+    p->subscription = -1;
+    pb_rng_seed(&p->rng, config->seed);
+    return p;
+}
+
+void pb_particles_destroy(pb_particles* particles)
+{
+    if (!particles) return;
+    free(particles->x);
+    free(particles->palette);
+    free(particles->batch);
+    free(particles);
+}
+
+void pb_particles_clear(pb_particles* particles)
+{
+    if (!particles) return;
+    memset(particles->x, 0, (size_t)particles->capacity * 5 * sizeof(float));
+    memset(particles->palette, 0, (size_t)particles->capacity);
+    particles->count = 0;
+}
+
+/*============================================================================
+ * Spawning
+ *============================================================================*/
+
+int pb_particles_burst(pb_particles* particles, pb_event_type type,
+                       pb_offset cell, uint8_t color_id)
+{
+    if (!particles) return 0;
+    const pb_particle_config* cfg = &particles->config;
+
+    bool pop = (type == PB_EVENT_BUBBLES_POPPED);
+    if (!pop && type != PB_EVENT_BUBBLES_DROPPED) return 0;
+
+    int want = pop ? cfg->per_pop : cfg->per_drop;
+    int room = particles->capacity - particles->count;
+    int n = (want < room) ? want : room;
+    particles->rejected += (uint32_t)(want - n);
+    if (n <= 0) return 0;
+
+    pb_point center = pb_offset_to_pixel(cell, PB_FLOAT_TO_FIXED(cfg->bubble_radius));
+    float cx = cfg->origin_x + PB_FIXED_TO_FLOAT(center.x);
+    float cy = cfg->origin_y + PB_FIXED_TO_FLOAT(center.y);
+    uint8_t palette = (uint8_t)(cfg->palette_base + color_id);
+
+    pb_rng* rng = &particles->rng;
+    for (int k = 0; k < n; k++) {
+        int i = particles->count++;
+        float vx, vy, life;
+        if (pop) {
+            /* Radial burst, evenly spaced with jittered angle and speed */
+            float angle = TWO_PI * ((float)k + pb_rng_float(rng)) / (float)n;
+            float speed = cfg->pop_speed * pb_rng_float_range(rng, 0.5f, 1.0f);
+            vx = pb_cosf(angle) * speed;
+            vy = pb_sinf(angle) * speed;
+            life = cfg->life_pop * pb_rng_float_range(rng, 0.75f, 1.25f);
+        } else {
+            /* Falling debris with a little sideways scatter */
+            vx = pb_rng_float_range(rng, -0.5f, 0.5f);
+            vy = cfg->drop_speed * pb_rng_float_range(rng, 0.5f, 1.5f);
+            life = cfg->life_drop * pb_rng_float_range(rng, 0.75f, 1.25f);
+        }
+        particles->x[i] = cx;
+        particles->y[i] = cy;
+        particles->vx[i] = vx;
+        particles->vy[i] = vy;
+        particles->life[i] = life;
+        particles->palette[i] = palette;
+    }
+    particles->spawned += (uint32_t)n;
+    return n;
+}
+
+void pb_particles_on_event(const pb_event* event, void* userdata)
+{
+    pb_particles* particles = userdata;
+    if (!event || !particles) return;
+
+    const pb_cell_index* cells;
+    int count;
+    if (event->type == PB_EVENT_BUBBLES_POPPED) {
+        cells = event->data.popped.cells;
+        count = event->data.popped.count;
+    } else if (event->type == PB_EVENT_BUBBLES_DROPPED) {
+        cells = event->data.dropped.cells;
+        count = event->data.dropped.count;
+    } else {
+        return;
+    }
+
+    const pb_board* board = particles->board;
+    for (int i = 0; i < count; i++) {
+        pb_offset cell = {PB_INDEX_TO_ROW(cells[i]), PB_INDEX_TO_COL(cells[i])};
+        uint8_t color = 0;
+        if (board && pb_board_in_bounds(board, cell)) {
+            color = board->cells[cell.row][cell.col].color_id;
+        }
+        pb_particles_burst(particles, event->type, cell, color);
+    }
+}
+
+pb_result pb_particles_attach(pb_particles* particles, pb_game_state* state)
+{
+    if (!particles || !state) return PB_ERR_INVALID_ARG;
+    if (particles->subscription >= 0) return PB_ERR_INVALID_STATE;
+
+    uint32_t mask = PB_EVENT_MASK(PB_EVENT_BUBBLES_POPPED) |
+                    PB_EVENT_MASK(PB_EVENT_BUBBLES_DROPPED);
+    int id;
+    pb_result result = pb_game_subscribe(state, mask, pb_particles_on_event,
+                                         particles, &id);
+    if (result != PB_OK) return result;
+
+    particles->subscription = id;
+    particles->board = &state->board;
+    return PB_OK;
+}
+
+void pb_particles_detach(pb_particles* particles, pb_game_state* state)
+{
+    if (!particles || !state || particles->subscription < 0) return;
+    pb_game_unsubscribe(state, particles->subscription);
+    particles->subscription = -1;
+    particles->board = NULL;
+}
+
+/*============================================================================
+ * Update
+ *============================================================================*/
+
+typedef struct step_params {
+    float dt;
+    float damp;                 /* Velocity scale per step */
+    float dvy;                  /* Gravity impulse per step */
+    float min_x, min_y, max_x, max_y;
+} step_params;
+
+/*
+ * Integrate lanes [i, i + 4) in place. Returns a bitmask of lanes that are
+ * now dead (expired or outside the view).
+ */
+static unsigned step_block(pb_particles* p, int i, const step_params* s)
+{
+#if PARTICLE_SSE2
+    __m128 dt = _mm_set1_ps(s->dt);
+    __m128 damp = _mm_set1_ps(s->damp);
+    __m128 vx = _mm_mul_ps(_mm_loadu_ps(p->vx + i), damp);
+    __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p->vy + i), damp),
+                           _mm_set1_ps(s->dvy));
+    __m128 x = _mm_add_ps(_mm_loadu_ps(p->x + i), _mm_mul_ps(vx, dt));
+    __m128 y = _mm_add_ps(_mm_loadu_ps(p->y + i), _mm_mul_ps(vy, dt));
+    __m128 life = _mm_sub_ps(_mm_loadu_ps(p->life + i), dt);
+    _mm_storeu_ps(p->vx + i, vx);
+    _mm_storeu_ps(p->vy + i, vy);
+    _mm_storeu_ps(p->x + i, x);
+    _mm_storeu_ps(p->y + i, y);
+    _mm_storeu_ps(p->life + i, life);
+
+    __m128 dead = _mm_cmple_ps(life, _mm_setzero_ps());
+    dead = _mm_or_ps(dead, _mm_cmplt_ps(x, _mm_set1_ps(s->min_x)));
+    dead = _mm_or_ps(dead, _mm_cmpge_ps(x, _mm_set1_ps(s->max_x)));
+    dead = _mm_or_ps(dead, _mm_cmplt_ps(y, _mm_set1_ps(s->min_y)));
+    dead = _mm_or_ps(dead, _mm_cmpge_ps(y, _mm_set1_ps(s->max_y)));
+    return (unsigned)_mm_movemask_ps(dead);
+#elif PARTICLE_NEON
+    float32x4_t dt = vdupq_n_f32(s->dt);
+    float32x4_t damp = vdupq_n_f32(s->damp);
+    float32x4_t vx = vmulq_f32(vld1q_f32(p->vx + i), damp);
+    float32x4_t vy = vaddq_f32(vmulq_f32(vld1q_f32(p->vy + i), damp),
+                               vdupq_n_f32(s->dvy));
+    float32x4_t x = vaddq_f32(vld1q_f32(p->x + i), vmulq_f32(vx, dt));
+    float32x4_t y = vaddq_f32(vld1q_f32(p->y + i), vmulq_f32(vy, dt));
+    float32x4_t life = vsubq_f32(vld1q_f32(p->life + i), dt);
+    vst1q_f32(p->vx + i, vx);
+    vst1q_f32(p->vy + i, vy);
+    vst1q_f32(p->x + i, x);
+    vst1q_f32(p->y + i, y);
+    vst1q_f32(p->life + i, life);
+
+    uint32x4_t dead = vcleq_f32(life, vdupq_n_f32(0.0f));
+    dead = vorrq_u32(dead, vcltq_f32(x, vdupq_n_f32(s->min_x)));
+    dead = vorrq_u32(dead, vcgeq_f32(x, vdupq_n_f32(s->max_x)));
+    dead = vorrq_u32(dead, vcltq_f32(y, vdupq_n_f32(s->min_y)));
+    dead = vorrq_u32(dead, vcgeq_f32(y, vdupq_n_f32(s->max_y)));
+    return (vgetq_lane_u32(dead, 0) & 1u) | (vgetq_lane_u32(dead, 1) & 2u) |
+           (vgetq_lane_u32(dead, 2) & 4u) | (vgetq_lane_u32(dead, 3) & 8u);
+#else
+    unsigned mask = 0;
+    for (int lane = 0; lane < PB_PARTICLE_LANES; lane++) {
+        int j = i + lane;
+        float vx = p->vx[j] * s->damp;
+        float vy = p->vy[j] * s->damp + s->dvy;
+        float x = p->x[j] + vx * s->dt;
+        float y = p->y[j] + vy * s->dt;
+        float life = p->life[j] - s->dt;
+        p->vx[j] = vx;
+        p->vy[j] = vy;
+        p->x[j] = x;
+        p->y[j] = y;
+        p->life[j] = life;
+        if (life <= 0.0f || x < s->min_x || x >= s->max_x ||
+            y < s->min_y || y >= s->max_y) {
+            mask |= 1u << lane;
+        }
+    }
+    return mask;
+#endif
+}
+
+static void move_particle(pb_particles* p, int to, int from)
+{
+    p->x[to] = p->x[from];
+    p->y[to] = p->y[from];
+    p->vx[to] = p->vx[from];
+    p->vy[to] = p->vy[from];
+    p->life[to] = p->life[from];
+    p->palette[to] = p->palette[from];
+}
+
+void pb_particles_update(pb_particles* particles, float dt)
+{
+    if (!particles || particles->count == 0 || dt <= 0.0f) return;
+    const pb_particle_config* cfg = &particles->config;
+
+    float damp = 1.0f - cfg->drag * dt;
+    step_params s = {
+        .dt = dt,
+        .damp = (damp > 0.0f) ? damp : 0.0f,
+        .dvy = cfg->gravity * dt,
+        .min_x = cfg->view_min_x, .min_y = cfg->view_min_y,
+        .max_x = cfg->view_max_x, .max_y = cfg->view_max_y,
+    };
+
+    /* Integrate and compact in one pass; survivors slide down to out */
+    int count = particles->count;
+    int out = 0;
+    for (int i = 0; i < count; i += PB_PARTICLE_LANES) {
+        unsigned dead = step_block(particles, i, &s);
+        if (dead == 0 && out == i && i + PB_PARTICLE_LANES <= count) {
+            out += PB_PARTICLE_LANES;
+            continue;
+        }
+        for (int lane = 0; lane < PB_PARTICLE_LANES && i + lane < count; lane++) {
+            int j = i + lane;
+            if (dead & (1u << lane)) {
+                if (particles->life[j] <= 0.0f) particles->expired++;
+                else particles->culled++;
+                continue;
+            }
+            if (out != j) move_particle(particles, out, j);
+            out++;
+        }
+    }
+
+    /* Restore the zero tail, including the padding lanes just integrated */
+    int end = (count + PB_PARTICLE_LANES - 1) & ~(PB_PARTICLE_LANES - 1);
+    size_t tail = (size_t)(end - out);
+    if (tail > 0) {
+        memset(particles->x + out, 0, tail * sizeof(float));
+        memset(particles->y + out, 0, tail * sizeof(float));
+        memset(particles->vx + out, 0, tail * sizeof(float));
+        memset(particles->vy + out, 0, tail * sizeof(float));
+        memset(particles->life + out, 0, tail * sizeof(float));
+        memset(particles->palette + out, 0, tail);
+    }
+    particles->count = out;
+}
+
+/*============================================================================
+ * Rendering
+ *============================================================================*/
+
+static int floor_to_int(float v)
+{
+    int i = (int)v;
+    return (v < (float)i) ? i - 1 : i;
+}
+
+int pb_particles_build_batch(pb_particles* particles,
+                             const pb_indexed_sprite_instance** out)
+{
+    if (!particles) {
+        if (out) *out = NULL;
+        return 0;
+    }
+    const pb_particle_config* cfg = &particles->config;
+
+    int half_w = cfg->sprite ? cfg->sprite->width / 2 : 0;
+    int half_h = cfg->sprite ? cfg->sprite->height / 2 : 0;
+    for (int i = 0; i < particles->count; i++) {
+        pb_indexed_sprite_instance* inst = &particles->batch[i];
+        inst->sprite = cfg->sprite;
+        inst->x = floor_to_int(particles->x[i]) - half_w;
+        inst->y = floor_to_int(particles->y[i]) - half_h;
+        inst->layer = cfg->layer;
+        inst->flags = 0;
+        inst->palette_offset = particles->palette[i];
+    }
+
+    if (out) *out = particles->batch;
+    return particles->count;
+}
+
+pb_particle_view pb_particles_view(const pb_particles* particles)
+{
+    pb_particle_view view = {0, NULL, NULL, NULL, NULL};
+    if (!particles) return view;
+    view.count = particles->count;
+    view.x = particles->x;
+    view.y = particles->y;
+    view.life = particles->life;
+    view.palette = particles->palette;
+    return view;
+}
+
+void pb_particles_get_stats(const pb_particles* particles, pb_particle_stats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!particles) return;
+    stats->active = particles->count;
+    stats->capacity = particles->capacity;
+    stats->spawned = particles->spawned;
+    stats->rejected = particles->rejected;
+    stats->expired = particles->expired;
+    stats->culled = particles->culled;
+}
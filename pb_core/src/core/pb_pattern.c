@@ -84,7 +84,7 @@ pb_pattern_category pb_pattern_get_category(pb_pattern_id id) {
  * ============================================================================ */
 
 /* Triangle (upward pointing) */
-static pb_polygon2d triangle_poly = {
+static const pb_polygon2d triangle_poly = {
     .vertices = {
         { 0.5f, 0.2f },   /* Top */
         { 0.2f, 0.8f },   /* Bottom left */
@@ -95,7 +95,7 @@ static pb_polygon2d triangle_poly = {
 };
 
 /* Square (rotated 45 degrees = diamond orientation) */
-static pb_polygon2d square_poly = {
+static const pb_polygon2d square_poly = {
     .vertices = {
         { 0.5f, 0.2f },   /* Top */
         { 0.8f, 0.5f },   /* Right */
@@ -107,7 +107,7 @@ static pb_polygon2d square_poly = {
 };
 
 /* Diamond (tall rhombus) */
-static pb_polygon2d diamond_poly = {
+static const pb_polygon2d diamond_poly = {
     .vertices = {
         { 0.5f, 0.15f },  /* Top */
         { 0.7f, 0.5f },   /* Right */
@@ -119,7 +119,7 @@ static pb_polygon2d diamond_poly = {
 };
 
 /* 5-pointed star */
-static pb_polygon2d star_poly = {
+static const pb_polygon2d star_poly = {
     .vertices = {
         /* Outer points */
         { 0.5f, 0.15f },   /* Top */
@@ -138,7 +138,7 @@ static pb_polygon2d star_poly = {
 };
 
 /* Cross (plus sign) */
-static pb_polygon2d cross_poly = {
+static const pb_polygon2d cross_poly = {
     .vertices = {
         { 0.35f, 0.2f },
         { 0.65f, 0.2f },
@@ -158,7 +158,7 @@ static pb_polygon2d cross_poly = {
 };
 
 /* Heart shape (approximated) */
-static pb_polygon2d heart_poly = {
+static const pb_polygon2d heart_poly = {
     .vertices = {
         { 0.5f, 0.85f },   /* Bottom point */
         { 0.15f, 0.5f },   /* Left curve */
@@ -174,47 +174,47 @@ static pb_polygon2d heart_poly = {
 };
 
 /* Circles for CIRCLE pattern */
-static pb_circle2d circle_shape = {
+static const pb_circle2d circle_shape = {
     .center = { 0.5f, 0.5f },
     .radius = 0.25f
 };
 
 /* Ring (hollow circle) - rendered with stroke only */
-static pb_circle2d ring_outer = {
+static const pb_circle2d ring_outer = {
     .center = { 0.5f, 0.5f },
     .radius = 0.3f
 };
 
 /* Horizontal lines */
-static pb_line2d lines_h[] = {
+static const pb_line2d lines_h[] = {
     { { 0.2f, 0.35f }, { 0.8f, 0.35f } },
     { { 0.2f, 0.5f },  { 0.8f, 0.5f } },
     { { 0.2f, 0.65f }, { 0.8f, 0.65f } }
 };
 
 /* Vertical lines */
-static pb_line2d lines_v[] = {
+static const pb_line2d lines_v[] = {
     { { 0.35f, 0.2f }, { 0.35f, 0.8f } },
     { { 0.5f, 0.2f },  { 0.5f, 0.8f } },
     { { 0.65f, 0.2f }, { 0.65f, 0.8f } }
 };
 
 /* Diagonal left (/) */
-static pb_line2d lines_diag_l[] = {
+static const pb_line2d lines_diag_l[] = {
     { { 0.25f, 0.75f }, { 0.75f, 0.25f } },
     { { 0.15f, 0.5f },  { 0.5f, 0.15f } },
     { { 0.5f, 0.85f },  { 0.85f, 0.5f } }
 };
 
 /* Diagonal right (\) */
-static pb_line2d lines_diag_r[] = {
+static const pb_line2d lines_diag_r[] = {
     { { 0.25f, 0.25f }, { 0.75f, 0.75f } },
     { { 0.15f, 0.5f },  { 0.5f, 0.85f } },
     { { 0.5f, 0.15f },  { 0.85f, 0.5f } }
 };
 
 /* Cross hatch (+) */
-static pb_line2d hatch_cross[] = {
+static const pb_line2d hatch_cross[] = {
     { { 0.2f, 0.35f }, { 0.8f, 0.35f } },
     { { 0.2f, 0.5f },  { 0.8f, 0.5f } },
     { { 0.2f, 0.65f }, { 0.8f, 0.65f } },
@@ -224,7 +224,7 @@ static pb_line2d hatch_cross[] = {
 };
 
 /* Diagonal crosshatch (X) */
-static pb_line2d hatch_diag[] = {
+static const pb_line2d hatch_diag[] = {
     { { 0.25f, 0.25f }, { 0.75f, 0.75f } },
     { { 0.25f, 0.75f }, { 0.75f, 0.25f } },
     { { 0.15f, 0.5f },  { 0.5f, 0.15f } },
@@ -234,7 +234,7 @@ static pb_line2d hatch_diag[] = {
 };
 
 /* Dots pattern */
-static pb_circle2d dots_circles[] = {
+static const pb_circle2d dots_circles[] = {
     { { 0.3f, 0.3f }, 0.06f },
     { { 0.7f, 0.3f }, 0.06f },
     { { 0.5f, 0.5f }, 0.06f },
@@ -243,7 +243,7 @@ static pb_circle2d dots_circles[] = {
 };
 
 /* Stipple pattern (random-looking dots) */
-static pb_circle2d stipple_circles[] = {
+static const pb_circle2d stipple_circles[] = {
     { { 0.25f, 0.35f }, 0.04f },
     { { 0.45f, 0.25f }, 0.04f },
     { { 0.65f, 0.40f }, 0.04f },
@@ -258,7 +258,7 @@ static pb_circle2d stipple_circles[] = {
  * Pattern Definitions
  * ============================================================================ */
 
-static pb_pattern_def pattern_defs[PB_PATTERN_COUNT] = {
+static const pb_pattern_def pattern_defs[PB_PATTERN_COUNT] = {
     /* NONE */
     { PB_PATTERN_NONE, PB_PATTERN_CAT_NONE, "none",
       NULL, 0, NULL, 0, NULL, 0, 0.0f, 0.0f, 0.0f },
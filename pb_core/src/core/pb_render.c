@@ -0,0 +1,665 @@
+/*
+ * pb_render.c - Software indexed render context
+ *
+ * Holds the 8-bit framebuffer and the palette state for a platform
+ * backend to present. Palette cycles are resolved once per frame in
+ * pb_render_begin_frame(), touching at most PB_PALETTE_SIZE entries and
+ * no pixels; the display palette version only moves when a range
+ * actually steps, so backends skip unchanged uploads.
+ *
+ * Dithered fills work a span at a time: the pattern bits for a row are
+ * looked up once, widened to a 64-bit byte mask and blended as
+ * A ^ ((A ^ B) & mask), then stored 8 pixels per write.
+ *
+ * Sprite batches are bucketed by layer with a counting sort into a
+ * scratch index array kept on the context, so drawing back to front
+ * never sorts. Opaque, unflipped sprites are copied a row at a time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_render.h"
+#include "pb/pb_compat.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct pb_render_context {
+    pb_render_config config;
+    uint8_t* pixels;
+
+    pb_palette palette;             /* Active (unanimated) palette */
+    pb_palette display;             /* palette with cycles applied */
+    uint32_t palette_version;
+
+    pb_palette_cycle cycles[PB_MAX_PALETTE_CYCLES];
+    bool cycle_used[PB_MAX_PALETTE_CYCLES];
+    int cycle_offsets[PB_MAX_PALETTE_CYCLES];   /* Offsets last applied */
+    bool display_dirty;
+
+    pb_layer_config layers[PB_MAX_LAYERS];
+    int* order;                     /* Batch bucketing scratch */
+    int order_capacity;
+
+    uint32_t frame;
+    pb_render_stats stats;
+};
+
+/*============================================================================
+ * Palette Cycling
+ *============================================================================*/
+
+static bool cycle_valid(const pb_palette_cycle* cycle)
+{
+    return cycle && cycle->count >= 2 && cycle->period >= 1 &&
+           cycle->mode <= PB_CYCLE_PINGPONG &&
+           (int)cycle->first + cycle->count <= PB_PALETTE_SIZE;
+}
+
+int pb_palette_cycle_offset(const pb_palette_cycle* cycle, uint32_t frame)
+{
+    if (!cycle_valid(cycle) || frame < cycle->start_frame) return 0;
+
+    uint32_t step = (frame - cycle->start_frame) / cycle->period;
+    uint32_t n = cycle->count;
+
+    switch (cycle->mode) {
+    case PB_CYCLE_REVERSE:
+        return (int)((n - step % n) % n);
+    case PB_CYCLE_PINGPONG: {
+        uint32_t s = step % (2 * (n - 1));
+        return (int)(s < n ? s : 2 * (n - 1) - s);
+    }
+    default:
+        return (int)(step % n);
+    }
+}
+
+static void apply_cycle(const pb_palette* base, const pb_palette_cycle* cycle,
+                        int offset, pb_palette* out)
+{
+    int first = cycle->first;
+    int n = cycle->count;
+    for (int i = 0; i < n; i++) {
+        out->colors[first + (i + offset) % n] = base->colors[first + i];
+    }
+}
+
+void pb_palette_cycle_apply(const pb_palette* base, const pb_palette_cycle* cycles,
+                            int count, uint32_t frame, pb_palette* out)
+{
+    if (!base || !out) return;
+    if (out != base) *out = *base;
+
+    for (int c = 0; c < count; c++) {
+        if (!cycle_valid(&cycles[c])) continue;
+        apply_cycle(base, &cycles[c], pb_palette_cycle_offset(&cycles[c], frame), out);
+    }
+}
+
+/* Rebuild the display palette if any range moved since the last frame */
+static void update_display(pb_render_context* ctx)
+{
+    bool changed = ctx->display_dirty;
+    for (int c = 0; c < PB_MAX_PALETTE_CYCLES && !changed; c++) {
+        if (ctx->cycle_used[c] &&
+            pb_palette_cycle_offset(&ctx->cycles[c], ctx->frame) != ctx->cycle_offsets[c]) {
+            changed = true;
+        }
+    }
+    if (!changed) return;
+
+    ctx->display = ctx->palette;
+    for (int c = 0; c < PB_MAX_PALETTE_CYCLES; c++) {
+        if (!ctx->cycle_used[c]) continue;
+        int offset = pb_palette_cycle_offset(&ctx->cycles[c], ctx->frame);
+        apply_cycle(&ctx->palette, &ctx->cycles[c], offset, &ctx->display);
+        ctx->cycle_offsets[c] = offset;
+    }
+    ctx->display_dirty = false;
+    ctx->palette_version++;
+}
+
+int pb_render_add_palette_cycle(pb_render_context* ctx, const pb_palette_cycle* cycle)
+{
+    if (!ctx || !cycle_valid(cycle)) return -1;
+    for (int c = 0; c < PB_MAX_PALETTE_CYCLES; c++) {
+        if (!ctx->cycle_used[c]) {
+            ctx->cycles[c] = *cycle;
+            ctx->cycle_used[c] = true;
+            ctx->display_dirty = true;
+            return c;
+        }
+    }
+    return -1;
+}
+
+void pb_render_remove_palette_cycle(pb_render_context* ctx, int id)
+{
+    if (!ctx || id < 0 || id >= PB_MAX_PALETTE_CYCLES || !ctx->cycle_used[id]) return;
+    ctx->cycle_used[id] = false;
+    ctx->display_dirty = true;
+}
+
+const pb_palette* pb_render_get_display_palette(const pb_render_context* ctx)
+{
+    return ctx ? &ctx->display : NULL;
+}
+
+uint32_t pb_render_palette_version(const pb_render_context* ctx)
+{
+    return ctx ? ctx->palette_version : 0;
+}
+
+/*============================================================================
+ * Dithering
+ *============================================================================*/
+
+static const uint8_t bayer2[2][2] = {
+    {0, 2},
+    {3, 1},
+};
+
+static const uint8_t bayer4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+static const uint8_t bayer8[8][8] = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+static const uint8_t halftone4[4][4] = {
+    {12,  5,  6, 13},
+    { 4,  0,  1,  7},
+    {11,  3,  2,  8},
+    {15, 10,  9, 14},
+};
+
+/* Pixel takes color_b when the level exceeds this (0..63) */
+static int dither_threshold(pb_dither_type type, int x, int y)
+{
+    switch (type) {
+    case PB_DITHER_BAYER2X2:
+        return bayer2[y & 1][x & 1] * 16 + 8;
+    case PB_DITHER_BAYER4X4:
+        return bayer4[y & 3][x & 3] * 4 + 2;
+    case PB_DITHER_BAYER8X8:
+        return bayer8[y & 7][x & 7];
+    case PB_DITHER_ORDERED:
+        return (((x + y) & 3) * 4 + (y & 3)) * 4 + 2;
+    case PB_DITHER_HALFTONE:
+        return halftone4[y & 3][x & 3] * 4 + 2;
+    case PB_DITHER_CHECKERBOARD:
+        return ((x + y) & 1) ? 48 : 16;
+    case PB_DITHER_NOISE: {
+        uint32_t h = (uint32_t)x * 0x9E3779B1u ^ (uint32_t)y * 0x85EBCA77u;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        return (int)(h & 63);
+    }
+    default:
+        return PB_DITHER_LEVELS / 2 - 1;
+    }
+}
+
+int pb_dither_level(pb_scalar blend)
+{
+#if PB_USE_FIXED_POINT
+    int level = (int)(((int32_t)blend * PB_DITHER_LEVELS +
+                       (1 << (PB_FIXED_SHIFT - 1))) >> PB_FIXED_SHIFT);
+#else
+    int level = (int)(blend * PB_DITHER_LEVELS + 0.5f);
+#endif
+    if (level < 0) return 0;
+    if (level > PB_DITHER_LEVELS) return PB_DITHER_LEVELS;
+    return level;
+}
+
+uint8_t pb_dither_blend(int x, int y, uint8_t color_a, uint8_t color_b,
+                        pb_scalar blend, pb_dither_type type)
+{
+    return pb_dither_level(blend) > dither_threshold(type, x, y) ? color_b : color_a;
+}
+
+uint8_t pb_dither_mask(pb_dither_type type, int level, int x, int y)
+{
+    int x8 = x & ~7;
+    uint8_t mask = 0;
+    for (int i = 0; i < 8; i++) {
+        if (level > dither_threshold(type, x8 + i, y)) {
+            mask |= (uint8_t)(1u << i);
+        }
+    }
+    return mask;
+}
+
+/* Byte i of the result (in memory order) is 0xFF where bit i of m is set */
+static uint64_t expand_mask(uint8_t m)
+{
+#if PB_BIG_ENDIAN
+    const uint64_t select = 0x0102040810204080ULL;
+#else
+    const uint64_t select = 0x8040201008040201ULL;
+#endif
+    uint64_t x = (m * 0x0101010101010101ULL) & select;
+    x = (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | x) &
+        0x8080808080808080ULL;
+    return (x >> 7) * 0xFF;
+}
+
+/* Eight pixels: color_b where the mask bit is set, else color_a */
+static uint64_t blend_word(uint8_t m, uint8_t color_a, uint8_t color_b)
+{
+    uint64_t a = color_a * 0x0101010101010101ULL;
+    uint64_t b = color_b * 0x0101010101010101ULL;
+    return a ^ ((a ^ b) & expand_mask(m));
+}
+
+void pb_dither_span(uint8_t* dst, int x, int y, int width, uint8_t color_a,
+                    uint8_t color_b, int level, pb_dither_type type)
+{
+    if (width <= 0) return;
+    if (level <= 0 || color_a == color_b) {
+        memset(dst, color_a, (size_t)width);
+        return;
+    }
+    if (level >= PB_DITHER_LEVELS) {
+        memset(dst, color_b, (size_t)width);
+        return;
+    }
+
+    if (type == PB_DITHER_NOISE) {
+        /* No period: a fresh mask for every 8-pixel block */
+        int i = 0;
+        while (i < width) {
+            int phase = (x + i) & 7;
+            int n = width - i < 8 - phase ? width - i : 8 - phase;
+            uint8_t m = (uint8_t)(pb_dither_mask(type, level, x + i, y) >> phase);
+            uint64_t word = blend_word(m, color_a, color_b);
+            memcpy(dst + i, &word, (size_t)n);
+            i += n;
+        }
+        return;
+    }
+
+    /* Rotate the row mask so bit 0 is pixel x; the word then repeats */
+    int phase = x & 7;
+    uint8_t m = pb_dither_mask(type, level, x, y);
+    m = (uint8_t)((m >> phase) | (m << ((8 - phase) & 7)));
+    uint64_t word = blend_word(m, color_a, color_b);
+
+    int i = 0;
+    for (; i + 8 <= width; i += 8) {
+        memcpy(dst + i, &word, 8);
+    }
+    memcpy(dst + i, &word, (size_t)(width - i));
+}
+
+/*============================================================================
+ * Render Context Lifecycle
+ *============================================================================*/
+
+pb_render_context* pb_render_create(const pb_render_config* config)
+{
+    if (!config || config->width <= 0 || config->height <= 0 ||
+        config->width > 4096 || config->height > 4096 || config->scale < 1) {
+        return NULL;
+    }
+
+    pb_render_context* ctx = calloc(1, sizeof(*ctx));
+    if (!ctx) return NULL;
+    ctx->pixels = calloc((size_t)config->width * (size_t)config->height, 1);
+    if (!ctx->pixels) {
+        free(ctx);
+        return NULL;
+    }
+    ctx->config = *config;
+    ctx->display_dirty = true;
+    for (int i = 0; i < PB_MAX_LAYERS; i++) {
+        ctx->layers[i].scale = PB_FLOAT_TO_FIXED(1.0f);
+        ctx->layers[i].ambient = 255;
+    }
+    return ctx;
+}
+
+void pb_render_destroy(pb_render_context* ctx)
+{
+    if (!ctx) return;
+    free(ctx->order);
+    free(ctx->pixels);
+    free(ctx);
+}
+
+void pb_render_set_palette(pb_render_context* ctx, const pb_palette* pal)
+{
+    if (!ctx || !pal) return;
+    ctx->palette = *pal;
+    ctx->display_dirty = true;
+    update_display(ctx);
+}
+
+const pb_render_config* pb_render_get_config(const pb_render_context* ctx)
+{
+    return ctx ? &ctx->config : NULL;
+}
+
+/*============================================================================
+ * Frame Operations
+ *============================================================================*/
+
+void pb_render_begin_frame(pb_render_context* ctx)
+{
+    if (!ctx) return;
+    ctx->frame++;
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    update_display(ctx);
+}
+
+void pb_render_clear(pb_render_context* ctx, uint8_t color)
+{
+    if (!ctx) return;
+    size_t size = (size_t)ctx->config.width * (size_t)ctx->config.height;
+    memset(ctx->pixels, color, size);
+    ctx->stats.pixels_filled += (int)size;
+    ctx->stats.draw_calls++;
+}
+
+void pb_render_end_frame(pb_render_context* ctx)
+{
+    (void)ctx;  /* Presentation belongs to the platform backend */
+}
+
+pb_render_stats pb_render_get_stats(const pb_render_context* ctx)
+{
+    pb_render_stats stats = {0, 0, 0, 0, 0.0f};
+    return ctx ? ctx->stats : stats;
+}
+
+uint32_t pb_render_get_frame(const pb_render_context* ctx)
+{
+    return ctx ? ctx->frame : 0;
+}
+
+const uint8_t* pb_render_get_framebuffer(const pb_render_context* ctx)
+{
+    return ctx ? ctx->pixels : NULL;
+}
+
+/*============================================================================
+ * Text
+ *============================================================================*/
+
+void pb_render_text_batch(pb_render_context* ctx, const pb_font_atlas* atlas,
+                          const pb_text_batch* batch)
+{
+    if (!ctx || !atlas || !batch || batch->count == 0) return;
+    int width = ctx->config.width;
+    int height = ctx->config.height;
+
+    for (int i = 0; i < batch->count; i++) {
+        const pb_text_quad* q = &batch->quads[i];
+
+        /* Clip the quad against the screen */
+        int x0 = (q->x < 0) ? -q->x : 0;
+        int y0 = (q->y < 0) ? -q->y : 0;
+        int x1 = (q->x + q->w > width) ? width - q->x : q->w;
+        int y1 = (q->y + q->h > height) ? height - q->y : q->h;
+
+        for (int y = y0; y < y1; y++) {
+            const uint8_t* src = &atlas->pixels[(q->src_y + y) * PB_FONT_ATLAS_W + q->src_x];
+            uint8_t* dst = &ctx->pixels[(q->y + y) * width + q->x];
+            for (int x = x0; x < x1; x++) {
+                if (src[x]) dst[x] = q->color;
+            }
+        }
+    }
+    ctx->stats.sprites_drawn += batch->count;
+    ctx->stats.draw_calls++;
+}
+
+/*============================================================================
+ * Sprites
+ *============================================================================*/
+
+/* Layers, then PB_SPRITE_PRIORITY on top */
+#define SPRITE_BUCKETS (PB_MAX_LAYERS + 1)
+
+static int layer_index(int layer)
+{
+    if (layer < 0) return 0;
+    return layer < PB_MAX_LAYERS ? layer : PB_MAX_LAYERS - 1;
+}
+
+static int sprite_bucket(const pb_indexed_sprite_instance* inst)
+{
+    return (inst->flags & PB_SPRITE_PRIORITY) ? PB_MAX_LAYERS
+                                              : layer_index(inst->layer);
+}
+
+static void blit_sprite(pb_render_context* ctx, const pb_indexed_sprite_instance* inst)
+{
+    const pb_indexed_sprite* spr = inst->sprite;
+    if (!spr || !spr->pixels || (inst->flags & PB_SPRITE_HIDDEN)) return;
+
+    /* Destination size and position, layer parallax applied */
+    bool rotate = (inst->flags & PB_SPRITE_ROTATE_90) != 0;
+    int w = rotate ? spr->height : spr->width;
+    int h = rotate ? spr->width : spr->height;
+    int x = inst->x;
+    int y = inst->y + ctx->layers[layer_index(inst->layer)].y_offset;
+    int width = ctx->config.width;
+
+    int x0 = (x < 0) ? -x : 0;
+    int y0 = (y < 0) ? -y : 0;
+    int x1 = (x + w > width) ? width - x : w;
+    int y1 = (y + h > ctx->config.height) ? ctx->config.height - y : h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    bool half_turn = (inst->flags & PB_SPRITE_ROTATE_180) != 0;
+    bool flip_h = ((inst->flags & PB_SPRITE_FLIP_H) != 0) != half_turn;
+    bool flip_v = ((inst->flags & PB_SPRITE_FLIP_V) != 0) != half_turn;
+    uint8_t offset = inst->palette_offset;
+
+    if (spr->opaque && !rotate && !flip_h && !flip_v && offset == 0) {
+        for (int ty = y0; ty < y1; ty++) {
+            memcpy(&ctx->pixels[(size_t)(y + ty) * (size_t)width + (size_t)(x + x0)],
+                   &spr->pixels[ty * spr->width + x0], (size_t)(x1 - x0));
+        }
+    } else {
+        for (int ty = y0; ty < y1; ty++) {
+            uint8_t* dst = &ctx->pixels[(size_t)(y + ty) * (size_t)width + (size_t)x];
+            int v = flip_v ? h - 1 - ty : ty;
+            for (int tx = x0; tx < x1; tx++) {
+                int u = flip_h ? w - 1 - tx : tx;
+
+                /* Quarter turn clockwise: destination (u, v) is source
+                 * column v, counted from the bottom row */
+                uint8_t c = rotate ? spr->pixels[(spr->height - 1 - u) * spr->width + v]
+                                   : spr->pixels[v * spr->width + u];
+                if (!spr->opaque && c == spr->transparent) continue;
+                dst[tx] = (uint8_t)(c + offset);
+            }
+        }
+    }
+    ctx->stats.sprites_drawn++;
+    ctx->stats.pixels_filled += (x1 - x0) * (y1 - y0);
+}
+
+bool pb_indexed_sprite_mark_opaque(pb_indexed_sprite* sprite)
+{
+    if (!sprite) return false;
+    sprite->opaque = sprite->pixels != NULL &&
+        !memchr(sprite->pixels, sprite->transparent,
+                (size_t)sprite->width * (size_t)sprite->height);
+    return sprite->opaque;
+}
+
+void pb_render_set_layer(pb_render_context* ctx, int layer,
+                         const pb_layer_config* config)
+{
+    if (!ctx || !config || layer < 0 || layer >= PB_MAX_LAYERS) return;
+    ctx->layers[layer] = *config;
+}
+
+void pb_render_indexed_sprite(pb_render_context* ctx,
+                              const pb_indexed_sprite_instance* inst)
+{
+    if (!ctx || !inst) return;
+    blit_sprite(ctx, inst);
+    ctx->stats.draw_calls++;
+}
+
+void pb_render_indexed_sprite_batch(pb_render_context* ctx,
+                                    const pb_indexed_sprite_instance* sprites,
+                                    int count)
+{
+    if (!ctx || !sprites || count <= 0) return;
+
+    if (count > ctx->order_capacity) {
+        int* order = realloc(ctx->order, (size_t)count * sizeof(*order));
+        if (order) {
+            ctx->order = order;
+            ctx->order_capacity = count;
+        }
+    }
+
+    if (count <= ctx->order_capacity) {
+        /* Counting sort: bucket sizes, prefix sums, stable scatter */
+        int start[SPRITE_BUCKETS + 1] = {0};
+        for (int i = 0; i < count; i++) {
+            start[sprite_bucket(&sprites[i]) + 1]++;
+        }
+        for (int b = 0; b < SPRITE_BUCKETS; b++) {
+            start[b + 1] += start[b];
+        }
+        for (int i = 0; i < count; i++) {
+            ctx->order[start[sprite_bucket(&sprites[i])]++] = i;
+        }
+        for (int i = 0; i < count; i++) {
+            blit_sprite(ctx, &sprites[ctx->order[i]]);
+        }
+    } else {
+        /* No scratch: one pass per bucket draws the same order */
+        for (int b = 0; b < SPRITE_BUCKETS; b++) {
+            for (int i = 0; i < count; i++) {
+                if (sprite_bucket(&sprites[i]) == b) blit_sprite(ctx, &sprites[i]);
+            }
+        }
+    }
+    ctx->stats.draw_calls++;
+}
+
+/*============================================================================
+ * Dithered Fills
+ *============================================================================*/
+
+/* Clip and fill one span; returns pixels written */
+static int fill_span(pb_render_context* ctx, int x, int y, int width,
+                     uint8_t color_a, uint8_t color_b, int level,
+                     pb_dither_type type)
+{
+    if (y < 0 || y >= ctx->config.height) return 0;
+    if (x < 0) {
+        width += x;
+        x = 0;
+    }
+    if (x + width > ctx->config.width) width = ctx->config.width - x;
+    if (width <= 0) return 0;
+
+    uint8_t* dst = &ctx->pixels[(size_t)y * (size_t)ctx->config.width + (size_t)x];
+    pb_dither_span(dst, x, y, width, color_a, color_b, level, type);
+    return width;
+}
+
+void pb_render_dither_span(pb_render_context* ctx, int x, int y, int width,
+                           uint8_t color_a, uint8_t color_b, pb_scalar blend,
+                           pb_dither_type type)
+{
+    if (!ctx) return;
+    ctx->stats.pixels_filled += fill_span(ctx, x, y, width, color_a, color_b,
+                                          pb_dither_level(blend), type);
+    ctx->stats.draw_calls++;
+}
+
+void pb_render_dither_rect(pb_render_context* ctx, int x, int y, int w, int h,
+                           uint8_t color_a, uint8_t color_b, pb_scalar blend,
+                           pb_dither_type type)
+{
+    if (!ctx) return;
+    int level = pb_dither_level(blend);
+    int y0 = y < 0 ? 0 : y;
+    int y1 = y + h > ctx->config.height ? ctx->config.height : y + h;
+    for (int row = y0; row < y1; row++) {
+        ctx->stats.pixels_filled += fill_span(ctx, x, row, w, color_a, color_b,
+                                              level, type);
+    }
+    ctx->stats.draw_calls++;
+}
+
+/*============================================================================
+ * Bubble-Specific Rendering
+ *============================================================================*/
+
+void pb_render_bubble(pb_render_context* ctx, int cx, int cy, int radius,
+                      uint8_t color)
+{
+    if (!ctx || radius <= 0) return;
+    pb_dither_type type = ctx->config.dither;
+    uint8_t highlight = (uint8_t)(color + 1);
+    uint8_t shadow = (uint8_t)(color + 2);
+    int rr = radius * radius;
+    int half = 0;
+
+    for (int dy = -radius; dy <= radius; dy++) {
+        /* Half-width of the row: largest half with half^2 + dy^2 <= r^2 */
+        int limit = rr - dy * dy;
+        while ((half + 1) * (half + 1) <= limit) half++;
+        while (half * half > limit) half--;
+
+        int filled;
+        if (dy < 0) {
+            int level = (dy + radius) * PB_DITHER_LEVELS / radius;
+            filled = fill_span(ctx, cx - half, cy + dy, 2 * half + 1,
+                               highlight, color, level, type);
+        } else {
+            int level = dy * PB_DITHER_LEVELS / radius;
+            filled = fill_span(ctx, cx - half, cy + dy, 2 * half + 1,
+                               color, shadow, level, type);
+        }
+        ctx->stats.pixels_filled += filled;
+    }
+    ctx->stats.sprites_drawn++;
+    ctx->stats.draw_calls++;
+}
+
+/*============================================================================
+ * Background/Parallax
+ *============================================================================*/
+
+void pb_render_background_gradient(pb_render_context* ctx, uint8_t color_top,
+                                    uint8_t color_bottom, pb_dither_type dither)
+{
+    if (!ctx) return;
+    int width = ctx->config.width;
+    int height = ctx->config.height;
+    int last = height > 1 ? height - 1 : 1;
+
+    for (int y = 0; y < height; y++) {
+        int level = (y * PB_DITHER_LEVELS + last / 2) / last;
+        pb_dither_span(&ctx->pixels[(size_t)y * (size_t)width], 0, y, width,
+                       color_top, color_bottom, level, dither);
+    }
+    ctx->stats.pixels_filled += width * height;
+    ctx->stats.draw_calls++;
+}
@@ -320,7 +320,9 @@ int pb_session_tick(pb_session* session)
     int events = pb_game_tick(&session->game);
 
     /* Record frame checksum */
-    record_frame_checksum(session);
+    if (!session->config.skip_frame_checksums) {
+        record_frame_checksum(session);
+    }
 
     /* Maybe create checkpoint */
     maybe_create_checkpoint(session);
@@ -489,6 +489,12 @@ pb_vec2 pb_magnetic_force(pb_point shot_pos, pb_point magnet_pos,
     pb_scalar dx = magnet_pos.x - shot_pos.x;
     pb_scalar dy = magnet_pos.y - shot_pos.y;
 
+    /* Beyond max radius on either axis: no force (and dx^2 + dy^2 cannot
+     * overflow a fixed-point scalar below) */
+    if (dx > max_radius || dx < -max_radius || dy > max_radius || dy < -max_radius) {
+        return zero;
+    }
+
     /* Distance squared */
     pb_scalar dist_sq = PB_FIXED_MUL(dx, dx) + PB_FIXED_MUL(dy, dy);
 
@@ -521,6 +527,20 @@ pb_vec2 pb_magnetic_force(pb_point shot_pos, pb_point magnet_pos,
     return force;
 }
 
+/* Strength from the bubble, or the default */
+static pb_scalar magnet_strength(const pb_bubble* b)
+{
+    return (b->payload.magnet_strength > 0)
+        ? PB_FLOAT_TO_FIXED((float)b->payload.magnet_strength)
+        : PB_MAGNETIC_DEFAULT_STRENGTH;
+}
+
+static bool is_magnet(const pb_bubble* b)
+{
+    return b != NULL && b->kind == PB_KIND_SPECIAL &&
+           b->special == PB_SPECIAL_MAGNETIC;
+}
+
 void pb_apply_magnetic_forces(pb_shot* shot, const pb_board* board,
                               pb_scalar radius)
 {
@@ -539,20 +559,13 @@ void pb_apply_magnetic_forces(pb_shot* shot, const pb_board* board,
             pb_offset pos = {row, col};
             const pb_bubble* b = pb_board_get_const(board, pos);
 
-            if (b == NULL || b->kind != PB_KIND_SPECIAL) {
-                continue;
-            }
-            if (b->special != PB_SPECIAL_MAGNETIC) {
+            if (!is_magnet(b)) {
                 continue;
             }
 
             /* Get magnetic bubble position in pixels */
             pb_point magnet_pos = pb_offset_to_pixel(pos, radius);
-
-            /* Get strength from bubble or use default */
-            pb_scalar strength = (b->payload.magnet_strength > 0)
-                ? PB_FLOAT_TO_FIXED((float)b->payload.magnet_strength)
-                : PB_MAGNETIC_DEFAULT_STRENGTH;
+            pb_scalar strength = magnet_strength(b);
 
             /* Calculate force from this magnet */
             pb_vec2 force = pb_magnetic_force(shot->pos, magnet_pos,
@@ -567,3 +580,231 @@ void pb_apply_magnetic_forces(pb_shot* shot, const pb_board* board,
     shot->velocity.x += total_fx;
     shot->velocity.y += total_fy;
 }
+
+/*============================================================================
+ * Magnet Field Grid
+ *============================================================================*/
+
+/* pb_scalar <-> Q16.16 */
+#if PB_USE_FIXED_POINT
+#define SCALAR_TO_Q16(x) ((int32_t)(x) * (1 << (16 - PB_FIXED_SHIFT)))
+#define Q16_TO_SCALAR(q) ((pb_scalar)((q) / (1 << (16 - PB_FIXED_SHIFT))))
+#else
+#define SCALAR_TO_Q16(x) ((int32_t)((x) * 65536.0f + ((x) < 0 ? -0.5f : 0.5f)))
+#define Q16_TO_SCALAR(q) ((pb_scalar)(q) / 65536.0f)
+#endif
+
+/* Coarsest spacing considered (16384px); any board fits long before */
+#define FIELD_MAX_SHIFT 14
+
+/* Q16.16 pixels are exact up to here; the field never reaches it */
+#define FIELD_COORD_LIMIT 32000
+
+/* Whether the field was built from this board's magnets and radius */
+static bool layout_matches(const pb_magnet_field* field, const pb_board* board,
+                           pb_scalar radius)
+{
+    if (!field->built || field->layout_radius != SCALAR_TO_Q16(radius) ||
+        field->layout_rows != board->rows || field->layout_cols_even != board->cols_even ||
+        field->layout_cols_odd != board->cols_odd) {
+        return false;
+    }
+
+    int n = 0;
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            if (!is_magnet(b)) {
+                continue;
+            }
+            if (n >= field->layout_count ||
+                field->layout_cell[n] != (uint16_t)(row * PB_MAX_COLS + col) ||
+                field->layout_strength[n] != b->payload.magnet_strength) {
+                return false;
+            }
+            n++;
+        }
+    }
+    return n == field->layout_count;
+}
+
+static int32_t field_lerp(int32_t a, int32_t b, int32_t t)
+{
+    return a + (int32_t)(((int64_t)(b - a) * t) >> 16);
+}
+
+void pb_magnet_field_init(pb_magnet_field* field)
+{
+    pb_memset(field, 0, sizeof(*field));
+    field->built = false;
+    field->shift = PB_MAGNET_FIELD_MIN_SHIFT;
+}
+
+int pb_magnet_field_build(pb_magnet_field* field, const pb_board* board,
+                          pb_scalar radius)
+{
+    field->built = true;
+    field->layout_radius = SCALAR_TO_Q16(radius);
+    field->layout_rows = board->rows;
+    field->layout_cols_even = board->cols_even;
+    field->layout_cols_odd = board->cols_odd;
+    field->layout_count = 0;
+    field->magnets = 0;
+    field->cols = 0;
+    field->rows = 0;
+    field->shift = PB_MAGNET_FIELD_MIN_SHIFT;
+    field->origin_x = 0;
+    field->origin_y = 0;
+
+    pb_point pos[PB_MAX_CELLS];
+    pb_scalar strength[PB_MAX_CELLS];
+    int n = 0;
+    int32_t min_x = INT32_MAX, min_y = INT32_MAX;
+    int32_t max_x = INT32_MIN, max_y = INT32_MIN;
+
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            if (!is_magnet(b)) {
+                continue;
+            }
+            field->layout_cell[n] = (uint16_t)(row * PB_MAX_COLS + col);
+            field->layout_strength[n] = b->payload.magnet_strength;
+            field->layout_count = n + 1;
+            pos[n] = pb_offset_to_pixel((pb_offset){row, col}, radius);
+            strength[n] = magnet_strength(b);
+
+            int32_t x = SCALAR_TO_Q16(pos[n].x);
+            int32_t y = SCALAR_TO_Q16(pos[n].y);
+            if (x < min_x) min_x = x;
+            if (x > max_x) max_x = x;
+            if (y < min_y) min_y = y;
+            if (y > max_y) max_y = y;
+            n++;
+        }
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    /* Cover every point within reach of a magnet, plus a pixel of slack */
+    int32_t reach = SCALAR_TO_Q16(PB_MAGNETIC_DEFAULT_RADIUS) + (1 << 16);
+    field->origin_x = min_x - reach;
+    field->origin_y = min_y - reach;
+    int32_t span_x = max_x - min_x + 2 * reach;
+    int32_t span_y = max_y - min_y + 2 * reach;
+
+    int shift = PB_MAGNET_FIELD_MIN_SHIFT;
+    int cols, rows;
+    for (;;) {
+        cols = (int)(span_x >> (16 + shift)) + 2;
+        rows = (int)(span_y >> (16 + shift)) + 2;
+        if (cols * rows <= PB_MAGNET_FIELD_MAX_NODES || shift >= FIELD_MAX_SHIFT) {
+            break;
+        }
+        shift++;
+    }
+    if (cols * rows > PB_MAGNET_FIELD_MAX_NODES) {
+        return 0;
+    }
+    field->shift = shift;
+    field->cols = cols;
+    field->rows = rows;
+    pb_memset(field->force, 0, (size_t)(cols * rows) * sizeof(field->force[0]));
+
+    /* Each magnet only touches the nodes within its reach */
+    int32_t step = (int32_t)1 << (16 + shift);
+    for (int m = 0; m < n; m++) {
+        int32_t mx = SCALAR_TO_Q16(pos[m].x) - field->origin_x;
+        int32_t my = SCALAR_TO_Q16(pos[m].y) - field->origin_y;
+        int c0 = (int)((mx - reach) >> (16 + shift));
+        int r0 = (int)((my - reach) >> (16 + shift));
+        int c1 = (int)((mx + reach) >> (16 + shift)) + 1;
+        int r1 = (int)((my + reach) >> (16 + shift)) + 1;
+        if (c0 < 0) c0 = 0;
+        if (r0 < 0) r0 = 0;
+        if (c1 > cols - 1) c1 = cols - 1;
+        if (r1 > rows - 1) r1 = rows - 1;
+
+        for (int r = r0; r <= r1; r++) {
+            pb_point node;
+            node.y = Q16_TO_SCALAR(field->origin_y + r * step);
+            for (int c = c0; c <= c1; c++) {
+                node.x = Q16_TO_SCALAR(field->origin_x + c * step);
+                pb_vec2 f = pb_magnetic_force(node, pos[m], strength[m],
+                                              PB_MAGNETIC_DEFAULT_RADIUS);
+                field->force[r * cols + c][0] += SCALAR_TO_Q16(f.x);
+                field->force[r * cols + c][1] += SCALAR_TO_Q16(f.y);
+            }
+        }
+    }
+
+    field->magnets = n;
+    return n;
+}
+
+bool pb_magnet_field_update(pb_magnet_field* field, const pb_board* board,
+                            pb_scalar radius)
+{
+    if (layout_matches(field, board, radius)) {
+        return false;
+    }
+    pb_magnet_field_build(field, board, radius);
+    return true;
+}
+
+pb_vec2 pb_magnet_field_sample(const pb_magnet_field* field, pb_point pos)
+{
+    pb_vec2 zero = {0, 0};
+    if (field->magnets == 0) {
+        return zero;
+    }
+#if !PB_USE_FIXED_POINT
+    if (pos.x < -FIELD_COORD_LIMIT || pos.x > FIELD_COORD_LIMIT ||
+        pos.y < -FIELD_COORD_LIMIT || pos.y > FIELD_COORD_LIMIT) {
+        return zero;
+    }
+#endif
+
+    int32_t px = SCALAR_TO_Q16(pos.x) - field->origin_x;
+    int32_t py = SCALAR_TO_Q16(pos.y) - field->origin_y;
+    if (px < 0 || py < 0) {
+        return zero;
+    }
+
+    int cell_shift = 16 + field->shift;
+    int c = (int)(px >> cell_shift);
+    int r = (int)(py >> cell_shift);
+    if (c >= field->cols - 1 || r >= field->rows - 1) {
+        return zero;
+    }
+
+    /* Position within the cell, Q16 */
+    int32_t tx = (px & ((1 << cell_shift) - 1)) >> field->shift;
+    int32_t ty = (py & ((1 << cell_shift) - 1)) >> field->shift;
+
+    const int32_t (*n00)[2] = &field->force[r * field->cols + c];
+    const int32_t (*n10)[2] = n00 + field->cols;
+    int32_t out[2];
+    for (int k = 0; k < 2; k++) {
+        int32_t top = field_lerp(n00[0][k], n00[1][k], tx);
+        int32_t bottom = field_lerp(n10[0][k], n10[1][k], tx);
+        out[k] = field_lerp(top, bottom, ty);
+    }
+
+    pb_vec2 force = {Q16_TO_SCALAR(out[0]), Q16_TO_SCALAR(out[1])};
+    return force;
+}
+
+void pb_apply_magnet_field(pb_shot* shot, const pb_magnet_field* field)
+{
+    if (shot->phase != PB_SHOT_MOVING) {
+        return;
+    }
+
+    pb_vec2 force = pb_magnet_field_sample(field, shot->pos);
+    shot->velocity.x += force.x;
+    shot->velocity.y += force.y;
+}
@@ -54,12 +54,8 @@ void pb_board_analyze(const pb_board* board, pb_board_stats* stats)
     /* Find orphans */
     stats->orphan_count = pb_count_orphans(board);
 
-    /* Find largest group (simplified - just check each color) */
-    for (int c = 0; c < PB_MAX_COLORS; c++) {
-        if (stats->color_counts[c] > stats->max_group_size) {
-            stats->max_group_size = stats->color_counts[c];
-        }
-    }
+    /* Largest connected same-color cluster */
+    stats->max_group_size = pb_board_largest_cluster(board);
 }
 
 int pb_count_orphans(const pb_board* board)
@@ -233,6 +229,7 @@ void pb_solver_init(pb_solver* solver, const pb_board* board,
                     const pb_ruleset* ruleset, uint64_t seed)
 {
     memcpy(&solver->board, board, sizeof(pb_board));
+    pb_board_track_neighbors(&solver->board, true);
 
     if (ruleset) {
         solver->ruleset = *ruleset;
@@ -286,25 +283,9 @@ static float evaluate_target(const pb_board* board, pb_offset target,
 {
     float score = 0.0f;
 
-    /* Count adjacent same-color bubbles */
-    pb_offset neighbors[6];
-    pb_hex_neighbors_offset(target, neighbors);
-
-    int same_color = 0;
-    int any_neighbor = 0;
-
-    for (int i = 0; i < 6; i++) {
-        pb_offset n = neighbors[i];
-        if (!pb_board_in_bounds(board, n)) continue;
-
-        const pb_bubble* nb = pb_board_get_const(board, n);
-        if (nb->kind == PB_KIND_NONE) continue;
-
-        any_neighbor++;
-        if (nb->kind == PB_KIND_COLORED && nb->color_id == color_id) {
-            same_color++;
-        }
-    }
+    /* Adjacent bubbles (table lookups when the board tracks neighbors) */
+    int same_color = pb_board_neighbor_color_count(board, target, color_id);
+    int any_neighbor = pb_board_neighbor_total(board, target);
 
     /* No neighbors = floating shot, very bad */
     if (any_neighbor == 0) {
@@ -493,6 +474,17 @@ bool pb_analyze_solvability(const pb_board* board,
                             const pb_bubble* queue, int queue_length,
                             int max_search,
                             pb_solvability* result)
+{
+    return pb_analyze_solvability_ex(board, ruleset, queue, queue_length,
+                                     max_search, NULL, NULL, result);
+}
+
+bool pb_analyze_solvability_ex(const pb_board* board,
+                               const pb_ruleset* ruleset,
+                               const pb_bubble* queue, int queue_length,
+                               int max_search,
+                               pb_solvability_step_fn on_step, void* userdata,
+                               pb_solvability* result)
 {
     memset(result, 0, sizeof(*result));
 
@@ -561,6 +553,13 @@ bool pb_analyze_solvability(const pb_board* board,
         }
 
         cleared = pb_solver_is_cleared(&solver);
+
+        if (on_step && !cleared) {
+            result->min_moves = moves_used;
+            if (!on_step(result, userdata)) {
+                return false;
+            }
+        }
     }
 
     result->solvable = cleared;
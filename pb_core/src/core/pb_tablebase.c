@@ -0,0 +1,605 @@
+/*
+ * pb_tablebase.c - Endgame tablebase generation, storage and probing
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "pb/pb_tablebase.h"
+#include "pb/pb_exact.h"
+#include "pb/pb_canon.h"
+#include "pb/pb_compat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pb/pb_freestanding.h"
+
+#if !PB_PLATFORM_FREESTANDING && (defined(__unix__) || defined(__APPLE__))
+#define TB_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define TB_HAVE_MMAP 0
+#endif
+
+PB_STATIC_ASSERT(sizeof(pb_tablebase_header) == 40,
+                 "pb_tablebase_header must stay 40 bytes");
+
+/*============================================================================
+ * Key Encoding
+ *
+ * Bubbles are visited in row-major order. Each contributes 10 bits:
+ * a 7-bit cell index (row * 8 + col) and a 3-bit relabeled color.
+ * The top 4 bits hold the bubble count.
+ *============================================================================*/
+
+#define TB_CELL_BITS    10
+#define TB_GRID_COLS    8
+
+static uint64_t encode_key(const pb_offset* cells, const uint8_t* labels, int count)
+{
+    uint64_t key = (uint64_t)count << 60;
+    for (int i = 0; i < count; i++) {
+        uint64_t idx = (uint64_t)(cells[i].row * TB_GRID_COLS + cells[i].col);
+        key |= ((idx << 3) | labels[i]) << (TB_CELL_BITS * i);
+    }
+    return key;
+}
+
+static int decode_key(uint64_t key, pb_offset* cells, uint8_t* labels)
+{
+    int count = (int)(key >> 60);
+    for (int i = 0; i < count; i++) {
+        unsigned field = (unsigned)(key >> (TB_CELL_BITS * i)) & 0x3FFu;
+        unsigned idx = field >> 3;
+        cells[i].row = (int)(idx / TB_GRID_COLS);
+        cells[i].col = (int)(idx % TB_GRID_COLS);
+        labels[i] = (uint8_t)(field & 7u);
+    }
+    return count;
+}
+
+/*============================================================================
+ * Header Validation
+ *============================================================================*/
+
+static uint32_t ipow(uint32_t base, int exp)
+{
+    uint32_t r = 1;
+    while (exp-- > 0) r *= base;
+    return r;
+}
+
+static pb_result attach_image(pb_tablebase* tb, const void* data, size_t size)
+{
+    const pb_tablebase_header* h = (const pb_tablebase_header*)data;
+
+    if (size < sizeof(*h) || ((uintptr_t)data & 7u) != 0) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (h->magic != PB_TB_MAGIC || h->version != PB_TB_VERSION ||
+        h->endian != PB_TB_ENDIAN_MARK) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (h->max_bubbles < 1 || h->max_bubbles > PB_TB_MAX_BUBBLES ||
+        h->horizon < 1 || h->horizon > PB_TB_MAX_HORIZON ||
+        h->colors < 2 || h->colors > PB_TB_MAX_COLORS ||
+        h->value_stride != ipow(h->colors, h->horizon)) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    uint64_t keys_end = h->keys_offset + (uint64_t)h->entry_count * sizeof(uint64_t);
+    uint64_t values_end = h->values_offset +
+                          (uint64_t)h->entry_count * h->value_stride;
+    if ((h->keys_offset & 7u) != 0 || keys_end > size || values_end > size ||
+        h->keys_offset < sizeof(*h) || h->values_offset < keys_end) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    tb->header = h;
+    tb->keys = (const uint64_t*)((const uint8_t*)data + h->keys_offset);
+    tb->values = (const uint8_t*)data + h->values_offset;
+    return PB_OK;
+}
+
+/*============================================================================
+ * Probing
+ *============================================================================*/
+
+int pb_tablebase_probe(const pb_tablebase* tb, const pb_board* board,
+                       const pb_bubble* shots, int shot_count)
+{
+    if (!tb || !tb->header || !board) {
+        return PB_TB_PROBE_MISS;
+    }
+
+    const pb_tablebase_header* h = tb->header;
+    if (board->cols_even != h->cols_even || board->cols_odd != h->cols_odd ||
+        board->rows != h->rows || board->ceiling_row != 0) {
+        return PB_TB_PROBE_MISS;
+    }
+
+    /* Cheap rejection before canonicalizing */
+    int count = 0;
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            if (b->kind == PB_KIND_NONE) continue;
+            if (b->kind != PB_KIND_COLORED || b->color_id >= PB_MAX_COLORS ||
+                ++count > h->max_bubbles) {
+                return PB_TB_PROBE_MISS;
+            }
+        }
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+    if (shot_count < h->horizon) {
+        return PB_TB_PROBE_MISS;
+    }
+    for (int i = 0; i < h->horizon; i++) {
+        if (shots[i].kind != PB_KIND_COLORED || shots[i].color_id >= PB_MAX_COLORS) {
+            return PB_TB_PROBE_MISS;
+        }
+    }
+
+    pb_canon_form form;
+    if (pb_canon_compute(board, shots, h->horizon, &form) != PB_OK) {
+        return PB_TB_PROBE_MISS;
+    }
+
+    pb_offset cells[PB_TB_MAX_BUBBLES];
+    uint8_t labels[PB_TB_MAX_BUBBLES];
+    int n = 0;
+    for (int row = 0; row < h->max_bubbles && n < count; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &form.board.cells[row][col];
+            if (b->kind == PB_KIND_NONE) continue;
+            if (b->color_id >= h->colors) {
+                return PB_TB_PROBE_MISS;
+            }
+            cells[n].row = row;
+            cells[n].col = col;
+            labels[n] = b->color_id;
+            n++;
+        }
+    }
+    if (n != count) {
+        return PB_TB_PROBE_MISS;    /* Hangs below the stored rows */
+    }
+
+    /* Queue window in base `colors` */
+    uint32_t pattern = 0;
+    uint32_t scale = 1;
+    for (int i = 0; i < h->horizon; i++) {
+        if (form.queue[i].color_id >= h->colors) {
+            return PB_TB_PROBE_MISS;
+        }
+        pattern += form.queue[i].color_id * scale;
+        scale *= h->colors;
+    }
+
+    uint64_t key = encode_key(cells, labels, count);
+    uint32_t lo = 0;
+    uint32_t hi = h->entry_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (tb->keys[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo >= h->entry_count || tb->keys[lo] != key) {
+        return PB_TB_PROBE_MISS;
+    }
+
+    uint8_t v = tb->values[(size_t)lo * h->value_stride + pattern];
+    if (v == PB_TB_NOT_STORED) {
+        return PB_TB_PROBE_MISS;
+    }
+    return v == PB_TB_UNSOLVED ? h->horizon + 1 : v;
+}
+
+/*============================================================================
+ * Generation
+ *============================================================================*/
+
+typedef struct tb_gen {
+    pb_board board;             /* Scratch board on the target geometry */
+    pb_offset cells[PB_MAX_CELLS];
+    int cell_count;
+    int threshold;
+    int colors;
+    int max_bubbles;
+
+    uint64_t* keys;
+    uint32_t key_count;
+    uint32_t key_capacity;
+    bool oom;
+    pb_canon_form canon;        /* Scratch for the mirror check */
+} tb_gen;
+
+static void gen_push_key(tb_gen* g, uint64_t key)
+{
+    if (g->key_count == g->key_capacity) {
+        uint32_t cap = g->key_capacity ? g->key_capacity * 2 : 1024;
+        uint64_t* keys = realloc(g->keys, cap * sizeof(uint64_t));
+        if (!keys) {
+            g->oom = true;
+            return;
+        }
+        g->keys = keys;
+        g->key_capacity = cap;
+    }
+    g->keys[g->key_count++] = key;
+}
+
+static bool board_is_stable(const pb_board* board, const pb_offset* cells,
+                            int count, int threshold)
+{
+    for (int i = 0; i < count; i++) {
+        pb_visit_result group;
+        if (pb_find_matches(board, cells[i], &group) >= threshold) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Assign restricted-growth color labels to the chosen cells */
+static void gen_colorings(tb_gen* g, const pb_offset* cells, int count,
+                          uint8_t* labels, int index, int used)
+{
+    if (g->oom) return;
+
+    if (index == count) {
+        /* Store one orientation per mirror pair */
+        if (board_is_stable(&g->board, cells, count, g->threshold) &&
+            pb_canon_compute(&g->board, NULL, 0, &g->canon) == PB_OK &&
+            !g->canon.mirrored) {
+            gen_push_key(g, encode_key(cells, labels, count));
+        }
+        return;
+    }
+
+    int limit = used + 1 < g->colors ? used + 1 : g->colors;
+    for (int c = 0; c < limit; c++) {
+        labels[index] = (uint8_t)c;
+        g->board.cells[cells[index].row][cells[index].col].color_id = (uint8_t)c;
+        gen_colorings(g, cells, count, labels, index + 1, c == used ? used + 1 : used);
+    }
+}
+
+/* Choose cell subsets in row-major order; keep those hanging from the ceiling */
+static void gen_subsets(tb_gen* g, pb_offset* chosen, int count, int start)
+{
+    if (g->oom) return;
+
+    if (count > 0) {
+        pb_visit_result orphans;
+        if (pb_find_orphans(&g->board, &orphans) == 0) {
+            uint8_t labels[PB_TB_MAX_BUBBLES];
+            gen_colorings(g, chosen, count, labels, 0, 0);
+        }
+    }
+    if (count == g->max_bubbles) {
+        return;
+    }
+
+    pb_bubble b = {PB_KIND_COLORED, 0, 0, PB_SPECIAL_NONE, {0}};
+    for (int i = start; i < g->cell_count; i++) {
+        chosen[count] = g->cells[i];
+        pb_board_set(&g->board, g->cells[i], b);
+        gen_subsets(g, chosen, count + 1, i + 1);
+        pb_board_remove(&g->board, g->cells[i]);
+    }
+}
+
+/* Can `board` be cleared with at most `depth` of the given shots? */
+static bool clears_within(const pb_board* board, const pb_bubble* shots,
+                          int depth, int threshold)
+{
+    int lb = pb_exact_lower_bound(board, threshold, shots, depth);
+    if (lb == 0) return true;
+    if (lb > depth) return false;
+
+    pb_offset cells[PB_MAX_CELLS];
+    int n = pb_exact_attachable_cells(board, cells, PB_MAX_CELLS);
+    for (int i = 0; i < n; i++) {
+        pb_board child = *board;
+        if (!pb_exact_play(&child, cells[i], shots[0].color_id, threshold,
+                           NULL, NULL)) {
+            continue;
+        }
+        if (clears_within(&child, shots + 1, depth - 1, threshold)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* A window is canonical if labels new to the board appear in order */
+static bool window_is_canonical(const uint8_t* digits, int horizon, int board_labels)
+{
+    int next = board_labels;
+    for (int i = 0; i < horizon; i++) {
+        if (digits[i] > next) return false;
+        if (digits[i] == next) next++;
+    }
+    return true;
+}
+
+static int compare_keys(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+void pb_tablebase_config_default(pb_tablebase_config* config)
+{
+    config->max_bubbles = 3;
+    config->horizon = 3;
+    config->colors = 4;
+    config->match_threshold = PB_DEFAULT_MATCH_THRESHOLD;
+}
+
+pb_result pb_tablebase_generate(pb_tablebase* tb, const pb_tablebase_config* config)
+{
+    pb_tablebase_config cfg;
+    if (!tb) {
+        return PB_ERR_INVALID_ARG;
+    }
+    if (config) {
+        cfg = *config;
+    } else {
+        pb_tablebase_config_default(&cfg);
+    }
+    if (cfg.match_threshold <= 0) {
+        cfg.match_threshold = PB_DEFAULT_MATCH_THRESHOLD;
+    }
+    if (cfg.max_bubbles < 1 || cfg.max_bubbles > PB_TB_MAX_BUBBLES ||
+        cfg.horizon < 1 || cfg.horizon > PB_TB_MAX_HORIZON ||
+        cfg.colors < 2 || cfg.colors > PB_TB_MAX_COLORS) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    memset(tb, 0, sizeof(*tb));
+
+    tb_gen* g = calloc(1, sizeof(*g));
+    if (!g) {
+        return PB_ERR_NO_MEMORY;
+    }
+    g->threshold = cfg.match_threshold;
+    g->colors = cfg.colors;
+    g->max_bubbles = cfg.max_bubbles;
+    pb_board_init(&g->board);
+
+    /* An anchored set of K bubbles cannot reach below row K-1 */
+    for (int row = 0; row < cfg.max_bubbles && row < g->board.rows; row++) {
+        int cols = pb_row_cols(row, g->board.cols_even, g->board.cols_odd);
+        for (int col = 0; col < cols; col++) {
+            g->cells[g->cell_count].row = row;
+            g->cells[g->cell_count].col = col;
+            g->cell_count++;
+        }
+    }
+
+    pb_offset chosen[PB_TB_MAX_BUBBLES];
+    gen_subsets(g, chosen, 0, 0);
+    if (g->oom) {
+        free(g->keys);
+        free(g);
+        return PB_ERR_NO_MEMORY;
+    }
+    qsort(g->keys, g->key_count, sizeof(uint64_t), compare_keys);
+
+    uint32_t stride = ipow((uint32_t)cfg.colors, cfg.horizon);
+    size_t keys_offset = sizeof(pb_tablebase_header);
+    size_t values_offset = keys_offset + (size_t)g->key_count * sizeof(uint64_t);
+    size_t size = values_offset + (size_t)g->key_count * stride;
+
+    /* uint64_t storage keeps the image 8-byte aligned */
+    void* image = calloc((size + 7) / 8, sizeof(uint64_t));
+    if (!image) {
+        free(g->keys);
+        free(g);
+        return PB_ERR_NO_MEMORY;
+    }
+
+    pb_tablebase_header* h = (pb_tablebase_header*)image;
+    h->magic = PB_TB_MAGIC;
+    h->version = PB_TB_VERSION;
+    h->endian = PB_TB_ENDIAN_MARK;
+    h->cols_even = (uint8_t)g->board.cols_even;
+    h->cols_odd = (uint8_t)g->board.cols_odd;
+    h->rows = (uint8_t)g->board.rows;
+    h->match_threshold = (uint8_t)cfg.match_threshold;
+    h->max_bubbles = (uint8_t)cfg.max_bubbles;
+    h->horizon = (uint8_t)cfg.horizon;
+    h->colors = (uint8_t)cfg.colors;
+    h->entry_count = g->key_count;
+    h->value_stride = stride;
+    h->keys_offset = keys_offset;
+    h->values_offset = values_offset;
+
+    uint64_t* keys = (uint64_t*)((uint8_t*)image + keys_offset);
+    uint8_t* values = (uint8_t*)image + values_offset;
+    memcpy(keys, g->keys, (size_t)g->key_count * sizeof(uint64_t));
+
+    for (uint32_t e = 0; e < g->key_count; e++) {
+        pb_offset cells[PB_TB_MAX_BUBBLES];
+        uint8_t labels[PB_TB_MAX_BUBBLES];
+        int count = decode_key(keys[e], cells, labels);
+
+        pb_board_clear(&g->board);
+        int board_labels = 0;
+        for (int i = 0; i < count; i++) {
+            pb_bubble b = {PB_KIND_COLORED, labels[i], 0, PB_SPECIAL_NONE, {0}};
+            pb_board_set(&g->board, cells[i], b);
+            if (labels[i] + 1 > board_labels) board_labels = labels[i] + 1;
+        }
+
+        for (uint32_t p = 0; p < stride; p++) {
+            uint8_t digits[PB_TB_MAX_HORIZON];
+            pb_bubble shots[PB_TB_MAX_HORIZON] = {{0}};
+            uint32_t rest = p;
+            for (int i = 0; i < cfg.horizon; i++) {
+                digits[i] = (uint8_t)(rest % (uint32_t)cfg.colors);
+                rest /= (uint32_t)cfg.colors;
+                shots[i].kind = PB_KIND_COLORED;
+                shots[i].color_id = digits[i];
+            }
+
+            uint8_t* v = &values[(size_t)e * stride + p];
+            if (!window_is_canonical(digits, cfg.horizon, board_labels)) {
+                *v = PB_TB_NOT_STORED;
+                continue;
+            }
+
+            *v = PB_TB_UNSOLVED;
+            for (int d = 1; d <= cfg.horizon; d++) {
+                if (clears_within(&g->board, shots, d, cfg.match_threshold)) {
+                    *v = (uint8_t)d;
+                    break;
+                }
+            }
+        }
+    }
+
+    free(g->keys);
+    free(g);
+
+    tb->storage = image;
+    tb->storage_size = size;
+    tb->mapped = false;
+    return attach_image(tb, image, size);
+}
+
+/*============================================================================
+ * File I/O
+ *============================================================================*/
+
+pb_result pb_tablebase_save(const pb_tablebase* tb, const char* path)
+{
+    if (!tb || !tb->header || !path) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    const pb_tablebase_header* h = tb->header;
+    size_t size = (size_t)h->values_offset + (size_t)h->entry_count * h->value_stride;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return PB_ERR_INVALID_STATE;
+    }
+    size_t written = fwrite(h, 1, size, f);
+    int closed = fclose(f);
+    return (written == size && closed == 0) ? PB_OK : PB_ERR_INVALID_STATE;
+}
+
+pb_result pb_tablebase_from_memory(pb_tablebase* tb, const void* data, size_t size)
+{
+    if (!tb || !data) {
+        return PB_ERR_INVALID_ARG;
+    }
+    memset(tb, 0, sizeof(*tb));
+    return attach_image(tb, data, size);
+}
+
+pb_result pb_tablebase_open(pb_tablebase* tb, const char* path)
+{
+    if (!tb || !path) {
+        return PB_ERR_INVALID_ARG;
+    }
+    memset(tb, 0, sizeof(*tb));
+
+#if TB_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return PB_ERR_INVALID_STATE;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return PB_ERR_INVALID_STATE;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return PB_ERR_NO_MEMORY;
+    }
+
+    pb_result r = attach_image(tb, map, size);
+    if (r != PB_OK) {
+        munmap(map, size);
+        memset(tb, 0, sizeof(*tb));
+        return r;
+    }
+    tb->storage = map;
+    tb->storage_size = size;
+    tb->mapped = true;
+    return PB_OK;
+#else
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return PB_ERR_INVALID_STATE;
+    }
+    if (fseek(f, 0, SEEK_END) != 0) {
+        fclose(f);
+        return PB_ERR_INVALID_STATE;
+    }
+    long len = ftell(f);
+    if (len <= 0 || fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return PB_ERR_INVALID_STATE;
+    }
+    size_t size = (size_t)len;
+    void* image = malloc((size + 7) / 8 * sizeof(uint64_t));
+    if (!image) {
+        fclose(f);
+        return PB_ERR_NO_MEMORY;
+    }
+    size_t got = fread(image, 1, size, f);
+    fclose(f);
+
+    pb_result r = got == size ? attach_image(tb, image, size) : PB_ERR_INVALID_STATE;
+    if (r != PB_OK) {
+        free(image);
+        memset(tb, 0, sizeof(*tb));
+        return r;
+    }
+    tb->storage = image;
+    tb->storage_size = size;
+    tb->mapped = false;
+    return PB_OK;
+#endif
+}
+
+void pb_tablebase_close(pb_tablebase* tb)
+{
+    if (!tb) return;
+
+    if (tb->storage) {
+#if TB_HAVE_MMAP
+        if (tb->mapped) {
+            munmap(tb->storage, tb->storage_size);
+        } else {
+            free(tb->storage);
+        }
+#else
+        free(tb->storage);
+#endif
+    }
+    memset(tb, 0, sizeof(*tb));
+}
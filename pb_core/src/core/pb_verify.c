@@ -0,0 +1,390 @@
+/*
+ * pb_verify.c - Segment-parallel replay verification
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_verify.h"
+#include "pb/pb_session.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if PB_FEATURE_THREADS
+#include <pthread.h>
+#endif
+
+/*============================================================================
+ * Internal Types
+ *============================================================================*/
+
+/* Everything in pb_game_state before the event log */
+#define VERIFY_STATE_BYTES offsetof(pb_game_state, events)
+
+#define VERIFY_NO_SEGMENT UINT32_MAX
+
+typedef struct verify_snapshot {
+    uint32_t tick;              /* Ticks played before this snapshot */
+    uint32_t state_checksum;    /* pb_state_checksum() at this point */
+    pb_playback playback;       /* Event cursor (replay pointer rebound) */
+} verify_snapshot;
+
+typedef struct verify_shared {
+    const pb_replay* replay;
+    const pb_ruleset* ruleset;
+
+    /* Fast-forward output: segment i runs from snaps[i] to snaps[i + 1] */
+    verify_snapshot* snaps;     /* [segment_count + 1] */
+    uint8_t* states;            /* [segment_count] * VERIFY_STATE_BYTES */
+    uint32_t segment_count;
+    uint32_t capacity;
+
+    /* Guarded by lock when threaded */
+    uint32_t next_segment;
+    uint32_t failed_segment;    /* Earliest failing segment */
+    pb_desync_info desync;
+    uint32_t segments_verified;
+    uint32_t checkpoints_verified;
+    pb_result status;
+#if PB_FEATURE_THREADS
+    pthread_mutex_t lock;
+#endif
+} verify_shared;
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static void shared_lock(verify_shared* sh)
+{
+#if PB_FEATURE_THREADS
+    pthread_mutex_lock(&sh->lock);
+#else
+    (void)sh;
+#endif
+}
+
+static void shared_unlock(verify_shared* sh)
+{
+#if PB_FEATURE_THREADS
+    pthread_mutex_unlock(&sh->lock);
+#else
+    (void)sh;
+#endif
+}
+
+static pb_result open_session(pb_session* session, const verify_shared* sh,
+                              pb_session_mode mode)
+{
+    pb_session_config config;
+    pb_session_config_default(&config);
+    config.mode = mode;
+    config.auto_checkpoint = false;
+    config.verify_checksums = (mode == PB_SESSION_VERIFICATION);
+    config.skip_frame_checksums = true;
+
+    pb_replay replay_copy = *sh->replay;
+    pb_result result = pb_session_create_playback(session, &replay_copy,
+                                                  sh->ruleset, &config);
+    if (result == PB_OK) {
+        pb_game_set_event_log(&session->game, false);
+    }
+    return result;
+}
+
+/* Checkpoints with frame in (from, to] */
+static uint32_t count_checkpoints(const pb_replay* replay, uint32_t from, uint32_t to)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < replay->checkpoint_count; i++) {
+        uint32_t f = replay->checkpoints[i].frame;
+        if (f > from && f <= to) n++;
+    }
+    return n;
+}
+
+/*============================================================================
+ * Pass 1: Fast-Forward
+ *============================================================================*/
+
+static bool push_snapshot(verify_shared* sh, const pb_session* session, uint32_t tick)
+{
+    uint32_t index = sh->segment_count;
+    if (index + 1 >= sh->capacity) {
+        uint32_t capacity = sh->capacity * 2;
+        verify_snapshot* snaps = realloc(sh->snaps, capacity * sizeof(*snaps));
+        if (!snaps) return false;
+        sh->snaps = snaps;
+        uint8_t* states = realloc(sh->states, capacity * VERIFY_STATE_BYTES);
+        if (!states) return false;
+        sh->states = states;
+        sh->capacity = capacity;
+    }
+
+    verify_snapshot* snap = &sh->snaps[index];
+    snap->tick = tick;
+    snap->state_checksum = pb_state_checksum(&session->game);
+    snap->playback = session->playback;
+    memcpy(sh->states + (size_t)index * VERIFY_STATE_BYTES, &session->game,
+           VERIFY_STATE_BYTES);
+    sh->segment_count++;
+    return true;
+}
+
+static pb_result fast_forward(verify_shared* sh, uint32_t segment_frames,
+                              uint32_t max_frames, uint32_t* ticks_out)
+{
+    pb_session* session = malloc(sizeof(*session));
+    if (!session) return PB_ERR_NO_MEMORY;
+
+    pb_result result = open_session(session, sh, PB_SESSION_PLAYBACK);
+    if (result != PB_OK) {
+        free(session);
+        return result;
+    }
+
+    uint32_t tick = 0;
+    while (!session->finished && (max_frames == 0 || tick < max_frames)) {
+        if (tick % segment_frames == 0 && !push_snapshot(sh, session, tick)) {
+            result = PB_ERR_NO_MEMORY;
+            break;
+        }
+        if (pb_session_tick(session) < 0) break;
+        tick++;
+    }
+
+    /* Closing boundary: the last segment ends here. Not a segment itself. */
+    if (result == PB_OK) {
+        verify_snapshot* end = &sh->snaps[sh->segment_count];
+        end->tick = tick;
+        end->state_checksum = pb_state_checksum(&session->game);
+        end->playback = session->playback;
+    }
+
+    *ticks_out = tick;
+    pb_session_destroy(session);
+    free(session);
+    return result;
+}
+
+/*============================================================================
+ * Pass 2: Segment Workers
+ *============================================================================*/
+
+typedef struct verify_worker {
+    verify_shared* sh;
+    pb_session* session;
+} verify_worker;
+
+static void restore_segment(pb_session* session, const verify_shared* sh,
+                            uint32_t index)
+{
+    memcpy(&session->game, sh->states + (size_t)index * VERIFY_STATE_BYTES,
+           VERIFY_STATE_BYTES);
+    session->game.event_count = 0;
+    session->playback = sh->snaps[index].playback;
+    session->playback.replay = &session->replay;
+    session->finished = false;
+    memset(&session->last_desync, 0, sizeof(session->last_desync));
+}
+
+/* Re-simulate one segment; returns true and fills desync on a mismatch */
+static bool run_segment(verify_worker* w, uint32_t index, pb_desync_info* desync,
+                        uint32_t* checkpoints)
+{
+    const verify_shared* sh = w->sh;
+    pb_session* session = w->session;
+    const verify_snapshot* start = &sh->snaps[index];
+    const verify_snapshot* end = &sh->snaps[index + 1];
+
+    restore_segment(session, sh, index);
+    uint32_t from_frame = session->game.frame;
+
+    for (uint32_t t = start->tick; t < end->tick && !session->finished; t++) {
+        if (pb_session_tick(session) < 0) break;
+    }
+
+    if (session->last_desync.detected) {
+        *desync = session->last_desync;
+        *checkpoints = count_checkpoints(sh->replay, from_frame, desync->frame);
+        return true;
+    }
+    *checkpoints = count_checkpoints(sh->replay, from_frame, session->game.frame);
+
+    uint32_t crc = pb_state_checksum(&session->game);
+    if (crc != end->state_checksum) {
+        desync->detected = true;
+        desync->frame = session->game.frame;
+        desync->expected = end->state_checksum;
+        desync->actual = crc;
+        desync->component = "segment";
+        return true;
+    }
+    return false;
+}
+
+static void worker_run(verify_worker* w)
+{
+    verify_shared* sh = w->sh;
+
+    for (;;) {
+        uint32_t index;
+        bool stop;
+
+        shared_lock(sh);
+        index = sh->next_segment++;
+        /* Nothing past a known failure can report an earlier one */
+        stop = index >= sh->segment_count || index > sh->failed_segment;
+        shared_unlock(sh);
+
+        if (stop) break;
+
+        pb_desync_info desync;
+        memset(&desync, 0, sizeof(desync));
+        uint32_t checkpoints = 0;
+        bool failed = run_segment(w, index, &desync, &checkpoints);
+
+        shared_lock(sh);
+        sh->segments_verified++;
+        sh->checkpoints_verified += checkpoints;
+        if (failed && (sh->failed_segment == VERIFY_NO_SEGMENT ||
+                       index < sh->failed_segment)) {
+            sh->failed_segment = index;
+            sh->desync = desync;
+        }
+        shared_unlock(sh);
+    }
+}
+
+#if PB_FEATURE_THREADS
+static void* worker_thread(void* arg)
+{
+    worker_run((verify_worker*)arg);
+    return NULL;
+}
+#endif
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void pb_verify_config_default(pb_verify_config* config)
+{
+    memset(config, 0, sizeof(*config));
+    config->threads = 1;
+    config->segment_frames = PB_VERIFY_DEFAULT_SEGMENT;
+}
+
+pb_result pb_verify_replay(const pb_replay* replay, const pb_ruleset* ruleset,
+                           const pb_verify_config* config,
+                           pb_verify_result* result)
+{
+    if (!replay || !result) {
+        return PB_ERR_INVALID_ARG;
+    }
+
+    pb_verify_config defaults;
+    if (!config) {
+        pb_verify_config_default(&defaults);
+        config = &defaults;
+    }
+    uint32_t segment_frames = config->segment_frames ? config->segment_frames
+                                                     : PB_VERIFY_DEFAULT_SEGMENT;
+
+    memset(result, 0, sizeof(*result));
+
+    verify_shared sh;
+    memset(&sh, 0, sizeof(sh));
+    sh.replay = replay;
+    sh.ruleset = ruleset;
+    sh.failed_segment = VERIFY_NO_SEGMENT;
+    sh.status = PB_OK;
+
+    /* Size for the recorded duration; push_snapshot() grows if needed */
+    uint32_t frames = config->max_frames ? config->max_frames
+                                         : replay->header.duration_frames;
+    sh.capacity = frames / segment_frames + 2;
+    sh.snaps = malloc(sh.capacity * sizeof(*sh.snaps));
+    sh.states = malloc(sh.capacity * VERIFY_STATE_BYTES);
+    if (!sh.snaps || !sh.states) {
+        free(sh.snaps);
+        free(sh.states);
+        return PB_ERR_NO_MEMORY;
+    }
+
+    pb_result status = fast_forward(&sh, segment_frames, config->max_frames,
+                                    &result->frames);
+    if (status != PB_OK) {
+        goto cleanup;
+    }
+    result->segments = sh.segment_count;
+
+    int threads = config->threads;
+    if (threads < 1) threads = 1;
+    if (threads > PB_VERIFY_MAX_THREADS) threads = PB_VERIFY_MAX_THREADS;
+    if ((uint32_t)threads > sh.segment_count) threads = (int)sh.segment_count;
+#if !PB_FEATURE_THREADS
+    threads = 1;
+#endif
+    if (threads < 1) threads = 1;
+
+    verify_worker workers[PB_VERIFY_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+    for (int t = 0; t < threads; t++) {
+        workers[t].sh = &sh;
+        workers[t].session = malloc(sizeof(pb_session));
+        if (!workers[t].session) {
+            status = PB_ERR_NO_MEMORY;
+            continue;
+        }
+        pb_result r = open_session(workers[t].session, &sh, PB_SESSION_VERIFICATION);
+        if (r != PB_OK) {
+            free(workers[t].session);
+            workers[t].session = NULL;
+            status = r;
+        }
+    }
+
+    if (status == PB_OK) {
+#if PB_FEATURE_THREADS
+        pthread_mutex_init(&sh.lock, NULL);
+        pthread_t tids[PB_VERIFY_MAX_THREADS];
+        int spawned = 1;
+        for (int t = 1; t < threads; t++) {
+            if (pthread_create(&tids[t], NULL, worker_thread, &workers[t]) != 0) {
+                break;
+            }
+            spawned++;
+        }
+        worker_run(&workers[0]);
+        for (int t = 1; t < spawned; t++) {
+            pthread_join(tids[t], NULL);
+        }
+        pthread_mutex_destroy(&sh.lock);
+        result->threads_used = (uint32_t)spawned;
+#else
+        worker_run(&workers[0]);
+        result->threads_used = 1;
+#endif
+
+        result->ok = (sh.failed_segment == VERIFY_NO_SEGMENT);
+        if (!result->ok) {
+            result->desync = sh.desync;
+        }
+        result->segments_verified = sh.segments_verified;
+        result->checkpoints_verified = sh.checkpoints_verified;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        if (workers[t].session) {
+            pb_session_destroy(workers[t].session);
+            free(workers[t].session);
+        }
+    }
+
+cleanup:
+    free(sh.snaps);
+    free(sh.states);
+    return status;
+}
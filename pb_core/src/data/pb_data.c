@@ -160,9 +160,10 @@ bool pb_level_load_string(const char* json, pb_level_data* level,
 
     memset(level, 0, sizeof(*level));
 
-    cJSON* root = cJSON_Parse(json);
+    /* Error position comes back through parse_end, not cJSON's global */
+    const char* err = NULL;
+    cJSON* root = cJSON_ParseWithOpts(json, &err, false);
     if (!root) {
-        const char* err = cJSON_GetErrorPtr();
         SET_ERROR(result, "JSON parse error near: %.20s", err ? err : "unknown");
         return false;
     }
@@ -56,6 +56,14 @@ static const pb_color_srgb8 COLORS[] = {
 static const pb_color_srgb8 BG_COLOR = {32, 32, 48, 255};
 static const pb_color_srgb8 WALL_COLOR = {64, 64, 80, 255};
 static const pb_color_srgb8 AIM_COLOR = {255, 255, 255, 128};
+static const pb_color_srgb8 BARREL_COLOR = {200, 200, 220, 255};
+
+/* HUD text colors, indexed by pb_text_quad.color */
+enum { HUD_WHITE = 0, HUD_YELLOW = 1 };
+static const pb_color_srgb8 HUD_COLORS[] = {
+    {255, 255, 255, 255},
+    {255, 224, 64, 255},
+};
 
 /*============================================================================
  * Demo State
@@ -64,15 +72,50 @@ static const pb_color_srgb8 AIM_COLOR = {255, 255, 255, 128};
 typedef struct demo_state {
     pb_platform* platform;
     pb_session session;
+    pb_particles* particles;    /* Pop/drop bursts (NULL if unavailable) */
+    pb_font_atlas font;
+    pb_text_cache text_cache;
+    pb_text_batch text_batch;
+    pb_texture font_texture;    /* Uploaded atlas (NULL: no text) */
+    pb_texture aim_texture;     /* Uploaded aim sprites (NULL: draw lines) */
+    int barrel_sprite;
+    int arrow_sprite;
     pb_scalar aim_angle;
     bool running;
     bool paused;
 } demo_state;
 
+/* Barrel and arrowhead at every aim direction (large, kept off the stack) */
+static pb_dirsprite_atlas aim_sprites;
+
 /*============================================================================
  * Rendering
  *============================================================================*/
 
+/* Blit a pre-rotated sprite with its pivot on (x, y) */
+static void draw_aim_sprite(demo_state* state, int id, int x, int y,
+                            pb_color_srgb8 tint)
+{
+    pb_platform* p = state->platform;
+    const pb_dirsprite_cell* cell =
+        pb_dirsprite_get(&aim_sprites, id, pb_dirsprite_dir(state->aim_angle));
+    if (!cell) return;
+
+    pb_sprite sprite = {0};
+    sprite.texture = state->aim_texture;
+    sprite.src_x = cell->x;
+    sprite.src_y = cell->y;
+    sprite.src_w = cell->w;
+    sprite.src_h = cell->h;
+    sprite.dst_x = (float)(x - cell->pivot_x);
+    sprite.dst_y = (float)(y - cell->pivot_y);
+    sprite.dst_w = (float)cell->w;
+    sprite.dst_h = (float)cell->h;
+    sprite.tint = tint;
+    sprite.alpha = tint.a;
+    p->texture_draw_ex(p, &sprite);
+}
+
 static void draw_bubble(pb_platform* p, int cx, int cy, const pb_bubble* bubble)
 {
     if (bubble->kind == PB_KIND_NONE) return;
@@ -131,6 +174,18 @@ static void draw_shot(demo_state* state)
     draw_bubble(p, cx, cy, &shot->bubble);
 }
 
+static void draw_particles(demo_state* state)
+{
+    if (!state->particles) return;
+    pb_platform* p = state->platform;
+
+    pb_particle_view view = pb_particles_view(state->particles);
+    for (int i = 0; i < view.count; i++) {
+        pb_color_srgb8 color = COLORS[view.palette[i] % PB_MAX_COLORS];
+        p->draw_rect(p, (int)view.x[i] - 1, (int)view.y[i] - 1, 2, 2, color);
+    }
+}
+
 static void draw_cannon(demo_state* state)
 {
     pb_platform* p = state->platform;
@@ -143,13 +198,17 @@ static void draw_cannon(demo_state* state)
     pb_color_srgb8 base_color = {100, 100, 120, 255};
     p->draw_rect(p, bx - 12, by, 24, 12, base_color);
 
-    /* Draw cannon barrel */
-    float angle = PB_FIXED_TO_FLOAT(state->aim_angle);
-    int tx = bx + (int)(cosf(angle) * CANNON_LENGTH);
-    int ty = by - (int)(sinf(angle) * CANNON_LENGTH);
-    p->draw_line(p, bx, by, tx, ty, (pb_color_srgb8){200, 200, 220, 255});
-    p->draw_line(p, bx - 1, by, tx - 1, ty, (pb_color_srgb8){200, 200, 220, 255});
-    p->draw_line(p, bx + 1, by, tx + 1, ty, (pb_color_srgb8){200, 200, 220, 255});
+    /* Draw cannon barrel: one blit of the pre-rotated sprite */
+    if (state->aim_texture) {
+        draw_aim_sprite(state, state->barrel_sprite, bx, by, BARREL_COLOR);
+    } else {
+        float angle = PB_FIXED_TO_FLOAT(state->aim_angle);
+        int tx = bx + (int)(cosf(angle) * CANNON_LENGTH);
+        int ty = by - (int)(sinf(angle) * CANNON_LENGTH);
+        p->draw_line(p, bx, by, tx, ty, BARREL_COLOR);
+        p->draw_line(p, bx - 1, by, tx - 1, ty, BARREL_COLOR);
+        p->draw_line(p, bx + 1, by, tx + 1, ty, BARREL_COLOR);
+    }
 
     /* Draw current bubble */
     draw_bubble(p, bx, by, &state->session.game.current_bubble);
@@ -166,7 +225,9 @@ static void draw_aim_line(demo_state* state)
     int bx = BOARD_OFFSET_X + CANNON_X;
     int by = BOARD_OFFSET_Y + CANNON_Y;
 
-    /* Draw dotted aim line */
+    /* Draw dotted aim line; the dots follow the exact angle the shot uses,
+     * only the arrowhead at the end is snapped to a direction index */
+    int tip_x = bx, tip_y = by;
     for (int i = 0; i < 10; i++) {
         int dist = CANNON_LENGTH + 10 + i * 12;
         int x = bx + (int)(cosf(angle) * dist);
@@ -175,7 +236,18 @@ static void draw_aim_line(demo_state* state)
         if (y < BOARD_OFFSET_Y) break;
         if (x < BOARD_OFFSET_X || x > BOARD_OFFSET_X + SCREEN_W - 2 * BOARD_OFFSET_X) break;
 
-        p->draw_rect(p, x - 1, y - 1, 2, 2, AIM_COLOR);
+        if (tip_x != bx || tip_y != by) {
+            p->draw_rect(p, tip_x - 1, tip_y - 1, 2, 2, AIM_COLOR);
+        }
+        tip_x = x;
+        tip_y = y;
+    }
+    if (tip_x == bx && tip_y == by) return;
+
+    if (state->aim_texture) {
+        draw_aim_sprite(state, state->arrow_sprite, tip_x, tip_y, AIM_COLOR);
+    } else {
+        p->draw_rect(p, tip_x - 1, tip_y - 1, 2, 2, AIM_COLOR);
     }
 }
 
@@ -198,17 +270,98 @@ static void draw_walls(demo_state* state)
 static void draw_ui(demo_state* state)
 {
     pb_platform* p = state->platform;
-    (void)p; /* Would draw score, frame count, etc. here */
+    const pb_game_state* game = &state->session.game;
 
-    /* For now, just indicate pause state */
     if (state->paused) {
         pb_color_srgb8 overlay = {0, 0, 0, 128};
         p->draw_rect(p, 0, 0, SCREEN_W, SCREEN_H, overlay);
+    }
+
+    if (!state->font_texture || !p->draw_text) return;
 
-        /* Simple "PAUSED" indicator */
-        pb_color_srgb8 white = {255, 255, 255, 255};
-        p->draw_rect(p, SCREEN_W / 2 - 30, SCREEN_H / 2 - 5, 60, 10, white);
+    /* Score and frame strings repeat between changes, so layout comes
+     * from the cache; all HUD text goes out as one draw */
+    char line[PB_TEXT_MAX_LEN];
+    pb_text_batch_clear(&state->text_batch);
+
+    snprintf(line, sizeof(line), "SCORE %u", (unsigned)game->score);
+    pb_text_batch_add(&state->text_batch, &state->text_cache, line, 4, 4, HUD_YELLOW);
+
+    snprintf(line, sizeof(line), "FRAME %u", (unsigned)game->frame);
+    pb_text_batch_add(&state->text_batch, &state->text_cache, line,
+                      SCREEN_W - 60, 4, HUD_WHITE);
+
+    if (state->paused) {
+        pb_text_batch_add(&state->text_batch, &state->text_cache, "PAUSED",
+                          SCREEN_W / 2 - 12, SCREEN_H / 2 - 3, HUD_WHITE);
     }
+
+    p->draw_text(p, state->font_texture, &state->text_batch, HUD_COLORS);
+}
+
+static pb_texture upload_font(pb_platform* p, const pb_font_atlas* font)
+{
+    if (!p->texture_create || !p->texture_upload) return NULL;
+
+    pb_texture tex = p->texture_create(p, PB_FONT_ATLAS_W, PB_FONT_ATLAS_H);
+    if (!tex) return NULL;
+
+    /* White texels; coverage becomes alpha so quad colors tint them */
+    static uint32_t rgba[PB_FONT_ATLAS_W * PB_FONT_ATLAS_H];
+    for (int i = 0; i < PB_FONT_ATLAS_W * PB_FONT_ATLAS_H; i++) {
+        rgba[i] = font->pixels[i] ? 0xFFFFFFFFu : 0xFFFFFF00u;
+    }
+    p->texture_upload(p, tex, rgba);
+    return tex;
+}
+
+/* Procedural upright sprites, rendered for every direction at load */
+#define BARREL_W 5
+#define BARREL_H (CANNON_LENGTH + 2)
+#define ARROW_W 9
+#define ARROW_H 7
+
+static pb_texture upload_aim_sprites(demo_state* state)
+{
+    pb_platform* p = state->platform;
+    if (!p->texture_create || !p->texture_upload || !p->texture_draw_ex) return NULL;
+
+    /* Sources must outlive the atlas only when it is lazy; this one is not */
+    static uint8_t barrel[BARREL_W * BARREL_H];
+    static uint8_t arrow[ARROW_W * ARROW_H];
+    for (int y = 0; y < BARREL_H; y++) {
+        for (int x = 0; x < BARREL_W; x++) {
+            barrel[y * BARREL_W + x] = (x == 0 || x == BARREL_W - 1) ? 160 : 255;
+        }
+    }
+    for (int y = 0; y < ARROW_H; y++) {
+        int half = y * (ARROW_W / 2) / (ARROW_H - 1);
+        for (int x = 0; x < ARROW_W; x++) {
+            int dx = x - ARROW_W / 2;
+            arrow[y * ARROW_W + x] = (dx >= -half && dx <= half) ? 255 : 0;
+        }
+    }
+
+    pb_dirsprite_source barrel_src = {barrel, BARREL_W, BARREL_H,
+                                      BARREL_W / 2, BARREL_H - 1};
+    pb_dirsprite_source arrow_src = {arrow, ARROW_W, ARROW_H,
+                                     ARROW_W / 2, ARROW_H / 2};
+    pb_dirsprite_atlas_init(&aim_sprites, false);
+    if (pb_dirsprite_add(&aim_sprites, &barrel_src, &state->barrel_sprite) != PB_OK ||
+        pb_dirsprite_add(&aim_sprites, &arrow_src, &state->arrow_sprite) != PB_OK) {
+        return NULL;
+    }
+
+    pb_texture tex = p->texture_create(p, PB_DIRSPRITE_ATLAS_W, PB_DIRSPRITE_ATLAS_H);
+    if (!tex) return NULL;
+
+    /* White texels with coverage as alpha, tinted at draw time */
+    static uint32_t rgba[PB_DIRSPRITE_ATLAS_W * PB_DIRSPRITE_ATLAS_H];
+    for (int i = 0; i < PB_DIRSPRITE_ATLAS_W * PB_DIRSPRITE_ATLAS_H; i++) {
+        rgba[i] = 0xFFFFFF00u | aim_sprites.pixels[i];
+    }
+    p->texture_upload(p, tex, rgba);
+    return tex;
 }
 
 static void render(demo_state* state)
@@ -220,6 +373,7 @@ static void render(demo_state* state)
     draw_walls(state);
     draw_board(state);
     draw_shot(state);
+    draw_particles(state);
     draw_aim_line(state);
     draw_cannon(state);
     draw_ui(state);
@@ -275,6 +429,7 @@ static void update(demo_state* state)
     if (state->paused) return;
 
     pb_session_tick(&state->session);
+    pb_particles_update(state->particles, 1.0f);
 
     /* Check game state */
     if (state->session.game.phase == PB_PHASE_WON) {
@@ -368,6 +523,28 @@ int main(int argc, char* argv[])
     pb_session_create(&state.session, NULL, 42, &sess_config);
     setup_test_level(&state.session.game.board);
 
+    /* Particles use the demo layout; palette index is the bubble color */
+    pb_particle_config particle_config;
+    pb_particle_config_default(&particle_config);
+    particle_config.origin_x = BOARD_OFFSET_X;
+    particle_config.origin_y = BOARD_OFFSET_Y;
+    particle_config.bubble_radius = BUBBLE_RADIUS;
+    particle_config.view_max_x = SCREEN_W;
+    particle_config.view_max_y = SCREEN_H;
+    particle_config.palette_base = 0;
+    state.particles = pb_particles_create(&particle_config);
+    if (state.particles) {
+        pb_particles_attach(state.particles, &state.session.game);
+    }
+
+    /* HUD font */
+    pb_font_atlas_init_builtin(&state.font);
+    pb_text_cache_init(&state.text_cache, &state.font);
+    state.font_texture = upload_font(platform, &state.font);
+
+    /* Cannon and aim arrow, pre-rotated */
+    state.aim_texture = upload_aim_sprites(&state);
+
     /* Main loop */
     pb_input_state input;
     while (state.running && !pb_should_quit(platform)) {
@@ -382,6 +559,14 @@ int main(int argc, char* argv[])
     }
 
     /* Cleanup */
+    pb_particles_detach(state.particles, &state.session.game);
+    pb_particles_destroy(state.particles);
+    if (state.font_texture) {
+        platform->texture_free(platform, state.font_texture);
+    }
+    if (state.aim_texture) {
+        platform->texture_free(platform, state.aim_texture);
+    }
     pb_session_destroy(&state.session);
     pb_shutdown(platform);
     pb_platform_free(platform);
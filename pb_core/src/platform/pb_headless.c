@@ -0,0 +1,875 @@
+/*
+ * pb_headless.c - Headless platform backend implementation
+ *
+ * Implements pb_platform interface without a display: drawing goes to an
+ * in-memory RGBA framebuffer, time is a virtual clock advanced per frame,
+ * input is replayed from a key script, and audio calls are counted.
+ * No dependencies beyond the C library, so it builds into libpb_core.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_platform.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Headless Implementation Data
+ *============================================================================*/
+
+#define HEADLESS_AUDIO_RATE     44100
+#define HEADLESS_AUDIO_CHANNELS 2
+#define HEADLESS_AUDIO_CHUNK    512     /* Frames per stream callback */
+
+#define HEADLESS_MAX_TEXTURE    8192    /* Texture side limit, pixels */
+
+typedef struct headless_impl {
+    pb_platform_config config;
+    uint32_t* pixels;           /* 0xRRGGBBAA, width * height */
+    int width;
+    int height;
+    bool should_quit;
+
+    /* Virtual clock: whole frames at target_fps plus delays */
+    uint32_t fps;
+    uint64_t delay_us;
+    uint32_t frame_index;       /* Current frame (begin_frame count - 1) */
+    bool frame_started;
+
+    /* Scripted input */
+    const pb_headless_key_event* script;
+    int script_count;
+    int script_pos;
+    bool held[PB_KEY_COUNT];
+    pb_input_state prev_input;
+
+    /* PCM stream, pulled in chunks at end_frame */
+    pb_audio_stream_fn audio_fn;
+    void* audio_userdata;
+    uint64_t audio_opened;      /* Frame count when the stream opened */
+    uint64_t audio_pulled;      /* Stream frames pulled since */
+    int16_t audio_chunk[HEADLESS_AUDIO_CHUNK * HEADLESS_AUDIO_CHANNELS];
+
+    pb_headless_stats stats;
+} headless_impl;
+
+/* Texture wrapper */
+struct pb_texture {
+    uint32_t* pixels;
+    int width;
+    int height;
+};
+
+/* Sound wrapper */
+struct pb_sound {
+    int id;
+};
+
+/* Music wrapper */
+struct pb_music {
+    int id;
+};
+
+/*============================================================================
+ * Pixel Helpers
+ *============================================================================*/
+
+static inline uint32_t pack_rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    return ((uint32_t)r << 24) | ((uint32_t)g << 16) | ((uint32_t)b << 8) | a;
+}
+
+static inline uint32_t mul8(uint32_t a, uint32_t b)
+{
+    /* a * b / 255, rounded */
+    uint32_t t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/* Source-over blend with straight alpha */
+static inline uint32_t blend(uint32_t dst, uint32_t r, uint32_t g, uint32_t b,
+                             uint32_t a)
+{
+    if (a == 255) return pack_rgba((uint8_t)r, (uint8_t)g, (uint8_t)b, 255);
+    if (a == 0) return dst;
+
+    uint32_t ia = 255 - a;
+    uint32_t dr = dst >> 24, dg = (dst >> 16) & 0xFF, db = (dst >> 8) & 0xFF;
+    uint32_t da = dst & 0xFF;
+    return pack_rgba((uint8_t)(mul8(r, a) + mul8(dr, ia)),
+                     (uint8_t)(mul8(g, a) + mul8(dg, ia)),
+                     (uint8_t)(mul8(b, a) + mul8(db, ia)),
+                     (uint8_t)(a + mul8(da, ia)));
+}
+
+static inline void plot(headless_impl* impl, int x, int y, pb_color_srgb8 c)
+{
+    if ((unsigned)x >= (unsigned)impl->width || (unsigned)y >= (unsigned)impl->height) {
+        return;
+    }
+    uint32_t* px = &impl->pixels[y * impl->width + x];
+    *px = blend(*px, c.r, c.g, c.b, c.a);
+    impl->stats.pixels_written++;
+}
+
+/* Horizontal span [x0, x1], clipped */
+static void span(headless_impl* impl, int y, int x0, int x1, pb_color_srgb8 c)
+{
+    if ((unsigned)y >= (unsigned)impl->height) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 >= impl->width) x1 = impl->width - 1;
+    if (x0 > x1) return;
+
+    uint32_t* row = &impl->pixels[y * impl->width];
+    if (c.a == 255) {
+        uint32_t v = pack_rgba(c.r, c.g, c.b, 255);
+        for (int x = x0; x <= x1; x++) row[x] = v;
+    } else {
+        for (int x = x0; x <= x1; x++) row[x] = blend(row[x], c.r, c.g, c.b, c.a);
+    }
+    impl->stats.pixels_written += (uint64_t)(x1 - x0 + 1);
+}
+
+static int isqrt(int n)
+{
+    if (n <= 0) return 0;
+    int r = (int)sqrtf((float)n);
+    while (r * r > n) r--;
+    while ((r + 1) * (r + 1) <= n) r++;
+    return r;
+}
+
+/*============================================================================
+ * Lifecycle
+ *============================================================================*/
+
+static bool headless_init(pb_platform* p, const pb_platform_config* config)
+{
+    headless_impl* impl = p->impl;
+    if (!config) return false;
+
+    int w = config->logical_width > 0 ? config->logical_width : config->window_width;
+    int h = config->logical_height > 0 ? config->logical_height : config->window_height;
+    if (w <= 0 || h <= 0) return false;
+
+    uint32_t* pixels = calloc((size_t)w * (size_t)h, sizeof(*pixels));
+    if (!pixels) return false;
+
+    free(impl->pixels);
+    const pb_headless_key_event* script = impl->script;
+    int script_count = impl->script_count;
+
+    memset(impl, 0, sizeof(*impl));
+    impl->config = *config;
+    impl->pixels = pixels;
+    impl->width = w;
+    impl->height = h;
+    impl->fps = config->target_fps > 0 ? (uint32_t)config->target_fps : 60;
+    impl->script = script;
+    impl->script_count = script_count;
+    return true;
+}
+
+static void headless_shutdown(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+    free(impl->pixels);
+    impl->pixels = NULL;
+    impl->width = 0;
+    impl->height = 0;
+}
+
+static bool headless_should_quit(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+    return impl->should_quit;
+}
+
+/*============================================================================
+ * Frame Timing
+ *============================================================================*/
+
+/* Computed from the frame count so rates like 60 fps do not drift */
+static uint64_t clock_us(const headless_impl* impl)
+{
+    if (impl->fps == 0) return impl->delay_us;
+    return (uint64_t)impl->stats.frames * 1000000u / impl->fps + impl->delay_us;
+}
+
+static void headless_begin_frame(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+    if (impl->frame_started) {
+        impl->frame_index++;
+    }
+    impl->frame_started = true;
+}
+
+static void headless_end_frame(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+
+    /* Every frame takes exactly its budget; nothing sleeps */
+    impl->stats.frames++;
+    impl->stats.clock_ms = clock_us(impl) / 1000;
+
+    /* Audio keeps pace with the frame count, so it cannot drift either */
+    if (impl->audio_fn) {
+        uint64_t due = (impl->stats.frames - impl->audio_opened) *
+                       HEADLESS_AUDIO_RATE / (uint64_t)impl->fps;
+        while (impl->audio_pulled < due) {
+            uint64_t left = due - impl->audio_pulled;
+            int n = left < HEADLESS_AUDIO_CHUNK ? (int)left : HEADLESS_AUDIO_CHUNK;
+            memset(impl->audio_chunk, 0, sizeof(impl->audio_chunk));
+            impl->audio_fn(impl->audio_userdata, impl->audio_chunk, n,
+                           HEADLESS_AUDIO_CHANNELS);
+            impl->audio_pulled += (uint64_t)n;
+            impl->stats.audio_frames += (uint64_t)n;
+        }
+    }
+}
+
+static uint64_t headless_get_ticks_ms(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+    return clock_us(impl) / 1000;
+}
+
+static void headless_delay(pb_platform* p, uint32_t ms)
+{
+    headless_impl* impl = p->impl;
+    impl->delay_us += (uint64_t)ms * 1000;
+    impl->stats.clock_ms = clock_us(impl) / 1000;
+}
+
+/*============================================================================
+ * Input
+ *============================================================================*/
+
+static void headless_poll_input(pb_platform* p, pb_input_state* state)
+{
+    headless_impl* impl = p->impl;
+
+    pb_input_state prev = impl->prev_input;
+    memset(state, 0, sizeof(*state));
+
+    /* Apply every scripted transition due by this frame */
+    while (impl->script_pos < impl->script_count &&
+           impl->script[impl->script_pos].frame <= impl->frame_index) {
+        const pb_headless_key_event* ev = &impl->script[impl->script_pos++];
+        if ((unsigned)ev->key < PB_KEY_COUNT) {
+            impl->held[ev->key] = ev->down;
+        }
+    }
+
+    for (int i = 0; i < PB_KEY_COUNT; i++) {
+        state->keys[i] = impl->held[i];
+        state->keys_pressed[i] = state->keys[i] && !prev.keys[i];
+        state->keys_released[i] = !state->keys[i] && prev.keys[i];
+    }
+
+    if (state->keys[PB_KEY_QUIT]) {
+        impl->should_quit = true;
+    }
+
+    impl->prev_input = *state;
+}
+
+/*============================================================================
+ * Rendering
+ *============================================================================*/
+
+static void headless_clear(pb_platform* p, pb_color_srgb8 color)
+{
+    headless_impl* impl = p->impl;
+    if (!impl->pixels) return;
+
+    uint32_t v = pack_rgba(color.r, color.g, color.b, color.a);
+    size_t n = (size_t)impl->width * (size_t)impl->height;
+    for (size_t i = 0; i < n; i++) impl->pixels[i] = v;
+
+    impl->stats.draw_calls++;
+    impl->stats.pixels_written += n;
+}
+
+static void headless_draw_rect(pb_platform* p, int x, int y, int w, int h,
+                               pb_color_srgb8 color)
+{
+    headless_impl* impl = p->impl;
+    if (!impl->pixels || w <= 0 || h <= 0) return;
+
+    for (int row = y; row < y + h; row++) {
+        span(impl, row, x, x + w - 1, color);
+    }
+    impl->stats.draw_calls++;
+}
+
+static void headless_draw_rect_outline(pb_platform* p, int x, int y, int w, int h,
+                                       pb_color_srgb8 color)
+{
+    headless_impl* impl = p->impl;
+    if (!impl->pixels || w <= 0 || h <= 0) return;
+
+    span(impl, y, x, x + w - 1, color);
+    if (h > 1) span(impl, y + h - 1, x, x + w - 1, color);
+    for (int row = y + 1; row < y + h - 1; row++) {
+        plot(impl, x, row, color);
+        if (w > 1) plot(impl, x + w - 1, row, color);
+    }
+    impl->stats.draw_calls++;
+}
+
+static void headless_draw_circle(pb_platform* p, int cx, int cy, int r,
+                                 pb_color_srgb8 color)
+{
+    headless_impl* impl = p->impl;
+    if (!impl->pixels || r < 0) return;
+
+    for (int dy = -r; dy <= r; dy++) {
+        int dx = isqrt(r * r - dy * dy);
+        span(impl, cy + dy, cx - dx, cx + dx, color);
+    }
+    impl->stats.draw_calls++;
+}
+
+/* Midpoint circle algorithm for outline */
+static void headless_draw_circle_outline(pb_platform* p, int cx, int cy, int r,
+                                         pb_color_srgb8 color)
+{
+    headless_impl* impl = p->impl;
+    if (!impl->pixels || r < 0) return;
+
+    int x = r;
+    int y = 0;
+    int err = 1 - r;
+
+    while (x >= y) {
+        plot(impl, cx + x, cy + y, color);
+        plot(impl, cx + y, cy + x, color);
+        plot(impl, cx - y, cy + x, color);
+        plot(impl, cx - x, cy + y, color);
+        plot(impl, cx - x, cy - y, color);
+        plot(impl, cx - y, cy - x, color);
+        plot(impl, cx + y, cy - x, color);
+        plot(impl, cx + x, cy - y, color);
+
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x + 1);
+        }
+    }
+    impl->stats.draw_calls++;
+}
+
+/* Bresenham, both endpoints inclusive */
+static void headless_draw_line(pb_platform* p, int x1, int y1, int x2, int y2,
+                               pb_color_srgb8 color)
+{
+    headless_impl* impl = p->impl;
+    if (!impl->pixels) return;
+
+    int dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+    int dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+    int err = dx + dy;
+
+    for (;;) {
+        plot(impl, x1, y1, color);
+        if (x1 == x2 && y1 == y2) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x1 += sx; }
+        if (e2 <= dx) { err += dx; y1 += sy; }
+    }
+    impl->stats.draw_calls++;
+}
+
+static void headless_present(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+    impl->stats.presents++;
+}
+
+/*============================================================================
+ * Texture Management
+ *============================================================================*/
+
+static pb_texture texture_alloc(int w, int h)
+{
+    if (w <= 0 || h <= 0 || w > HEADLESS_MAX_TEXTURE || h > HEADLESS_MAX_TEXTURE) {
+        return NULL;
+    }
+
+    pb_texture tex = malloc(sizeof(*tex));
+    if (!tex) return NULL;
+
+    tex->pixels = calloc((size_t)w * (size_t)h, sizeof(*tex->pixels));
+    if (!tex->pixels) {
+        free(tex);
+        return NULL;
+    }
+    tex->width = w;
+    tex->height = h;
+    return tex;
+}
+
+/* Skip whitespace and '#' comments in a PPM header */
+static int ppm_skip(FILE* f)
+{
+    int c = fgetc(f);
+    while (c == '#' || c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        if (c == '#') {
+            while (c != '\n' && c != EOF) c = fgetc(f);
+        }
+        c = fgetc(f);
+    }
+    return c;
+}
+
+static int ppm_int(FILE* f)
+{
+    int c = ppm_skip(f);
+    int v = 0;
+    if (c < '0' || c > '9') return -1;
+    while (c >= '0' && c <= '9') {
+        if (v > 65535) return -1;
+        v = v * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return v;  /* Consumes the single whitespace after the value */
+}
+
+/* Binary PPM (P6, maxval 255), the format frames are captured in */
+static pb_texture headless_texture_load(pb_platform* p, const char* path)
+{
+    (void)p;
+    if (!path) return NULL;
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    pb_texture tex = NULL;
+    if (fgetc(f) == 'P' && fgetc(f) == '6') {
+        int w = ppm_int(f);
+        int h = ppm_int(f);
+        int maxval = ppm_int(f);
+        /* Header values come from the file: texture_alloc() bounds them */
+        if (maxval == 255) {
+            tex = texture_alloc(w, h);
+        }
+        size_t count = tex ? (size_t)w * (size_t)h : 0;
+        for (size_t i = 0; i < count; i++) {
+            uint8_t rgb[3];
+            if (fread(rgb, 1, 3, f) != 3) {
+                free(tex->pixels);
+                free(tex);
+                tex = NULL;
+                break;
+            }
+            tex->pixels[i] = pack_rgba(rgb[0], rgb[1], rgb[2], 255);
+        }
+    }
+
+    fclose(f);
+    return tex;
+}
+
+static pb_texture headless_texture_create(pb_platform* p, int w, int h)
+{
+    (void)p;
+    return texture_alloc(w, h);
+}
+
+static void headless_texture_free(pb_platform* p, pb_texture tex)
+{
+    (void)p;
+    if (tex) {
+        free(tex->pixels);
+        free(tex);
+    }
+}
+
+static void headless_texture_upload(pb_platform* p, pb_texture tex,
+                                    const uint32_t* pixels)
+{
+    (void)p;
+    if (!tex || !pixels) return;
+    memcpy(tex->pixels, pixels, (size_t)tex->width * (size_t)tex->height * sizeof(*pixels));
+}
+
+/* Blit one texel with color modulation (tint 255 = unchanged) */
+static inline void blit_texel(headless_impl* impl, int x, int y, uint32_t t,
+                              pb_color_srgb8 tint)
+{
+    if ((unsigned)x >= (unsigned)impl->width || (unsigned)y >= (unsigned)impl->height) {
+        return;
+    }
+    uint32_t a = mul8(t & 0xFF, tint.a);
+    if (a == 0) return;
+
+    uint32_t* px = &impl->pixels[y * impl->width + x];
+    *px = blend(*px, mul8(t >> 24, tint.r), mul8((t >> 16) & 0xFF, tint.g),
+                mul8((t >> 8) & 0xFF, tint.b), a);
+    impl->stats.pixels_written++;
+}
+
+static void headless_texture_draw(pb_platform* p, pb_texture tex,
+                                  int src_x, int src_y, int src_w, int src_h,
+                                  int dst_x, int dst_y, int dst_w, int dst_h)
+{
+    headless_impl* impl = p->impl;
+    if (!tex || !impl->pixels || dst_w <= 0 || dst_h <= 0) return;
+
+    if (src_w <= 0 || src_h <= 0) {
+        src_x = 0;
+        src_y = 0;
+        src_w = tex->width;
+        src_h = tex->height;
+    }
+
+    const pb_color_srgb8 opaque = {255, 255, 255, 255};
+
+    /* Nearest-neighbor scaling */
+    for (int dy = 0; dy < dst_h; dy++) {
+        int sy = src_y + (int)((int64_t)dy * src_h / dst_h);
+        if ((unsigned)sy >= (unsigned)tex->height) continue;
+        const uint32_t* row = &tex->pixels[sy * tex->width];
+        for (int dx = 0; dx < dst_w; dx++) {
+            int sx = src_x + (int)((int64_t)dx * src_w / dst_w);
+            if ((unsigned)sx >= (unsigned)tex->width) continue;
+            blit_texel(impl, dst_x + dx, dst_y + dy, row[sx], opaque);
+        }
+    }
+    impl->stats.draw_calls++;
+}
+
+static void headless_texture_draw_ex(pb_platform* p, const pb_sprite* sprite)
+{
+    headless_impl* impl = p->impl;
+    if (!sprite || !sprite->texture || !impl->pixels) return;
+    if (sprite->dst_w <= 0.0f || sprite->dst_h <= 0.0f ||
+        sprite->src_w <= 0 || sprite->src_h <= 0) {
+        return;
+    }
+
+    pb_texture tex = sprite->texture;
+    pb_color_srgb8 tint = sprite->tint;
+    tint.a = sprite->alpha;
+
+    float c = cosf(sprite->rotation);
+    float s = sinf(sprite->rotation);
+    float px = sprite->dst_x + sprite->origin_x;
+    float py = sprite->dst_y + sprite->origin_y;
+
+    /* Destination bounding box of the rotated rectangle */
+    float min_x = px, max_x = px, min_y = py, max_y = py;
+    const float corners[4][2] = {
+        {-sprite->origin_x, -sprite->origin_y},
+        {sprite->dst_w - sprite->origin_x, -sprite->origin_y},
+        {-sprite->origin_x, sprite->dst_h - sprite->origin_y},
+        {sprite->dst_w - sprite->origin_x, sprite->dst_h - sprite->origin_y},
+    };
+    for (int i = 0; i < 4; i++) {
+        float x = px + corners[i][0] * c - corners[i][1] * s;
+        float y = py + corners[i][0] * s + corners[i][1] * c;
+        if (x < min_x) min_x = x;
+        if (x > max_x) max_x = x;
+        if (y < min_y) min_y = y;
+        if (y > max_y) max_y = y;
+    }
+
+    int x0 = (int)floorf(min_x), x1 = (int)ceilf(max_x);
+    int y0 = (int)floorf(min_y), y1 = (int)ceilf(max_y);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > impl->width) x1 = impl->width;
+    if (y1 > impl->height) y1 = impl->height;
+
+    /* Inverse-map each pixel center into the unrotated rectangle */
+    float sx_scale = (float)sprite->src_w / sprite->dst_w;
+    float sy_scale = (float)sprite->src_h / sprite->dst_h;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            float rx = (float)x + 0.5f - px;
+            float ry = (float)y + 0.5f - py;
+            float lx = rx * c + ry * s + sprite->origin_x;
+            float ly = -rx * s + ry * c + sprite->origin_y;
+            if (lx < 0.0f || ly < 0.0f || lx >= sprite->dst_w || ly >= sprite->dst_h) {
+                continue;
+            }
+            int tx = sprite->src_x + (int)(lx * sx_scale);
+            int ty = sprite->src_y + (int)(ly * sy_scale);
+            if ((unsigned)tx >= (unsigned)tex->width ||
+                (unsigned)ty >= (unsigned)tex->height) {
+                continue;
+            }
+            blit_texel(impl, x, y, tex->pixels[ty * tex->width + tx], tint);
+        }
+    }
+    impl->stats.draw_calls++;
+}
+
+/*============================================================================
+ * Text
+ *============================================================================*/
+
+static void headless_draw_text(pb_platform* p, pb_texture atlas,
+                               const pb_text_batch* batch, const pb_color_srgb8* colors)
+{
+    headless_impl* impl = p->impl;
+    if (!atlas || !batch || !colors || !impl->pixels || batch->count <= 0) return;
+
+    int n = batch->count < PB_TEXT_BATCH_MAX ? batch->count : PB_TEXT_BATCH_MAX;
+    for (int i = 0; i < n; i++) {
+        const pb_text_quad* q = &batch->quads[i];
+        pb_color_srgb8 color = colors[q->color];
+        for (int gy = 0; gy < q->h; gy++) {
+            int ty = q->src_y + gy;
+            if (ty >= atlas->height) break;
+            for (int gx = 0; gx < q->w; gx++) {
+                int tx = q->src_x + gx;
+                if (tx >= atlas->width) break;
+                blit_texel(impl, q->x + gx, q->y + gy,
+                           atlas->pixels[ty * atlas->width + tx], color);
+            }
+        }
+    }
+    impl->stats.draw_calls++;
+}
+
+/*============================================================================
+ * Audio
+ *============================================================================*/
+
+static pb_sound headless_sound_load(pb_platform* p, const char* path)
+{
+    (void)p;
+    if (!path) return NULL;
+    return calloc(1, sizeof(struct pb_sound));
+}
+
+static void headless_sound_free(pb_platform* p, pb_sound snd)
+{
+    (void)p;
+    free(snd);
+}
+
+static void headless_sound_play(pb_platform* p, pb_sound snd, float volume)
+{
+    (void)volume;
+    headless_impl* impl = p->impl;
+    if (snd) impl->stats.sounds_played++;
+}
+
+static bool headless_audio_stream_open(pb_platform* p, pb_audio_stream_fn fn,
+                                       void* userdata, int* sample_rate, int* channels)
+{
+    headless_impl* impl = p->impl;
+    if (!fn || impl->audio_fn) return false;
+    impl->audio_fn = fn;
+    impl->audio_userdata = userdata;
+    impl->audio_opened = impl->stats.frames;
+    impl->audio_pulled = 0;
+    if (sample_rate) *sample_rate = HEADLESS_AUDIO_RATE;
+    if (channels) *channels = HEADLESS_AUDIO_CHANNELS;
+    return true;
+}
+
+static void headless_audio_stream_close(pb_platform* p)
+{
+    headless_impl* impl = p->impl;
+    impl->audio_fn = NULL;
+    impl->audio_userdata = NULL;
+}
+
+static void headless_audio_lock(pb_platform* p, bool lock)
+{
+    (void)p;
+    (void)lock;     /* The stream only runs inside end_frame */
+}
+
+static pb_music headless_music_load(pb_platform* p, const char* path)
+{
+    (void)p;
+    if (!path) return NULL;
+    return calloc(1, sizeof(struct pb_music));
+}
+
+static void headless_music_free(pb_platform* p, pb_music mus)
+{
+    (void)p;
+    free(mus);
+}
+
+static void headless_music_play(pb_platform* p, pb_music mus, bool loop)
+{
+    (void)p;
+    (void)mus;
+    (void)loop;
+}
+
+static void headless_music_stop(pb_platform* p)
+{
+    (void)p;
+}
+
+static void headless_music_set_volume(pb_platform* p, float volume)
+{
+    (void)p;
+    (void)volume;
+}
+
+/*============================================================================
+ * Platform Creation
+ *============================================================================*/
+
+pb_platform* pb_platform_headless_create(void)
+{
+    pb_platform* p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+
+    headless_impl* impl = calloc(1, sizeof(*impl));
+    if (!impl) {
+        free(p);
+        return NULL;
+    }
+
+    p->impl = impl;
+
+    /* Wire up vtable */
+    p->init = headless_init;
+    p->shutdown = headless_shutdown;
+    p->should_quit = headless_should_quit;
+    p->begin_frame = headless_begin_frame;
+    p->end_frame = headless_end_frame;
+    p->get_ticks_ms = headless_get_ticks_ms;
+    p->delay = headless_delay;
+    p->poll_input = headless_poll_input;
+    p->clear = headless_clear;
+    p->draw_rect = headless_draw_rect;
+    p->draw_rect_outline = headless_draw_rect_outline;
+    p->draw_circle = headless_draw_circle;
+    p->draw_circle_outline = headless_draw_circle_outline;
+    p->draw_line = headless_draw_line;
+    p->present = headless_present;
+    p->texture_load = headless_texture_load;
+    p->texture_create = headless_texture_create;
+    p->texture_free = headless_texture_free;
+    p->texture_draw = headless_texture_draw;
+    p->texture_draw_ex = headless_texture_draw_ex;
+    p->texture_upload = headless_texture_upload;
+    p->draw_text = headless_draw_text;
+    p->audio_stream_open = headless_audio_stream_open;
+    p->audio_stream_close = headless_audio_stream_close;
+    p->audio_lock = headless_audio_lock;
+    p->sound_load = headless_sound_load;
+    p->sound_free = headless_sound_free;
+    p->sound_play = headless_sound_play;
+    p->music_load = headless_music_load;
+    p->music_free = headless_music_free;
+    p->music_play = headless_music_play;
+    p->music_stop = headless_music_stop;
+    p->music_set_volume = headless_music_set_volume;
+
+    return p;
+}
+
+/*============================================================================
+ * Headless Extensions
+ *============================================================================*/
+
+static headless_impl* headless_of(const pb_platform* p)
+{
+    return (p && p->init == headless_init) ? p->impl : NULL;
+}
+
+pb_result pb_platform_headless_set_script(pb_platform* p,
+                                          const pb_headless_key_event* events,
+                                          int count)
+{
+    headless_impl* impl = headless_of(p);
+    if (!impl || count < 0 || (count > 0 && !events)) return PB_ERR_INVALID_ARG;
+
+    for (int i = 1; i < count; i++) {
+        if (events[i].frame < events[i - 1].frame) return PB_ERR_INVALID_ARG;
+    }
+
+    impl->script = events;
+    impl->script_count = count;
+    impl->script_pos = 0;
+    return PB_OK;
+}
+
+const uint32_t* pb_platform_headless_framebuffer(const pb_platform* p,
+                                                 int* width, int* height)
+{
+    const headless_impl* impl = headless_of(p);
+    if (!impl || !impl->pixels) return NULL;
+
+    if (width) *width = impl->width;
+    if (height) *height = impl->height;
+    return impl->pixels;
+}
+
+size_t pb_platform_headless_encode_ppm(const pb_platform* p, uint8_t* out,
+                                       size_t capacity)
+{
+    const headless_impl* impl = headless_of(p);
+    if (!impl || !impl->pixels) return 0;
+
+    char header[32];
+    int header_len = snprintf(header, sizeof(header), "P6\n%d %d\n255\n",
+                              impl->width, impl->height);
+    if (header_len <= 0 || (size_t)header_len >= sizeof(header)) return 0;
+
+    size_t n = (size_t)impl->width * (size_t)impl->height;
+    size_t size = (size_t)header_len + n * 3;
+    if (!out) return size;
+    if (capacity < size) return 0;
+
+    memcpy(out, header, (size_t)header_len);
+    uint8_t* dst = out + header_len;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t v = impl->pixels[i];
+        dst[0] = (uint8_t)(v >> 24);
+        dst[1] = (uint8_t)(v >> 16);
+        dst[2] = (uint8_t)(v >> 8);
+        dst += 3;
+    }
+    return size;
+}
+
+pb_result pb_platform_headless_capture_ppm(const pb_platform* p, const char* path)
+{
+    if (!headless_of(p) || !path) return PB_ERR_INVALID_ARG;
+
+    size_t size = pb_platform_headless_encode_ppm(p, NULL, 0);
+    if (size == 0) return PB_ERR_INVALID_STATE;
+
+    uint8_t* buf = malloc(size);
+    if (!buf) return PB_ERR_NO_MEMORY;
+    pb_platform_headless_encode_ppm(p, buf, size);
+
+    pb_result result = PB_ERR_INVALID_ARG;
+    FILE* f = fopen(path, "wb");
+    if (f) {
+        if (fwrite(buf, 1, size, f) == size) result = PB_OK;
+        if (fclose(f) != 0) result = PB_ERR_INVALID_ARG;
+    }
+    free(buf);
+    return result;
+}
+
+void pb_platform_headless_get_stats(const pb_platform* p, pb_headless_stats* out)
+{
+    if (!out) return;
+    const headless_impl* impl = headless_of(p);
+    if (!impl) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    *out = impl->stats;
+}
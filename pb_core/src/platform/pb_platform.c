@@ -0,0 +1,19 @@
+/*
+ * pb_platform.c - Backend-independent platform helpers
+ *
+ * Every backend allocates its pb_platform and implementation data with
+ * calloc, so one pb_platform_free serves them all.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_platform.h"
+#include <stdlib.h>
+
+void pb_platform_free(pb_platform* p)
+{
+    if (p) {
+        free(p->impl);
+        free(p);
+    }
+}
@@ -26,6 +26,12 @@ typedef struct sdl2_impl {
     uint64_t frame_start;
     uint32_t frame_time_ms;
     pb_input_state prev_input;
+
+    /* PCM stream, mixed after SDL_mixer's channels */
+    SDL_mutex* audio_mutex;
+    pb_audio_stream_fn audio_fn;
+    void* audio_userdata;
+    int audio_channels;
 } sdl2_impl;
 
 /* Texture wrapper */
@@ -130,6 +136,12 @@ static void sdl2_shutdown(pb_platform* p)
         impl->window = NULL;
     }
 
+    if (impl->audio_mutex) {
+        Mix_SetPostMix(NULL, NULL);
+        SDL_DestroyMutex(impl->audio_mutex);
+        impl->audio_mutex = NULL;
+        impl->audio_fn = NULL;
+    }
     Mix_CloseAudio();
     IMG_Quit();
     SDL_Quit();
@@ -426,6 +438,60 @@ static void sdl2_texture_draw_ex(pb_platform* p, const pb_sprite* sprite)
                       &src, &dst, angle_deg, &center, SDL_FLIP_NONE);
 }
 
+static void sdl2_texture_upload(pb_platform* p, pb_texture tex,
+                                const uint32_t* pixels)
+{
+    (void)p;
+    if (!tex || !tex->sdl_tex || !pixels) return;
+
+    SDL_UpdateTexture(tex->sdl_tex, NULL, pixels,
+                      tex->width * (int)sizeof(uint32_t));
+    SDL_SetTextureBlendMode(tex->sdl_tex, SDL_BLENDMODE_BLEND);
+}
+
+/*============================================================================
+ * Text
+ *============================================================================*/
+
+static void sdl2_draw_text(pb_platform* p, pb_texture atlas,
+                           const pb_text_batch* batch, const pb_color_srgb8* colors)
+{
+    if (!atlas || !atlas->sdl_tex || !batch || !colors || batch->count <= 0) return;
+    sdl2_impl* impl = p->impl;
+
+    /* One geometry submission per batch; static to keep ~60 KB off the stack */
+    static SDL_Vertex verts[PB_TEXT_BATCH_MAX * 4];
+    static int indices[PB_TEXT_BATCH_MAX * 6];
+
+    float inv_w = 1.0f / (float)atlas->width;
+    float inv_h = 1.0f / (float)atlas->height;
+    int n = batch->count < PB_TEXT_BATCH_MAX ? batch->count : PB_TEXT_BATCH_MAX;
+
+    for (int i = 0; i < n; i++) {
+        const pb_text_quad* q = &batch->quads[i];
+        pb_color_srgb8 c = colors[q->color];
+        SDL_Color col = {c.r, c.g, c.b, c.a};
+
+        float x0 = (float)q->x, y0 = (float)q->y;
+        float x1 = x0 + (float)q->w, y1 = y0 + (float)q->h;
+        float u0 = (float)q->src_x * inv_w, v0 = (float)q->src_y * inv_h;
+        float u1 = (float)(q->src_x + q->w) * inv_w;
+        float v1 = (float)(q->src_y + q->h) * inv_h;
+
+        SDL_Vertex* v = &verts[i * 4];
+        v[0] = (SDL_Vertex){{x0, y0}, col, {u0, v0}};
+        v[1] = (SDL_Vertex){{x1, y0}, col, {u1, v0}};
+        v[2] = (SDL_Vertex){{x0, y1}, col, {u0, v1}};
+        v[3] = (SDL_Vertex){{x1, y1}, col, {u1, v1}};
+
+        int* idx = &indices[i * 6];
+        idx[0] = i * 4;     idx[1] = i * 4 + 1; idx[2] = i * 4 + 2;
+        idx[3] = i * 4 + 2; idx[4] = i * 4 + 1; idx[5] = i * 4 + 3;
+    }
+
+    SDL_RenderGeometry(impl->renderer, atlas->sdl_tex, verts, n * 4, indices, n * 6);
+}
+
 /*============================================================================
  * Audio
  *============================================================================*/
@@ -468,6 +534,102 @@ static void sdl2_sound_play(pb_platform* p, pb_sound snd, float volume)
     Mix_PlayChannel(-1, snd->chunk, 0);
 }
 
+static int16_t* sdl2_sound_decode(pb_platform* p, const char* path, int sample_rate,
+                                  uint32_t* frames)
+{
+    (void)p;
+    SDL_AudioSpec spec;
+    Uint8* wav;
+    Uint32 wav_len;
+    if (!frames || !SDL_LoadWAV(path, &spec, &wav, &wav_len)) {
+        SDL_Log("SDL_LoadWAV failed for %s: %s", path, SDL_GetError());
+        return NULL;
+    }
+
+    /* Convert to mono signed 16-bit at the mixing rate */
+    SDL_AudioCVT cvt;
+    if (SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq,
+                          AUDIO_S16SYS, 1, sample_rate) < 0) {
+        SDL_Log("SDL_BuildAudioCVT failed for %s: %s", path, SDL_GetError());
+        SDL_FreeWAV(wav);
+        return NULL;
+    }
+    cvt.len = (int)wav_len;
+    cvt.buf = malloc((size_t)wav_len * (size_t)cvt.len_mult);
+    if (!cvt.buf) {
+        SDL_FreeWAV(wav);
+        return NULL;
+    }
+    memcpy(cvt.buf, wav, wav_len);
+    SDL_FreeWAV(wav);
+
+    if (cvt.needed && SDL_ConvertAudio(&cvt) < 0) {
+        SDL_Log("SDL_ConvertAudio failed for %s: %s", path, SDL_GetError());
+        free(cvt.buf);
+        return NULL;
+    }
+    int len = cvt.needed ? cvt.len_cvt : cvt.len;
+    *frames = (uint32_t)((size_t)len / sizeof(int16_t));
+    return (int16_t*)cvt.buf;
+}
+
+static void sdl2_post_mix(void* udata, Uint8* stream, int len)
+{
+    sdl2_impl* impl = udata;
+    SDL_LockMutex(impl->audio_mutex);
+    if (impl->audio_fn) {
+        int frames = len / (int)(sizeof(int16_t) * (size_t)impl->audio_channels);
+        impl->audio_fn(impl->audio_userdata, (int16_t*)stream, frames,
+                       impl->audio_channels);
+    }
+    SDL_UnlockMutex(impl->audio_mutex);
+}
+
+static bool sdl2_audio_stream_open(pb_platform* p, pb_audio_stream_fn fn,
+                                   void* userdata, int* sample_rate, int* channels)
+{
+    sdl2_impl* impl = p->impl;
+    int freq, count;
+    Uint16 format;
+    if (!fn || impl->audio_mutex || !Mix_QuerySpec(&freq, &format, &count) ||
+        format != AUDIO_S16SYS) {
+        return false;
+    }
+
+    impl->audio_mutex = SDL_CreateMutex();
+    if (!impl->audio_mutex) return false;
+    impl->audio_fn = fn;
+    impl->audio_userdata = userdata;
+    impl->audio_channels = count;
+    Mix_SetPostMix(sdl2_post_mix, impl);
+
+    if (sample_rate) *sample_rate = freq;
+    if (channels) *channels = count;
+    return true;
+}
+
+static void sdl2_audio_stream_close(pb_platform* p)
+{
+    sdl2_impl* impl = p->impl;
+    if (!impl->audio_mutex) return;
+    Mix_SetPostMix(NULL, NULL);
+    SDL_DestroyMutex(impl->audio_mutex);
+    impl->audio_mutex = NULL;
+    impl->audio_fn = NULL;
+    impl->audio_userdata = NULL;
+}
+
+static void sdl2_audio_lock(pb_platform* p, bool lock)
+{
+    sdl2_impl* impl = p->impl;
+    if (!impl->audio_mutex) return;
+    if (lock) {
+        SDL_LockMutex(impl->audio_mutex);
+    } else {
+        SDL_UnlockMutex(impl->audio_mutex);
+    }
+}
+
 static pb_music sdl2_music_load(pb_platform* p, const char* path)
 {
     (void)p;
@@ -555,9 +717,15 @@ pb_platform* pb_platform_sdl2_create(void)
     p->texture_free = sdl2_texture_free;
     p->texture_draw = sdl2_texture_draw;
     p->texture_draw_ex = sdl2_texture_draw_ex;
+    p->texture_upload = sdl2_texture_upload;
+    p->draw_text = sdl2_draw_text;
     p->sound_load = sdl2_sound_load;
     p->sound_free = sdl2_sound_free;
     p->sound_play = sdl2_sound_play;
+    p->sound_decode = sdl2_sound_decode;
+    p->audio_stream_open = sdl2_audio_stream_open;
+    p->audio_stream_close = sdl2_audio_stream_close;
+    p->audio_lock = sdl2_audio_lock;
     p->music_load = sdl2_music_load;
     p->music_free = sdl2_music_free;
     p->music_play = sdl2_music_play;
@@ -566,11 +734,3 @@ pb_platform* pb_platform_sdl2_create(void)
 
     return p;
 }
-
-void pb_platform_free(pb_platform* p)
-{
-    if (p) {
-        free(p->impl);
-        free(p);
-    }
-}
@@ -0,0 +1,350 @@
+/*
+ * test_anim.c - Tests for pb_anim module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/* Shared across tests: the timeline is large, keep it off the stack */
+static pb_anim_timeline timeline;
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+static pb_tween linear_tween(uint32_t start, uint16_t duration)
+{
+    pb_tween tween = {
+        .kind = PB_TWEEN_CUSTOM,
+        .ease = PB_EASE_LINEAR,
+        .start_frame = start,
+        .duration = duration,
+        .from = PB_ANIM_FROM_INT(10),
+        .to = PB_ANIM_FROM_INT(30),
+    };
+    return tween;
+}
+
+/*============================================================================
+ * Easing Tests
+ *============================================================================*/
+
+TEST(ease_endpoints) {
+    for (int e = 0; e < PB_EASE_COUNT; e++) {
+        ASSERT_EQ(pb_ease_eval((pb_ease)e, 0), 0);
+        ASSERT_EQ(pb_ease_eval((pb_ease)e, 65536), PB_EASE_ONE);
+        ASSERT_EQ(pb_ease_eval((pb_ease)e, 1u << 20), PB_EASE_ONE);
+    }
+    ASSERT_EQ(pb_ease_eval(PB_EASE_LINEAR, 32768), PB_EASE_ONE / 2);
+    ASSERT_EQ(pb_ease_eval(PB_EASE_IN_QUAD, 32768), PB_EASE_ONE / 4);
+    ASSERT_EQ(pb_ease_eval(PB_EASE_IN_OUT_CUBIC, 32768), PB_EASE_ONE / 2);
+}
+
+TEST(ease_shapes) {
+    int32_t prev_in = 0, prev_out = 0, peak_back = 0;
+    for (uint32_t phase = 0; phase <= 65536; phase += 256) {
+        int32_t in = pb_ease_eval(PB_EASE_IN_QUAD, phase);
+        int32_t out = pb_ease_eval(PB_EASE_OUT_QUAD, phase);
+        ASSERT_TRUE(in >= prev_in);
+        ASSERT_TRUE(out >= prev_out);
+        ASSERT_TRUE(out >= in);
+        prev_in = in;
+        prev_out = out;
+
+        int32_t back = pb_ease_eval(PB_EASE_OUT_BACK, phase);
+        if (back > peak_back) peak_back = back;
+
+        int32_t bounce = pb_ease_eval(PB_EASE_OUT_BOUNCE, phase);
+        ASSERT_TRUE(bounce >= 0 && bounce <= PB_EASE_ONE);
+    }
+    ASSERT_TRUE(peak_back > PB_EASE_ONE);
+}
+
+/* Closed-form Penner curves, t in [0, 1] */
+static double ease_reference(pb_ease ease, double t)
+{
+    switch (ease) {
+    case PB_EASE_IN_QUAD:
+        return t * t;
+    case PB_EASE_OUT_QUAD:
+        return 1.0 - (1.0 - t) * (1.0 - t);
+    case PB_EASE_IN_OUT_CUBIC:
+        return t < 0.5 ? 4.0 * t * t * t : 1.0 - pow(-2.0 * t + 2.0, 3.0) / 2.0;
+    case PB_EASE_OUT_BACK:
+        return 1.0 + 2.70158 * pow(t - 1.0, 3.0) + 1.70158 * pow(t - 1.0, 2.0);
+    case PB_EASE_OUT_BOUNCE:
+        if (t < 1.0 / 2.75) return 7.5625 * t * t;
+        if (t < 2.0 / 2.75) { t -= 1.5 / 2.75; return 7.5625 * t * t + 0.75; }
+        if (t < 2.5 / 2.75) { t -= 2.25 / 2.75; return 7.5625 * t * t + 0.9375; }
+        t -= 2.625 / 2.75;
+        return 7.5625 * t * t + 0.984375;
+    default:
+        return t;
+    }
+}
+
+TEST(ease_matches_closed_form) {
+    /* The 0.2% bound documented in pb_anim.c */
+    const double bound = 0.002 * PB_EASE_ONE;
+    for (int e = 0; e < PB_EASE_COUNT; e++) {
+        for (uint32_t phase = 0; phase <= 65536; phase += 7) {
+            double want = ease_reference((pb_ease)e, phase / 65536.0) * PB_EASE_ONE;
+            double got = pb_ease_eval((pb_ease)e, phase);
+            ASSERT_TRUE(fabs(got - want) <= bound);
+        }
+    }
+}
+
+/*============================================================================
+ * Timeline Tests
+ *============================================================================*/
+
+TEST(advance_interpolates) {
+    pb_anim_init(&timeline, NULL);
+    pb_tween tween = linear_tween(100, 4);
+    ASSERT_EQ(pb_anim_add(&timeline, &tween), PB_OK);
+
+    /* Before the start it holds the from value */
+    pb_anim_advance(&timeline, 90);
+    ASSERT_EQ(timeline.value[0], PB_ANIM_FROM_INT(10));
+
+    pb_anim_advance(&timeline, 101);
+    ASSERT_EQ(timeline.value[0], PB_ANIM_FROM_INT(15));
+    pb_anim_advance(&timeline, 102);
+    ASSERT_EQ(timeline.value[0], PB_ANIM_FROM_INT(20));
+
+    /* The end value is shown for one frame, then the tween is removed */
+    pb_anim_advance(&timeline, 104);
+    ASSERT_EQ(timeline.count, 1);
+    ASSERT_EQ(timeline.value[0], PB_ANIM_FROM_INT(30));
+    ASSERT_TRUE(timeline.flags[0] & PB_TWEEN_DONE);
+    pb_anim_advance(&timeline, 105);
+    ASSERT_EQ(timeline.count, 0);
+}
+
+TEST(add_validates_and_fills) {
+    pb_anim_init(&timeline, NULL);
+    pb_tween tween = linear_tween(0, 0);
+    ASSERT_EQ(pb_anim_add(&timeline, &tween), PB_ERR_INVALID_ARG);
+    tween.duration = 5;
+    tween.ease = PB_EASE_COUNT;
+    ASSERT_EQ(pb_anim_add(&timeline, &tween), PB_ERR_INVALID_ARG);
+    tween.ease = PB_EASE_LINEAR;
+
+    for (int i = 0; i < PB_ANIM_MAX_TWEENS; i++) {
+        tween.start_frame = (uint32_t)i;
+        ASSERT_EQ(pb_anim_add(&timeline, &tween), PB_OK);
+    }
+    tween.flags = PB_TWEEN_BLOCKING;
+    tween.start_frame = 1000;
+    ASSERT_EQ(pb_anim_add(&timeline, &tween), PB_ERR_NO_MEMORY);
+    ASSERT_EQ(timeline.dropped, 1u);
+
+    /* A dropped blocking tween still holds the simulation */
+    ASSERT_FALSE(pb_anim_sim_can_continue(&timeline, 1004));
+    ASSERT_TRUE(pb_anim_sim_can_continue(&timeline, 1005));
+
+    /* Compaction keeps insertion order */
+    pb_anim_advance(&timeline, 10);
+    pb_anim_advance(&timeline, 11);
+    ASSERT_EQ(timeline.count, PB_ANIM_MAX_TWEENS - 6);
+    ASSERT_EQ(timeline.start[0], 6u);
+    ASSERT_EQ(timeline.start[1], 7u);
+}
+
+TEST(events_schedule_tweens) {
+    pb_anim_init(&timeline, NULL);
+    const pb_anim_config* cfg = &timeline.config;
+
+    pb_event evt = {0};
+    evt.type = PB_EVENT_BUBBLES_POPPED;
+    evt.frame = 50;
+    evt.data.popped.count = 3;
+    for (int i = 0; i < 3; i++) {
+        evt.data.popped.cells[i] = PB_CELL_TO_INDEX(2, i);
+    }
+    pb_anim_on_event(&evt, &timeline);
+    ASSERT_EQ(timeline.count, 3);
+
+    /* Pops are staggered; the last one sets the horizon */
+    ASSERT_EQ(timeline.start[2], 50u + 2u * cfg->pop_stagger);
+    ASSERT_EQ(timeline.block_until, 50u + 2u * cfg->pop_stagger + cfg->pop_frames);
+
+    pb_anim_advance(&timeline, 50 + cfg->pop_frames);
+    pb_anim_value v;
+    ASSERT_TRUE(pb_anim_cell_value(&timeline, PB_TWEEN_POP, PB_CELL_TO_INDEX(2, 0), &v));
+    ASSERT_EQ(v, 0);
+    ASSERT_TRUE(pb_anim_cell_value(&timeline, PB_TWEEN_POP, PB_CELL_TO_INDEX(2, 2), &v));
+    ASSERT_TRUE(v > 0 && v < PB_ANIM_ONE);
+    ASSERT_FALSE(pb_anim_cell_value(&timeline, PB_TWEEN_FALL, PB_CELL_TO_INDEX(2, 2), NULL));
+
+    /* Garbage: ceiling drops by whole rows and settles at zero */
+    pb_anim_clear(&timeline);
+    memset(&evt, 0, sizeof(evt));
+    evt.type = PB_EVENT_GARBAGE_RECEIVED;
+    evt.frame = 200;
+    evt.data.garbage.count = 9;     /* Two rows of 8 */
+    pb_anim_on_event(&evt, &timeline);
+    pb_anim_advance(&timeline, 200);
+    ASSERT_EQ(pb_anim_board_offset(&timeline), -2 * cfg->row_height);
+    pb_anim_advance(&timeline, 200 + cfg->ceiling_drop_frames);
+    ASSERT_EQ(pb_anim_board_offset(&timeline), 0);
+
+    /* Other events are ignored */
+    evt.type = PB_EVENT_FIRE;
+    pb_anim_on_event(&evt, &timeline);
+    ASSERT_EQ(timeline.count, 1);
+}
+
+TEST(attach_follows_game) {
+    static pb_game_state game;
+    pb_game_init(&game, NULL, 0);
+    pb_anim_init(&timeline, NULL);
+    const pb_anim_config* cfg = &timeline.config;
+
+    ASSERT_EQ(pb_anim_attach(&timeline, &game), PB_OK);
+    ASSERT_EQ(pb_anim_attach(&timeline, &game), PB_ERR_INVALID_STATE);
+
+    for (int col = 0; col < 3; col++) {
+        pb_board_set(&game.board, (pb_offset){0, col}, colored(2));
+    }
+    pb_board_set(&game.board, (pb_offset){1, 0}, colored(5));
+    game.frame = 10;
+    pb_game_process_matches(&game, (pb_offset){0, 0});
+    pb_game_process_orphans(&game);
+
+    ASSERT_EQ(timeline.count, 4);
+    ASSERT_EQ(timeline.kind[3], PB_TWEEN_FALL);
+    ASSERT_EQ(timeline.color[0], 2);
+    ASSERT_EQ(timeline.color[3], 5);
+
+    uint32_t end = 10u + cfg->fall_delay + cfg->fall_frames;
+    ASSERT_EQ(timeline.block_until, end);
+    ASSERT_FALSE(pb_anim_sim_can_continue(&timeline, end - 1));
+    ASSERT_TRUE(pb_anim_sim_can_continue(&timeline, end));
+
+    /* Falling accelerates toward fall_distance */
+    pb_anim_value y1, y2, y3;
+    pb_anim_advance(&timeline, 10 + cfg->fall_delay + 5);
+    pb_anim_cell_value(&timeline, PB_TWEEN_FALL, PB_CELL_TO_INDEX(1, 0), &y1);
+    pb_anim_advance(&timeline, 10 + cfg->fall_delay + 10);
+    pb_anim_cell_value(&timeline, PB_TWEEN_FALL, PB_CELL_TO_INDEX(1, 0), &y2);
+    pb_anim_advance(&timeline, end);
+    pb_anim_cell_value(&timeline, PB_TWEEN_FALL, PB_CELL_TO_INDEX(1, 0), &y3);
+    ASSERT_TRUE(y2 - y1 > y1);
+    ASSERT_EQ(y3, cfg->fall_distance);
+
+    pb_anim_detach(&timeline, &game);
+    pb_anim_clear(&timeline);
+    pb_board_set(&game.board, (pb_offset){0, 0}, colored(1));
+    pb_board_set(&game.board, (pb_offset){0, 1}, colored(1));
+    pb_board_set(&game.board, (pb_offset){0, 2}, colored(1));
+    pb_game_process_matches(&game, (pb_offset){0, 0});
+    ASSERT_EQ(timeline.count, 0);
+}
+
+TEST(headless_matches_full) {
+    static pb_anim_timeline headless;
+    pb_anim_config cfg;
+    pb_anim_config_default(&cfg);
+    cfg.headless = true;
+    pb_anim_init(&headless, &cfg);
+    pb_anim_init(&timeline, NULL);
+
+    pb_rng rng;
+    pb_rng_seed(&rng, 87);
+    uint32_t frame = 0;
+    for (int step = 0; step < 200; step++) {
+        frame += (uint32_t)pb_rng_range_int(&rng, 1, 20);
+        pb_event evt = {0};
+        evt.frame = frame;
+        switch (pb_rng_range_int(&rng, 0, 3)) {
+        case 0:
+            evt.type = PB_EVENT_BUBBLES_POPPED;
+            evt.data.popped.count = (uint8_t)pb_rng_range_int(&rng, 3, 12);
+            break;
+        case 1:
+            evt.type = PB_EVENT_BUBBLES_DROPPED;
+            evt.data.dropped.count = (uint8_t)pb_rng_range_int(&rng, 1, 12);
+            break;
+        case 2:
+            evt.type = PB_EVENT_ROW_INSERTED;
+            break;
+        default:
+            evt.type = PB_EVENT_GARBAGE_RECEIVED;
+            evt.data.garbage.count = (uint8_t)pb_rng_range_int(&rng, 1, 20);
+            break;
+        }
+        pb_anim_on_event(&evt, &headless);
+        pb_anim_on_event(&evt, &timeline);
+        pb_anim_advance(&timeline, frame);
+
+        ASSERT_EQ(headless.count, 0);
+        ASSERT_EQ(headless.block_until, timeline.block_until);
+        ASSERT_EQ(pb_anim_sim_can_continue(&headless, frame + 1),
+                  pb_anim_sim_can_continue(&timeline, frame + 1));
+    }
+    ASSERT_EQ(timeline.dropped, 0u);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_anim test suite\n");
+    printf("==================\n\n");
+
+    printf("Easing:\n");
+    RUN(ease_endpoints);
+    RUN(ease_shapes);
+    RUN(ease_matches_closed_form);
+
+    printf("\nTimeline:\n");
+    RUN(advance_interpolates);
+    RUN(add_validates_and_fills);
+    RUN(events_schedule_tweens);
+    RUN(attach_follows_game);
+    RUN(headless_matches_full);
+
+    printf("\n==================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,321 @@
+/*
+ * test_async.c - Tests for pb_async module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+/* Two red bubbles on the ceiling; one red shot clears them */
+static void build_easy(pb_board* board, pb_bubble* queue)
+{
+    pb_board_init(board);
+    pb_board_set(board, (pb_offset){0, 2}, colored(0));
+    pb_board_set(board, (pb_offset){0, 3}, colored(0));
+    for (int i = 0; i < 4; i++) {
+        queue[i] = colored(0);
+    }
+}
+
+#if PB_FEATURE_THREADS
+/* Dense multi-color board with a long queue: far beyond any test budget */
+static void build_hard(pb_board* board, pb_bubble* queue)
+{
+    pb_board_init(board);
+    for (int row = 0; row < 5; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            pb_board_set(board, (pb_offset){row, col},
+                         colored((uint8_t)((row * 3 + col * 5) % 6)));
+        }
+    }
+    for (int i = 0; i < 24; i++) {
+        queue[i] = colored((uint8_t)((i * 7) % 6));
+    }
+}
+#endif
+
+static pb_async_config exact_config(uint32_t budget_ms)
+{
+    pb_async_config config;
+    pb_async_config_default(&config);
+    config.exact.movegen = PB_EXACT_MOVES_ATTACHABLE;
+    config.exact.time_budget_ms = budget_ms;
+    return config;
+}
+
+typedef struct callback_log {
+    int calls;
+    int final_calls;
+    uint32_t last_generation;
+} callback_log;
+
+static void log_progress(const pb_async_progress* progress, void* userdata)
+{
+    callback_log* log = userdata;
+    log->calls++;
+    if (progress->state != PB_ASYNC_RUNNING) {
+        log->final_calls++;
+    }
+    log->last_generation = progress->generation;
+}
+
+/*============================================================================
+ * Lifecycle Tests
+ *============================================================================*/
+
+TEST(config_default) {
+    pb_async_config config;
+    pb_async_config_default(&config);
+    ASSERT_TRUE(config.max_search > 0);
+    ASSERT_TRUE(config.run_exact);
+    ASSERT_TRUE(config.exact.time_budget_ms > 0);
+    ASSERT_EQ(config.on_progress, NULL);
+}
+
+TEST(create_idle) {
+    pb_async_solver* solver = pb_async_create(NULL);
+    ASSERT_NE(solver, NULL);
+
+    pb_async_progress progress;
+    ASSERT_EQ(pb_async_poll(solver, &progress), PB_ASYNC_IDLE);
+    ASSERT_EQ(progress.generation, 0u);
+    ASSERT_EQ(pb_async_wait(solver, NULL), PB_ASYNC_IDLE);
+
+    pb_async_cancel(solver);
+    ASSERT_EQ(pb_async_poll(solver, NULL), PB_ASYNC_IDLE);
+    pb_async_destroy(solver);
+    pb_async_destroy(NULL);
+}
+
+TEST(start_invalid_args) {
+    pb_async_solver* solver = pb_async_create(NULL);
+    pb_board board;
+    pb_bubble queue[4];
+    build_easy(&board, queue);
+
+    ASSERT_EQ(pb_async_start(NULL, &board, NULL, queue, 4), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_async_start(solver, NULL, NULL, queue, 4), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_async_start(solver, &board, NULL, NULL, 4), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_async_start(solver, &board, NULL, queue, -1), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_async_start(solver, &board, NULL, queue, PB_EXACT_MAX_DEPTH + 1),
+              PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_async_poll(solver, NULL), PB_ASYNC_IDLE);
+    pb_async_destroy(solver);
+}
+
+/*============================================================================
+ * Analysis Tests
+ *============================================================================*/
+
+TEST(solve_easy) {
+    pb_async_config config = exact_config(1000);
+    pb_async_solver* solver = pb_async_create(&config);
+    pb_board board;
+    pb_bubble queue[4];
+    build_easy(&board, queue);
+
+    ASSERT_EQ(pb_async_start(solver, &board, NULL, queue, 4), PB_OK);
+
+    pb_async_progress progress;
+    ASSERT_EQ(pb_async_wait(solver, &progress), PB_ASYNC_DONE);
+    ASSERT_EQ(progress.generation, 1u);
+    ASSERT_TRUE(progress.greedy_done);
+    ASSERT_TRUE(progress.greedy.solvable);
+    ASSERT_TRUE(progress.exact_done);
+    ASSERT_EQ(progress.exact_status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(progress.exact_min_shots, 1);
+    ASSERT_FALSE(progress.reused);
+    ASSERT_EQ(pb_async_poll(solver, NULL), PB_ASYNC_DONE);
+
+    pb_async_destroy(solver);
+}
+
+TEST(greedy_only) {
+    pb_async_config config;
+    pb_async_config_default(&config);
+    config.run_exact = false;
+    pb_async_solver* solver = pb_async_create(&config);
+    pb_board board;
+    pb_bubble queue[4];
+    build_easy(&board, queue);
+
+    pb_async_start(solver, &board, NULL, queue, 4);
+
+    pb_async_progress progress;
+    ASSERT_EQ(pb_async_wait(solver, &progress), PB_ASYNC_DONE);
+    ASSERT_TRUE(progress.greedy_done);
+    ASSERT_TRUE(progress.greedy.solvable);
+    ASSERT_FALSE(progress.exact_done);
+    ASSERT_EQ(progress.exact_min_shots, -1);
+
+    pb_async_destroy(solver);
+}
+
+TEST(progress_callback) {
+    callback_log log = {0, 0, 0};
+    pb_async_config config = exact_config(1000);
+    config.progress_interval_ms = 0;
+    config.on_progress = log_progress;
+    config.callback_userdata = &log;
+    pb_async_solver* solver = pb_async_create(&config);
+
+    pb_board board;
+    pb_bubble queue[4];
+    build_easy(&board, queue);
+    pb_async_start(solver, &board, NULL, queue, 4);
+    pb_async_wait(solver, NULL);
+
+    /* Joining the worker orders its callbacks before the checks */
+    pb_async_destroy(solver);
+    ASSERT_TRUE(log.calls >= 1);
+    ASSERT_EQ(log.final_calls, 1);
+    ASSERT_EQ(log.last_generation, 1u);
+}
+
+TEST(identical_restart_reuses_result) {
+    pb_async_config config = exact_config(1000);
+    pb_async_solver* solver = pb_async_create(&config);
+    pb_board board;
+    pb_bubble queue[4];
+    build_easy(&board, queue);
+
+    pb_async_progress first, second;
+    pb_async_start(solver, &board, NULL, queue, 4);
+    ASSERT_EQ(pb_async_wait(solver, &first), PB_ASYNC_DONE);
+
+    pb_async_start(solver, &board, NULL, queue, 4);
+    ASSERT_EQ(pb_async_wait(solver, &second), PB_ASYNC_DONE);
+    ASSERT_TRUE(second.reused);
+    ASSERT_EQ(second.generation, 2u);
+    ASSERT_EQ(second.exact_min_shots, first.exact_min_shots);
+    ASSERT_EQ(second.greedy.min_moves, first.greedy.min_moves);
+
+    /* Any edit forces a fresh search */
+    pb_board_set(&board, (pb_offset){0, 4}, colored(0));
+    pb_async_start(solver, &board, NULL, queue, 4);
+    ASSERT_EQ(pb_async_wait(solver, &second), PB_ASYNC_DONE);
+    ASSERT_FALSE(second.reused);
+
+    pb_async_destroy(solver);
+}
+
+/*============================================================================
+ * Cancellation Tests
+ *============================================================================*/
+
+#if PB_FEATURE_THREADS
+
+TEST(cancel_running) {
+    pb_async_config config = exact_config(0);
+    config.exact.seed_with_greedy = false;
+    pb_async_solver* solver = pb_async_create(&config);
+    pb_board board;
+    pb_bubble queue[24];
+    build_hard(&board, queue);
+
+    ASSERT_EQ(pb_async_start(solver, &board, NULL, queue, 24), PB_OK);
+    pb_async_cancel(solver);
+
+    pb_async_progress progress;
+    ASSERT_EQ(pb_async_wait(solver, &progress), PB_ASYNC_CANCELLED);
+    ASSERT_FALSE(progress.exact_done);
+
+    /* Destroy must not hang on the unbounded search */
+    pb_async_destroy(solver);
+}
+
+TEST(restart_supersedes) {
+    pb_async_config config = exact_config(0);
+    pb_async_solver* solver = pb_async_create(&config);
+    pb_board hard, easy;
+    pb_bubble hard_queue[24], easy_queue[4];
+    build_hard(&hard, hard_queue);
+    build_easy(&easy, easy_queue);
+
+    pb_async_start(solver, &hard, NULL, hard_queue, 24);
+    pb_async_start(solver, &easy, NULL, easy_queue, 4);
+
+    pb_async_progress progress;
+    ASSERT_EQ(pb_async_wait(solver, &progress), PB_ASYNC_DONE);
+    ASSERT_EQ(progress.generation, 2u);
+    ASSERT_EQ(progress.exact_status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(progress.exact_min_shots, 1);
+
+    pb_async_destroy(solver);
+}
+#endif
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_async test suite\n");
+    printf("===================\n\n");
+
+    printf("Lifecycle:\n");
+    RUN(config_default);
+    RUN(create_idle);
+    RUN(start_invalid_args);
+
+    printf("\nAnalysis:\n");
+    RUN(solve_easy);
+    RUN(greedy_only);
+    RUN(progress_callback);
+    RUN(identical_restart_reuses_result);
+
+#if PB_FEATURE_THREADS
+    /* Serial builds finish every job inside pb_async_start() */
+    printf("\nCancellation:\n");
+    RUN(cancel_running);
+    RUN(restart_supersedes);
+#endif
+
+    printf("\n===================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
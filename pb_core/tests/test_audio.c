@@ -0,0 +1,319 @@
+/*
+ * test_audio.c - Tests for pb_audio module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+
+#define RATE 44100
+#define LEN 64
+
+/* Constant-level test tones */
+static int16_t tone_a[LEN];
+static int16_t tone_b[LEN * 4];
+
+static void init_tones(void)
+{
+    for (int i = 0; i < LEN; i++) tone_a[i] = 1000;
+    for (int i = 0; i < LEN * 4; i++) tone_b[i] = 1000;
+}
+
+/* Mix a block into silence and return the first frame's left sample */
+static int mix_first(pb_audio* audio, int frames)
+{
+    int16_t out[LEN * 4 * 2];
+    memset(out, 0, sizeof(out));
+    pb_audio_mix(audio, out, frames, 2);
+    ASSERT_EQ(out[0], out[1]);
+    return out[0];
+}
+
+/*============================================================================
+ * Scheduling Tests
+ *============================================================================*/
+
+TEST(requests_coalesce)
+{
+    pb_audio* audio = pb_audio_create(RATE);
+    ASSERT_NE(audio, NULL);
+    int id;
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, LEN, 1, &id), PB_OK);
+
+    /* Ten pops in one frame: one voice, louder but capped */
+    for (int i = 0; i < 10; i++) pb_audio_play(audio, id, 0.25f);
+    pb_audio_commit(audio);
+
+    pb_audio_stats stats = pb_audio_get_stats(audio);
+    ASSERT_EQ(stats.requests, 10u);
+    ASSERT_EQ(stats.coalesced, 9u);
+    ASSERT_EQ(stats.started, 1u);
+    ASSERT_EQ(stats.active, 1);
+
+    /* 0.25 * sqrt(10) = 0.79 */
+    int level = mix_first(audio, 1);
+    ASSERT(level > 780 && level < 800);
+
+    /* Ten at full volume clip to unity gain */
+    pb_audio_stop_all(audio);
+    for (int i = 0; i < 10; i++) pb_audio_play(audio, id, 1.0f);
+    pb_audio_commit(audio);
+    ASSERT_EQ(mix_first(audio, 1), 1000);
+
+    /* Bad ids and silent requests are ignored */
+    pb_audio_play(audio, 99, 1.0f);
+    pb_audio_play(audio, -1, 1.0f);
+    pb_audio_play(audio, id, 0.0f);
+    ASSERT_EQ(pb_audio_get_stats(audio).requests, 20u);
+
+    pb_audio_destroy(audio);
+}
+
+TEST(pool_steals_by_priority)
+{
+    pb_audio* audio = pb_audio_create(RATE);
+    int low, high;
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_b, LEN * 4, 1, &low), PB_OK);
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_b, LEN * 4, 5, &high), PB_OK);
+
+    /* Fill the pool with low-priority voices over several frames */
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+        pb_audio_play(audio, low, 1.0f);
+        pb_audio_commit(audio);
+    }
+    pb_audio_stats stats = pb_audio_get_stats(audio);
+    ASSERT_EQ(stats.active, PB_AUDIO_MAX_VOICES);
+    ASSERT_EQ(stats.stolen, 0u);
+
+    /* A higher priority takes a voice */
+    pb_audio_play(audio, high, 1.0f);
+    pb_audio_commit(audio);
+    stats = pb_audio_get_stats(audio);
+    ASSERT_EQ(stats.stolen, 1u);
+    ASSERT_EQ(stats.active, PB_AUDIO_MAX_VOICES);
+
+    /* Once every voice is high priority, low requests are dropped */
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES; i++) {
+        pb_audio_play(audio, high, 1.0f);
+        pb_audio_commit(audio);
+    }
+    pb_audio_play(audio, low, 1.0f);
+    pb_audio_play(audio, low, 1.0f);
+    pb_audio_commit(audio);
+    stats = pb_audio_get_stats(audio);
+    ASSERT_EQ(stats.dropped, 2u);
+    ASSERT_EQ(stats.started, 2u * PB_AUDIO_MAX_VOICES + 1u);
+
+    pb_audio_destroy(audio);
+}
+
+TEST(higher_priority_commits_first)
+{
+    pb_audio* audio = pb_audio_create(RATE);
+    int ids[PB_AUDIO_MAX_VOICES + 1];
+    for (int i = 0; i <= PB_AUDIO_MAX_VOICES; i++) {
+        ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, LEN, (uint8_t)i, &ids[i]), PB_OK);
+    }
+
+    /* One more sound than voices in a frame: the lowest priority loses */
+    for (int i = 0; i <= PB_AUDIO_MAX_VOICES; i++) pb_audio_play(audio, ids[i], 1.0f);
+    pb_audio_commit(audio);
+    pb_audio_stats stats = pb_audio_get_stats(audio);
+    ASSERT_EQ(stats.started, (uint32_t)PB_AUDIO_MAX_VOICES);
+    ASSERT_EQ(stats.dropped, 1u);
+    ASSERT_EQ(stats.stolen, 0u);
+
+    pb_audio_destroy(audio);
+}
+
+TEST(commit_never_steals_its_own_voices)
+{
+    pb_audio* audio = pb_audio_create(RATE);
+    int ids[PB_AUDIO_MAX_VOICES + 3];
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES + 3; i++) {
+        ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, LEN, 1, &ids[i]), PB_OK);
+    }
+
+    /* More distinct equal-priority sounds than voices in one frame */
+    for (int i = 0; i < PB_AUDIO_MAX_VOICES + 3; i++) pb_audio_play(audio, ids[i], 1.0f);
+    pb_audio_commit(audio);
+    pb_audio_stats stats = pb_audio_get_stats(audio);
+    ASSERT_EQ(stats.started, (uint32_t)PB_AUDIO_MAX_VOICES);
+    ASSERT_EQ(stats.stolen, 0u);
+    ASSERT_EQ(stats.dropped, 3u);
+
+    /* Every started voice plays */
+    ASSERT_EQ(mix_first(audio, 1), PB_AUDIO_MAX_VOICES * 1000);
+
+    /* A later frame may steal them at equal priority */
+    pb_audio_play(audio, ids[PB_AUDIO_MAX_VOICES], 1.0f);
+    pb_audio_commit(audio);
+    ASSERT_EQ(pb_audio_get_stats(audio).stolen, 1u);
+
+    pb_audio_destroy(audio);
+}
+
+/*============================================================================
+ * Mixing Tests
+ *============================================================================*/
+
+TEST(mix_adds_and_saturates)
+{
+    pb_audio* audio = pb_audio_create(RATE);
+    int16_t loud[LEN];
+    for (int i = 0; i < LEN; i++) loud[i] = 30000;
+    int id, quiet;
+    ASSERT_EQ(pb_audio_add_pcm(audio, loud, LEN, 1, &id), PB_OK);
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, LEN, 1, &quiet), PB_OK);
+
+    pb_audio_play(audio, id, 1.0f);
+    pb_audio_play(audio, quiet, 0.5f);
+    pb_audio_commit(audio);
+
+    /* Added to what is already in the stream, clamped */
+    int16_t out[LEN * 2 * 2];
+    for (int i = 0; i < LEN * 2 * 2; i++) out[i] = 5000;
+    pb_audio_mix(audio, out, LEN * 2, 2);
+    ASSERT_EQ(out[0], 32767);
+    ASSERT_EQ(out[1], 32767);
+
+    /* Voices end with their sound */
+    ASSERT_EQ(out[LEN * 2], 5000);
+    ASSERT_EQ(pb_audio_get_stats(audio).active, 0);
+
+    /* Nothing playing leaves the stream alone */
+    pb_audio_mix(audio, out, LEN, 2);
+    ASSERT_EQ(out[0], 32767);
+
+    pb_audio_destroy(audio);
+}
+
+TEST(attach_to_headless_stream)
+{
+    pb_platform* p = pb_platform_headless_create();
+    ASSERT_NE(p, NULL);
+    pb_platform_config config = PB_PLATFORM_CONFIG_DEFAULT;
+    ASSERT_TRUE(pb_init(p, &config));
+
+    /* The stream rate must match */
+    pb_audio* wrong = pb_audio_create(22050);
+    ASSERT_EQ(pb_audio_attach(wrong, p), PB_ERR_INVALID_STATE);
+    pb_audio_destroy(wrong);
+
+    pb_audio* audio = pb_audio_create(PB_AUDIO_DEFAULT_RATE);
+    ASSERT_EQ(pb_audio_attach(audio, p), PB_OK);
+    ASSERT_EQ(pb_audio_attach(audio, p), PB_ERR_INVALID_STATE);
+
+    int id;
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_b, LEN * 4, 1, &id), PB_OK);
+    pb_audio_play(audio, id, 1.0f);
+    pb_audio_commit(audio);
+    ASSERT_EQ(pb_audio_get_stats(audio).active, 1);
+
+    /* One 60fps frame pulls 735 frames, playing the sound out */
+    p->begin_frame(p);
+    p->end_frame(p);
+    pb_headless_stats stats;
+    pb_platform_headless_get_stats(p, &stats);
+    ASSERT_EQ(stats.audio_frames, 735u);
+    ASSERT_EQ(pb_audio_get_stats(audio).active, 0);
+
+    /* No decoder on the headless backend */
+    ASSERT_EQ(pb_audio_load(audio, p, "pop.wav", 1, &id), PB_ERR_NOT_IMPLEMENTED);
+
+    /* Destroying detaches */
+    pb_audio_destroy(audio);
+    p->begin_frame(p);
+    p->end_frame(p);
+    pb_platform_headless_get_stats(p, &stats);
+    ASSERT_EQ(stats.audio_frames, 735u);
+
+    pb_shutdown(p);
+    pb_platform_free(p);
+}
+
+TEST(invalid_args)
+{
+    ASSERT_EQ(pb_audio_create(0), NULL);
+    pb_audio* audio = pb_audio_create(RATE);
+    int id;
+    ASSERT_EQ(pb_audio_add_pcm(NULL, tone_a, LEN, 1, &id), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_audio_add_pcm(audio, NULL, LEN, 1, &id), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, 0, 1, &id), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_audio_attach(audio, NULL), PB_ERR_INVALID_ARG);
+
+    pb_platform bare = {0};
+    ASSERT_EQ(pb_audio_attach(audio, &bare), PB_ERR_NOT_IMPLEMENTED);
+
+    for (int i = 0; i < PB_AUDIO_MAX_SOUNDS; i++) {
+        ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, LEN, 1, &id), PB_OK);
+    }
+    ASSERT_EQ(pb_audio_add_pcm(audio, tone_a, LEN, 1, &id), PB_ERR_NO_MEMORY);
+
+    pb_audio_commit(NULL);
+    pb_audio_mix(NULL, NULL, 0, 0);
+    pb_audio_destroy(audio);
+    pb_audio_destroy(NULL);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_audio test suite\n");
+    printf("===================\n\n");
+
+    init_tones();
+
+    printf("Scheduling:\n");
+    RUN(requests_coalesce);
+    RUN(pool_steals_by_priority);
+    RUN(higher_priority_commits_first);
+    RUN(commit_never_steals_its_own_voices);
+
+    printf("\nMixing:\n");
+    RUN(mix_adds_and_saturates);
+    RUN(attach_to_headless_stream);
+
+    printf("\nValidation:\n");
+    RUN(invalid_args);
+
+    printf("\n===================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
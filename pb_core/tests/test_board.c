@@ -497,6 +497,255 @@ TEST(board_checksum_different)
     ASSERT_NE(pb_board_checksum(&board1), pb_board_checksum(&board2));
 }
 
+/*============================================================================
+ * Neighbor Count Tests
+ *============================================================================*/
+
+/* Compare a tracked board's table lookups against plain neighbor scans */
+static bool neighbor_counts_consistent(const pb_board* tracked)
+{
+    pb_board scanned = *tracked;
+    pb_board_track_neighbors(&scanned, false);
+
+    for (int r = 0; r < tracked->rows; r++) {
+        int cols = pb_row_cols(r, tracked->cols_even, tracked->cols_odd);
+        for (int c = 0; c < cols; c++) {
+            pb_offset pos = {r, c};
+            if (pb_board_neighbor_total(tracked, pos) !=
+                pb_board_neighbor_total(&scanned, pos) ||
+                pb_board_neighbor_wildcard_count(tracked, pos) !=
+                pb_board_neighbor_wildcard_count(&scanned, pos)) {
+                return false;
+            }
+            for (uint8_t color = 0; color < PB_MAX_COLORS; color++) {
+                if (pb_board_neighbor_color_count(tracked, pos, color) !=
+                    pb_board_neighbor_color_count(&scanned, pos, color)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+TEST(neighbor_counts_basic)
+{
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_track_neighbors(&board, true);
+
+    pb_bubble red = {.kind = PB_KIND_COLORED, .color_id = 0};
+    pb_bubble wild = {.kind = PB_KIND_WILDCARD};
+    pb_board_set(&board, (pb_offset){0, 2}, red);
+    pb_board_set(&board, (pb_offset){0, 3}, red);
+    pb_board_set(&board, (pb_offset){1, 3}, wild);
+
+    /* (1, 2) on an odd row touches (0, 2), (0, 3) and (1, 3) */
+    pb_offset target = {1, 2};
+    ASSERT_EQ(pb_board_neighbor_color_count(&board, target, 0), 2);
+    ASSERT_EQ(pb_board_neighbor_color_count(&board, target, 1), 0);
+    ASSERT_EQ(pb_board_neighbor_wildcard_count(&board, target), 1);
+    ASSERT_EQ(pb_board_neighbor_total(&board, target), 3);
+
+    pb_board_remove(&board, (pb_offset){0, 3});
+    ASSERT_EQ(pb_board_neighbor_color_count(&board, target, 0), 1);
+    ASSERT_EQ(pb_board_neighbor_total(&board, target), 2);
+}
+
+TEST(neighbor_counts_random_edits)
+{
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_track_neighbors(&board, true);
+
+    pb_rng rng;
+    pb_rng_seed(&rng, 79);
+    for (int i = 0; i < 2000; i++) {
+        int r = pb_rng_range_int(&rng, 0, board.rows - 1);
+        int cols = pb_row_cols(r, board.cols_even, board.cols_odd);
+        pb_offset pos = {r, pb_rng_range_int(&rng, 0, cols - 1)};
+
+        int op = pb_rng_range_int(&rng, 0, 9);
+        if (op < 4) {
+            pb_board_remove(&board, pos);
+        } else {
+            pb_bubble b = {.kind = PB_KIND_COLORED,
+                           .color_id = (uint8_t)pb_rng_range_int(&rng, 0, PB_MAX_COLORS - 1)};
+            if (op == 8) b.kind = PB_KIND_WILDCARD;
+            if (op == 9) b.kind = PB_KIND_BLOCKER;
+            pb_board_set(&board, pos, b);
+        }
+    }
+    ASSERT_TRUE(neighbor_counts_consistent(&board));
+
+    pb_visit_result orphans;
+    pb_find_orphans(&board, &orphans);
+    pb_board_remove_cells(&board, &orphans);
+    ASSERT_TRUE(neighbor_counts_consistent(&board));
+
+    pb_board_insert_row(&board, &rng, 0x0F);
+    ASSERT_TRUE(neighbor_counts_consistent(&board));
+
+    pb_board_clear(&board);
+    ASSERT_EQ(pb_board_neighbor_total(&board, (pb_offset){3, 3}), 0);
+    ASSERT_TRUE(neighbor_counts_consistent(&board));
+}
+
+/*============================================================================
+ * Connected Component Tests
+ *============================================================================*/
+
+TEST(components_empty)
+{
+    pb_board board;
+    pb_board_init(&board);
+
+    pb_components cc;
+    ASSERT_EQ(pb_board_label_components(&board, &cc), 0);
+    ASSERT_EQ(cc.support_count, 0);
+    ASSERT_EQ(cc.largest_cluster, 0);
+    ASSERT_EQ(cc.color_label[0][0], PB_LABEL_NONE);
+    ASSERT_EQ(cc.support_label[0][0], PB_LABEL_NONE);
+}
+
+TEST(components_clusters)
+{
+    pb_board board;
+    pb_board_init(&board);
+
+    pb_bubble red = {.kind = PB_KIND_COLORED, .color_id = 0};
+    pb_bubble blue = {.kind = PB_KIND_COLORED, .color_id = 1};
+    pb_board_set(&board, (pb_offset){0, 0}, red);
+    pb_board_set(&board, (pb_offset){0, 1}, red);
+    pb_board_set(&board, (pb_offset){0, 2}, blue);
+    pb_board_set(&board, (pb_offset){0, 3}, red);
+    pb_board_set(&board, (pb_offset){1, 2}, red);   /* Touches (0,2) and (0,3) */
+    pb_board_set(&board, (pb_offset){4, 4}, blue);  /* Floating */
+
+    pb_components cc;
+    ASSERT_EQ(pb_board_label_components(&board, &cc), 4);
+    ASSERT_EQ(cc.support_count, 2);
+    ASSERT_EQ(cc.largest_cluster, 2);
+
+    /* Labels follow row-major order of each cluster's first cell */
+    ASSERT_EQ(cc.color_label[0][0], 0);
+    ASSERT_EQ(cc.color_label[0][1], 0);
+    ASSERT_EQ(cc.color_label[0][2], 1);
+    ASSERT_EQ(cc.color_label[0][3], 2);
+    ASSERT_EQ(cc.color_label[1][2], 2);
+    ASSERT_EQ(cc.color_label[4][4], 3);
+
+    ASSERT_EQ(cc.colors[2].size, 2);
+    ASSERT_EQ(cc.colors[2].color_id, 0);
+    ASSERT_EQ(cc.colors[2].top_row, 0);
+    ASSERT_EQ(cc.colors[2].bottom_row, 1);
+    ASSERT_TRUE(cc.colors[2].attached);
+    ASSERT_FALSE(cc.colors[3].attached);
+    ASSERT_EQ(cc.colors[3].support, 1);
+
+    ASSERT_EQ(cc.supports[0].size, 5);
+    ASSERT_TRUE(cc.supports[0].attached);
+    ASSERT_EQ(cc.attached_cells, 5);
+    ASSERT_EQ(cc.orphan_cells, 1);
+
+    /* A lone bubble mid-board touches six empty cells */
+    ASSERT_EQ(cc.colors[3].liberties, 6);
+}
+
+static bool same_colored_visitor(const pb_board* board, pb_offset pos,
+                                 pb_offset origin, void* userdata)
+{
+    (void)userdata;
+    const pb_bubble* b = pb_board_get_const(board, pos);
+    const pb_bubble* o = pb_board_get_const(board, origin);
+    return b->kind == PB_KIND_COLORED && b->color_id == o->color_id;
+}
+
+TEST(components_match_bfs)
+{
+    pb_rng rng;
+    pb_rng_seed(&rng, 81);
+
+    for (int trial = 0; trial < 50; trial++) {
+        pb_board board;
+        pb_board_init(&board);
+        for (int r = 0; r < 9; r++) {
+            int cols = pb_row_cols(r, board.cols_even, board.cols_odd);
+            for (int c = 0; c < cols; c++) {
+                int roll = pb_rng_range_int(&rng, 0, 19);
+                if (roll < 6) continue;
+                pb_bubble b = {.kind = PB_KIND_COLORED,
+                               .color_id = (uint8_t)pb_rng_range_int(&rng, 0, 3)};
+                if (roll == 6) b.kind = PB_KIND_WILDCARD;
+                if (roll == 7) b.kind = PB_KIND_BLOCKER;
+                if (roll == 8) b.flags = PB_FLAG_GHOST;
+                if (roll == 9) b.flags = PB_FLAG_FROZEN;
+                pb_board_set(&board, (pb_offset){r, c}, b);
+            }
+        }
+
+        pb_components cc;
+        pb_board_label_components(&board, &cc);
+
+        for (int r = 0; r < board.rows; r++) {
+            int cols = pb_row_cols(r, board.cols_even, board.cols_odd);
+            for (int c = 0; c < cols; c++) {
+                pb_offset pos = {r, c};
+                if (board.cells[r][c].kind != PB_KIND_COLORED) {
+                    ASSERT_EQ(cc.color_label[r][c], PB_LABEL_NONE);
+                    continue;
+                }
+                pb_visit_result group;
+                int n = pb_visit_connected(&board, pos, same_colored_visitor, NULL, &group);
+                ASSERT_EQ(cc.colors[cc.color_label[r][c]].size, n);
+                for (int i = 0; i < n; i++) {
+                    ASSERT_EQ(cc.color_label[group.cells[i].row][group.cells[i].col],
+                              cc.color_label[r][c]);
+                }
+            }
+        }
+
+        for (int i = 0; i < cc.color_count; i++) {
+            const pb_component* comp = &cc.colors[i];
+            if (comp->support == PB_LABEL_NONE) {
+                ASSERT_FALSE(comp->attached);
+            } else {
+                ASSERT_EQ(comp->attached, cc.supports[comp->support].attached);
+            }
+        }
+        ASSERT_EQ(pb_board_largest_cluster(&board), cc.largest_cluster);
+
+        pb_visit_result anchored, orphans;
+        ASSERT_EQ(cc.attached_cells, pb_find_anchored(&board, &anchored));
+        ASSERT_EQ(cc.orphan_cells, pb_find_orphans(&board, &orphans));
+    }
+}
+
+TEST(components_ghost_clusters)
+{
+    pb_board board;
+    pb_board_init(&board);
+    pb_bubble red = {.kind = PB_KIND_COLORED, .color_id = 0};
+    pb_bubble ghost = red;
+    ghost.flags = PB_FLAG_GHOST;
+
+    /* An all-ghost cluster has no support component */
+    pb_board_set(&board, (pb_offset){0, 0}, ghost);
+    pb_board_set(&board, (pb_offset){0, 1}, ghost);
+
+    /* A cluster led by a ghost takes its support from the next cell */
+    pb_board_set(&board, (pb_offset){0, 4}, ghost);
+    pb_board_set(&board, (pb_offset){0, 5}, red);
+
+    pb_components cc;
+    ASSERT_EQ(pb_board_label_components(&board, &cc), 2);
+    ASSERT_EQ(cc.colors[0].support, PB_LABEL_NONE);
+    ASSERT_FALSE(cc.colors[0].attached);
+    ASSERT_EQ(cc.colors[1].support, cc.support_label[0][5]);
+    ASSERT_TRUE(cc.colors[1].attached);
+    ASSERT_EQ(pb_board_largest_cluster(&board), 2);
+}
+
 /*============================================================================
  * Main
  *============================================================================*/
@@ -546,6 +795,16 @@ int main(void)
     RUN_TEST(board_checksum_deterministic);
     RUN_TEST(board_checksum_different);
 
+    printf("\nNeighbor counts:\n");
+    RUN_TEST(neighbor_counts_basic);
+    RUN_TEST(neighbor_counts_random_edits);
+
+    printf("\nConnected components:\n");
+    RUN_TEST(components_empty);
+    RUN_TEST(components_clusters);
+    RUN_TEST(components_match_bfs);
+    RUN_TEST(components_ghost_clusters);
+
     printf("\n========================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
 
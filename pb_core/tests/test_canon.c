@@ -0,0 +1,363 @@
+/*
+ * test_canon.c - Tests for pb_canon module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+static pb_bubble special(pb_special_type type, uint8_t color)
+{
+    pb_bubble b = {PB_KIND_SPECIAL, color, 0, type, {0}};
+    return b;
+}
+
+/* Sample colors, valid on every size tier (micro has four) */
+#define COLOR_A     (PB_MAX_COLORS - 1)
+#define COLOR_B     2
+#define COLOR_C     1
+#define COLOR_QUEUE 0       /* Only ever in the queue */
+
+/* A small asymmetric board with three colors */
+static void build_sample(pb_board* board)
+{
+    pb_board_init(board);
+    pb_board_set(board, (pb_offset){0, 0}, colored(COLOR_A));
+    pb_board_set(board, (pb_offset){0, 1}, colored(COLOR_A));
+    pb_board_set(board, (pb_offset){0, 2}, colored(COLOR_B));
+    pb_board_set(board, (pb_offset){1, 1}, colored(COLOR_C));
+    pb_board_set(board, (pb_offset){2, 1}, colored(COLOR_B));
+}
+
+/* perm[c] = (c + shift) mod PB_MAX_COLORS, reversed first if asked */
+static void make_perm(uint8_t perm[PB_MAX_COLORS], int shift, bool reverse)
+{
+    for (int c = 0; c < PB_MAX_COLORS; c++) {
+        int from = reverse ? PB_MAX_COLORS - 1 - c : c;
+        perm[c] = (uint8_t)((from + shift) % PB_MAX_COLORS);
+    }
+}
+
+static void mirror_board(const pb_board* src, pb_board* dst)
+{
+    pb_board_init_custom(dst, src->rows, src->cols_even, src->cols_odd);
+    for (int row = 0; row < src->rows; row++) {
+        int cols = pb_row_cols(row, src->cols_even, src->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            pb_offset cell = {row, col};
+            pb_offset m = pb_canon_mirror_cell(src, cell);
+            dst->cells[m.row][m.col] = src->cells[row][col];
+        }
+    }
+}
+
+static void permute_colors(pb_board* board, const uint8_t* perm)
+{
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            pb_bubble* b = &board->cells[row][col];
+            if (b->kind == PB_KIND_COLORED) {
+                b->color_id = perm[b->color_id];
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * Geometry Tests
+ *============================================================================*/
+
+TEST(can_mirror_geometry) {
+    pb_board board;
+    pb_board_init(&board);
+    ASSERT_TRUE(pb_canon_can_mirror(&board));
+
+    /* Equal row widths are not symmetric with shifted odd rows */
+    pb_board_init_custom(&board, PB_DEFAULT_ROWS, 8, 8);
+    ASSERT_FALSE(pb_canon_can_mirror(&board));
+
+    pb_board_init_custom(&board, PB_DEFAULT_ROWS, 7, 8);
+    ASSERT_FALSE(pb_canon_can_mirror(&board));
+}
+
+TEST(mirror_preserves_adjacency) {
+    pb_board board;
+    pb_board_init(&board);
+
+    for (int row = 0; row < board.rows; row++) {
+        int cols = pb_row_cols(row, board.cols_even, board.cols_odd);
+        for (int col = 0; col < cols; col++) {
+            pb_offset cell = {row, col};
+            pb_offset m = pb_canon_mirror_cell(&board, cell);
+            ASSERT_TRUE(pb_board_in_bounds(&board, m));
+
+            pb_offset back = pb_canon_mirror_cell(&board, m);
+            ASSERT_EQ(back.row, row);
+            ASSERT_EQ(back.col, col);
+
+            /* Every neighbour of a cell mirrors to a neighbour of its mirror */
+            pb_offset nbrs[6], mirror_nbrs[6];
+            pb_hex_neighbors_offset(cell, nbrs);
+            pb_hex_neighbors_offset(m, mirror_nbrs);
+            for (int i = 0; i < 6; i++) {
+                if (!pb_board_in_bounds(&board, nbrs[i])) continue;
+                pb_offset mn = pb_canon_mirror_cell(&board, nbrs[i]);
+                bool found = false;
+                for (int j = 0; j < 6; j++) {
+                    if (mirror_nbrs[j].row == mn.row && mirror_nbrs[j].col == mn.col) {
+                        found = true;
+                    }
+                }
+                ASSERT_TRUE(found);
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * Canonical Form Tests
+ *============================================================================*/
+
+TEST(compute_invalid_args) {
+    pb_board board;
+    pb_canon_form form;
+    pb_board_init(&board);
+
+    ASSERT_EQ(pb_canon_compute(NULL, NULL, 0, &form), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_canon_compute(&board, NULL, 0, NULL), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_canon_compute(&board, NULL, 1, &form), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_canon_hash(&board, NULL, PB_MAX_QUEUE + 1), 0u);
+}
+
+TEST(relabels_by_first_appearance) {
+    pb_board board;
+    build_sample(&board);
+
+    pb_bubble queue[2] = {colored(COLOR_C), colored(COLOR_QUEUE)};
+    pb_canon_form form;
+    ASSERT_EQ(pb_canon_compute(&board, queue, 2, &form), PB_OK);
+
+    ASSERT_EQ(form.color_map[COLOR_A], form.mirrored ? 1 : 0);
+    ASSERT_EQ(form.color_map[COLOR_QUEUE], 3);
+    for (int c = 0; c < PB_MAX_COLORS; c++) {
+        if (c != COLOR_A && c != COLOR_B && c != COLOR_C && c != COLOR_QUEUE) {
+            ASSERT_EQ(form.color_map[c], PB_CANON_NO_COLOR);
+        }
+    }
+    for (int c = 0; c < 4; c++) {
+        ASSERT_EQ(form.color_map[form.color_unmap[c]], c);
+    }
+    ASSERT_EQ(form.queue[1].color_id, 3);
+}
+
+TEST(color_permutation_invariant) {
+    pb_board a, b;
+    build_sample(&a);
+    build_sample(&b);
+
+    uint8_t perm[PB_MAX_COLORS];
+    make_perm(perm, 3, true);
+    permute_colors(&b, perm);
+
+    pb_bubble qa[1] = {colored(COLOR_B)};
+    pb_bubble qb[1] = {colored(perm[COLOR_B])};
+    ASSERT_EQ(pb_canon_hash(&a, qa, 1), pb_canon_hash(&b, qb, 1));
+
+    /* A queue that is not the same permutation is a different position */
+    pb_bubble qc[1] = {colored(perm[COLOR_A])};
+    ASSERT_NE(pb_canon_hash(&a, qa, 1), pb_canon_hash(&b, qc, 1));
+}
+
+TEST(mirror_invariant) {
+    pb_board a, b;
+    build_sample(&a);
+    mirror_board(&a, &b);
+
+    pb_canon_form fa, fb;
+    ASSERT_EQ(pb_canon_compute(&a, NULL, 0, &fa), PB_OK);
+    ASSERT_EQ(pb_canon_compute(&b, NULL, 0, &fb), PB_OK);
+    ASSERT_EQ(fa.hash, fb.hash);
+    ASSERT_NE(fa.mirrored, fb.mirrored);
+    ASSERT_EQ(memcmp(fa.board.cells, fb.board.cells, sizeof(fa.board.cells)), 0);
+
+    /* map_cell carries original cells onto the canonical board */
+    pb_offset cell = {1, 1};
+    pb_offset mapped = pb_canon_map_cell(&fb, pb_canon_mirror_cell(&b, cell));
+    pb_offset direct = pb_canon_map_cell(&fa, cell);
+    ASSERT_EQ(mapped.row, direct.row);
+    ASSERT_EQ(mapped.col, direct.col);
+}
+
+TEST(distinct_boards_differ) {
+    pb_board a, b;
+    build_sample(&a);
+    build_sample(&b);
+    pb_board_set(&b, (pb_offset){0, 3}, colored(COLOR_A));
+    ASSERT_NE(pb_canon_hash(&a, NULL, 0), pb_canon_hash(&b, NULL, 0));
+
+    /* Same cells, different ceiling */
+    build_sample(&b);
+    b.ceiling_row = 1;
+    ASSERT_NE(pb_canon_hash(&a, NULL, 0), pb_canon_hash(&b, NULL, 0));
+}
+
+TEST(equal_width_rows_not_mirrored) {
+    pb_board a, b;
+    pb_board_init_custom(&a, PB_DEFAULT_ROWS, 8, 8);
+    pb_board_init_custom(&b, PB_DEFAULT_ROWS, 8, 8);
+    pb_board_set(&a, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&b, (pb_offset){0, 7}, colored(0));
+
+    pb_canon_form form;
+    ASSERT_EQ(pb_canon_compute(&b, NULL, 0, &form), PB_OK);
+    ASSERT_FALSE(form.mirrored);
+    ASSERT_NE(pb_canon_hash(&a, NULL, 0), pb_canon_hash(&b, NULL, 0));
+}
+
+TEST(specials_restrict_symmetry) {
+    pb_board a, b;
+    build_sample(&a);
+    mirror_board(&a, &b);
+
+    /* Portals address absolute cells: no mirroring */
+    pb_board_set(&a, (pb_offset){5, 3}, special(PB_SPECIAL_PORTAL, 0));
+    pb_board_set(&b, (pb_offset){5, 3}, special(PB_SPECIAL_PORTAL, 0));
+    ASSERT_NE(pb_canon_hash(&a, NULL, 0), pb_canon_hash(&b, NULL, 0));
+
+    /* Shifters cycle colors: no relabeling */
+    build_sample(&a);
+    build_sample(&b);
+    uint8_t perm[PB_MAX_COLORS];
+    make_perm(perm, 1, false);
+    permute_colors(&b, perm);
+    ASSERT_EQ(pb_canon_hash(&a, NULL, 0), pb_canon_hash(&b, NULL, 0));
+    pb_board_set(&a, (pb_offset){5, 3}, special(PB_SPECIAL_SHIFTER, 0));
+    pb_board_set(&b, (pb_offset){5, 3}, special(PB_SPECIAL_SHIFTER, 0));
+    ASSERT_NE(pb_canon_hash(&a, NULL, 0), pb_canon_hash(&b, NULL, 0));
+
+    pb_canon_form form;
+    ASSERT_EQ(pb_canon_compute(&b, NULL, 0, &form), PB_OK);
+    ASSERT_EQ(form.color_map[perm[COLOR_A]], perm[COLOR_A]);
+}
+
+/*============================================================================
+ * Index Tests
+ *============================================================================*/
+
+TEST(index_detects_duplicates) {
+    pb_canon_index index;
+    ASSERT_EQ(pb_canon_index_init(&index, 4), PB_OK);
+
+    pb_board a, b;
+    build_sample(&a);
+    mirror_board(&a, &b);
+    uint8_t perm[PB_MAX_COLORS];
+    make_perm(perm, 0, true);
+    permute_colors(&b, perm);
+
+    int existing = 0;
+    ASSERT_EQ(pb_canon_index_insert(&index, pb_canon_hash(&a, NULL, 0), 10, &existing), PB_OK);
+    ASSERT_EQ(existing, -1);
+    ASSERT_EQ(pb_canon_index_insert(&index, pb_canon_hash(&b, NULL, 0), 11, &existing), PB_OK);
+    ASSERT_EQ(existing, 10);
+    ASSERT_EQ(index.count, 1);
+    ASSERT_EQ(pb_canon_index_find(&index, pb_canon_hash(&b, NULL, 0)), 10);
+
+    pb_canon_index_free(&index);
+}
+
+TEST(index_grows) {
+    pb_canon_index index;
+    ASSERT_EQ(pb_canon_index_init(&index, 0), PB_OK);
+
+    for (int i = 0; i < 1000; i++) {
+        int existing = 0;
+        ASSERT_EQ(pb_canon_index_insert(&index, (uint64_t)i * 0x9E3779B97F4A7C15ULL, i,
+                                        &existing), PB_OK);
+        ASSERT_EQ(existing, -1);
+    }
+    ASSERT_EQ(index.count, 1000);
+    ASSERT_TRUE(index.capacity >= 2000);
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(pb_canon_index_find(&index, (uint64_t)i * 0x9E3779B97F4A7C15ULL), i);
+    }
+    ASSERT_EQ(pb_canon_index_find(&index, 12345), -1);
+    ASSERT_EQ(pb_canon_index_insert(&index, 1, -1, NULL), PB_ERR_INVALID_ARG);
+
+    pb_canon_index_free(&index);
+    ASSERT_EQ(pb_canon_index_find(&index, 0), -1);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_canon test suite\n");
+    printf("===================\n\n");
+
+    printf("Geometry:\n");
+    RUN(can_mirror_geometry);
+    RUN(mirror_preserves_adjacency);
+
+    printf("\nCanonical form:\n");
+    RUN(compute_invalid_args);
+    RUN(relabels_by_first_appearance);
+    RUN(color_permutation_invariant);
+    RUN(mirror_invariant);
+    RUN(distinct_boards_differ);
+    RUN(equal_width_rows_not_mirrored);
+    RUN(specials_restrict_symmetry);
+
+    printf("\nIndex:\n");
+    RUN(index_detects_duplicates);
+    RUN(index_grows);
+
+    printf("\n===================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+/*
+ * test_cga.c - Tests for pb_cga module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+
+#define ROW 32
+
+#define RED(c)   ((int)((c) >> 24))
+#define GREEN(c) ((int)(((c) >> 16) & 0xFF))
+#define BLUE(c)  ((int)(((c) >> 8) & 0xFF))
+
+/* Decode one row repeating a 4-pixel pattern */
+static void present_pattern(const pb_cga_composite* cga, const uint8_t pattern[4],
+                            uint32_t out[ROW])
+{
+    uint8_t row[ROW];
+    for (int x = 0; x < ROW; x++) row[x] = pattern[x & 3];
+    pb_cga_composite_present(cga, row, ROW, 1, out);
+}
+
+static uint32_t solid(const pb_cga_composite* cga, uint8_t index, int x)
+{
+    const uint8_t pattern[4] = {index, index, index, index};
+    uint32_t out[ROW];
+    present_pattern(cga, pattern, out);
+    return out[x];
+}
+
+/*============================================================================
+ * Decoding Tests
+ *============================================================================*/
+
+TEST(solid_colors) {
+    pb_cga_composite* cga = pb_cga_composite_create(NULL);
+    ASSERT(cga != NULL);
+
+    ASSERT_EQ(solid(cga, 0, 8), 0x000000FFu);
+    ASSERT_EQ(solid(cga, 15, 8), 0xFFFFFFFFu);
+
+    /* Grays carry no chroma; dark gray is darker than light gray */
+    uint32_t light = solid(cga, 7, 8), dark = solid(cga, 8, 8);
+    ASSERT_EQ(RED(light), GREEN(light));
+    ASSERT_EQ(GREEN(light), BLUE(light));
+    ASSERT_EQ(RED(dark), BLUE(dark));
+    ASSERT(RED(dark) < RED(light));
+
+    /* Primaries decode to their own hue */
+    uint32_t blue = solid(cga, 1, 8), green = solid(cga, 2, 8), red = solid(cga, 4, 8);
+    ASSERT(BLUE(blue) > RED(blue) && BLUE(blue) > GREEN(blue));
+    ASSERT(GREEN(green) > RED(green) && GREEN(green) > BLUE(green));
+    ASSERT(RED(red) > GREEN(red) && RED(red) > BLUE(red));
+
+    /* A flat field decodes the same at every phase */
+    for (int color = 0; color < PB_CGA_COLORS; color++) {
+        for (int x = 4; x < 8; x++) {
+            ASSERT_EQ(solid(cga, (uint8_t)color, x), solid(cga, (uint8_t)color, 12));
+        }
+    }
+    pb_cga_composite_destroy(cga);
+}
+
+TEST(artifact_patterns) {
+    pb_cga_composite* cga = pb_cga_composite_create(NULL);
+    uint32_t out[ROW];
+
+    /* White/black pairs are at the subcarrier: strong artifact colors,
+     * a different one for each alignment */
+    static const uint8_t pairs[4][4] = {
+        {15, 15, 0, 0}, {0, 15, 15, 0}, {0, 0, 15, 15}, {15, 0, 0, 15},
+    };
+    uint32_t colors[4];
+    for (int k = 0; k < 4; k++) {
+        present_pattern(cga, pairs[k], out);
+        colors[k] = out[12];
+        for (int x = 8; x < 16; x++) ASSERT_EQ(out[x], colors[k]);
+
+        int hi = RED(colors[k]), lo = RED(colors[k]);
+        int ch[3] = {RED(colors[k]), GREEN(colors[k]), BLUE(colors[k])};
+        for (int c = 1; c < 3; c++) {
+            if (ch[c] > hi) hi = ch[c];
+            if (ch[c] < lo) lo = ch[c];
+        }
+        ASSERT(hi - lo > 128);
+    }
+    for (int a = 0; a < 4; a++) {
+        for (int b = a + 1; b < 4; b++) ASSERT_NE(colors[a], colors[b]);
+    }
+
+    /* Alternate pixels are at twice the subcarrier: no chroma */
+    static const uint8_t alternate[4] = {15, 0, 15, 0};
+    present_pattern(cga, alternate, out);
+    ASSERT_EQ(RED(out[12]), GREEN(out[12]));
+    ASSERT_EQ(GREEN(out[12]), BLUE(out[12]));
+    pb_cga_composite_destroy(cga);
+}
+
+TEST(row_edges) {
+    pb_cga_composite* cga = pb_cga_composite_create(NULL);
+    uint8_t pixels[2 * ROW];
+    uint32_t out[2 * ROW];
+    memset(pixels, 15, ROW);
+    memset(pixels + ROW, 0, ROW);
+
+    /* Rows decode independently: nothing bleeds into the black row */
+    pb_cga_composite_present(cga, pixels, ROW, 2, out);
+    for (int x = 0; x < ROW; x++) ASSERT_EQ(out[ROW + x], 0x000000FFu);
+    ASSERT_EQ(out[ROW / 2], 0xFFFFFFFFu);
+    ASSERT_NE(out[0], 0xFFFFFFFFu);             /* Black beyond the ends */
+    ASSERT_NE(out[ROW - 1], 0xFFFFFFFFu);
+
+    /* Rows narrower than the window */
+    for (int width = 1; width <= 3; width++) {
+        out[width] = 0;
+        pb_cga_composite_present(cga, pixels, width, 1, out);
+        ASSERT_NE(out[0], 0x000000FFu);
+        ASSERT_EQ(out[width], 0u);
+    }
+    pb_cga_composite_destroy(cga);
+}
+
+/*============================================================================
+ * Configuration Tests
+ *============================================================================*/
+
+TEST(config_controls) {
+    pb_cga_config config;
+    pb_cga_config_default(&config);
+    config.saturation = 0.0f;
+    pb_cga_composite* cga = pb_cga_composite_create(&config);
+
+    /* Monochrome: every color is a gray */
+    for (int color = 0; color < PB_CGA_COLORS; color++) {
+        uint32_t c = solid(cga, (uint8_t)color, 8);
+        ASSERT_EQ(RED(c), GREEN(c));
+        ASSERT_EQ(GREEN(c), BLUE(c));
+    }
+
+    /* Column 0's phase: shifting it matches shifting the picture */
+    static const uint8_t pattern[4] = {9, 0, 14, 14};
+    uint8_t row[ROW], shifted[ROW];
+    uint32_t out[ROW], out_shifted[ROW];
+    for (int x = 0; x < ROW; x++) {
+        row[x] = pattern[x & 3];
+        shifted[x] = pattern[(x + 3) & 3];
+    }
+    pb_cga_config_default(&config);
+    config.phase = 1;
+    pb_cga_composite_configure(cga, &config);
+    pb_cga_composite_present(cga, row, ROW, 1, out);
+    config.phase = 0;
+    pb_cga_composite_configure(cga, &config);
+    pb_cga_composite_present(cga, shifted, ROW, 1, out_shifted);
+    for (int x = 4; x < ROW - 4; x++) ASSERT_EQ(out[x], out_shifted[x + 1]);
+
+    /* New cards put R, G and B into luma: same ends, different middle */
+    uint32_t old_blue = solid(cga, 1, 8);
+    config.variant = PB_CGA_NEW;
+    pb_cga_composite_configure(cga, &config);
+    ASSERT_EQ(solid(cga, 0, 8), 0x000000FFu);
+    ASSERT_EQ(solid(cga, 15, 8), 0xFFFFFFFFu);
+    ASSERT_NE(solid(cga, 1, 8), old_blue);
+    pb_cga_composite_destroy(cga);
+}
+
+TEST(palette_mapping) {
+    pb_cga_composite* cga = pb_cga_composite_create(NULL);
+    pb_palette pal;
+    pb_palette_init_cga(&pal);
+    ASSERT_EQ(pal.colors[4 + 16].r, 0xAA);
+    ASSERT_EQ(pal.colors[4 + 16].g, 0x00);
+    ASSERT_EQ(strcmp(pal.name, "CGA"), 0);
+
+    /* The CGA palette maps onto itself */
+    uint32_t red = solid(cga, 4, 8), light_red = solid(cga, 12, 8);
+    pb_cga_composite_map_palette(cga, &pal);
+    ASSERT_EQ(solid(cga, 4 + 32, 8), red);
+
+    /* Any other palette maps to the nearest RGBI color */
+    pal.colors[100] = (pb_palette_entry){250, 90, 90, 0};
+    pal.colors[101] = (pb_palette_entry){160, 10, 5, 0};
+    pb_cga_composite_map_palette(cga, &pal);
+    ASSERT_EQ(solid(cga, 100, 8), light_red);
+    ASSERT_EQ(solid(cga, 101, 8), red);
+
+    pb_cga_composite_set_index(cga, 100, 4);
+    ASSERT_EQ(solid(cga, 100, 8), red);
+    pb_cga_composite_destroy(cga);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_cga test suite\n");
+    printf("=================\n\n");
+
+    printf("Decoding:\n");
+    RUN(solid_colors);
+    RUN(artifact_patterns);
+    RUN(row_edges);
+
+    printf("\nConfiguration:\n");
+    RUN(config_controls);
+    RUN(palette_mapping);
+
+    printf("\n=================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
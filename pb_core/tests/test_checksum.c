@@ -86,6 +86,73 @@ static void test_crc32_deterministic(void) {
     PASS();
 }
 
+/* Bitwise reference, independent of the generated tables */
+static uint32_t crc32_bitwise(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static void test_crc32_lengths_and_offsets(void) {
+    TEST(crc32_lengths_and_offsets);
+
+    /* Every length around the 8-byte stride, from unaligned starts */
+    uint8_t data[80];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (size_t off = 0; off < 8; off++) {
+        for (size_t len = 0; len + off <= sizeof(data); len++) {
+            uint32_t expected = crc32_bitwise(data + off, len);
+            ASSERT(pb_crc32(data + off, len) == expected, "matches bitwise CRC");
+        }
+    }
+
+    /* Splits that leave partial blocks on both sides */
+    uint32_t crc = pb_crc32_update(0, data, 3);
+    crc = pb_crc32_update(crc, data + 3, 21);
+    crc = pb_crc32_update(crc, data + 24, 56);
+    ASSERT(crc == crc32_bitwise(data, 80), "split update matches");
+
+    PASS();
+}
+
+static void test_generated_tables(void) {
+    TEST(generated_tables);
+
+    /* Direction vectors: 12 degrees, vertical, mirror symmetry */
+    ASSERT(pb_dir_cos_q16[0] == 64104 && pb_dir_sin_q16[0] == 13626, "12 degrees");
+    ASSERT(pb_dir_cos_q16[PB_DIR_VERTICAL] == 0, "vertical cos");
+    ASSERT(pb_dir_sin_q16[PB_DIR_VERTICAL] == 65536, "vertical sin");
+    for (int d = 0; d < PB_DIR_COUNT; d++) {
+        int m = PB_DIR_REFLECT(d);
+        ASSERT(pb_dir_cos_q16[d] == -pb_dir_cos_q16[m], "cos mirrors");
+        ASSERT(pb_dir_sin_q16[d] == pb_dir_sin_q16[m], "sin mirrors");
+    }
+
+    /* sRGB: endpoints, linear segment, and agreement with the float path */
+    ASSERT(pb_srgb8_linear[0] == 0.0f && pb_srgb8_linear[255] == 1.0f, "srgb endpoints");
+    ASSERT(pb_srgb8_linear[10] > 0.003034f && pb_srgb8_linear[10] < 0.003036f, "srgb 10");
+    pb_rgb8 c8 = {128, 64, 200};
+    pb_linear_rgb lin = pb_rgb8_to_linear(c8);
+    ASSERT(lin.r > 0.2158f && lin.r < 0.2159f, "srgb 128");
+    ASSERT(lin.g == pb_srgb8_linear[64], "rgb8_to_linear uses table");
+
+    /* Reciprocal seeds lie within 2^-8 of 1/m */
+    for (int i = 0; i < 256; i++) {
+        uint32_t lo = 65536u * 256u / (uint32_t)(257 + i);
+        uint32_t hi = 65536u * 256u / (uint32_t)(256 + i);
+        ASSERT(pb_recip_seed_q16[i] >= lo && pb_recip_seed_q16[i] <= hi, "seed bracket");
+    }
+
+    PASS();
+}
+
 /* ============================================================================
  * Bubble/Board Checksum Tests
  * ============================================================================ */
@@ -407,6 +474,8 @@ int main(void) {
     test_crc32_known_values();
     test_crc32_incremental();
     test_crc32_deterministic();
+    test_crc32_lengths_and_offsets();
+    test_generated_tables();
 
     printf("\nBubble/Board checksums:\n");
     test_bubble_checksum();
@@ -0,0 +1,314 @@
+/*
+ * test_cow.c - Tests for pb_cow module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if PB_FEATURE_THREADS
+#include <pthread.h>
+#endif
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+/* Random top-heavy board in rows 0..depth-1 */
+static void random_board(pb_board* board, pb_rng* rng, int depth)
+{
+    pb_board_init(board);
+    for (int row = 0; row < depth; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            int roll = pb_rng_range_int(rng, 0, 15);
+            if (roll < 3) continue;
+            pb_bubble b = colored((uint8_t)pb_rng_range_int(rng, 0, 3));
+            if (roll == 3) b.kind = PB_KIND_WILDCARD;
+            if (roll == 4) b.flags = PB_FLAG_FROZEN;
+            pb_board_set(board, (pb_offset){row, col}, b);
+        }
+    }
+}
+
+/* Compare occupancy and colors (removed cells may keep stale payloads) */
+static bool same_cells(const pb_board* a, const pb_board* b)
+{
+    for (int row = 0; row < a->rows; row++) {
+        int cols = pb_row_cols(row, a->cols_even, a->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* x = &a->cells[row][col];
+            const pb_bubble* y = &b->cells[row][col];
+            if (x->kind != y->kind) return false;
+            if (x->kind != PB_KIND_NONE &&
+                (x->color_id != y->color_id || x->flags != y->flags)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*============================================================================
+ * Lifetime Tests
+ *============================================================================*/
+
+TEST(roundtrip) {
+    pb_rng rng;
+    pb_rng_seed(&rng, 82);
+    pb_board board, back;
+    random_board(&board, &rng, 6);
+
+    pb_cow_board cow;
+    ASSERT_EQ(pb_cow_from_board(&cow, &board), PB_OK);
+    pb_cow_to_board(&cow, &back);
+    ASSERT_TRUE(same_cells(&board, &back));
+    ASSERT_EQ(back.ceiling_row, board.ceiling_row);
+
+    /* Rows below the fill are not allocated */
+    ASSERT_EQ(pb_cow_row_refs(&cow, 0), 1);
+    ASSERT_EQ(pb_cow_row_refs(&cow, 6), 0);
+    ASSERT_EQ(pb_cow_get(&cow, (pb_offset){9, 0})->kind, PB_KIND_NONE);
+    ASSERT_EQ(pb_cow_get(&cow, (pb_offset){0, 99}), NULL);
+
+    pb_cow_release(&cow);
+    ASSERT_EQ(pb_cow_row_refs(&cow, 0), 0);
+}
+
+TEST(share_clones_one_row) {
+    pb_rng rng;
+    pb_rng_seed(&rng, 7);
+    pb_board board, check;
+    random_board(&board, &rng, 5);
+
+    pb_cow_board parent, child;
+    pb_cow_from_board(&parent, &board);
+    pb_cow_share(&child, &parent);
+    ASSERT_EQ(pb_cow_shared_rows(&parent, &child), 5);
+    ASSERT_EQ(pb_cow_row_refs(&parent, 2), 2);
+
+    ASSERT_EQ(pb_cow_set(&child, (pb_offset){2, 3}, colored(7)), PB_OK);
+    ASSERT_EQ(pb_cow_shared_rows(&parent, &child), 4);
+    ASSERT_EQ(pb_cow_row_refs(&parent, 2), 1);
+    ASSERT_EQ(pb_cow_row_refs(&child, 2), 1);
+    ASSERT_EQ(pb_cow_get(&child, (pb_offset){2, 3})->color_id, 7);
+
+    /* Parent is untouched */
+    pb_cow_to_board(&parent, &check);
+    ASSERT_TRUE(same_cells(&board, &check));
+
+    /* Writing into an empty row allocates without touching the parent */
+    ASSERT_EQ(pb_cow_set(&child, (pb_offset){8, 0}, colored(1)), PB_OK);
+    ASSERT_EQ(pb_cow_row_refs(&parent, 8), 0);
+    ASSERT_EQ(pb_cow_set(&child, (pb_offset){40, 0}, colored(1)), PB_ERR_INVALID_ARG);
+
+    pb_cow_release(&parent);
+    ASSERT_EQ(pb_cow_row_refs(&child, 0), 1);
+    pb_cow_release(&child);
+}
+
+/*============================================================================
+ * Move Tests
+ *============================================================================*/
+
+TEST(play_matches_exact_play) {
+    pb_rng rng;
+    pb_rng_seed(&rng, 2024);
+
+    for (int trial = 0; trial < 40; trial++) {
+        pb_board flat, check;
+        random_board(&flat, &rng, 4 + trial % 4);
+
+        pb_cow_board root;
+        ASSERT_EQ(pb_cow_from_board(&root, &flat), PB_OK);
+
+        for (int move = 0; move < 12; move++) {
+            pb_offset cells[PB_MAX_CELLS];
+            int n = pb_exact_attachable_cells(&flat, cells, PB_MAX_CELLS);
+            if (n == 0) break;
+            pb_offset cell = cells[pb_rng_range_int(&rng, 0, n - 1)];
+            uint8_t color = (uint8_t)pb_rng_range_int(&rng, 0, 3);
+
+            pb_cow_board child;
+            pb_cow_share(&child, &root);
+
+            int pops_a, drops_a, pops_b, drops_b;
+            bool survived;
+            bool alive = pb_exact_play(&flat, cell, color, 3, &pops_a, &drops_a);
+            ASSERT_EQ(pb_cow_play(&child, cell, color, 3, &pops_b, &drops_b, &survived),
+                      PB_OK);
+            ASSERT_EQ(pops_a, pops_b);
+            ASSERT_EQ(drops_a, drops_b);
+            ASSERT_EQ(alive, survived);
+
+            pb_cow_to_board(&child, &check);
+            ASSERT_TRUE(same_cells(&flat, &check));
+
+            pb_cow_release(&root);
+            root = child;
+        }
+
+        pb_cow_release(&root);
+    }
+}
+
+TEST(play_shares_untouched_rows) {
+    pb_board board;
+    pb_board_init(&board);
+    for (int row = 0; row < 8; row++) {
+        int cols = pb_row_cols(row, board.cols_even, board.cols_odd);
+        for (int col = 0; col < cols; col++) {
+            pb_board_set(&board, (pb_offset){row, col},
+                         colored((uint8_t)(1 + (row + col) % 3)));
+        }
+    }
+    pb_board_set(&board, (pb_offset){8, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){8, 1}, colored(0));
+
+    pb_cow_board parent, child;
+    pb_cow_from_board(&parent, &board);
+    pb_cow_share(&child, &parent);
+
+    /* Completing the pair at the bottom pops three cells in rows 8-9 */
+    int pops = 0, drops = 0;
+    bool survived = false;
+    ASSERT_EQ(pb_cow_play(&child, (pb_offset){9, 0}, 0, 3, &pops, &drops, &survived),
+              PB_OK);
+    ASSERT_EQ(pops, 3);
+    ASSERT_EQ(drops, 0);
+    ASSERT_TRUE(survived);
+    ASSERT_EQ(pb_cow_shared_rows(&parent, &child), 8);
+    ASSERT_EQ(pb_cow_row_refs(&child, 8), 0);   /* Emptied and released */
+    ASSERT_EQ(pb_cow_row_refs(&child, 9), 0);
+
+    pb_cow_release(&parent);
+    pb_cow_release(&child);
+}
+
+/*============================================================================
+ * Thread Tests
+ *============================================================================*/
+
+#if PB_FEATURE_THREADS
+typedef struct branch_job {
+    const pb_cow_board* root;
+    uint64_t seed;
+    int failures;
+} branch_job;
+
+static void* branch_worker(void* arg)
+{
+    branch_job* job = arg;
+    pb_rng rng;
+    pb_rng_seed(&rng, job->seed);
+
+    for (int i = 0; i < 2000; i++) {
+        pb_cow_board node;
+        pb_cow_share(&node, job->root);
+        int cols = pb_row_cols(6, node.cols_even, node.cols_odd);
+        pb_offset cell = {6, pb_rng_range_int(&rng, 0, cols - 1)};
+        if (pb_cow_get(&node, cell)->kind == PB_KIND_NONE &&
+            pb_cow_play(&node, cell, (uint8_t)pb_rng_range_int(&rng, 0, 3), 3,
+                        NULL, NULL, NULL) != PB_OK) {
+            job->failures++;
+        }
+        pb_cow_release(&node);
+    }
+    return NULL;
+}
+
+TEST(threads_share_rows) {
+    pb_rng rng;
+    pb_rng_seed(&rng, 99);
+    pb_board board, check;
+    random_board(&board, &rng, 6);
+
+    pb_cow_board root;
+    pb_cow_from_board(&root, &board);
+
+    pthread_t threads[4];
+    branch_job jobs[4];
+    for (int t = 0; t < 4; t++) {
+        jobs[t].root = &root;
+        jobs[t].seed = (uint64_t)t + 1;
+        jobs[t].failures = 0;
+        ASSERT_EQ(pthread_create(&threads[t], NULL, branch_worker, &jobs[t]), 0);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+        ASSERT_EQ(jobs[t].failures, 0);
+    }
+
+    pb_cow_to_board(&root, &check);
+    ASSERT_TRUE(same_cells(&board, &check));
+    for (int row = 0; row < 6; row++) {
+        ASSERT_TRUE(pb_cow_row_refs(&root, row) <= 1);
+    }
+    pb_cow_release(&root);
+}
+#endif
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_cow test suite\n");
+    printf("=================\n\n");
+
+    printf("Lifetime:\n");
+    RUN(roundtrip);
+    RUN(share_clones_one_row);
+
+    printf("\nMoves:\n");
+    RUN(play_matches_exact_play);
+    RUN(play_shares_untouched_rows);
+
+#if PB_FEATURE_THREADS
+    printf("\nThreads:\n");
+    RUN(threads_share_rows);
+#endif
+
+    printf("\n=================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
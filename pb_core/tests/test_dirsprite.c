@@ -0,0 +1,241 @@
+/*
+ * test_dirsprite.c - Tests for pb_dirsprite module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+
+/* Large value types, kept off the stack */
+static pb_dirsprite_atlas atlas;
+static pb_dirsprite_atlas lazy_atlas;
+
+/* Upright bar, 3 wide and 16 tall, pivot at the bottom center */
+#define BAR_W 3
+#define BAR_H 16
+static uint8_t bar_pixels[BAR_W * BAR_H];
+
+static pb_dirsprite_source bar_source(void)
+{
+    memset(bar_pixels, 255, sizeof(bar_pixels));
+    return (pb_dirsprite_source){bar_pixels, BAR_W, BAR_H, BAR_W / 2, BAR_H - 1};
+}
+
+/* Coverage relative to a cell's pivot (0 outside the cell) */
+static int cell_at(const pb_dirsprite_atlas* a, const pb_dirsprite_cell* cell,
+                   int dx, int dy)
+{
+    int x = cell->pivot_x + dx, y = cell->pivot_y + dy;
+    if (x < 0 || y < 0 || x >= cell->w || y >= cell->h) return 0;
+    return a->pixels[(cell->y + y) * PB_DIRSPRITE_ATLAS_W + cell->x + x];
+}
+
+/*============================================================================
+ * Rendering Tests
+ *============================================================================*/
+
+TEST(vertical_matches_source) {
+    pb_dirsprite_atlas_init(&atlas, false);
+    pb_dirsprite_source src = bar_source();
+    int id = -1;
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &src, &id), PB_OK);
+    ASSERT_EQ(id, 0);
+    ASSERT_NE(atlas.version, 0u);
+
+    const pb_dirsprite_cell* cell = pb_dirsprite_get(&atlas, id, PB_DIR_VERTICAL);
+    ASSERT(cell != NULL);
+
+    /* Straight up is the source itself: a solid spine, nothing beside it */
+    for (int k = 1; k < BAR_H - 1; k++) {
+        ASSERT(cell_at(&atlas, cell, 0, -k) >= 250);
+        ASSERT_EQ(cell_at(&atlas, cell, 3, -k), 0);
+        ASSERT_EQ(cell_at(&atlas, cell, -3, -k), 0);
+    }
+    ASSERT_EQ(cell_at(&atlas, cell, 0, -BAR_H - 1), 0);
+    ASSERT_EQ(cell_at(&atlas, cell, 0, 2), 0);
+}
+
+TEST(directions_turn_about_pivot) {
+    pb_dirsprite_atlas_init(&atlas, false);
+    pb_dirsprite_source src = bar_source();
+    int id;
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &src, &id), PB_OK);
+
+    /* Direction 0 points 12 degrees above the right-hand wall */
+    const pb_dirsprite_cell* right = pb_dirsprite_get(&atlas, id, PB_DIR_MIN);
+    const pb_dirsprite_cell* left = pb_dirsprite_get(&atlas, id, PB_DIR_MAX);
+    float c = cosf(12.0f * 3.14159265f / 180.0f);
+    float s = sinf(12.0f * 3.14159265f / 180.0f);
+    int tip_x = (int)lroundf(13.0f * c), tip_y = (int)lroundf(-13.0f * s);
+    ASSERT(cell_at(&atlas, right, tip_x, tip_y) > 128);
+    ASSERT(cell_at(&atlas, left, -tip_x, tip_y) > 128);
+    ASSERT_EQ(cell_at(&atlas, right, -tip_x, tip_y), 0);
+    ASSERT_EQ(cell_at(&atlas, left, tip_x, tip_y), 0);
+
+    /* Same cell geometry for every direction */
+    ASSERT_EQ(right->w, left->w);
+    ASSERT_EQ(right->pivot_y, left->pivot_y);
+}
+
+TEST(mirrored_directions) {
+    pb_dirsprite_atlas_init(&atlas, false);
+    pb_dirsprite_source src = bar_source();
+    int id;
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &src, &id), PB_OK);
+
+    /* A symmetric sprite at d and at its wall reflection are mirror images */
+    for (int dir = 0; dir < PB_DIR_COUNT; dir += 7) {
+        const pb_dirsprite_cell* a = pb_dirsprite_get(&atlas, id, dir);
+        const pb_dirsprite_cell* b = pb_dirsprite_get(&atlas, id, PB_DIR_REFLECT(dir));
+        for (int dy = -a->pivot_y; dy < a->h - a->pivot_y; dy++) {
+            for (int dx = -a->pivot_x; dx < a->w - a->pivot_x; dx++) {
+                int diff = cell_at(&atlas, a, dx, dy) - cell_at(&atlas, b, -dx, dy);
+                ASSERT(diff >= -2 && diff <= 2);
+            }
+        }
+    }
+}
+
+TEST(lazy_matches_eager) {
+    pb_dirsprite_atlas_init(&atlas, false);
+    pb_dirsprite_atlas_init(&lazy_atlas, true);
+    pb_dirsprite_source src = bar_source();
+    int id, lazy_id;
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &src, &id), PB_OK);
+    ASSERT_EQ(pb_dirsprite_add(&lazy_atlas, &src, &lazy_id), PB_OK);
+    ASSERT_EQ(lazy_atlas.version, 0u);
+
+    /* First use renders and bumps the version; a second use does not */
+    ASSERT(pb_dirsprite_get(&lazy_atlas, lazy_id, 10) != NULL);
+    ASSERT_EQ(lazy_atlas.version, 1u);
+    ASSERT(pb_dirsprite_get(&lazy_atlas, lazy_id, 10) != NULL);
+    ASSERT_EQ(lazy_atlas.version, 1u);
+
+    ASSERT_EQ(pb_dirsprite_render_all(&lazy_atlas), PB_DIR_COUNT - 1);
+    ASSERT_EQ(pb_dirsprite_render_all(&lazy_atlas), 0);
+    ASSERT_EQ(lazy_atlas.version, 2u);
+    ASSERT(memcmp(atlas.pixels, lazy_atlas.pixels, sizeof(atlas.pixels)) == 0);
+}
+
+/*============================================================================
+ * API Tests
+ *============================================================================*/
+
+TEST(dir_from_angle) {
+    float deg = 3.14159265f / 180.0f;
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(90.0f * deg)), PB_DIR_VERTICAL);
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(12.0f * deg)), PB_DIR_MIN);
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(168.0f * deg)), PB_DIR_MAX);
+
+    /* Nearest, not truncated */
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(15.4f * deg)), 2);
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(14.6f * deg)), 1);
+
+    /* Clamped */
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(0.0f)), PB_DIR_MIN);
+    ASSERT_EQ(pb_dirsprite_dir(PB_FLOAT_TO_FIXED(180.0f * deg)), PB_DIR_MAX);
+}
+
+TEST(invalid_args) {
+    pb_dirsprite_atlas_init(&atlas, false);
+    pb_dirsprite_source src = bar_source();
+    int id;
+
+    ASSERT_EQ(pb_dirsprite_add(NULL, &src, &id), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_dirsprite_add(&atlas, NULL, &id), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &src, NULL), PB_ERR_INVALID_ARG);
+
+    pb_dirsprite_source bad = src;
+    bad.pivot_y = BAR_H;
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &bad, &id), PB_ERR_INVALID_ARG);
+    bad = src;
+    bad.w = PB_DIRSPRITE_MAX_SRC + 1;
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &bad, &id), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(atlas.sprite_count, 0);
+
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &src, &id), PB_OK);
+    ASSERT(pb_dirsprite_get(&atlas, id, -1) == NULL);
+    ASSERT(pb_dirsprite_get(&atlas, id, PB_DIR_COUNT) == NULL);
+    ASSERT(pb_dirsprite_get(&atlas, id + 1, 0) == NULL);
+}
+
+TEST(atlas_limits) {
+    /* Too many sprites */
+    static const uint8_t dot = 255;
+    pb_dirsprite_source small = {&dot, 1, 1, 0, 0};
+    pb_dirsprite_atlas_init(&atlas, true);
+    int id;
+    for (int i = 0; i < PB_DIRSPRITE_MAX_SPRITES; i++) {
+        ASSERT_EQ(pb_dirsprite_add(&atlas, &small, &id), PB_OK);
+        ASSERT_EQ(id, i);
+    }
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &small, &id), PB_ERR_NO_MEMORY);
+
+    /* Too many pixels: a failed add leaves the atlas as it was */
+    static uint8_t big[PB_DIRSPRITE_MAX_SRC * PB_DIRSPRITE_MAX_SRC];
+    pb_dirsprite_source large = {big, PB_DIRSPRITE_MAX_SRC, PB_DIRSPRITE_MAX_SRC,
+                                 PB_DIRSPRITE_MAX_SRC / 2, PB_DIRSPRITE_MAX_SRC - 1};
+    pb_dirsprite_atlas_init(&atlas, true);
+    ASSERT_EQ(pb_dirsprite_add(&atlas, &large, &id), PB_ERR_NO_MEMORY);
+    ASSERT_EQ(atlas.sprite_count, 0);
+    ASSERT_EQ(atlas.shelf_y, 0);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_dirsprite test suite\n");
+    printf("=======================\n\n");
+
+    printf("Rendering:\n");
+    RUN(vertical_matches_source);
+    RUN(directions_turn_about_pivot);
+    RUN(mirrored_directions);
+    RUN(lazy_matches_eager);
+
+    printf("\nAPI:\n");
+    RUN(dir_from_angle);
+    RUN(invalid_args);
+    RUN(atlas_limits);
+
+    printf("\n=======================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
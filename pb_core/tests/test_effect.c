@@ -104,6 +104,46 @@ static void test_get_effect_invalid(void)
     ASSERT(effect == NULL);
 }
 
+static void test_registry_defaults(void)
+{
+    pb_effect_registry registry;
+    pb_effect_registry_init(&registry);
+
+    for (int i = 0; i < PB_SPECIAL_COUNT; i++) {
+        ASSERT(pb_effect_registry_get(&registry, (pb_special_type)i) ==
+               pb_get_special_effect((pb_special_type)i));
+    }
+    ASSERT(pb_effect_registry_get(&registry, PB_SPECIAL_COUNT) == NULL);
+    ASSERT(pb_effect_registry_get(NULL, PB_SPECIAL_BOMB) == NULL);
+}
+
+static void test_registry_overrides_are_isolated(void)
+{
+    pb_effect_registry classic, variant;
+    pb_effect_registry_init(&classic);
+    pb_effect_registry_init(&variant);
+
+    /* Variant rules: bombs clear radius 2 */
+    pb_effect_def big_bomb = *pb_get_special_effect(PB_SPECIAL_BOMB);
+    big_bomb.target.type = PB_TARGET_RADIUS;
+    big_bomb.target.param.radius = 2;
+    ASSERT(pb_effect_registry_set(&variant, PB_SPECIAL_BOMB, &big_bomb) == PB_OK);
+    ASSERT(pb_effect_registry_set(&variant, PB_SPECIAL_COUNT, &big_bomb) == PB_ERR_INVALID_ARG);
+
+    const pb_effect_def* v = pb_effect_registry_get(&variant, PB_SPECIAL_BOMB);
+    ASSERT(v->target.type == PB_TARGET_RADIUS);
+    ASSERT(v->target.param.radius == 2);
+
+    /* Neither the other registry nor the built-in table changed */
+    ASSERT(pb_effect_registry_get(&classic, PB_SPECIAL_BOMB)->target.type == PB_TARGET_NEIGHBORS);
+    ASSERT(pb_get_special_effect(PB_SPECIAL_BOMB)->target.type == PB_TARGET_NEIGHBORS);
+
+    /* Removing the override restores the built-in */
+    ASSERT(pb_effect_registry_set(&variant, PB_SPECIAL_BOMB, NULL) == PB_OK);
+    ASSERT(pb_effect_registry_get(&variant, PB_SPECIAL_BOMB) ==
+           pb_get_special_effect(PB_SPECIAL_BOMB));
+}
+
 /*============================================================================
  * Target Finding Tests
  *============================================================================*/
@@ -395,6 +435,186 @@ static void test_apply_magnetic_forces(void)
     ASSERT(shot.velocity.x != vel_before.x || shot.velocity.y != vel_before.y);
 }
 
+/*============================================================================
+ * Magnet Field Grid Tests
+ *============================================================================*/
+
+static pb_magnet_field test_field;
+
+/* Exact summed force at a point, via the per-magnet path */
+static pb_vec2 exact_field(const pb_board* board, pb_point pos, pb_scalar radius)
+{
+    pb_shot shot;
+    pb_bubble shot_bubble = {PB_KIND_COLORED, 1, 0, PB_SPECIAL_NONE, {0}};
+    pb_shot_init(&shot, shot_bubble, pos, PB_FLOAT_TO_FIXED(1.57f), 0);
+    shot.velocity.x = 0;
+    shot.velocity.y = 0;
+    pb_apply_magnetic_forces(&shot, board, radius);
+    return shot.velocity;
+}
+
+/*
+ * Documented lookup error (pb_shot.h) at a point for the field's actual
+ * node spacing, which grows as the tier's node budget shrinks. Sets
+ * *near_magnet when the point is inside a magnet's own bubble.
+ */
+static float field_error_bound(const pb_magnet_field* field, const pb_board* board,
+                               pb_scalar radius, float x, float y, bool* near_magnet)
+{
+    const float s = 100.0f;
+    const float R = PB_FIXED_TO_FLOAT(PB_MAGNETIC_DEFAULT_RADIUS);
+    const float r = PB_FIXED_TO_FLOAT(radius);
+    const float h = (float)(1 << field->shift);
+    const float diag = h * 1.4143f;
+    const float rounding = PB_USE_FIXED_POINT ? 1.0f / 65536.0f : 1.0f / 131072.0f;
+
+    float bound = 0.0f;
+    *near_magnet = false;
+    for (int row = 0; row < board->rows; row++) {
+        int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+        for (int col = 0; col < cols; col++) {
+            const pb_bubble* b = &board->cells[row][col];
+            if (b->kind != PB_KIND_SPECIAL || b->special != PB_SPECIAL_MAGNETIC) continue;
+            pb_point m = pb_offset_to_pixel((pb_offset){row, col}, radius);
+            float dx = PB_FIXED_TO_FLOAT(m.x) - x;
+            float dy = PB_FIXED_TO_FLOAT(m.y) - y;
+            float dist = sqrtf(dx * dx + dy * dy);
+            float d = dist - diag;
+            if (dist < 2.0f * r) *near_magnet = true;
+            if (d < R) bound += 1.3f * h * h * s / (d * d * d * d);
+            if (fabsf(dist - R) < diag) bound += s / (R * R);
+            bound += rounding;
+        }
+    }
+    return bound;
+}
+
+static void test_magnet_field_empty(void)
+{
+    pb_board board;
+    pb_board_init_custom(&board, 8, 8, 7);
+
+    ASSERT(pb_magnet_field_build(&test_field, &board, PB_FLOAT_TO_FIXED(16.0f)) == 0);
+    pb_point p = {PB_FLOAT_TO_FIXED(50.0f), PB_FLOAT_TO_FIXED(50.0f)};
+    pb_vec2 f = pb_magnet_field_sample(&test_field, p);
+    ASSERT(f.x == 0 && f.y == 0);
+}
+
+static void test_magnet_field_error_bound(void)
+{
+    const float r = 16.0f;
+    pb_board board;
+    pb_board_init_custom(&board, 12, 8, 7);
+
+    pb_bubble magnet = {PB_KIND_SPECIAL, 0, 0, PB_SPECIAL_MAGNETIC, {0}};
+    const pb_offset spots[] = {{1, 1}, {2, 5}, {5, 3}, {6, 4}, {9, 1}};
+    for (int i = 0; i < 5; i++) {
+        pb_board_set(&board, spots[i], magnet);
+    }
+
+    ASSERT(pb_magnet_field_build(&test_field, &board, PB_FLOAT_TO_FIXED(r)) == 5);
+
+    /* Sweep the playfield outside the magnets, checking the documented bound */
+    int checked = 0;
+    for (float y = 2.0f; y < 360.0f; y += 3.7f) {
+        for (float x = 1.0f; x < 260.0f; x += 2.9f) {
+            pb_point p = {PB_FLOAT_TO_FIXED(x), PB_FLOAT_TO_FIXED(y)};
+            bool near_magnet;
+            float bound = field_error_bound(&test_field, &board, PB_FLOAT_TO_FIXED(r),
+                                            x, y, &near_magnet);
+            if (near_magnet) continue;
+
+            pb_vec2 grid = pb_magnet_field_sample(&test_field, p);
+            pb_vec2 exact = exact_field(&board, p, PB_FLOAT_TO_FIXED(r));
+            ASSERT(fabsf(PB_FIXED_TO_FLOAT(grid.x - exact.x)) <= bound);
+            ASSERT(fabsf(PB_FIXED_TO_FLOAT(grid.y - exact.y)) <= bound);
+            checked++;
+        }
+    }
+    ASSERT(checked > 1000);
+
+    /* Far from every magnet the field is exactly zero */
+    pb_point far = {PB_FLOAT_TO_FIXED(2000.0f), PB_FLOAT_TO_FIXED(50.0f)};
+    pb_vec2 f = pb_magnet_field_sample(&test_field, far);
+    ASSERT(f.x == 0 && f.y == 0);
+}
+
+static void test_magnet_field_update(void)
+{
+    pb_scalar radius = PB_FLOAT_TO_FIXED(16.0f);
+    pb_board board;
+    pb_board_init_custom(&board, 8, 8, 7);
+    pb_bubble magnet = {PB_KIND_SPECIAL, 0, 0, PB_SPECIAL_MAGNETIC, {0}};
+    pb_bubble red = {PB_KIND_COLORED, 0, 0, PB_SPECIAL_NONE, {0}};
+    pb_board_set(&board, (pb_offset){3, 3}, magnet);
+
+    pb_magnet_field_init(&test_field);
+    ASSERT(test_field.magnets == 0);
+    ASSERT(pb_magnet_field_sample(&test_field, (pb_point){0, 0}).x == 0);
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+    ASSERT(test_field.magnets == 1);
+    ASSERT(!pb_magnet_field_update(&test_field, &board, radius));
+
+    /* Ordinary bubbles do not touch the field */
+    pb_board_set(&board, (pb_offset){0, 0}, red);
+    ASSERT(!pb_magnet_field_update(&test_field, &board, radius));
+
+    pb_board_set(&board, (pb_offset){5, 2}, magnet);
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+    ASSERT(test_field.magnets == 2);
+
+    /* Strength, radius and board shape are part of the layout */
+    pb_bubble strong = magnet;
+    strong.payload.magnet_strength = 200;
+    pb_board_set(&board, (pb_offset){5, 2}, strong);
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+    ASSERT(!pb_magnet_field_update(&test_field, &board, radius));
+    ASSERT(pb_magnet_field_update(&test_field, &board, PB_FLOAT_TO_FIXED(12.0f)));
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+    board.cols_odd = 8;
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+    board.cols_odd = 7;
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+
+    pb_board_remove(&board, (pb_offset){3, 3});
+    pb_board_remove(&board, (pb_offset){5, 2});
+    ASSERT(pb_magnet_field_update(&test_field, &board, radius));
+    ASSERT(test_field.magnets == 0);
+}
+
+static void test_apply_magnet_field(void)
+{
+    pb_scalar radius = PB_FLOAT_TO_FIXED(16.0f);
+    pb_board board;
+    pb_board_init_custom(&board, 8, 8, 8);
+    pb_bubble magnet = {PB_KIND_SPECIAL, 0, 0, PB_SPECIAL_MAGNETIC, {0}};
+    pb_board_set(&board, (pb_offset){4, 4}, magnet);
+    pb_magnet_field_build(&test_field, &board, radius);
+
+    /* Same shot as test_apply_magnetic_forces, through both paths */
+    pb_bubble shot_bubble = {PB_KIND_COLORED, 1, 0, PB_SPECIAL_NONE, {0}};
+    pb_point start = {PB_FLOAT_TO_FIXED(100.0f), PB_FLOAT_TO_FIXED(200.0f)};
+    pb_shot exact, grid;
+    pb_shot_init(&exact, shot_bubble, start, PB_FLOAT_TO_FIXED(1.57f), PB_DEFAULT_SHOT_SPEED);
+    grid = exact;
+
+    pb_apply_magnetic_forces(&exact, &board, radius);
+    pb_apply_magnet_field(&grid, &test_field);
+    bool near_magnet;
+    float bound = field_error_bound(&test_field, &board, radius,
+                                    PB_FIXED_TO_FLOAT(start.x), PB_FIXED_TO_FLOAT(start.y),
+                                    &near_magnet);
+    ASSERT(!near_magnet);
+    ASSERT(fabsf(PB_FIXED_TO_FLOAT(grid.velocity.x - exact.velocity.x)) <= bound);
+    ASSERT(fabsf(PB_FIXED_TO_FLOAT(grid.velocity.y - exact.velocity.y)) <= bound);
+
+    /* Only moving shots are affected */
+    grid.phase = PB_SHOT_COLLIDED;
+    pb_vec2 before = grid.velocity;
+    pb_apply_magnet_field(&grid, &test_field);
+    ASSERT(grid.velocity.x == before.x && grid.velocity.y == before.y);
+}
+
 /*============================================================================
  * Main
  *============================================================================*/
@@ -411,6 +631,8 @@ int main(void)
     RUN(get_effect_magnetic);
     RUN(get_effect_none);
     RUN(get_effect_invalid);
+    RUN(registry_defaults);
+    RUN(registry_overrides_are_isolated);
 
     printf("\nTarget finding:\n");
     RUN(find_targets_self);
@@ -435,6 +657,12 @@ int main(void)
     RUN(magnetic_force_clamped);
     RUN(apply_magnetic_forces);
 
+    printf("\nMagnet field grid:\n");
+    RUN(magnet_field_empty);
+    RUN(magnet_field_error_bound);
+    RUN(magnet_field_update);
+    RUN(apply_magnet_field);
+
     printf("\n====================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
 
@@ -0,0 +1,326 @@
+/*
+ * test_endless.c - Tests for pb_endless module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_level_source gen_source(pb_level_gen* gen, uint64_t seed,
+                                  uint8_t fill, uint32_t height)
+{
+    memset(gen, 0, sizeof(*gen));
+    gen->seed = seed;
+    gen->allowed_colors = 0x3F;
+    gen->fill_percent = fill;
+    gen->height = height;
+    return (pb_level_source){pb_level_gen_row, gen};
+}
+
+/* Every cell of a window row matches the level row at its altitude */
+static void assert_row_matches(const pb_endless* e, pb_level_gen* gen, int row)
+{
+    const pb_board* board = e->board;
+    int cols = pb_row_cols(row, board->cols_even, board->cols_odd);
+    pb_bubble expect[PB_MAX_COLS];
+    memset(expect, 0, sizeof(expect));
+
+    uint32_t altitude = pb_endless_row_altitude(e, row);
+    if (altitude != UINT32_MAX) {
+        ASSERT_TRUE(pb_level_gen_row(gen, altitude, expect, cols));
+    }
+    for (int col = 0; col < cols; col++) {
+        ASSERT_EQ(board->cells[row][col].kind, expect[col].kind);
+        ASSERT_EQ(board->cells[row][col].color_id, expect[col].color_id);
+    }
+}
+
+static void assert_neighbors_consistent(const pb_board* board)
+{
+#if PB_FEATURE_NEIGHBOR_COUNTS
+    pb_board rebuilt = *board;
+    pb_board_track_neighbors(&rebuilt, true);
+    ASSERT_EQ(memcmp(rebuilt.neighbor_counts, board->neighbor_counts,
+                     sizeof(board->neighbor_counts)), 0);
+#else
+    (void)board;
+#endif
+}
+
+/*============================================================================
+ * Level Source Tests
+ *============================================================================*/
+
+TEST(gen_row_deterministic)
+{
+    pb_level_gen gen;
+    gen_source(&gen, 42, 70, 100);
+
+    pb_bubble a[PB_MAX_COLS], b[PB_MAX_COLS];
+    memset(a, 0, sizeof(a));
+    memset(b, 0, sizeof(b));
+    ASSERT_TRUE(pb_level_gen_row(&gen, 37, a, 8));
+    ASSERT_TRUE(pb_level_gen_row(&gen, 37, b, 8));
+    ASSERT_EQ(memcmp(a, b, sizeof(a)), 0);
+
+    /* Different rows differ somewhere */
+    int same_rows = 0;
+    for (uint32_t alt = 0; alt < 20; alt++) {
+        memset(b, 0, sizeof(b));
+        pb_level_gen_row(&gen, alt, b, 8);
+        if (memcmp(a, b, sizeof(a)) == 0) same_rows++;
+    }
+    ASSERT_TRUE(same_rows <= 1);
+
+    ASSERT_FALSE(pb_level_gen_row(&gen, 100, b, 8));
+}
+
+TEST(rows_source)
+{
+    pb_bubble cells[3 * PB_MAX_COLS];
+    memset(cells, 0, sizeof(cells));
+    cells[1 * PB_MAX_COLS + 2] = (pb_bubble){.kind = PB_KIND_COLORED, .color_id = 4};
+
+    pb_level_rows rows = {cells, 3};
+    pb_bubble out[PB_MAX_COLS];
+    memset(out, 0, sizeof(out));
+    ASSERT_TRUE(pb_level_rows_row(&rows, 1, out, 8));
+    ASSERT_EQ(out[2].kind, PB_KIND_COLORED);
+    ASSERT_EQ(out[2].color_id, 4);
+    ASSERT_FALSE(pb_level_rows_row(&rows, 3, out, 8));
+}
+
+/*============================================================================
+ * Board Scroll Tests
+ *============================================================================*/
+
+TEST(board_scroll_down)
+{
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_track_neighbors(&board, true);
+    pb_bubble red = {.kind = PB_KIND_COLORED, .color_id = 0};
+    pb_board_set(&board, (pb_offset){0, 3}, red);
+    pb_board_set(&board, (pb_offset){1, 3}, red);
+
+    ASSERT_FALSE(pb_board_scroll_down(&board, 1));
+    ASSERT_FALSE(pb_board_scroll_down(&board, -2));
+    ASSERT_EQ(board.cells[0][3].kind, PB_KIND_COLORED);
+
+    ASSERT_TRUE(pb_board_scroll_down(&board, 4));
+    ASSERT_EQ(board.cells[0][3].kind, PB_KIND_NONE);
+    ASSERT_EQ(board.cells[4][3].kind, PB_KIND_COLORED);
+    ASSERT_EQ(board.cells[5][3].kind, PB_KIND_COLORED);
+    assert_neighbors_consistent(&board);
+
+    /* Row 5 lands in the last row, then falls off */
+    int shift = (board.rows - 6) & ~1;
+    ASSERT_TRUE(pb_board_scroll_down(&board, shift));
+    ASSERT_FALSE(pb_board_scroll_down(&board, 2));
+    assert_neighbors_consistent(&board);
+}
+
+/*============================================================================
+ * Window Tests
+ *============================================================================*/
+
+TEST(init_and_config)
+{
+    pb_endless_config config;
+    pb_endless_config_default(&config);
+    ASSERT_EQ(config.window_rows % 2, 0);
+    ASSERT_EQ(config.initial_rows % 2, 0);
+    ASSERT_TRUE(config.lead_rows < config.window_rows);
+
+    pb_level_gen gen;
+    pb_level_source source = gen_source(&gen, 7, 100, 0);
+    pb_board board;
+    pb_endless e;
+
+    pb_endless_config bad = config;
+    bad.window_rows = 7;
+    ASSERT_EQ(pb_endless_init(&e, &board, &source, &bad), PB_ERR_INVALID_ARG);
+    bad = config;
+    bad.initial_rows = 3;
+    ASSERT_EQ(pb_endless_init(&e, &board, &source, &bad), PB_ERR_INVALID_ARG);
+    pb_level_source empty = {NULL, NULL};
+    ASSERT_EQ(pb_endless_init(&e, &board, &empty, &config), PB_ERR_INVALID_ARG);
+
+    ASSERT_EQ(pb_endless_init(&e, &board, &source, NULL), PB_OK);
+    ASSERT_EQ(board.rows, config.window_rows);
+    ASSERT_EQ(e.next_altitude, (uint32_t)config.initial_rows);
+    ASSERT_EQ(pb_endless_lowest_row(&e), config.initial_rows - 1);
+    ASSERT_EQ(pb_endless_row_altitude(&e, config.initial_rows - 1), 0u);
+    ASSERT_EQ(pb_endless_row_altitude(&e, 0), (uint32_t)config.initial_rows - 1);
+    ASSERT_EQ(pb_endless_row_altitude(&e, config.initial_rows), UINT32_MAX);
+    ASSERT_EQ(board.ceiling_row, 0);
+
+    for (int row = 0; row < board.rows; row++) {
+        assert_row_matches(&e, &gen, row);
+    }
+}
+
+TEST(scroll_pulls_rows)
+{
+    pb_level_gen gen;
+    pb_level_source source = gen_source(&gen, 11, 60, 0);
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_track_neighbors(&board, true);
+
+    pb_endless e;
+    ASSERT_EQ(pb_endless_init(&e, &board, &source, NULL), PB_OK);
+    pb_board before = board;
+
+    ASSERT_TRUE(pb_endless_scroll(&e));
+    ASSERT_EQ(e.rows_scrolled, 2u);
+    for (int row = 2; row < board.rows; row++) {
+        ASSERT_EQ(memcmp(board.cells[row], before.cells[row - 2],
+                         sizeof(board.cells[row])), 0);
+    }
+    for (int row = 0; row < board.rows; row++) {
+        assert_row_matches(&e, &gen, row);
+    }
+    assert_neighbors_consistent(&board);
+}
+
+TEST(refill_after_clear)
+{
+    pb_level_gen gen;
+    pb_level_source source = gen_source(&gen, 3, 80, 0);
+    pb_board board;
+    pb_endless e;
+    ASSERT_EQ(pb_endless_init(&e, &board, &source, NULL), PB_OK);
+
+    /* Nothing to do while bubbles reach the lead row */
+    for (int i = 0; i < 4; i++) pb_endless_scroll(&e);
+    ASSERT_TRUE(pb_endless_lowest_row(&e) >= e.lead_rows);
+    ASSERT_EQ(pb_endless_refill(&e), 0);
+
+    /* Shoot everything away: the window climbs */
+    pb_board_clear(&board);
+    int scrolled = pb_endless_refill(&e);
+    ASSERT_TRUE(scrolled > 0);
+    ASSERT_EQ(scrolled % 2, 0);
+    ASSERT_TRUE(pb_endless_lowest_row(&e) >= e.lead_rows);
+    ASSERT_TRUE(pb_endless_lowest_row(&e) < board.rows - 2);
+}
+
+TEST(long_level_runs_out)
+{
+    const uint32_t height = 10000;
+    pb_level_gen gen;
+    pb_level_source source = gen_source(&gen, 99, 50, height);
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_track_neighbors(&board, true);
+
+    pb_endless e;
+    ASSERT_EQ(pb_endless_init(&e, &board, &source, NULL), PB_OK);
+
+    /* Clear the bottom pair each step, as the player would */
+    uint32_t steps = 0;
+    while (!e.exhausted) {
+        for (int col = 0; col < PB_MAX_COLS; col++) {
+            pb_board_remove(&board, (pb_offset){board.rows - 1, col});
+            pb_board_remove(&board, (pb_offset){board.rows - 2, col});
+        }
+        ASSERT_TRUE(pb_endless_scroll(&e));
+        if (!e.exhausted) ASSERT_EQ(board.ceiling_row, 0);
+        steps++;
+        ASSERT_TRUE(steps < height);
+    }
+    ASSERT_EQ(e.height, height);
+    assert_neighbors_consistent(&board);
+
+    /* The top of the level is in view and the ceiling anchors on it */
+    int top = board.ceiling_row;
+    ASSERT_TRUE(top > 0);
+    ASSERT_EQ(pb_endless_row_altitude(&e, top), height - 1);
+    ASSERT_EQ(pb_endless_row_altitude(&e, top - 1), UINT32_MAX);
+    for (int row = 0; row < board.rows; row++) {
+        assert_row_matches(&e, &gen, row);
+    }
+
+    /* Scrolling on brings empty rows in and moves the ceiling down */
+    pb_endless_scroll(&e);
+    ASSERT_EQ(board.ceiling_row, top + 2 < board.rows ? top + 2 : board.rows - 1);
+    for (int row = 0; row < board.ceiling_row; row++) {
+        for (int col = 0; col < PB_MAX_COLS; col++) {
+            ASSERT_EQ(board.cells[row][col].kind, PB_KIND_NONE);
+        }
+    }
+
+    /* A bubble on the level top is anchored, a loose one below it is not */
+    pb_board_clear(&board);
+    pb_board_track_neighbors(&board, true);
+    pb_bubble blue = {.kind = PB_KIND_COLORED, .color_id = 1};
+    pb_board_set(&board, (pb_offset){board.ceiling_row, 2}, blue);
+    pb_board_set(&board, (pb_offset){board.ceiling_row + 2, 6}, blue);
+    pb_visit_result orphans;
+    ASSERT_EQ(pb_find_orphans(&board, &orphans), 1);
+    ASSERT_EQ(pb_endless_refill(&e), 0);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_endless test suite\n");
+    printf("=====================\n\n");
+
+    printf("Level sources:\n");
+    RUN(gen_row_deterministic);
+    RUN(rows_source);
+
+    printf("\nBoard scroll:\n");
+    RUN(board_scroll_down);
+
+    printf("\nWindow:\n");
+    RUN(init_and_config);
+    RUN(scroll_pulls_rows);
+    RUN(refill_after_clear);
+    RUN(long_level_runs_out);
+
+    printf("\n=====================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
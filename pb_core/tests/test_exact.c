@@ -0,0 +1,431 @@
+/*
+ * test_exact.c - Tests for pb_exact module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+static pb_bubble rainbow(void)
+{
+    pb_bubble b = {PB_KIND_SPECIAL, 0, 0, PB_SPECIAL_RAINBOW, {0}};
+    return b;
+}
+
+static void fill_queue(pb_bubble* queue, const uint8_t* colors, int n)
+{
+    for (int i = 0; i < n; i++) {
+        queue[i] = colored(colors[i]);
+    }
+}
+
+/* Replay a witness with pb_solver_apply_move and check it clears */
+static bool witness_clears(const pb_board* board, const pb_exact_result* r)
+{
+    pb_solver solver;
+    pb_solver_init(&solver, board, NULL, 0);
+    for (int i = 0; i < r->witness_length; i++) {
+        pb_solver_apply_move(&solver, &r->witness[i]);
+    }
+    return pb_solver_is_cleared(&solver);
+}
+
+static pb_exact_config attachable_config(void)
+{
+    pb_exact_config config;
+    pb_exact_config_default(&config);
+    config.movegen = PB_EXACT_MOVES_ATTACHABLE;
+    return config;
+}
+
+/*============================================================================
+ * Lower Bound Tests
+ *============================================================================*/
+
+TEST(lower_bound_empty) {
+    pb_board board;
+    pb_board_init(&board);
+    ASSERT_EQ(pb_exact_lower_bound(&board, 3, NULL, 0), 0);
+}
+
+TEST(lower_bound_per_ceiling_color) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 1}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 4}, colored(1));
+
+    pb_bubble queue[4];
+    fill_queue(queue, (const uint8_t[]){0, 1, 1, 1}, 4);
+
+    /* Red needs one more, blue needs two more */
+    ASSERT_EQ(pb_exact_lower_bound(&board, 3, queue, 4), 3);
+}
+
+TEST(lower_bound_missing_color) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(2));
+
+    pb_bubble queue[3];
+    fill_queue(queue, (const uint8_t[]){0, 0, 1}, 3);
+
+    ASSERT_TRUE(pb_exact_lower_bound(&board, 3, queue, 3) > 3);
+}
+
+TEST(lower_bound_ignores_droppable) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 1}, colored(0));
+    pb_board_set(&board, (pb_offset){1, 0}, colored(3));
+
+    pb_bubble queue[1];
+    fill_queue(queue, (const uint8_t[]){0}, 1);
+
+    /* Color 3 hangs below and can be dropped for free */
+    ASSERT_EQ(pb_exact_lower_bound(&board, 3, queue, 1), 1);
+}
+
+TEST(lower_bound_counts_rainbow) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 3}, colored(1));
+    pb_board_set(&board, (pb_offset){0, 4}, rainbow());
+
+    pb_bubble queue[1];
+    fill_queue(queue, (const uint8_t[]){1}, 1);
+
+    /* The rainbow completes the group: one shot, not infeasible */
+    ASSERT_EQ(pb_exact_lower_bound(&board, 3, queue, 1), 1);
+}
+
+/*============================================================================
+ * Solver Tests
+ *============================================================================*/
+
+TEST(solve_empty_board) {
+    pb_board board;
+    pb_board_init(&board);
+
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, NULL, 0, NULL, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(result.min_shots, 0);
+}
+
+TEST(solve_invalid_args) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_exact_result result;
+
+    ASSERT_EQ(pb_solve_exact(NULL, NULL, NULL, 0, NULL, &result), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_solve_exact(&board, NULL, NULL, 3, NULL, &result), PB_ERR_INVALID_ARG);
+}
+
+TEST(solve_single_shot_trajectory) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 3}, colored(1));
+    pb_board_set(&board, (pb_offset){0, 4}, colored(1));
+
+    pb_bubble queue[3];
+    fill_queue(queue, (const uint8_t[]){1, 1, 1}, 3);
+
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 3, NULL, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(result.min_shots, 1);
+    ASSERT_EQ(result.witness_length, 1);
+    ASSERT_TRUE(witness_clears(&board, &result));
+}
+
+TEST(solve_two_shots) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 2}, colored(0));
+
+    pb_bubble queue[4];
+    fill_queue(queue, (const uint8_t[]){0, 0, 0, 0}, 4);
+
+    pb_exact_config config = attachable_config();
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 4, &config, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(result.min_shots, 2);
+    ASSERT_TRUE(witness_clears(&board, &result));
+}
+
+TEST(solve_uses_drops) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 1}, colored(0));
+    pb_board_set(&board, (pb_offset){1, 0}, colored(2));
+    pb_board_set(&board, (pb_offset){2, 0}, colored(3));
+    pb_board_set(&board, (pb_offset){2, 1}, colored(4));
+
+    pb_bubble queue[2];
+    fill_queue(queue, (const uint8_t[]){0, 2}, 2);
+
+    pb_exact_config config = attachable_config();
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 2, &config, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(result.min_shots, 1);
+    ASSERT_TRUE(witness_clears(&board, &result));
+}
+
+TEST(solve_rainbow_completes_ceiling) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 3}, colored(1));
+    pb_board_set(&board, (pb_offset){0, 4}, rainbow());
+
+    pb_bubble queue[1];
+    fill_queue(queue, (const uint8_t[]){1}, 1);
+
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 1, NULL, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(result.min_shots, 1);
+    ASSERT_TRUE(witness_clears(&board, &result));
+}
+
+TEST(solve_unsolvable) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+
+    pb_bubble queue[2];
+    fill_queue(queue, (const uint8_t[]){1, 1}, 2);
+
+    pb_exact_config config = attachable_config();
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 2, &config, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_UNSOLVABLE);
+    ASSERT_EQ(result.min_shots, -1);
+}
+
+TEST(solve_color_switch) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 1}, colored(0));
+
+    pb_bubble queue[2];
+    fill_queue(queue, (const uint8_t[]){1, 0}, 2);
+
+    pb_ruleset rules;
+    memset(&rules, 0, sizeof(rules));
+    rules.match_threshold = 3;
+
+    pb_exact_config config = attachable_config();
+    pb_exact_result result;
+
+    ASSERT_EQ(pb_solve_exact(&board, &rules, queue, 2, &config, &result), PB_OK);
+    ASSERT_EQ(result.min_shots, 2);
+
+    rules.allow_color_switch = true;
+    ASSERT_EQ(pb_solve_exact(&board, &rules, queue, 2, &config, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(result.min_shots, 1);
+    ASSERT_EQ(result.witness[0].color_id, 0);
+}
+
+/* Pairs along the ceiling; `second_row` extra bubbles hang below */
+static void build_puzzle(pb_board* board, pb_bubble* queue, int second_row)
+{
+    pb_board_init(board);
+    const uint8_t row0[8] = {0, 0, 1, 1, 2, 2, 3, 3};
+    const uint8_t row1[7] = {1, 2, 3, 0, 1, 2, 3};
+    for (int c = 0; c < 8; c++) pb_board_set(board, (pb_offset){0, c}, colored(row0[c]));
+    for (int c = 0; c < second_row; c++) {
+        pb_board_set(board, (pb_offset){1, c + (7 - second_row) / 2}, colored(row1[c]));
+    }
+    fill_queue(queue, (const uint8_t[]){0, 1, 2, 3, 0, 1, 2, 3, 0, 1}, 10);
+}
+
+TEST(solve_threads_match_serial) {
+    pb_board board;
+    pb_bubble queue[10];
+    build_puzzle(&board, queue, 3);
+
+    pb_exact_config config = attachable_config();
+    config.seed_with_greedy = false;
+    pb_exact_result serial, parallel;
+
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &serial), PB_OK);
+    config.threads = 4;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &parallel), PB_OK);
+
+    ASSERT_EQ(serial.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(parallel.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(serial.min_shots, parallel.min_shots);
+    ASSERT_EQ(serial.witness_length, parallel.witness_length);
+    for (int i = 0; i < serial.witness_length; i++) {
+        ASSERT_EQ(serial.witness[i].target.row, parallel.witness[i].target.row);
+        ASSERT_EQ(serial.witness[i].target.col, parallel.witness[i].target.col);
+    }
+    ASSERT_TRUE(witness_clears(&board, &serial));
+    ASSERT_TRUE(serial.min_shots >= serial.lower_bound);
+}
+
+TEST(solve_budget_is_anytime) {
+    pb_board board;
+    pb_bubble queue[10];
+    build_puzzle(&board, queue, 7);
+
+    pb_exact_config config = attachable_config();
+    config.node_budget = 1;
+
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_TIMEOUT);
+    ASSERT_TRUE(result.lower_bound >= 4);
+
+    /* The greedy seed still provides a valid line */
+    if (result.witness_length > 0) {
+        ASSERT_EQ(result.min_shots, result.witness_length);
+        ASSERT_TRUE(witness_clears(&board, &result));
+    }
+}
+
+static bool count_and_stop(const pb_exact_progress* progress, void* userdata)
+{
+    int* calls = userdata;
+    (*calls)++;
+    return progress->nodes < 1000;
+}
+
+TEST(progress_callback_cancels) {
+    pb_board board;
+    pb_bubble queue[10];
+    build_puzzle(&board, queue, 7);
+
+    int calls = 0;
+    pb_exact_config config = attachable_config();
+    config.seed_with_greedy = false;
+    config.on_progress = count_and_stop;
+    config.progress_userdata = &calls;
+
+    pb_exact_result result;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &result), PB_OK);
+    ASSERT_EQ(result.status, PB_EXACT_TIMEOUT);
+    ASSERT_TRUE(calls > 0);
+    ASSERT_TRUE(result.nodes < 2000);
+}
+
+TEST(cache_reuses_refutations) {
+    pb_board board;
+    pb_bubble queue[10];
+    build_puzzle(&board, queue, 3);
+    /* Paired colors force several IDA* iterations of refutations */
+    fill_queue(queue, (const uint8_t[]){0, 0, 1, 1, 2, 2, 3, 3, 0, 1}, 10);
+
+    pb_exact_cache* cache = pb_exact_cache_create(16);
+    ASSERT_NE(cache, NULL);
+
+    pb_exact_config config = attachable_config();
+    config.seed_with_greedy = false;
+    config.cache = cache;
+    pb_exact_result first, second;
+
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &first), PB_OK);
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &second), PB_OK);
+    ASSERT_EQ(first.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(second.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(first.min_shots, second.min_shots);
+    ASSERT_TRUE(second.nodes < first.nodes);
+    ASSERT_TRUE(witness_clears(&board, &second));
+
+    /* A different queue invalidates the table instead of misusing it */
+    queue[0] = colored(3);
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &second), PB_OK);
+    config.cache = NULL;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 10, &config, &first), PB_OK);
+    ASSERT_EQ(first.status, second.status);
+    ASSERT_EQ(first.min_shots, second.min_shots);
+    ASSERT_EQ(first.nodes, second.nodes);
+
+    pb_exact_cache_destroy(cache);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_exact test suite\n");
+    printf("===================\n\n");
+
+    printf("Lower bound:\n");
+    RUN(lower_bound_empty);
+    RUN(lower_bound_per_ceiling_color);
+    RUN(lower_bound_missing_color);
+    RUN(lower_bound_ignores_droppable);
+    RUN(lower_bound_counts_rainbow);
+
+    printf("\nSolver:\n");
+    RUN(solve_empty_board);
+    RUN(solve_invalid_args);
+    RUN(solve_single_shot_trajectory);
+    RUN(solve_two_shots);
+    RUN(solve_uses_drops);
+    RUN(solve_rainbow_completes_ceiling);
+    RUN(solve_unsolvable);
+    RUN(solve_color_switch);
+    RUN(solve_threads_match_serial);
+    RUN(solve_budget_is_anytime);
+
+    printf("\nProgress and cache:\n");
+    RUN(progress_callback_cancels);
+    RUN(cache_reuses_refutations);
+
+    printf("\n===================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/*
+ * test_font.c - Tests for pb_font module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+
+/* Large value types, kept off the stack */
+static pb_font_atlas atlas;
+static pb_text_cache cache;
+static pb_text_batch batch;
+
+static uint8_t atlas_at(const pb_glyph* g, int x, int y)
+{
+    return atlas.pixels[(g->y + y) * PB_FONT_ATLAS_W + g->x + x];
+}
+
+/*============================================================================
+ * Atlas Tests
+ *============================================================================*/
+
+TEST(builtin_glyphs) {
+    pb_font_atlas_init_builtin(&atlas);
+    ASSERT_EQ(atlas.line_height, 6);
+
+    /* '7': top row full, then a single right-hand pixel */
+    const pb_glyph* seven = pb_font_atlas_glyph(&atlas, '7');
+    ASSERT_NE(seven, NULL);
+    ASSERT_EQ(seven->w, 3);
+    ASSERT_EQ(seven->h, 5);
+    ASSERT_EQ(atlas_at(seven, 0, 0), 1);
+    ASSERT_EQ(atlas_at(seven, 2, 0), 1);
+    ASSERT_EQ(atlas_at(seven, 0, 1), 0);
+    ASSERT_EQ(atlas_at(seven, 2, 1), 1);
+
+    /* Fallbacks: lower case to upper, unknown to '?' */
+    ASSERT_EQ(pb_font_atlas_glyph(&atlas, 'q'), pb_font_atlas_glyph(&atlas, 'Q'));
+    ASSERT_EQ(pb_font_atlas_glyph(&atlas, '~'), pb_font_atlas_glyph(&atlas, '?'));
+    ASSERT_EQ(pb_font_atlas_glyph(&atlas, 200), pb_font_atlas_glyph(&atlas, '?'));
+
+    /* Glyphs never overlap */
+    const pb_glyph* a = pb_font_atlas_glyph(&atlas, 'A');
+    const pb_glyph* b = pb_font_atlas_glyph(&atlas, 'B');
+    ASSERT_TRUE(a->x != b->x || a->y != b->y);
+}
+
+TEST(add_glyph_limits) {
+    pb_font_atlas_init(&atlas, 10);
+    uint8_t rows[16] = {0xFF};
+    ASSERT_EQ(pb_font_atlas_add_glyph(&atlas, 31, 8, 8, rows, 9), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_font_atlas_add_glyph(&atlas, 'A', 9, 8, rows, 9), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_font_atlas_add_glyph(&atlas, 'A', 8, 8, NULL, 9), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_font_atlas_glyph(&atlas, 'A'), NULL);
+
+    /* 9x17 cells: 14 per shelf, 3 shelves */
+    uint32_t version = atlas.version;
+    for (int i = 0; i < 42; i++) {
+        ASSERT_EQ(pb_font_atlas_add_glyph(&atlas, 33 + i, 8, 16, rows, 9), PB_OK);
+    }
+    ASSERT_EQ(pb_font_atlas_add_glyph(&atlas, 'z', 8, 16, rows, 9), PB_ERR_NO_MEMORY);
+    ASSERT_EQ(atlas.version, version + 42);
+}
+
+/*============================================================================
+ * Layout Tests
+ *============================================================================*/
+
+TEST(layout_positions) {
+    pb_font_atlas_init_builtin(&atlas);
+    pb_text_quad quads[PB_TEXT_MAX_LEN];
+    int w, h;
+
+    ASSERT_EQ(pb_text_layout(&atlas, "12 3", quads, &w, &h), 3);
+    ASSERT_EQ(w, 16);
+    ASSERT_EQ(h, 6);
+    ASSERT_EQ(quads[1].x, 4);
+    ASSERT_EQ(quads[2].x, 12);
+    ASSERT_EQ(quads[2].src_x, pb_font_atlas_glyph(&atlas, '3')->x);
+
+    ASSERT_EQ(pb_text_layout(&atlas, "AB\nC", quads, &w, &h), 3);
+    ASSERT_EQ(w, 8);
+    ASSERT_EQ(h, 12);
+    ASSERT_EQ(quads[2].x, 0);
+    ASSERT_EQ(quads[2].y, 6);
+}
+
+TEST(cache_reuses_layouts) {
+    pb_font_atlas_init_builtin(&atlas);
+    pb_text_cache_init(&cache, &atlas);
+
+    const pb_text_layout_entry* a = pb_text_cache_get(&cache, "SCORE 1200");
+    ASSERT_NE(a, NULL);
+    ASSERT_EQ(a->quad_count, 9);
+    ASSERT_EQ(pb_text_cache_get(&cache, "SCORE 1200"), a);
+    ASSERT_EQ(cache.hits, 1u);
+    ASSERT_EQ(cache.misses, 1u);
+
+    /* A frame of unchanged HUD text is all hits */
+    for (int frame = 0; frame < 60; frame++) {
+        pb_text_cache_get(&cache, "SCORE 1200");
+        pb_text_cache_get(&cache, "LEVEL 3");
+    }
+    ASSERT_EQ(cache.misses, 2u);
+
+    /* Fill the cache with other strings: the oldest is evicted */
+    char buf[16];
+    for (int i = 0; i < PB_TEXT_CACHE_SIZE - 1; i++) {
+        snprintf(buf, sizeof(buf), "T%d", i);
+        pb_text_cache_get(&cache, buf);
+    }
+    pb_text_cache_get(&cache, "LEVEL 3");
+    uint32_t misses = cache.misses;
+    pb_text_cache_get(&cache, "SCORE 1200");
+    ASSERT_EQ(cache.misses, misses + 1);
+
+    /* Changing the atlas invalidates cached layouts */
+    uint8_t rows[5] = {7, 7, 7, 7, 7};
+    pb_font_atlas_add_glyph(&atlas, '~', 3, 5, rows, 4);
+    misses = cache.misses;
+    pb_text_cache_get(&cache, "SCORE 1200");
+    ASSERT_EQ(cache.misses, misses + 1);
+}
+
+/*============================================================================
+ * Batch Tests
+ *============================================================================*/
+
+TEST(batch_and_render) {
+    pb_font_atlas_init_builtin(&atlas);
+    pb_text_cache_init(&cache, &atlas);
+    pb_text_batch_clear(&batch);
+
+    ASSERT_EQ(pb_text_batch_add(&batch, &cache, "1", 10, 20, 5), 4);
+    ASSERT_EQ(pb_text_batch_add(&batch, &cache, "77", 60, 0, 9), 8);
+    ASSERT_EQ(batch.count, 3);
+    ASSERT_EQ(batch.quads[0].x, 10);
+    ASSERT_EQ(batch.quads[0].y, 20);
+    ASSERT_EQ(batch.quads[2].color, 9);
+
+    pb_render_config config = {64, 32, 1, false, true, PB_DITHER_NONE};
+    pb_render_context* ctx = pb_render_create(&config);
+    pb_render_begin_frame(ctx);
+    pb_render_clear(ctx, 0);
+    pb_render_text_batch(ctx, &atlas, &batch);
+    ASSERT_EQ(pb_render_get_stats(ctx).draw_calls, 2);
+
+    /* '1' has its stem in the middle column; the second '7' is clipped */
+    const uint8_t* fb = pb_render_get_framebuffer(ctx);
+    ASSERT_EQ(fb[20 * 64 + 11], 5);
+    ASSERT_EQ(fb[20 * 64 + 10], 0);
+    ASSERT_EQ(fb[24 * 64 + 12], 5);
+    ASSERT_EQ(fb[0 * 64 + 62], 9);
+    ASSERT_EQ(fb[1 * 64 + 63], 0);
+    pb_render_destroy(ctx);
+
+    /* Overflow is counted, never written past the end */
+    pb_text_batch_clear(&batch);
+    for (int i = 0; i < PB_TEXT_BATCH_MAX; i++) {
+        pb_text_batch_add(&batch, &cache, "88", 0, 0, 1);
+    }
+    ASSERT_EQ(batch.count, PB_TEXT_BATCH_MAX);
+    ASSERT_EQ(batch.dropped, (uint32_t)PB_TEXT_BATCH_MAX);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_font test suite\n");
+    printf("==================\n\n");
+
+    printf("Atlas:\n");
+    RUN(builtin_glyphs);
+    RUN(add_glyph_limits);
+
+    printf("\nLayout:\n");
+    RUN(layout_positions);
+    RUN(cache_reuses_layouts);
+
+    printf("\nBatching:\n");
+    RUN(batch_and_render);
+
+    printf("\n==================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
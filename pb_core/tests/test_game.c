@@ -329,6 +329,91 @@ TEST(game_clear_events) {
     ASSERT_EQ(game.event_count, 0);
 }
 
+typedef struct event_tally {
+    int calls;
+    const pb_event* last;
+} event_tally;
+
+static void tally_event(const pb_event* event, void* userdata)
+{
+    event_tally* tally = userdata;
+    tally->calls++;
+    tally->last = event;
+}
+
+TEST(game_subscribe_filters_by_mask) {
+    pb_game_state game;
+    pb_game_init(&game, NULL, 0);
+
+    event_tally pops = {0, NULL}, all = {0, NULL};
+    int id = -1;
+    ASSERT_EQ(pb_game_subscribe(&game, PB_EVENT_MASK(PB_EVENT_BUBBLES_POPPED),
+                                tally_event, &pops, &id), PB_OK);
+    ASSERT_EQ(pb_game_subscribe(&game, PB_EVENT_MASK_ALL, tally_event, &all, NULL),
+              PB_OK);
+
+    pb_event evt = {0};
+    evt.type = PB_EVENT_FIRE;
+    pb_game_add_event(&game, &evt);
+    evt.type = PB_EVENT_BUBBLES_POPPED;
+    pb_game_add_event(&game, &evt);
+
+    ASSERT_EQ(pops.calls, 1);
+    ASSERT_EQ(all.calls, 2);
+    ASSERT_TRUE(pops.last == &evt);     /* Delivered in place, not copied */
+
+    ASSERT_EQ(pb_game_unsubscribe(&game, id), PB_OK);
+    ASSERT_EQ(pb_game_unsubscribe(&game, id), PB_ERR_INVALID_ARG);
+    pb_game_add_event(&game, &evt);
+    ASSERT_EQ(pops.calls, 1);
+    ASSERT_EQ(all.calls, 3);
+}
+
+TEST(game_subscribe_invalid) {
+    pb_game_state game;
+    pb_game_init(&game, NULL, 0);
+    event_tally tally = {0, NULL};
+
+    ASSERT_EQ(pb_game_subscribe(&game, PB_EVENT_MASK_ALL, NULL, NULL, NULL),
+              PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_game_subscribe(&game, 0, tally_event, &tally, NULL),
+              PB_ERR_INVALID_ARG);
+    for (int i = 0; i < PB_MAX_EVENT_SUBSCRIBERS; i++) {
+        ASSERT_EQ(pb_game_subscribe(&game, PB_EVENT_MASK_ALL, tally_event, &tally,
+                                    NULL), PB_OK);
+    }
+    ASSERT_EQ(pb_game_subscribe(&game, PB_EVENT_MASK_ALL, tally_event, &tally, NULL),
+              PB_ERR_NO_MEMORY);
+    ASSERT_EQ(pb_game_unsubscribe(&game, -1), PB_ERR_INVALID_ARG);
+}
+
+TEST(game_event_log_overflow) {
+    pb_game_state game;
+    pb_game_init(&game, NULL, 0);
+    event_tally tally = {0, NULL};
+    pb_game_subscribe(&game, PB_EVENT_MASK_ALL, tally_event, &tally, NULL);
+
+    pb_event evt = {0};
+    evt.type = PB_EVENT_BUBBLES_DROPPED;
+    for (int i = 0; i < 300; i++) {
+        pb_game_add_event(&game, &evt);
+    }
+    ASSERT_EQ(tally.calls, 300);
+    ASSERT_EQ(game.event_count, 256);
+    ASSERT_EQ(game.events_dropped, 44u);
+
+    /* Subscriber-only mode never fills the log; reset keeps observers */
+    pb_game_reset(&game, 1);
+    pb_game_set_event_log(&game, false);
+    tally.calls = 0;
+    for (int i = 0; i < 300; i++) {
+        pb_game_add_event(&game, &evt);
+    }
+    ASSERT_EQ(tally.calls, 300);
+    ASSERT_EQ(game.event_count, 0);
+    ASSERT_EQ(game.events_dropped, 0u);
+}
+
 /*============================================================================
  * Checksum Tests
  *============================================================================*/
@@ -395,6 +480,9 @@ int main(void)
     printf("\nEvents:\n");
     RUN(game_event_count_starts_zero);
     RUN(game_clear_events);
+    RUN(game_subscribe_filters_by_mask);
+    RUN(game_subscribe_invalid);
+    RUN(game_event_log_overflow);
 
     printf("\nChecksum:\n");
     RUN(game_checksum_deterministic);
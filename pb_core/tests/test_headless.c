@@ -0,0 +1,436 @@
+/*
+ * test_headless.c - Tests for the headless pb_platform backend
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include "pb/pb_platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+static const pb_color_srgb8 BLACK = {0, 0, 0, 255};
+static const pb_color_srgb8 RED = {255, 0, 0, 255};
+static const pb_color_srgb8 WHITE = {255, 255, 255, 255};
+
+static pb_platform* open_headless(int w, int h)
+{
+    pb_platform* p = pb_platform_headless_create();
+    ASSERT_NE(p, NULL);
+
+    pb_platform_config config = PB_PLATFORM_CONFIG_DEFAULT;
+    config.logical_width = w;
+    config.logical_height = h;
+    ASSERT_TRUE(pb_init(p, &config));
+    return p;
+}
+
+static void close_headless(pb_platform* p)
+{
+    pb_shutdown(p);
+    pb_platform_free(p);
+}
+
+static uint32_t pixel_at(const pb_platform* p, int x, int y)
+{
+    int w, h;
+    const uint32_t* fb = pb_platform_headless_framebuffer(p, &w, &h);
+    ASSERT_NE(fb, NULL);
+    ASSERT(x >= 0 && x < w && y >= 0 && y < h);
+    return fb[y * w + x];
+}
+
+/* Draw a fixed scene exercising every primitive */
+static void draw_scene(pb_platform* p)
+{
+    pb_color_srgb8 veil = {0, 0, 255, 128};
+    pb_clear(p, BLACK);
+    p->draw_rect(p, 4, 4, 20, 10, RED);
+    p->draw_rect_outline(p, 30, 4, 12, 12, WHITE);
+    p->draw_circle(p, 60, 30, 9, RED);
+    p->draw_circle_outline(p, 90, 30, 9, WHITE);
+    p->draw_line(p, 0, 63, 127, 40, WHITE);
+    p->draw_rect(p, 0, 0, 64, 64, veil);
+    pb_present(p);
+}
+
+/*============================================================================
+ * Framebuffer Tests
+ *============================================================================*/
+
+TEST(framebuffer_uses_logical_size)
+{
+    pb_platform* p = open_headless(128, 64);
+
+    int w = 0, h = 0;
+    ASSERT_NE(pb_platform_headless_framebuffer(p, &w, &h), NULL);
+    ASSERT_EQ(w, 128);
+    ASSERT_EQ(h, 64);
+
+    pb_clear(p, BLACK);
+    ASSERT_EQ(pixel_at(p, 127, 63), 0x000000FFu);
+
+    /* Clipped at the edges */
+    p->draw_rect(p, -5, -5, 10, 10, RED);
+    ASSERT_EQ(pixel_at(p, 0, 0), 0xFF0000FFu);
+    ASSERT_EQ(pixel_at(p, 4, 4), 0xFF0000FFu);
+    ASSERT_EQ(pixel_at(p, 5, 5), 0x000000FFu);
+
+    /* Half-transparent white over black */
+    pb_color_srgb8 half = {255, 255, 255, 128};
+    p->draw_rect(p, 10, 10, 1, 1, half);
+    ASSERT_EQ(pixel_at(p, 10, 10), 0x808080FFu);
+
+    /* Lines include both endpoints */
+    p->draw_line(p, 20, 20, 30, 25, WHITE);
+    ASSERT_EQ(pixel_at(p, 20, 20), 0xFFFFFFFFu);
+    ASSERT_EQ(pixel_at(p, 30, 25), 0xFFFFFFFFu);
+
+    close_headless(p);
+}
+
+TEST(rendering_is_deterministic)
+{
+    pb_platform* a = open_headless(128, 64);
+    pb_platform* b = open_headless(128, 64);
+
+    draw_scene(a);
+    draw_scene(b);
+
+    const uint32_t* fa = pb_platform_headless_framebuffer(a, NULL, NULL);
+    const uint32_t* fb = pb_platform_headless_framebuffer(b, NULL, NULL);
+    ASSERT_EQ(memcmp(fa, fb, 128 * 64 * sizeof(uint32_t)), 0);
+
+    pb_headless_stats stats;
+    pb_platform_headless_get_stats(a, &stats);
+    ASSERT_EQ(stats.draw_calls, 7u);
+    ASSERT_EQ(stats.presents, 1u);
+    ASSERT(stats.pixels_written > 128u * 64u);
+
+    close_headless(a);
+    close_headless(b);
+}
+
+TEST(textures_and_text)
+{
+    pb_platform* p = open_headless(64, 32);
+    pb_clear(p, BLACK);
+
+    /* 2x2 checker scaled to 4x4 */
+    const uint32_t checker[4] = {0xFF0000FFu, 0x00FF00FFu, 0x0000FFFFu, 0xFFFFFF00u};
+    pb_texture tex = p->texture_create(p, 2, 2);
+    ASSERT_NE(tex, NULL);
+    p->texture_upload(p, tex, checker);
+    p->texture_draw(p, tex, 0, 0, 0, 0, 8, 8, 4, 4);
+    ASSERT_EQ(pixel_at(p, 8, 8), 0xFF0000FFu);
+    ASSERT_EQ(pixel_at(p, 9, 9), 0xFF0000FFu);
+    ASSERT_EQ(pixel_at(p, 10, 8), 0x00FF00FFu);
+    ASSERT_EQ(pixel_at(p, 8, 10), 0x0000FFFFu);
+    ASSERT_EQ(pixel_at(p, 11, 11), 0x000000FFu);   /* Transparent texel */
+
+    /* Unrotated sprite with a tint matches the plain blit, tinted */
+    pb_sprite sprite = {
+        .texture = tex, .src_x = 0, .src_y = 0, .src_w = 2, .src_h = 2,
+        .dst_x = 20, .dst_y = 8, .dst_w = 2, .dst_h = 2,
+        .rotation = 0.0f, .origin_x = 1, .origin_y = 1,
+        .tint = {255, 0, 255, 255}, .alpha = 255,
+    };
+    p->texture_draw_ex(p, &sprite);
+    ASSERT_EQ(pixel_at(p, 20, 8), 0xFF0000FFu);
+    ASSERT_EQ(pixel_at(p, 21, 8), 0x000000FFu);     /* Green tinted away */
+    p->texture_free(p, tex);
+
+    /* Text batch through an uploaded font atlas */
+    static pb_font_atlas font;
+    static pb_text_cache cache;
+    static pb_text_batch batch;
+    static uint32_t rgba[PB_FONT_ATLAS_W * PB_FONT_ATLAS_H];
+    pb_font_atlas_init_builtin(&font);
+    pb_text_cache_init(&cache, &font);
+    for (int i = 0; i < PB_FONT_ATLAS_W * PB_FONT_ATLAS_H; i++) {
+        rgba[i] = font.pixels[i] ? 0xFFFFFFFFu : 0xFFFFFF00u;
+    }
+    pb_texture atlas = p->texture_create(p, PB_FONT_ATLAS_W, PB_FONT_ATLAS_H);
+    ASSERT_NE(atlas, NULL);
+    p->texture_upload(p, atlas, rgba);
+
+    const pb_color_srgb8 colors[2] = {WHITE, RED};
+    pb_text_batch_clear(&batch);
+    pb_text_batch_add(&batch, &cache, "1", 40, 20, 1);
+
+    /* '1' in the built-in font has its top-middle pixel set */
+    const pb_glyph* g = pb_font_atlas_glyph(&font, '1');
+    ASSERT_NE(g, NULL);
+    int lit = 0;
+    for (int y = 0; y < g->h; y++) {
+        for (int x = 0; x < g->w; x++) {
+            lit += font.pixels[(g->y + y) * PB_FONT_ATLAS_W + g->x + x] != 0;
+        }
+    }
+    ASSERT(lit > 0);
+
+    pb_headless_stats before, after;
+    pb_platform_headless_get_stats(p, &before);
+    p->draw_text(p, atlas, &batch, colors);
+    pb_platform_headless_get_stats(p, &after);
+    ASSERT_EQ(after.draw_calls, before.draw_calls + 1);
+    ASSERT_EQ(after.pixels_written - before.pixels_written, (uint64_t)lit);
+
+    for (int y = 0; y < g->h; y++) {
+        for (int x = 0; x < g->w; x++) {
+            bool on = font.pixels[(g->y + y) * PB_FONT_ATLAS_W + g->x + x] != 0;
+            ASSERT_EQ(pixel_at(p, 40 + x, 20 + y), on ? 0xFF0000FFu : 0x000000FFu);
+        }
+    }
+
+    p->texture_free(p, atlas);
+    close_headless(p);
+}
+
+/*============================================================================
+ * Clock and Input Tests
+ *============================================================================*/
+
+TEST(virtual_clock)
+{
+    pb_platform* p = open_headless(16, 16);
+
+    ASSERT_EQ(p->get_ticks_ms(p), 0u);
+    for (int i = 0; i < 60; i++) {
+        pb_begin_frame(p);
+        pb_end_frame(p);
+    }
+    ASSERT_EQ(p->get_ticks_ms(p), 1000u);
+
+    p->delay(p, 250);
+    ASSERT_EQ(p->get_ticks_ms(p), 1250u);
+
+    pb_headless_stats stats;
+    pb_platform_headless_get_stats(p, &stats);
+    ASSERT_EQ(stats.frames, 60u);
+    ASSERT_EQ(stats.clock_ms, 1250u);
+
+    close_headless(p);
+}
+
+typedef struct stream_probe {
+    int calls;
+    uint64_t frames;
+    int channels;
+} stream_probe;
+
+static void probe_stream(void* userdata, int16_t* out, int frames, int channels)
+{
+    stream_probe* probe = userdata;
+    probe->calls++;
+    probe->frames += (uint64_t)frames;
+    probe->channels = channels;
+    ASSERT_EQ(out[0], 0);
+}
+
+TEST(audio_stream_follows_clock)
+{
+    pb_platform* p = open_headless(16, 16);
+    stream_probe probe = {0};
+
+    /* Opened mid-run: no backlog from earlier frames */
+    pb_begin_frame(p);
+    pb_end_frame(p);
+    int rate = 0, channels = 0;
+    ASSERT_TRUE(p->audio_stream_open(p, probe_stream, &probe, &rate, &channels));
+    ASSERT_EQ(rate, 44100);
+    ASSERT_EQ(channels, 2);
+    ASSERT_FALSE(p->audio_stream_open(p, probe_stream, &probe, NULL, NULL));
+
+    /* A second of frames pulls exactly a second of samples */
+    for (int i = 0; i < 60; i++) {
+        pb_begin_frame(p);
+        pb_end_frame(p);
+    }
+    ASSERT_EQ(probe.frames, 44100u);
+    ASSERT_EQ(probe.channels, 2);
+
+    pb_headless_stats stats;
+    pb_platform_headless_get_stats(p, &stats);
+    ASSERT_EQ(stats.audio_frames, 44100u);
+
+    /* Closed: no more pulls */
+    p->audio_stream_close(p);
+    int calls = probe.calls;
+    pb_begin_frame(p);
+    pb_end_frame(p);
+    ASSERT_EQ(probe.calls, calls);
+
+    close_headless(p);
+}
+
+TEST(scripted_input)
+{
+    static const pb_headless_key_event script[] = {
+        {2, PB_KEY_FIRE, true},
+        {2, PB_KEY_LEFT, true},
+        {4, PB_KEY_FIRE, false},
+        {6, PB_KEY_QUIT, true},
+    };
+    static const pb_headless_key_event unsorted[] = {
+        {3, PB_KEY_FIRE, true},
+        {1, PB_KEY_FIRE, false},
+    };
+
+    pb_platform* p = open_headless(16, 16);
+    ASSERT_EQ(pb_platform_headless_set_script(p, unsorted, 2), PB_ERR_INVALID_ARG);
+    ASSERT_EQ(pb_platform_headless_set_script(p, script, 4), PB_OK);
+
+    pb_input_state input;
+    int frames = 0, fire_pressed = 0, fire_released = 0, fire_held = 0;
+    while (!pb_should_quit(p) && frames < 100) {
+        pb_begin_frame(p);
+        pb_poll_input(p, &input);
+        fire_pressed += input.keys_pressed[PB_KEY_FIRE];
+        fire_released += input.keys_released[PB_KEY_FIRE];
+        fire_held += input.keys[PB_KEY_FIRE];
+        if (frames == 3) {
+            ASSERT_TRUE(input.keys[PB_KEY_LEFT]);
+            ASSERT_FALSE(input.keys_pressed[PB_KEY_LEFT]);
+        }
+        pb_end_frame(p);
+        frames++;
+    }
+
+    ASSERT_EQ(frames, 7);           /* Quit on frame 6 */
+    ASSERT_EQ(fire_pressed, 1);
+    ASSERT_EQ(fire_released, 1);
+    ASSERT_EQ(fire_held, 2);        /* Frames 2 and 3 */
+
+    close_headless(p);
+}
+
+/*============================================================================
+ * Capture Tests
+ *============================================================================*/
+
+TEST(ppm_capture)
+{
+    pb_platform* p = open_headless(4, 2);
+    pb_clear(p, BLACK);
+    p->draw_rect(p, 0, 0, 1, 1, RED);
+
+    static const char header[] = "P6\n4 2\n255\n";
+    size_t header_len = sizeof(header) - 1;
+    size_t size = pb_platform_headless_encode_ppm(p, NULL, 0);
+    ASSERT_EQ(size, header_len + 4 * 2 * 3);
+
+    uint8_t buf[64];
+    ASSERT_EQ(pb_platform_headless_encode_ppm(p, buf, size - 1), 0u);
+    ASSERT_EQ(pb_platform_headless_encode_ppm(p, buf, sizeof(buf)), size);
+    ASSERT_EQ(memcmp(buf, header, header_len), 0);
+    ASSERT_EQ(buf[header_len + 0], 255);
+    ASSERT_EQ(buf[header_len + 1], 0);
+    ASSERT_EQ(buf[header_len + 3], 0);
+
+    /* I/O failure is not an allocation failure */
+    ASSERT_EQ(pb_platform_headless_capture_ppm(p, "no_such_dir/out.ppm"), PB_ERR_INVALID_ARG);
+
+    /* Not initialized, or not headless */
+    pb_shutdown(p);
+    ASSERT_EQ(pb_platform_headless_encode_ppm(p, NULL, 0), 0u);
+    ASSERT_EQ(pb_platform_headless_capture_ppm(p, "unused.ppm"), PB_ERR_INVALID_STATE);
+    pb_platform_free(p);
+
+    pb_platform other = {0};
+    ASSERT_EQ(pb_platform_headless_framebuffer(&other, NULL, NULL), NULL);
+    ASSERT_EQ(pb_platform_headless_set_script(&other, NULL, 0), PB_ERR_INVALID_ARG);
+}
+
+static bool write_file(const char* path, const void* data, size_t size)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, size, f) == size;
+    return fclose(f) == 0 && ok;
+}
+
+TEST(ppm_texture_load)
+{
+    static const char path[] = "test_headless_load.ppm";
+    pb_platform* p = open_headless(4, 4);
+
+    static const char good[] = "P6\n2 1\n255\n\xff\x00\x00\x00\xff\x00";
+    ASSERT_TRUE(write_file(path, good, sizeof(good) - 1));
+    pb_texture tex = p->texture_load(p, path);
+    ASSERT_NE(tex, NULL);
+    p->texture_free(p, tex);
+
+    /* Truncated pixel data */
+    ASSERT_TRUE(write_file(path, good, sizeof(good) - 2));
+    ASSERT_EQ(p->texture_load(p, path), NULL);
+
+    /* Dimensions whose product overflows int, or just too large */
+    static const char huge[] = "P6\n600000 600000\n255\n\xff\xff\xff";
+    ASSERT_TRUE(write_file(path, huge, sizeof(huge) - 1));
+    ASSERT_EQ(p->texture_load(p, path), NULL);
+    static const char wide[] = "P6\n65536 1\n255\n\xff\xff\xff";
+    ASSERT_TRUE(write_file(path, wide, sizeof(wide) - 1));
+    ASSERT_EQ(p->texture_load(p, path), NULL);
+
+    remove(path);
+    close_headless(p);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_platform headless test suite\n");
+    printf("===============================\n\n");
+
+    printf("Framebuffer:\n");
+    RUN(framebuffer_uses_logical_size);
+    RUN(rendering_is_deterministic);
+    RUN(textures_and_text);
+
+    printf("\nClock and input:\n");
+    RUN(virtual_clock);
+    RUN(audio_stream_follows_clock);
+    RUN(scripted_input);
+
+    printf("\nCapture:\n");
+    RUN(ppm_capture);
+    RUN(ppm_texture_load);
+
+    printf("\n===============================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,391 @@
+/*
+ * test_net.c - Tests for pb_net module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_input_event input(pb_input_event_type type, uint32_t frame, float angle)
+{
+    pb_input_event e;
+    e.type = type;
+    e.frame = frame;
+    e.angle = PB_FLOAT_TO_FIXED(angle);
+    return e;
+}
+
+static pb_net_packet sample_packet(void)
+{
+    pb_net_packet p;
+    memset(&p, 0, sizeof(p));
+    p.flags = PB_NET_FLAG_ECHO;
+    p.seq = 300;
+    p.send_ms = 123456;
+    p.echo_ms = 123400;
+    p.echo_hold_ms = 5;
+    p.ack_frames = 77;
+    p.first_frame = 1000;
+    p.end_frame = 1016;
+    p.inputs[p.input_count++] = input(PB_INPUT_ROTATE_LEFT, 1000, 0.0f);
+    p.inputs[p.input_count++] = input(PB_INPUT_FIRE, 1003, 1.25f);
+    p.inputs[p.input_count++] = input(PB_INPUT_SWITCH, 1003, 0.0f);
+    p.inputs[p.input_count++] = input(PB_INPUT_FIRE, 1015, -0.5f);
+    p.checksums[p.checksum_count++] = (pb_net_checksum){1010, 0xDEADBEEFu};
+    p.checksums[p.checksum_count++] = (pb_net_checksum){1009, 0x01234567u};
+    return p;
+}
+
+/*============================================================================
+ * Codec Tests
+ *============================================================================*/
+
+TEST(packet_roundtrip) {
+    pb_net_packet p = sample_packet(), q;
+    uint8_t buf[PB_NET_MAX_PACKET];
+    int len = pb_net_packet_encode(&p, buf, (int)sizeof(buf));
+    ASSERT_TRUE(len > 0);
+    ASSERT_EQ(pb_net_packet_decode(buf, len, &q), PB_OK);
+
+    ASSERT_EQ(q.flags, p.flags);
+    ASSERT_EQ(q.seq, p.seq);
+    ASSERT_EQ(q.send_ms, p.send_ms);
+    ASSERT_EQ(q.echo_ms, p.echo_ms);
+    ASSERT_EQ(q.echo_hold_ms, p.echo_hold_ms);
+    ASSERT_EQ(q.ack_frames, p.ack_frames);
+    ASSERT_EQ(q.first_frame, p.first_frame);
+    ASSERT_EQ(q.end_frame, p.end_frame);
+    ASSERT_EQ(q.input_count, p.input_count);
+    for (int i = 0; i < p.input_count; i++) {
+        ASSERT_EQ(q.inputs[i].type, p.inputs[i].type);
+        ASSERT_EQ(q.inputs[i].frame, p.inputs[i].frame);
+        ASSERT_TRUE(q.inputs[i].angle == p.inputs[i].angle);
+    }
+    ASSERT_EQ(q.checksum_count, 2);
+    ASSERT_EQ(q.checksums[0].frame, 1010u);
+    ASSERT_EQ(q.checksums[0].value, 0xDEADBEEFu);
+
+    /* Fixed-point angles survive to Q16.16 precision */
+    p.flags |= PB_NET_FLAG_FIXED_POINT;
+    len = pb_net_packet_encode(&p, buf, (int)sizeof(buf));
+    ASSERT_EQ(pb_net_packet_decode(buf, len, &q), PB_OK);
+    ASSERT_TRUE(q.inputs[1].angle == p.inputs[1].angle);
+}
+
+TEST(packet_worst_case_fits) {
+    pb_net_packet p;
+    memset(&p, 0, sizeof(p));
+    p.seq = p.send_ms = p.echo_ms = p.echo_hold_ms = UINT32_MAX;
+    p.ack_frames = p.first_frame = 0xF0000000u;
+    p.end_frame = p.first_frame + 0x7FFFFFFFu;
+    p.input_count = PB_NET_PACKET_INPUTS;
+    for (int i = 0; i < p.input_count; i++) {
+        p.inputs[i] = input(PB_INPUT_FIRE, p.first_frame + (uint32_t)i * 0x1000000u, 1.0f);
+    }
+    p.checksum_count = PB_NET_PACKET_CHECKSUMS;
+
+    uint8_t buf[PB_NET_MAX_PACKET];
+    pb_net_packet q;
+    int len = pb_net_packet_encode(&p, buf, (int)sizeof(buf));
+    ASSERT_TRUE(len > 0);
+    ASSERT_EQ(pb_net_packet_decode(buf, len, &q), PB_OK);
+    ASSERT_EQ(q.inputs[39].frame, p.inputs[39].frame);
+}
+
+TEST(packet_rejects_malformed) {
+    pb_net_packet p = sample_packet(), q;
+    uint8_t buf[PB_NET_MAX_PACKET];
+    int len = pb_net_packet_encode(&p, buf, (int)sizeof(buf));
+
+    /* Every truncation fails, as do trailing bytes */
+    for (int cut = 0; cut < len; cut++) {
+        ASSERT_EQ(pb_net_packet_decode(buf, cut, &q), PB_ERR_INVALID_ARG);
+    }
+    buf[len] = 0;
+    ASSERT_EQ(pb_net_packet_decode(buf, len + 1, &q), PB_ERR_INVALID_ARG);
+
+    buf[0] = 'X';
+    ASSERT_EQ(pb_net_packet_decode(buf, len, &q), PB_ERR_INVALID_ARG);
+    buf[0] = 'P';
+    buf[2] = PB_NET_VERSION + 1;
+    ASSERT_EQ(pb_net_packet_decode(buf, len, &q), PB_ERR_INVALID_ARG);
+
+    /* Inputs outside [first, end) cannot be encoded */
+    p.inputs[3].frame = p.end_frame;
+    ASSERT_EQ(pb_net_packet_encode(&p, buf, (int)sizeof(buf)), 0);
+    p = sample_packet();
+    p.inputs[1].frame = 999;
+    ASSERT_EQ(pb_net_packet_encode(&p, buf, (int)sizeof(buf)), 0);
+    p = sample_packet();
+    ASSERT_EQ(pb_net_packet_encode(&p, buf, 8), 0);
+}
+
+/*============================================================================
+ * Input Queue Tests
+ *============================================================================*/
+
+TEST(add_input_validation) {
+    pb_net* net = pb_net_create(NULL);
+    ASSERT_NE(net, NULL);
+
+    pb_input_event e = input(PB_INPUT_FIRE, 5, 1.0f);
+    ASSERT_EQ(pb_net_add_input(net, &e), PB_OK);
+    e.frame = 4;
+    ASSERT_EQ(pb_net_add_input(net, &e), PB_ERR_INVALID_ARG);   /* Out of order */
+
+    pb_net_commit_frame(net, 9);
+    e.frame = 9;
+    ASSERT_EQ(pb_net_add_input(net, &e), PB_ERR_INVALID_ARG);   /* Committed */
+
+    e.frame = 10;
+    for (int i = 0; i < PB_NET_PACKET_INPUTS; i++) {
+        ASSERT_EQ(pb_net_add_input(net, &e), PB_OK);
+    }
+    ASSERT_EQ(pb_net_add_input(net, &e), PB_ERR_NO_MEMORY);     /* Frame full */
+
+    e.type = PB_INPUT_COUNT;
+    e.frame = 11;
+    ASSERT_EQ(pb_net_add_input(net, &e), PB_ERR_INVALID_ARG);
+
+    /* Not bound/connected */
+    ASSERT_EQ(pb_net_send(net, 0), PB_ERR_INVALID_STATE);
+    ASSERT_EQ(pb_net_poll(net, 0), 0);
+    pb_net_destroy(net);
+    pb_net_destroy(NULL);
+
+    pb_net_config config;
+    pb_net_config_default(&config);
+    config.max_frames = 0;
+    ASSERT_EQ(pb_net_create(&config), NULL);
+}
+
+/*============================================================================
+ * Loopback Tests
+ *============================================================================*/
+
+#if PB_FEATURE_NET
+
+#define FRAME_MS 16u
+
+static void open_pair(const pb_net_config* config, pb_net** a, pb_net** b)
+{
+    *a = pb_net_create(config);
+    *b = pb_net_create(config);
+    ASSERT_TRUE(*a && *b);
+    ASSERT_EQ(pb_net_bind(*a, "127.0.0.1", 0), PB_OK);
+    ASSERT_EQ(pb_net_bind(*b, "127.0.0.1", 0), PB_OK);
+    ASSERT_NE(pb_net_local_port(*a), 0);
+    ASSERT_EQ(pb_net_connect(*a, "127.0.0.1", pb_net_local_port(*b)), PB_OK);
+    ASSERT_EQ(pb_net_connect(*b, "127.0.0.1", pb_net_local_port(*a)), PB_OK);
+}
+
+/* Script of A's inputs: a shot every 3rd frame, a switch every 7th */
+static int script_inputs(uint32_t frame, pb_input_event* out)
+{
+    int n = 0;
+    if (frame % 3 == 0) {
+        out[n++] = input(PB_INPUT_FIRE, frame, 0.25f + 0.01f * (float)(frame % 50));
+    }
+    if (frame % 7 == 0) {
+        out[n++] = input(PB_INPUT_SWITCH, frame, 0.0f);
+    }
+    return n;
+}
+
+/*
+ * Run `frames` frames of A sending scripted inputs to B, then keep ticking
+ * until B has every frame. Returns the number of inputs B received, after
+ * checking each against the script.
+ */
+static int relay(pb_net* a, pb_net* b, uint32_t frames)
+{
+    uint32_t now = 0;
+    int expected_inputs = 0, received = 0;
+    pb_input_event expect[2 * 512];
+
+    for (uint32_t f = 0; f < frames; f++) {
+        pb_input_event in[2];
+        int n = script_inputs(f, in);
+        for (int i = 0; i < n; i++) {
+            ASSERT_EQ(pb_net_add_input(a, &in[i]), PB_OK);
+            expect[expected_inputs++] = in[i];
+        }
+    }
+    /* Commit one frame per tick so the window keeps moving */
+    for (int tick = 0; tick < 2000 && pb_net_remote_frames(b) < frames; tick++) {
+        if ((uint32_t)tick < frames) {
+            pb_net_commit_frame(a, (uint32_t)tick);
+        }
+        pb_net_poll(a, now);
+        pb_net_poll(b, now);
+        ASSERT_EQ(pb_net_send(a, now), PB_OK);
+        ASSERT_EQ(pb_net_send(b, now), PB_OK);
+
+        pb_input_event got;
+        while (pb_net_pop_input(b, &got)) {
+            ASSERT_TRUE(received < expected_inputs);
+            ASSERT_EQ(got.type, expect[received].type);
+            ASSERT_EQ(got.frame, expect[received].frame);
+            ASSERT_TRUE(got.frame < pb_net_remote_frames(b));
+            received++;
+        }
+        now += FRAME_MS;
+    }
+    ASSERT_EQ(pb_net_remote_frames(b), frames);
+    ASSERT_EQ(received, expected_inputs);
+    return received;
+}
+
+TEST(loopback_relay) {
+    pb_net *a, *b;
+    open_pair(NULL, &a, &b);
+    ASSERT_TRUE(relay(a, b, 60) > 0);
+
+    /* Let B's acks land */
+    pb_net_send(b, 5000);
+    pb_net_poll(a, 5000);
+    ASSERT_EQ(pb_net_acked_frames(a), 60u);
+
+    pb_net_stats stats;
+    pb_net_get_stats(b, &stats);
+    ASSERT_EQ(stats.packets_lost, 0u);
+    ASSERT_EQ(stats.packets_invalid, 0u);
+    ASSERT_EQ(stats.sim_dropped, 0u);
+    pb_net_destroy(a);
+    pb_net_destroy(b);
+}
+
+TEST(loopback_survives_loss) {
+    pb_net_config config;
+    pb_net_config_default(&config);
+    config.sim_loss_permille = 300;
+    config.sim_latency_ms = 40;
+    config.sim_jitter_ms = 30;
+    config.sim_seed = 84;
+
+    pb_net *a, *b;
+    open_pair(&config, &a, &b);
+    relay(a, b, 300);
+
+    pb_net_stats sa, sb;
+    pb_net_get_stats(a, &sa);
+    pb_net_get_stats(b, &sb);
+    ASSERT_TRUE(sa.sim_dropped > 0);
+    ASSERT_TRUE(sb.packets_lost > 0);
+    ASSERT_TRUE(sb.jitter_ms > 0.0f);
+    ASSERT_TRUE(sa.rtt_ms >= 80.0f);            /* Two simulated latencies */
+    ASSERT_TRUE(sb.delay_frames >= 3);
+    ASSERT_FALSE(pb_net_desync(b, NULL));
+    pb_net_destroy(a);
+    pb_net_destroy(b);
+}
+
+TEST(loopback_window_slides) {
+    /* A window of two frames must still catch up on a long backlog */
+    pb_net_config config;
+    pb_net_config_default(&config);
+    config.max_frames = 2;
+    config.sim_loss_permille = 200;
+    config.use_fixed_point = true;
+
+    pb_net *a, *b;
+    open_pair(&config, &a, &b);
+    relay(a, b, 120);
+    pb_net_destroy(a);
+    pb_net_destroy(b);
+}
+
+TEST(loopback_desync_detected) {
+    pb_net *a, *b;
+    open_pair(NULL, &a, &b);
+
+    uint32_t now = 0;
+    for (uint32_t f = 0; f < 10; f++) {
+        pb_net_add_checksum(a, f, 0x1000u + f);
+        pb_net_add_checksum(b, f, f == 7 ? 0xBADu : 0x1000u + f);
+        pb_net_send(a, now);
+        pb_net_send(b, now);
+        pb_net_poll(a, now);
+        pb_net_poll(b, now);
+        ASSERT_EQ(pb_net_desync(a, NULL), f >= 7);
+        now += FRAME_MS;
+    }
+
+    pb_desync_info info;
+    ASSERT_TRUE(pb_net_desync(a, &info));
+    ASSERT_EQ(info.frame, 7u);
+    ASSERT_EQ(info.expected, 0x1007u);
+    ASSERT_EQ(info.actual, 0xBADu);
+    ASSERT_TRUE(pb_net_desync(b, &info));
+    ASSERT_EQ(info.expected, 0xBADu);
+    pb_net_destroy(a);
+    pb_net_destroy(b);
+}
+
+#endif /* PB_FEATURE_NET */
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_net test suite\n");
+    printf("=================\n\n");
+
+    printf("Codec:\n");
+    RUN(packet_roundtrip);
+    RUN(packet_worst_case_fits);
+    RUN(packet_rejects_malformed);
+
+    printf("\nInput queue:\n");
+    RUN(add_input_validation);
+
+#if PB_FEATURE_NET
+    printf("\nLoopback:\n");
+    RUN(loopback_relay);
+    RUN(loopback_survives_loss);
+    RUN(loopback_window_slides);
+    RUN(loopback_desync_detected);
+#endif
+
+    printf("\n=================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
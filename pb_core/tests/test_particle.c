@@ -0,0 +1,338 @@
+/*
+ * test_particle.c - Tests for pb_particle module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+#define ASSERT_NEAR(a, b, eps) ASSERT(fabsf((float)(a) - (float)(b)) <= (eps))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+/* Screen position of a cell under the default mapping */
+static void cell_center(pb_offset cell, float* x, float* y)
+{
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+    pb_point p = pb_offset_to_pixel(cell, PB_FLOAT_TO_FIXED(cfg.bubble_radius));
+    *x = cfg.origin_x + PB_FIXED_TO_FLOAT(p.x);
+    *y = cfg.origin_y + PB_FIXED_TO_FLOAT(p.y);
+}
+
+/*============================================================================
+ * Pool Tests
+ *============================================================================*/
+
+TEST(create_validates_config) {
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+
+    cfg.capacity = 0;
+    ASSERT_EQ(pb_particles_create(&cfg), NULL);
+    cfg.capacity = 10;
+    cfg.per_pop = PB_PARTICLE_MAX_BURST + 1;
+    ASSERT_EQ(pb_particles_create(&cfg), NULL);
+    cfg.per_pop = 6;
+    cfg.view_max_x = cfg.view_min_x;
+    ASSERT_EQ(pb_particles_create(&cfg), NULL);
+    cfg.view_max_x = 256.0f;
+
+    /* Capacity rounds up to whole update blocks */
+    pb_particles* p = pb_particles_create(&cfg);
+    ASSERT_NE(p, NULL);
+    pb_particle_stats stats;
+    pb_particles_get_stats(p, &stats);
+    ASSERT_EQ(stats.capacity, 12);
+    ASSERT_EQ(stats.active, 0);
+    pb_particles_destroy(p);
+
+    p = pb_particles_create(NULL);
+    ASSERT_NE(p, NULL);
+    pb_particles_destroy(p);
+}
+
+TEST(burst_spawns_at_cell) {
+    pb_particles* p = pb_particles_create(NULL);
+    pb_offset cell = {3, 2};
+    float cx, cy;
+    cell_center(cell, &cx, &cy);
+
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_BUBBLES_POPPED, cell, 4), 6);
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_BUBBLES_DROPPED, cell, 1), 2);
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_FIRE, cell, 1), 0);
+
+    pb_particle_view view = pb_particles_view(p);
+    ASSERT_EQ(view.count, 8);
+    for (int i = 0; i < view.count; i++) {
+        ASSERT_NEAR(view.x[i], cx, 0.01f);
+        ASSERT_NEAR(view.y[i], cy, 0.01f);
+        ASSERT_TRUE(view.life[i] > 0.0f);
+        ASSERT_EQ(view.palette[i], PB_PAL_BUBBLE_RED + (i < 6 ? 4 : 1));
+    }
+    pb_particles_destroy(p);
+}
+
+TEST(full_pool_rejects) {
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+    cfg.capacity = 8;
+    pb_particles* p = pb_particles_create(&cfg);
+
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_BUBBLES_POPPED, (pb_offset){0, 0}, 0), 6);
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_BUBBLES_POPPED, (pb_offset){0, 1}, 0), 2);
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_BUBBLES_POPPED, (pb_offset){0, 2}, 0), 0);
+
+    pb_particle_stats stats;
+    pb_particles_get_stats(p, &stats);
+    ASSERT_EQ(stats.active, 8);
+    ASSERT_EQ(stats.spawned, 8u);
+    ASSERT_EQ(stats.rejected, 10u);
+
+    pb_particles_clear(p);
+    ASSERT_EQ(pb_particles_view(p).count, 0);
+    ASSERT_EQ(pb_particles_burst(p, PB_EVENT_BUBBLES_DROPPED, (pb_offset){0, 0}, 0), 2);
+    pb_particles_destroy(p);
+}
+
+/*============================================================================
+ * Update Tests
+ *============================================================================*/
+
+TEST(update_integrates) {
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+    cfg.per_drop = 1;
+    cfg.life_drop = 1000.0f;
+    cfg.view_max_y = 10000.0f;
+    pb_particles* p = pb_particles_create(&cfg);
+
+    pb_particles_burst(p, PB_EVENT_BUBBLES_DROPPED, (pb_offset){0, 3}, 0);
+    pb_particle_view view = pb_particles_view(p);
+    float x = view.x[0], y = view.y[0];
+    float vx, vy;
+
+    /* Recover the spawn velocity from one step, then follow the recurrence */
+    float damp = 1.0f - cfg.drag;
+    pb_particles_update(p, 1.0f);
+    view = pb_particles_view(p);
+    vx = view.x[0] - x;
+    vy = view.y[0] - y;
+    x = view.x[0];
+    y = view.y[0];
+    for (int step = 0; step < 20; step++) {
+        vx *= damp;
+        vy = vy * damp + cfg.gravity;
+        x += vx;
+        y += vy;
+        pb_particles_update(p, 1.0f);
+    }
+    view = pb_particles_view(p);
+    ASSERT_EQ(view.count, 1);
+    ASSERT_NEAR(view.x[0], x, 0.01f);
+    ASSERT_NEAR(view.y[0], y, 0.01f);
+    ASSERT_TRUE(vy > 0.0f);
+    pb_particles_destroy(p);
+}
+
+TEST(update_expires_and_culls) {
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+    cfg.life_pop = 4.0f;
+    cfg.life_drop = 10000.0f;
+    cfg.drop_speed = 4.0f;
+    pb_particles* p = pb_particles_create(&cfg);
+
+    /* Interleave short-lived pops with long-lived drops across blocks */
+    for (int col = 0; col < 5; col++) {
+        pb_particles_burst(p, PB_EVENT_BUBBLES_POPPED, (pb_offset){1, col}, 2);
+        pb_particles_burst(p, PB_EVENT_BUBBLES_DROPPED, (pb_offset){1, col}, 5);
+    }
+    ASSERT_EQ(pb_particles_view(p).count, 40);
+
+    for (int f = 0; f < 6; f++) pb_particles_update(p, 1.0f);
+
+    pb_particle_stats stats;
+    pb_particles_get_stats(p, &stats);
+    ASSERT_EQ(stats.active, 10);
+    ASSERT_EQ(stats.expired, 30u);
+
+    /* Survivors are the drops, still in spawn (column) order */
+    pb_particle_view view = pb_particles_view(p);
+    for (int i = 0; i < view.count; i++) {
+        ASSERT_EQ(view.palette[i], PB_PAL_BUBBLE_RED + 5);
+        if (i >= 2) ASSERT_TRUE(view.x[i] > view.x[i - 2] - 2.0f);
+    }
+
+    /* Drops fall out of the bottom of the view */
+    for (int f = 0; f < 200; f++) pb_particles_update(p, 1.0f);
+    pb_particles_get_stats(p, &stats);
+    ASSERT_EQ(stats.active, 0);
+    ASSERT_EQ(stats.culled, 10u);
+    pb_particles_destroy(p);
+}
+
+TEST(cascade_stays_bounded) {
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+    cfg.capacity = 256;
+    pb_particles* p = pb_particles_create(&cfg);
+
+    pb_particle_stats stats;
+    for (int frame = 0; frame < 300; frame++) {
+        for (int col = 0; col < 8; col++) {
+            pb_particles_burst(p, (frame & 1) ? PB_EVENT_BUBBLES_DROPPED
+                                              : PB_EVENT_BUBBLES_POPPED,
+                               (pb_offset){frame % 12, col}, (uint8_t)(col % 8));
+        }
+        pb_particles_update(p, 1.0f);
+        pb_particles_get_stats(p, &stats);
+        ASSERT_TRUE(stats.active <= stats.capacity);
+
+        /* Everything left is alive and inside the view */
+        pb_particle_view view = pb_particles_view(p);
+        for (int i = 0; i < view.count; i++) {
+            ASSERT_TRUE(view.life[i] > 0.0f);
+            ASSERT_TRUE(view.x[i] >= cfg.view_min_x && view.x[i] < cfg.view_max_x);
+            ASSERT_TRUE(view.y[i] >= cfg.view_min_y && view.y[i] < cfg.view_max_y);
+        }
+    }
+    ASSERT_EQ(stats.spawned, (uint32_t)stats.active + stats.expired + stats.culled);
+    ASSERT_TRUE(stats.rejected > 0);
+    pb_particles_destroy(p);
+}
+
+/*============================================================================
+ * Event and Render Tests
+ *============================================================================*/
+
+TEST(attach_spawns_from_game) {
+    pb_game_state game;
+    pb_game_init(&game, NULL, 0);
+    pb_particles* p = pb_particles_create(NULL);
+
+    ASSERT_EQ(pb_particles_attach(p, &game), PB_OK);
+    ASSERT_EQ(pb_particles_attach(p, &game), PB_ERR_INVALID_STATE);
+
+    for (int col = 0; col < 3; col++) {
+        pb_board_set(&game.board, (pb_offset){0, col}, colored(3));
+    }
+    pb_board_set(&game.board, (pb_offset){1, 0}, colored(6));
+    ASSERT_EQ(pb_game_process_matches(&game, (pb_offset){0, 1}), 3);
+
+    pb_particle_view view = pb_particles_view(p);
+    ASSERT_EQ(view.count, 18);
+    for (int i = 0; i < view.count; i++) {
+        ASSERT_EQ(view.palette[i], PB_PAL_BUBBLE_RED + 3);
+    }
+
+    /* The hanging bubble drops in its own color */
+    pb_game_process_orphans(&game);
+    view = pb_particles_view(p);
+    ASSERT_EQ(view.count, 20);
+    ASSERT_EQ(view.palette[19], PB_PAL_BUBBLE_RED + 6);
+
+    pb_particles_detach(p, &game);
+    pb_event evt = {0};
+    evt.type = PB_EVENT_BUBBLES_POPPED;
+    evt.data.popped.count = 1;
+    pb_game_add_event(&game, &evt);
+    ASSERT_EQ(pb_particles_view(p).count, 20);
+    pb_particles_destroy(p);
+}
+
+TEST(build_batch_centers_sprites) {
+    uint8_t pixels[9] = {0, 1, 0, 1, 1, 1, 0, 1, 0};
+    pb_indexed_sprite sprite = {pixels, 3, 3, 0, false};
+    pb_particle_config cfg;
+    pb_particle_config_default(&cfg);
+    cfg.sprite = &sprite;
+    cfg.palette_base = PB_PAL_EFFECT_START;
+    pb_particles* p = pb_particles_create(&cfg);
+
+    pb_offset cell = {2, 4};
+    float cx, cy;
+    cell_center(cell, &cx, &cy);
+    pb_particles_burst(p, PB_EVENT_BUBBLES_POPPED, cell, 2);
+
+    const pb_indexed_sprite_instance* batch = NULL;
+    int n = pb_particles_build_batch(p, &batch);
+    ASSERT_EQ(n, 6);
+    ASSERT_NE(batch, NULL);
+    for (int i = 0; i < n; i++) {
+        ASSERT_EQ(batch[i].sprite, &sprite);
+        ASSERT_EQ(batch[i].x, (int)floorf(cx) - 1);
+        ASSERT_EQ(batch[i].y, (int)floorf(cy) - 1);
+        ASSERT_EQ(batch[i].layer, cfg.layer);
+        ASSERT_EQ(batch[i].palette_offset, PB_PAL_EFFECT_START + 2);
+    }
+    pb_particles_destroy(p);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_particle test suite\n");
+    printf("======================\n\n");
+
+    printf("Pool:\n");
+    RUN(create_validates_config);
+    RUN(burst_spawns_at_cell);
+    RUN(full_pool_rejects);
+
+    printf("\nUpdate:\n");
+    RUN(update_integrates);
+    RUN(update_expires_and_culls);
+    RUN(cascade_stays_bounded);
+
+    printf("\nEvents and rendering:\n");
+    RUN(attach_spawns_from_game);
+    RUN(build_batch_centers_sprites);
+
+    printf("\n======================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
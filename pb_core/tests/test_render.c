@@ -0,0 +1,468 @@
+/*
+ * test_render.c - Tests for pb_render module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+/* Palette whose entry i is (i, 255 - i, i / 2) */
+static void ramp_palette(pb_palette* pal)
+{
+    memset(pal, 0, sizeof(*pal));
+    for (int i = 0; i < PB_PALETTE_SIZE; i++) {
+        pal->colors[i].r = (uint8_t)i;
+        pal->colors[i].g = (uint8_t)(255 - i);
+        pal->colors[i].b = (uint8_t)(i / 2);
+    }
+}
+
+static pb_render_context* make_context(void)
+{
+    pb_render_config config = {64, 32, 1, false, true, PB_DITHER_NONE};
+    return pb_render_create(&config);
+}
+
+/*============================================================================
+ * Palette Cycling Tests
+ *============================================================================*/
+
+TEST(cycle_offsets) {
+    pb_palette_cycle fwd = {PB_PAL_EFFECT_START, 4, PB_CYCLE_FORWARD, 3, 10};
+    ASSERT_EQ(pb_palette_cycle_offset(&fwd, 0), 0);     /* Before start */
+    ASSERT_EQ(pb_palette_cycle_offset(&fwd, 12), 0);
+    ASSERT_EQ(pb_palette_cycle_offset(&fwd, 13), 1);
+    ASSERT_EQ(pb_palette_cycle_offset(&fwd, 10 + 3 * 5), 1);
+
+    pb_palette_cycle rev = fwd;
+    rev.mode = PB_CYCLE_REVERSE;
+    ASSERT_EQ(pb_palette_cycle_offset(&rev, 13), 3);
+    ASSERT_EQ(pb_palette_cycle_offset(&rev, 16), 2);
+
+    /* Ping-pong over 4 entries: 0 1 2 3 2 1 0 1 ... */
+    pb_palette_cycle pp = {0, 4, PB_CYCLE_PINGPONG, 1, 0};
+    const int expect[] = {0, 1, 2, 3, 2, 1, 0, 1, 2};
+    for (uint32_t f = 0; f < 9; f++) {
+        ASSERT_EQ(pb_palette_cycle_offset(&pp, f), expect[f]);
+    }
+
+    pb_palette_cycle bad = {250, 8, PB_CYCLE_FORWARD, 1, 0};
+    ASSERT_EQ(pb_palette_cycle_offset(&bad, 5), 0);
+}
+
+TEST(cycle_apply_rotates_ranges) {
+    pb_palette base, out;
+    ramp_palette(&base);
+
+    pb_palette_cycle cycles[2] = {
+        {PB_PAL_EFFECT_START, 4, PB_CYCLE_FORWARD, 1, 0},
+        {PB_PAL_UI_WARNING, 2, PB_CYCLE_PINGPONG, 8, 0},     /* Flash */
+    };
+    pb_palette_cycle_apply(&base, cycles, 2, 1, &out);
+
+    /* Forward by one: each color moved up an index, the last wrapped */
+    ASSERT_EQ(out.colors[PB_PAL_EFFECT_START + 1].r, PB_PAL_EFFECT_START);
+    ASSERT_EQ(out.colors[PB_PAL_EFFECT_START].r, PB_PAL_EFFECT_START + 3);
+    ASSERT_EQ(out.colors[PB_PAL_EFFECT_START + 4].r, PB_PAL_EFFECT_START + 4);
+    ASSERT_EQ(out.colors[0].g, 255);
+
+    /* The flash alternates every 8 frames */
+    ASSERT_EQ(out.colors[PB_PAL_UI_WARNING].r, PB_PAL_UI_WARNING);
+    pb_palette_cycle_apply(&base, cycles, 2, 8, &out);
+    ASSERT_EQ(out.colors[PB_PAL_UI_WARNING].r, PB_PAL_UI_WARNING + 1);
+    pb_palette_cycle_apply(&base, cycles, 2, 16, &out);
+    ASSERT_EQ(out.colors[PB_PAL_UI_WARNING].r, PB_PAL_UI_WARNING);
+
+    /* A full revolution is the identity */
+    pb_palette_cycle_apply(&base, cycles, 1, 4, &out);
+    ASSERT_EQ(memcmp(&out, &base, sizeof(base)), 0);
+}
+
+/*============================================================================
+ * Render Context Tests
+ *============================================================================*/
+
+TEST(context_lifecycle) {
+    pb_render_config bad = {0, 32, 1, false, true, PB_DITHER_NONE};
+    ASSERT_EQ(pb_render_create(&bad), NULL);
+    ASSERT_EQ(pb_render_create(NULL), NULL);
+
+    pb_render_context* ctx = make_context();
+    ASSERT_NE(ctx, NULL);
+    ASSERT_EQ(pb_render_get_config(ctx)->width, 64);
+    ASSERT_EQ(pb_render_get_frame(ctx), 0u);
+
+    pb_render_begin_frame(ctx);
+    pb_render_clear(ctx, 7);
+    pb_render_end_frame(ctx);
+    ASSERT_EQ(pb_render_get_framebuffer(ctx)[64 * 32 - 1], 7);
+    ASSERT_EQ(pb_render_get_stats(ctx).pixels_filled, 64 * 32);
+    ASSERT_EQ(pb_render_get_frame(ctx), 1u);
+    pb_render_destroy(ctx);
+}
+
+TEST(context_cycles_palette_only) {
+    pb_render_context* ctx = make_context();
+    pb_palette base;
+    ramp_palette(&base);
+    pb_render_set_palette(ctx, &base);
+
+    pb_palette_cycle shimmer = {PB_PAL_BUBBLE_RED, 8, PB_CYCLE_FORWARD, 4, 0};
+    int id = pb_render_add_palette_cycle(ctx, &shimmer);
+    ASSERT_TRUE(id >= 0);
+
+    pb_render_begin_frame(ctx);
+    pb_render_clear(ctx, PB_PAL_BUBBLE_RED);
+    uint32_t version = pb_render_palette_version(ctx);
+
+    /* Frames 2 and 3 stay on the same step: no new palette */
+    pb_render_begin_frame(ctx);
+    pb_render_begin_frame(ctx);
+    ASSERT_EQ(pb_render_palette_version(ctx), version);
+
+    pb_render_begin_frame(ctx);     /* Frame 4: one step */
+    ASSERT_EQ(pb_render_palette_version(ctx), version + 1);
+    const pb_palette* shown = pb_render_get_display_palette(ctx);
+    ASSERT_EQ(shown->colors[PB_PAL_BUBBLE_RED].r, PB_PAL_BUBBLE_RED + 7);
+    ASSERT_EQ(pb_render_get_framebuffer(ctx)[0], PB_PAL_BUBBLE_RED);
+
+    /* Removing the cycle restores the base colors */
+    pb_render_remove_palette_cycle(ctx, id);
+    pb_render_begin_frame(ctx);
+    ASSERT_EQ(memcmp(pb_render_get_display_palette(ctx), &base, sizeof(base)), 0);
+
+    /* Invalid ranges and exhausted slots */
+    pb_palette_cycle bad = {0, 1, PB_CYCLE_FORWARD, 1, 0};
+    ASSERT_EQ(pb_render_add_palette_cycle(ctx, &bad), -1);
+    for (int i = 0; i < PB_MAX_PALETTE_CYCLES; i++) {
+        ASSERT_TRUE(pb_render_add_palette_cycle(ctx, &shimmer) >= 0);
+    }
+    ASSERT_EQ(pb_render_add_palette_cycle(ctx, &shimmer), -1);
+    pb_render_destroy(ctx);
+}
+
+/*============================================================================
+ * Dithering Tests
+ *============================================================================*/
+
+static const pb_dither_type all_dithers[] = {
+    PB_DITHER_NONE, PB_DITHER_BAYER2X2, PB_DITHER_BAYER4X4, PB_DITHER_BAYER8X8,
+    PB_DITHER_ORDERED, PB_DITHER_HALFTONE, PB_DITHER_CHECKERBOARD, PB_DITHER_NOISE,
+};
+#define DITHER_COUNT ((int)(sizeof(all_dithers) / sizeof(all_dithers[0])))
+
+static pb_scalar level_blend(int level)
+{
+    return PB_FIXED_DIV(PB_INT_TO_FIXED(level), PB_INT_TO_FIXED(PB_DITHER_LEVELS));
+}
+
+TEST(dither_levels) {
+    ASSERT_EQ(pb_dither_level(PB_INT_TO_FIXED(0)), 0);
+    ASSERT_EQ(pb_dither_level(PB_INT_TO_FIXED(1)), PB_DITHER_LEVELS);
+    ASSERT_EQ(pb_dither_level(PB_FLOAT_TO_FIXED(0.5f)), PB_DITHER_LEVELS / 2);
+    ASSERT_EQ(pb_dither_level(PB_FLOAT_TO_FIXED(-0.5f)), 0);
+    ASSERT_EQ(pb_dither_level(PB_FLOAT_TO_FIXED(1.5f)), PB_DITHER_LEVELS);
+
+    /* Bayer 8x8 sets exactly `level` pixels of its tile, growing monotonically */
+    uint8_t prev[8] = {0};
+    for (int level = 0; level <= PB_DITHER_LEVELS; level++) {
+        int set = 0;
+        for (int y = 0; y < 8; y++) {
+            uint8_t m = pb_dither_mask(PB_DITHER_BAYER8X8, level, 0, y);
+            ASSERT_EQ(m & prev[y], prev[y]);
+            prev[y] = m;
+            for (int i = 0; i < 8; i++) set += (m >> i) & 1;
+        }
+        ASSERT_EQ(set, level);
+    }
+
+    /* Endpoints are solid for every pattern */
+    for (int t = 0; t < DITHER_COUNT; t++) {
+        for (int y = 0; y < 8; y++) {
+            ASSERT_EQ(pb_dither_mask(all_dithers[t], 0, 3, y), 0);
+            ASSERT_EQ(pb_dither_mask(all_dithers[t], PB_DITHER_LEVELS, 3, y), 0xFF);
+        }
+    }
+}
+
+TEST(dither_span_matches_per_pixel) {
+    uint8_t buf[64];
+    for (int t = 0; t < DITHER_COUNT; t++) {
+        pb_dither_type type = all_dithers[t];
+        for (int level = 0; level <= PB_DITHER_LEVELS; level += 5) {
+            pb_scalar blend = level_blend(level);
+            for (int x = -9; x < 12; x += 3) {
+                for (int width = 0; width < 40; width += 7) {
+                    int y = x * 3 + width;
+                    memset(buf, 0xEE, sizeof(buf));
+                    pb_dither_span(buf + 4, x, y, width, 10, 20, level, type);
+
+                    for (int i = 0; i < width; i++) {
+                        ASSERT_EQ(buf[4 + i], pb_dither_blend(x + i, y, 10, 20, blend, type));
+                    }
+                    /* Nothing outside the span is touched */
+                    for (int i = 0; i < 4; i++) ASSERT_EQ(buf[i], 0xEE);
+                    for (int i = 4 + width; i < (int)sizeof(buf); i++) ASSERT_EQ(buf[i], 0xEE);
+                }
+            }
+        }
+    }
+}
+
+TEST(dither_rect_and_gradient) {
+    pb_render_context* ctx = make_context();
+    const uint8_t* fb = pb_render_get_framebuffer(ctx);
+
+    /* Clipped rect: only the on-screen part is written */
+    pb_render_begin_frame(ctx);
+    pb_render_clear(ctx, 0);
+    pb_render_dither_rect(ctx, -4, 30, 10, 8, 1, 2, PB_FLOAT_TO_FIXED(0.5f),
+                          PB_DITHER_CHECKERBOARD);
+    ASSERT_EQ(pb_render_get_stats(ctx).pixels_filled, 64 * 32 + 6 * 2);
+    ASSERT_EQ(fb[30 * 64 + 0], 2);
+    ASSERT_EQ(fb[30 * 64 + 1], 1);
+    ASSERT_EQ(fb[31 * 64 + 0], 1);
+    ASSERT_EQ(fb[30 * 64 + 6], 0);
+    ASSERT_EQ(fb[29 * 64 + 0], 0);
+
+    /* Gradient: solid ends, a mix in between */
+    pb_render_background_gradient(ctx, 5, 9, PB_DITHER_BAYER4X4);
+    int mid_top = 0;
+    for (int x = 0; x < 64; x++) {
+        ASSERT_EQ(fb[x], 5);
+        ASSERT_EQ(fb[31 * 64 + x], 9);
+        uint8_t c = fb[16 * 64 + x];
+        ASSERT_TRUE(c == 5 || c == 9);
+        mid_top += (c == 5);
+    }
+    ASSERT_TRUE(mid_top > 16 && mid_top < 48);
+    pb_render_destroy(ctx);
+}
+
+TEST(shaded_bubble) {
+    pb_render_config config = {64, 32, 1, false, true, PB_DITHER_BAYER8X8};
+    pb_render_context* ctx = pb_render_create(&config);
+    const uint8_t* fb = pb_render_get_framebuffer(ctx);
+    const uint8_t base = PB_PAL_BUBBLE_RED;
+
+    pb_render_begin_frame(ctx);
+    pb_render_clear(ctx, 0);
+    pb_render_bubble(ctx, 20, 15, 10, base);
+
+    ASSERT_EQ(fb[5 * 64 + 20], base + 1);       /* Top: highlight */
+    ASSERT_EQ(fb[15 * 64 + 20], base);          /* Middle: base */
+    ASSERT_EQ(fb[25 * 64 + 20], base + 2);      /* Bottom: shadow */
+    ASSERT_EQ(fb[15 * 64 + 10], base);          /* Left edge */
+    ASSERT_EQ(fb[15 * 64 + 9], 0);              /* Outside */
+    ASSERT_EQ(fb[6 * 64 + 12], 0);              /* Outside, near a corner */
+
+    /* Upper rows only mix highlight and base, lower rows base and shadow */
+    for (int y = 5; y <= 25; y++) {
+        for (int x = 10; x <= 30; x++) {
+            uint8_t c = fb[y * 64 + x];
+            if (c == 0) continue;
+            if (y < 15) ASSERT_TRUE(c == base || c == base + 1);
+            else ASSERT_TRUE(c == base || c == base + 2);
+        }
+    }
+
+    /* Clipped at the screen edge without touching other rows */
+    pb_render_bubble(ctx, 62, 30, 6, base);
+    ASSERT_EQ(fb[31 * 64 + 63], base);
+    pb_render_destroy(ctx);
+}
+
+/*============================================================================
+ * Sprite Tests
+ *============================================================================*/
+
+/* 3x2 sprite with one transparent pixel:
+ *   1 2 3
+ *   4 0 6 */
+static uint8_t sprite_pixels[6] = {1, 2, 3, 4, 0, 6};
+
+TEST(sprite_flags_and_transparency) {
+    pb_render_context* ctx = make_context();
+    const uint8_t* fb = pb_render_get_framebuffer(ctx);
+    pb_indexed_sprite spr = {sprite_pixels, 3, 2, 0, false};
+    ASSERT_FALSE(pb_indexed_sprite_mark_opaque(&spr));
+
+    pb_render_clear(ctx, 9);
+    pb_indexed_sprite_instance inst = {&spr, 10, 4, 0, 0, 0};
+    pb_render_indexed_sprite(ctx, &inst);
+    ASSERT_EQ(fb[4 * 64 + 10], 1);
+    ASSERT_EQ(fb[5 * 64 + 12], 6);
+    ASSERT_EQ(fb[5 * 64 + 11], 9);              /* Transparent */
+
+    inst.flags = PB_SPRITE_FLIP_H;
+    inst.palette_offset = 20;
+    pb_render_indexed_sprite(ctx, &inst);
+    ASSERT_EQ(fb[4 * 64 + 10], 23);
+    ASSERT_EQ(fb[5 * 64 + 12], 24);
+
+    /* Quarter turn clockwise: 2 wide, 3 tall, bottom-left to top-left */
+    pb_render_clear(ctx, 9);
+    inst.flags = PB_SPRITE_ROTATE_90;
+    inst.palette_offset = 0;
+    pb_render_indexed_sprite(ctx, &inst);
+    ASSERT_EQ(fb[4 * 64 + 10], 4);
+    ASSERT_EQ(fb[4 * 64 + 11], 1);
+    ASSERT_EQ(fb[6 * 64 + 10], 6);
+    ASSERT_EQ(fb[6 * 64 + 11], 3);
+    ASSERT_EQ(fb[5 * 64 + 10], 9);              /* Transparent */
+
+    /* Hidden draws nothing; clipped sprites stay on screen */
+    pb_render_clear(ctx, 9);
+    inst.flags = PB_SPRITE_HIDDEN;
+    pb_render_indexed_sprite(ctx, &inst);
+    ASSERT_EQ(fb[4 * 64 + 10], 9);
+    inst = (pb_indexed_sprite_instance){&spr, -2, 31, 0, 0, 0};
+    pb_render_indexed_sprite(ctx, &inst);
+    ASSERT_EQ(fb[31 * 64 + 0], 3);
+    ASSERT_EQ(fb[30 * 64 + 0], 9);
+
+    pb_render_stats stats = pb_render_get_stats(ctx);
+    ASSERT_EQ(stats.sprites_drawn, 4);
+    pb_render_destroy(ctx);
+}
+
+TEST(sprite_batch_layers) {
+    pb_render_context* ctx = make_context();
+    const uint8_t* fb = pb_render_get_framebuffer(ctx);
+    uint8_t pixels[3][4];
+    pb_indexed_sprite spr[3];
+    for (int i = 0; i < 3; i++) {
+        memset(pixels[i], 10 + i, sizeof(pixels[i]));
+        spr[i] = (pb_indexed_sprite){pixels[i], 2, 2, 0, false};
+    }
+
+    /* Submitted top-down: the batch still draws back to front */
+    pb_indexed_sprite_instance batch[] = {
+        {&spr[2], 4, 4, 5, 0, 0},
+        {&spr[0], 4, 4, 1, 0, 0},
+        {&spr[1], 5, 4, 3, 0, 0},
+        {&spr[0], 20, 4, 2, PB_SPRITE_PRIORITY, 0},
+        {&spr[2], 20, 4, 7, 0, 0},
+        {&spr[0], 30, 4, 4, 0, 0},        /* Same layer: later wins */
+        {&spr[1], 30, 4, 4, 0, 0},
+        {&spr[2], 40, 4, 99, 0, 0},       /* Clamped to the top layer */
+        {&spr[0], 40, 4, PB_MAX_LAYERS - 1, 0, 0},
+    };
+    pb_render_begin_frame(ctx);
+    pb_render_clear(ctx, 0);
+    pb_render_indexed_sprite_batch(ctx, batch, (int)(sizeof(batch) / sizeof(batch[0])));
+
+    ASSERT_EQ(fb[4 * 64 + 4], 12);
+    ASSERT_EQ(fb[4 * 64 + 5], 12);
+    ASSERT_EQ(fb[4 * 64 + 6], 11);
+    ASSERT_EQ(fb[4 * 64 + 20], 10);
+    ASSERT_EQ(fb[4 * 64 + 30], 11);
+    ASSERT_EQ(fb[4 * 64 + 40], 10);
+
+    pb_render_stats stats = pb_render_get_stats(ctx);
+    ASSERT_EQ(stats.sprites_drawn, 9);
+    ASSERT_EQ(stats.draw_calls, 2);
+
+    /* Layer parallax moves every sprite on the layer */
+    pb_layer_config layer = {3, PB_FLOAT_TO_FIXED(1.0f), 0, 255};
+    pb_render_set_layer(ctx, 1, &layer);
+    pb_render_clear(ctx, 0);
+    pb_render_indexed_sprite_batch(ctx, &batch[1], 1);
+    ASSERT_EQ(fb[4 * 64 + 4], 0);
+    ASSERT_EQ(fb[7 * 64 + 4], 10);
+    pb_render_destroy(ctx);
+}
+
+TEST(sprite_opaque_fast_path) {
+    pb_render_context* fast = make_context();
+    pb_render_context* slow = make_context();
+    uint8_t pixels[7 * 5];
+    for (int i = 0; i < (int)sizeof(pixels); i++) pixels[i] = (uint8_t)(i + 1);
+    pb_indexed_sprite opaque = {pixels, 7, 5, 0, false};
+    pb_indexed_sprite keyed = opaque;
+    ASSERT_TRUE(pb_indexed_sprite_mark_opaque(&opaque));
+    keyed.opaque = false;
+
+    /* Row copies match the per-pixel path, clipped on every side */
+    static const int pos[][2] = {{3, 3}, {-4, -2}, {60, 30}, {-10, 0}, {64, 5}};
+    for (int i = 0; i < 5; i++) {
+        pb_indexed_sprite_instance a = {&opaque, pos[i][0], pos[i][1], 0, 0, 0};
+        pb_indexed_sprite_instance b = {&keyed, pos[i][0], pos[i][1], 0, 0, 0};
+        pb_render_indexed_sprite_batch(fast, &a, 1);
+        pb_render_indexed_sprite_batch(slow, &b, 1);
+    }
+    ASSERT(memcmp(pb_render_get_framebuffer(fast), pb_render_get_framebuffer(slow),
+                  64 * 32) == 0);
+    ASSERT_EQ(pb_render_get_framebuffer(fast)[3 * 64 + 3], 1);
+    pb_render_destroy(fast);
+    pb_render_destroy(slow);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_render test suite\n");
+    printf("====================\n\n");
+
+    printf("Palette cycling:\n");
+    RUN(cycle_offsets);
+    RUN(cycle_apply_rotates_ranges);
+
+    printf("\nRender context:\n");
+    RUN(context_lifecycle);
+    RUN(context_cycles_palette_only);
+
+    printf("\nDithering:\n");
+    RUN(dither_levels);
+    RUN(dither_span_matches_per_pixel);
+    RUN(dither_rect_and_gradient);
+    RUN(shaded_bubble);
+
+    printf("\nSprites:\n");
+    RUN(sprite_flags_and_transparency);
+    RUN(sprite_batch_layers);
+    RUN(sprite_opaque_fast_path);
+
+    printf("\n====================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
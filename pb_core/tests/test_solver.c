@@ -78,6 +78,26 @@ TEST(board_analyze_with_bubbles) {
     ASSERT_TRUE(stats.density > 0.0f);
 }
 
+TEST(board_analyze_max_group_connected) {
+    pb_board board;
+    pb_board_init(&board);
+
+    /* Four reds split into two separate pairs */
+    pb_bubble red = {PB_KIND_COLORED, 0, 0, PB_SPECIAL_NONE, {0}};
+    pb_bubble blue = {PB_KIND_COLORED, 1, 0, PB_SPECIAL_NONE, {0}};
+    pb_board_set(&board, (pb_offset){0, 0}, red);
+    pb_board_set(&board, (pb_offset){0, 1}, red);
+    pb_board_set(&board, (pb_offset){0, 2}, blue);
+    pb_board_set(&board, (pb_offset){0, 5}, red);
+    pb_board_set(&board, (pb_offset){0, 6}, red);
+
+    pb_board_stats stats;
+    pb_board_analyze(&board, &stats);
+
+    ASSERT_EQ(stats.color_counts[0], 4);
+    ASSERT_EQ(stats.max_group_size, 2);
+}
+
 TEST(count_orphans_none) {
     pb_board board;
     pb_board_init(&board);
@@ -333,6 +353,36 @@ TEST(solvability_with_queue) {
     ASSERT_EQ(result.shots_available, 5);
 }
 
+static bool stop_after_two(const pb_solvability* partial, void* userdata)
+{
+    int* calls = userdata;
+    (*calls)++;
+    return partial->min_moves < 2;
+}
+
+TEST(solvability_step_callback_stops) {
+    pb_board board;
+    pb_board_init(&board);
+
+    pb_bubble b = {PB_KIND_COLORED, 0, 0, PB_SPECIAL_NONE, {0}};
+    pb_board_set(&board, (pb_offset){0, 0}, b);
+
+    /* No shot can ever pop the lone red bubble */
+    pb_bubble queue[5];
+    for (int i = 0; i < 5; i++) {
+        queue[i] = b;
+        queue[i].color_id = 1;
+    }
+
+    int calls = 0;
+    pb_solvability result;
+    ASSERT_FALSE(pb_analyze_solvability_ex(&board, NULL, queue, 5, 100,
+                                           stop_after_two, &calls, &result));
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(result.min_moves, 2);
+    ASSERT_EQ(result.solution.count, 2);
+}
+
 /*============================================================================
  * Main
  *============================================================================*/
@@ -345,6 +395,7 @@ int main(void)
     printf("Board analysis:\n");
     RUN(board_analyze_empty);
     RUN(board_analyze_with_bubbles);
+    RUN(board_analyze_max_group_connected);
     RUN(count_orphans_none);
     RUN(count_orphans_disconnected);
 
@@ -368,6 +419,7 @@ int main(void)
     printf("\nSolvability:\n");
     RUN(solvability_empty);
     RUN(solvability_with_queue);
+    RUN(solvability_step_callback_stops);
 
     printf("\n====================\n");
     printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
@@ -0,0 +1,323 @@
+/*
+ * test_tablebase.c - Tests for pb_tablebase module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+/* Shared K=2, horizon 2, 3-color table; generated once in main() */
+static pb_tablebase small_tb;
+
+static pb_bubble colored(uint8_t color)
+{
+    pb_bubble b = {PB_KIND_COLORED, color, 0, PB_SPECIAL_NONE, {0}};
+    return b;
+}
+
+static void fill_queue(pb_bubble* queue, const uint8_t* colors, int n)
+{
+    for (int i = 0; i < n; i++) {
+        queue[i] = colored(colors[i]);
+    }
+}
+
+static int probe(const pb_board* board, const uint8_t* colors, int n)
+{
+    pb_bubble queue[8];
+    fill_queue(queue, colors, n);
+    return pb_tablebase_probe(&small_tb, board, queue, n);
+}
+
+/*============================================================================
+ * Generation Tests
+ *============================================================================*/
+
+TEST(generate_invalid_args) {
+    pb_tablebase tb;
+    pb_tablebase_config config;
+    pb_tablebase_config_default(&config);
+
+    ASSERT_EQ(pb_tablebase_generate(NULL, &config), PB_ERR_INVALID_ARG);
+
+    config.max_bubbles = PB_TB_MAX_BUBBLES + 1;
+    ASSERT_EQ(pb_tablebase_generate(&tb, &config), PB_ERR_INVALID_ARG);
+
+    pb_tablebase_config_default(&config);
+    config.colors = 1;
+    ASSERT_EQ(pb_tablebase_generate(&tb, &config), PB_ERR_INVALID_ARG);
+}
+
+TEST(generate_counts) {
+    const pb_tablebase_header* h = small_tb.header;
+    ASSERT_TRUE(h != NULL);
+    ASSERT_EQ(h->cols_even, PB_DEFAULT_COLS_EVEN);
+    ASSERT_EQ(h->cols_odd, PB_DEFAULT_COLS_ODD);
+    ASSERT_EQ(h->value_stride, 9u);
+
+    /*
+     * 8 singles plus 28 ceiling pairs and 14 hanging pairs with two
+     * labelings each gives 92 boards. Mirroring pairs them up except for
+     * the 8 symmetric ceiling pairs, leaving (92 + 8) / 2 entries.
+     */
+    ASSERT_EQ(h->entry_count, 50u);
+
+    for (uint32_t i = 1; i < h->entry_count; i++) {
+        ASSERT_TRUE(small_tb.keys[i - 1] < small_tb.keys[i]);
+    }
+}
+
+/*============================================================================
+ * Probe Tests
+ *============================================================================*/
+
+TEST(probe_empty_board) {
+    pb_board board;
+    pb_board_init(&board);
+    ASSERT_EQ(probe(&board, (const uint8_t[]){0, 0}, 2), 0);
+}
+
+TEST(probe_pair_one_shot) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 2}, colored(5));
+    pb_board_set(&board, (pb_offset){0, 3}, colored(5));
+
+    ASSERT_EQ(probe(&board, (const uint8_t[]){5, 1}, 2), 1);
+    ASSERT_EQ(probe(&board, (const uint8_t[]){1, 5}, 2), 2);
+    ASSERT_EQ(probe(&board, (const uint8_t[]){1, 1}, 2), 3);
+}
+
+TEST(probe_relabels_colors) {
+    const uint8_t high = PB_MAX_COLORS - 1;
+    pb_board a, b;
+    pb_board_init(&a);
+    pb_board_init(&b);
+    pb_board_set(&a, (pb_offset){0, 4}, colored(1));
+    pb_board_set(&a, (pb_offset){1, 4}, colored(2));
+    pb_board_set(&b, (pb_offset){0, 4}, colored(high));
+    pb_board_set(&b, (pb_offset){1, 4}, colored(0));
+
+    int va = probe(&a, (const uint8_t[]){1, 1}, 2);
+    int vb = probe(&b, (const uint8_t[]){high, high}, 2);
+    ASSERT_EQ(va, 2);
+    ASSERT_EQ(va, vb);
+}
+
+TEST(probe_misses) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+
+    /* Queue shorter than the horizon */
+    ASSERT_EQ(probe(&board, (const uint8_t[]){0}, 1), PB_TB_PROBE_MISS);
+
+    /* Too many bubbles */
+    pb_board_set(&board, (pb_offset){0, 1}, colored(1));
+    pb_board_set(&board, (pb_offset){0, 2}, colored(2));
+    ASSERT_EQ(probe(&board, (const uint8_t[]){0, 0}, 2), PB_TB_PROBE_MISS);
+
+    /* Non-colored bubble */
+    pb_board_init(&board);
+    pb_bubble blocker = {PB_KIND_BLOCKER, 0, 0, PB_SPECIAL_NONE, {0}};
+    pb_board_set(&board, (pb_offset){0, 0}, blocker);
+    ASSERT_EQ(probe(&board, (const uint8_t[]){0, 0}, 2), PB_TB_PROBE_MISS);
+
+    /* More colors than the table stores */
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 1}, colored(1));
+    ASSERT_EQ(probe(&board, (const uint8_t[]){2, 3}, 2), PB_TB_PROBE_MISS);
+
+    /* Geometry and ceiling must match */
+    board.ceiling_row = 1;
+    ASSERT_EQ(probe(&board, (const uint8_t[]){0, 0}, 2), PB_TB_PROBE_MISS);
+    pb_board_init_custom(&board, PB_DEFAULT_ROWS, 8, 8);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    ASSERT_EQ(probe(&board, (const uint8_t[]){0, 0}, 2), PB_TB_PROBE_MISS);
+}
+
+TEST(probe_matches_exact_solver) {
+    static const pb_offset shapes[][2] = {
+        {{0, 0}, {0, 1}},
+        {{0, 3}, {0, 6}},
+        {{0, 7}, {1, 6}},
+        {{0, 2}, {1, 2}},
+    };
+    pb_exact_config config;
+    pb_exact_config_default(&config);
+    config.movegen = PB_EXACT_MOVES_ATTACHABLE;
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        for (int same = 0; same < 2; same++) {
+            pb_board board;
+            pb_board_init(&board);
+            pb_board_set(&board, shapes[s][0], colored(0));
+            pb_board_set(&board, shapes[s][1], colored(same ? 0 : 1));
+
+            for (int w = 0; w < 9; w++) {
+                pb_bubble queue[2];
+                fill_queue(queue, (const uint8_t[]){(uint8_t)(w % 3), (uint8_t)(w / 3)}, 2);
+
+                pb_exact_result result;
+                ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 2, &config, &result), PB_OK);
+                int expected = result.min_shots >= 0 ? result.min_shots : 3;
+                ASSERT_EQ(pb_tablebase_probe(&small_tb, &board, queue, 2), expected);
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * Storage Tests
+ *============================================================================*/
+
+TEST(save_open_roundtrip) {
+    const char* path = "/tmp/pb_test_tablebase.pbtb";
+    ASSERT_EQ(pb_tablebase_save(&small_tb, path), PB_OK);
+
+    pb_tablebase loaded;
+    ASSERT_EQ(pb_tablebase_open(&loaded, path), PB_OK);
+    ASSERT_EQ(loaded.storage_size, small_tb.storage_size);
+    ASSERT_EQ(memcmp(loaded.header, small_tb.header, small_tb.storage_size), 0);
+
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 5}, colored(3));
+    pb_board_set(&board, (pb_offset){0, 6}, colored(3));
+    pb_bubble queue[2];
+    fill_queue(queue, (const uint8_t[]){3, 3}, 2);
+    ASSERT_EQ(pb_tablebase_probe(&loaded, &board, queue, 2), 1);
+
+    pb_tablebase_close(&loaded);
+    ASSERT_TRUE(loaded.header == NULL);
+    remove(path);
+}
+
+TEST(open_rejects_bad_image) {
+    pb_tablebase tb;
+    ASSERT_NE(pb_tablebase_open(&tb, "/tmp/pb_test_tablebase_missing.pbtb"), PB_OK);
+
+    size_t size = small_tb.storage_size;
+    uint64_t* copy = malloc((size + 7) / 8 * sizeof(uint64_t));
+    ASSERT_TRUE(copy != NULL);
+    memcpy(copy, small_tb.header, size);
+
+    ASSERT_EQ(pb_tablebase_from_memory(&tb, copy, size), PB_OK);
+    ASSERT_EQ(pb_tablebase_from_memory(&tb, copy, size - 1), PB_ERR_INVALID_ARG);
+
+    ((pb_tablebase_header*)copy)->version = PB_TB_VERSION + 1;
+    ASSERT_EQ(pb_tablebase_from_memory(&tb, copy, size), PB_ERR_INVALID_ARG);
+    free(copy);
+}
+
+/*============================================================================
+ * Solver Integration Tests
+ *============================================================================*/
+
+TEST(solver_with_tablebase) {
+    pb_board board;
+    pb_board_init(&board);
+    pb_board_set(&board, (pb_offset){0, 0}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 1}, colored(0));
+    pb_board_set(&board, (pb_offset){0, 4}, colored(1));
+    pb_board_set(&board, (pb_offset){0, 5}, colored(2));
+
+    pb_bubble queue[6];
+    fill_queue(queue, (const uint8_t[]){1, 1, 2, 0, 2, 1}, 6);
+
+    pb_exact_config config;
+    pb_exact_config_default(&config);
+    config.movegen = PB_EXACT_MOVES_ATTACHABLE;
+    config.seed_with_greedy = false;
+
+    pb_exact_result plain, probed;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 6, &config, &plain), PB_OK);
+    config.tablebase = &small_tb;
+    ASSERT_EQ(pb_solve_exact(&board, NULL, queue, 6, &config, &probed), PB_OK);
+
+    ASSERT_EQ(plain.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(probed.status, PB_EXACT_OPTIMAL);
+    ASSERT_EQ(plain.min_shots, probed.min_shots);
+    ASSERT_TRUE(probed.nodes <= plain.nodes);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_tablebase test suite\n");
+    printf("=======================\n\n");
+
+    pb_tablebase_config config;
+    pb_tablebase_config_default(&config);
+    config.max_bubbles = 2;
+    config.horizon = 2;
+    config.colors = 3;
+    if (pb_tablebase_generate(&small_tb, &config) != PB_OK) {
+        printf("FAILED: could not generate tablebase\n");
+        return 1;
+    }
+
+    printf("Generation:\n");
+    RUN(generate_invalid_args);
+    RUN(generate_counts);
+
+    printf("\nProbing:\n");
+    RUN(probe_empty_board);
+    RUN(probe_pair_one_shot);
+    RUN(probe_relabels_colors);
+    RUN(probe_misses);
+    RUN(probe_matches_exact_solver);
+
+    printf("\nStorage:\n");
+    RUN(save_open_roundtrip);
+    RUN(open_rejects_bad_image);
+
+    printf("\nSolver integration:\n");
+    RUN(solver_with_tablebase);
+
+    pb_tablebase_close(&small_tb);
+
+    printf("\n=======================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/*
+ * test_verify.c - Tests for pb_verify module
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * Test Framework (minimal)
+ *============================================================================*/
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) static void test_##name(void)
+#define RUN(name) do { \
+    tests_run++; \
+    printf("  " #name "... "); \
+    test_##name(); \
+    tests_passed++; \
+    printf("OK\n"); \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED at %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+#define ASSERT_NE(a, b) ASSERT((a) != (b))
+#define ASSERT_TRUE(a) ASSERT(a)
+#define ASSERT_FALSE(a) ASSERT(!(a))
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+/* Record a replay with rotations every few frames and a checkpoint every
+ * 25. The board starts empty, so it ends with the first (auto-fired) shot
+ * after about 500 frames. */
+static void record_replay(uint64_t seed, int steps, pb_replay* out)
+{
+    pb_session rec;
+    pb_session_config config;
+    pb_session_config_default(&config);
+    config.mode = PB_SESSION_RECORDING;
+    config.checkpoint_interval = 25;
+
+    ASSERT_EQ(pb_session_create(&rec, NULL, seed, &config), PB_OK);
+    for (int i = 0; i < steps && !rec.finished; i++) {
+        pb_session_rotate(&rec, PB_FLOAT_TO_FIXED((i % 3 - 1) * 0.05f));
+        pb_session_run(&rec, 20 + i % 7);
+    }
+    pb_session_finalize(&rec, PB_OUTCOME_ABANDONED);
+    ASSERT_EQ(pb_session_extract_replay(&rec, out), PB_OK);
+    pb_session_destroy(&rec);
+}
+
+/* Verdict of the serial verifier */
+static pb_desync_info serial_verify(const pb_replay* replay, int* frames)
+{
+    pb_session session;
+    pb_session_config config;
+    pb_session_config_default(&config);
+    config.mode = PB_SESSION_VERIFICATION;
+
+    pb_replay copy = *replay;
+    ASSERT_EQ(pb_session_create_playback(&session, &copy, NULL, &config), PB_OK);
+    *frames = pb_session_run(&session, 0);
+    pb_desync_info info = session.last_desync;
+    pb_session_destroy(&session);
+    return info;
+}
+
+static pb_verify_result parallel_verify(const pb_replay* replay, int threads,
+                                        uint32_t segment_frames)
+{
+    pb_verify_config config;
+    pb_verify_config_default(&config);
+    config.threads = threads;
+    config.segment_frames = segment_frames;
+
+    pb_verify_result result;
+    ASSERT_EQ(pb_verify_replay(replay, NULL, &config, &result), PB_OK);
+    return result;
+}
+
+/*============================================================================
+ * Tests
+ *============================================================================*/
+
+TEST(config_default)
+{
+    pb_verify_config config;
+    pb_verify_config_default(&config);
+    ASSERT_EQ(config.threads, 1);
+    ASSERT_EQ(config.segment_frames, (uint32_t)PB_VERIFY_DEFAULT_SEGMENT);
+    ASSERT_EQ(config.max_frames, 0u);
+
+    pb_verify_result result;
+    ASSERT_EQ(pb_verify_replay(NULL, NULL, &config, &result), PB_ERR_INVALID_ARG);
+}
+
+TEST(clean_replay_matches_serial)
+{
+    pb_replay replay;
+    record_replay(1234, 40, &replay);
+    ASSERT_TRUE(replay.checkpoint_count > 8);
+
+    int serial_frames = 0;
+    pb_desync_info serial = serial_verify(&replay, &serial_frames);
+    ASSERT_FALSE(serial.detected);
+
+    const int thread_counts[] = {1, 4};
+    for (int i = 0; i < 2; i++) {
+        pb_verify_result r = parallel_verify(&replay, thread_counts[i], 64);
+        ASSERT_TRUE(r.ok);
+        ASSERT_FALSE(r.desync.detected);
+        ASSERT_EQ(r.frames, (uint32_t)serial_frames);
+        ASSERT_EQ(r.segments, (r.frames + 63) / 64);
+        ASSERT_EQ(r.segments_verified, r.segments);
+        ASSERT_EQ(r.checkpoints_verified, replay.checkpoint_count);
+        ASSERT_TRUE(r.threads_used >= 1);
+    }
+
+    pb_replay_free(&replay);
+}
+
+TEST(tampered_checkpoint_same_verdict)
+{
+    pb_replay replay;
+    record_replay(99, 40, &replay);
+    ASSERT_TRUE(replay.checkpoint_count > 10);
+
+    /* Corrupt a checkpoint in the middle and a later one */
+    replay.checkpoints[6].state_checksum ^= 0x5A5A5A5Au;
+    replay.checkpoints[9].board_checksum ^= 1u;
+
+    int serial_frames = 0;
+    pb_desync_info serial = serial_verify(&replay, &serial_frames);
+    ASSERT_TRUE(serial.detected);
+    ASSERT_EQ(serial.frame, replay.checkpoints[6].frame);
+
+    const int thread_counts[] = {1, 3, 8};
+    const uint32_t segments[] = {50, 64, 1000};
+    for (int i = 0; i < 3; i++) {
+        pb_verify_result r = parallel_verify(&replay, thread_counts[i], segments[i]);
+        ASSERT_FALSE(r.ok);
+        ASSERT_TRUE(r.desync.detected);
+        ASSERT_EQ(r.desync.frame, serial.frame);
+        ASSERT_EQ(r.desync.expected, serial.expected);
+        ASSERT_EQ(r.desync.actual, serial.actual);
+        ASSERT_EQ(strcmp(r.desync.component, serial.component), 0);
+    }
+
+    pb_replay_free(&replay);
+}
+
+TEST(max_frames_limits_pass)
+{
+    pb_replay replay;
+    record_replay(7, 30, &replay);
+
+    pb_verify_config config;
+    pb_verify_config_default(&config);
+    config.threads = 2;
+    config.segment_frames = 40;
+    config.max_frames = 130;
+
+    pb_verify_result r;
+    ASSERT_EQ(pb_verify_replay(&replay, NULL, &config, &r), PB_OK);
+    ASSERT_TRUE(r.ok);
+    ASSERT_EQ(r.frames, 130u);
+    ASSERT_EQ(r.segments, 4u);
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < replay.checkpoint_count; i++) {
+        if (replay.checkpoints[i].frame <= 130) expected++;
+    }
+    ASSERT_EQ(r.checkpoints_verified, expected);
+
+    pb_replay_free(&replay);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    printf("pb_verify test suite\n");
+    printf("====================\n\n");
+
+    printf("Configuration:\n");
+    RUN(config_default);
+
+    printf("\nVerdicts:\n");
+    RUN(clean_replay_matches_serial);
+    RUN(tampered_checkpoint_same_verdict);
+    RUN(max_frames_limits_pass);
+
+    printf("\n====================\n");
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run);
+
+    return (tests_passed == tests_run) ? 0 : 1;
+}
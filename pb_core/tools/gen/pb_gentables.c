@@ -0,0 +1,222 @@
+/*
+ * pb_gentables.c - Constant table generator
+ *
+ * Usage: pb_gentables <pb_tables.h> <pb_tables.c>
+ *
+ * Emits every precomputed table pb_core reads at runtime as `const` data,
+ * so nothing is initialized at startup, retro targets can place the
+ * tables in ROM, and any number of threads can share them:
+ *
+ *   pb_crc32_table      CRC-32 slicing tables (1 or 8 slices by tier)
+ *   pb_dir_sin_q16/cos  Unit vector of each of the 79 direction indices
+ *   pb_srgb8_linear     sRGB 8-bit code value to linear light
+ *   pb_recip_seed_q16   Reciprocal seeds for Newton-Raphson division
+ *
+ * Runs on the build host (doubles and libm are fine here). The Makefile
+ * rebuilds the outputs when this file changes; they are checked in so
+ * cross toolchains without a host compiler still build.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Must match pb_types.h */
+#define DIR_COUNT       79
+#define DIR_BASE_DEG    12
+#define DIR_STEP_DEG    2
+
+#define CRC32_POLY      0xEDB88320u
+#define CRC32_SLICES    8
+#define RECIP_SEEDS     256
+
+static const char* const BANNER =
+    " *\n"
+    " * GENERATED by tools/gen/pb_gentables.c - do not edit.\n"
+    " * Regenerate with `make tables`.\n"
+    " *\n"
+    " * SPDX-License-Identifier: BSD-3-Clause\n"
+    " */\n";
+
+/*============================================================================
+ * Table Computation
+ *============================================================================*/
+
+static uint32_t crc32[CRC32_SLICES][256];
+static int32_t dir_sin[DIR_COUNT];
+static int32_t dir_cos[DIR_COUNT];
+static float srgb_linear[256];
+static uint16_t recip_seed[RECIP_SEEDS];
+
+static void compute_tables(void)
+{
+    /* Slice 0 is the classic byte table; slice k advances k more bytes */
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int j = 0; j < 8; j++) {
+            c = (c & 1) ? (c >> 1) ^ CRC32_POLY : c >> 1;
+        }
+        crc32[0][i] = c;
+    }
+    for (int k = 1; k < CRC32_SLICES; k++) {
+        for (int i = 0; i < 256; i++) {
+            uint32_t prev = crc32[k - 1][i];
+            crc32[k][i] = (prev >> 8) ^ crc32[0][prev & 0xFF];
+        }
+    }
+
+    const double pi = 3.14159265358979323846;
+    for (int d = 0; d < DIR_COUNT; d++) {
+        double rad = (DIR_BASE_DEG + d * DIR_STEP_DEG) * pi / 180.0;
+        dir_sin[d] = (int32_t)lround(sin(rad) * 65536.0);
+        dir_cos[d] = (int32_t)lround(cos(rad) * 65536.0);
+    }
+
+    /* IEC 61966-2-1 transfer curve */
+    for (int i = 0; i < 256; i++) {
+        double c = i / 255.0;
+        double lin = c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+        srgb_linear[i] = (float)lin;
+    }
+
+    /* 1/m for mantissa m in [1, 2), sampled at the bucket midpoint, Q16 */
+    for (int i = 0; i < RECIP_SEEDS; i++) {
+        double m = 1.0 + (i + 0.5) / RECIP_SEEDS;
+        recip_seed[i] = (uint16_t)lround(65536.0 / m);
+    }
+}
+
+/*============================================================================
+ * Emitters
+ *============================================================================*/
+
+static void emit_header(FILE* f)
+{
+    fprintf(f, "/*\n * pb_tables.h - Build-time generated constant tables\n%s", BANNER);
+    fprintf(f,
+        "\n"
+        "#ifndef PB_TABLES_H\n"
+        "#define PB_TABLES_H\n"
+        "\n"
+        "#include \"pb_config.h\"\n"
+        "#include <stdint.h>\n"
+        "\n"
+        "#ifdef __cplusplus\n"
+        "extern \"C\" {\n"
+        "#endif\n"
+        "\n"
+        "#if PB_CRC32_SLICES != 1 && PB_CRC32_SLICES != %d\n"
+        "#error \"PB_CRC32_SLICES must be 1 or %d\"\n"
+        "#endif\n"
+        "\n"
+        "/* CRC-32/ISO-HDLC; [0] is the byte table, [k] advances k more bytes */\n"
+        "extern const uint32_t pb_crc32_table[PB_CRC32_SLICES][256];\n"
+        "\n"
+        "/* sin/cos of direction index d, angle (%d + %d*d) degrees, Q16.16 */\n"
+        "#define PB_DIR_TABLE_SIZE %d\n"
+        "extern const int32_t pb_dir_sin_q16[PB_DIR_TABLE_SIZE];\n"
+        "extern const int32_t pb_dir_cos_q16[PB_DIR_TABLE_SIZE];\n"
+        "\n"
+        "/* sRGB code value 0-255 to linear light 0-1 */\n"
+        "extern const float pb_srgb8_linear[256];\n"
+        "\n"
+        "/* round(2^16 / m) for m = 1 + (i + 0.5) / %d: 1/x seed from the 8 bits\n"
+        " * below the leading one of x (about 9 correct bits) */\n"
+        "#define PB_RECIP_SEED_BITS 8\n"
+        "extern const uint16_t pb_recip_seed_q16[%d];\n"
+        "\n"
+        "#ifdef __cplusplus\n"
+        "}\n"
+        "#endif\n"
+        "\n"
+        "#endif /* PB_TABLES_H */\n",
+        CRC32_SLICES, CRC32_SLICES, DIR_BASE_DEG, DIR_STEP_DEG, DIR_COUNT,
+        RECIP_SEEDS, RECIP_SEEDS);
+}
+
+static void emit_u32_rows(FILE* f, const uint32_t* v, int n, const char* indent)
+{
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s0x%08Xu,", (i % 6 == 0) ? indent : " ", (unsigned)v[i]);
+        if (i % 6 == 5 || i == n - 1) fputc('\n', f);
+    }
+}
+
+static void emit_i32_rows(FILE* f, const int32_t* v, int n)
+{
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s%6ld,", (i % 8 == 0) ? "    " : " ", (long)v[i]);
+        if (i % 8 == 7 || i == n - 1) fputc('\n', f);
+    }
+}
+
+static void emit_source(FILE* f)
+{
+    fprintf(f, "/*\n * pb_tables.c - Build-time generated constant tables\n%s", BANNER);
+    fprintf(f, "\n#include \"pb/pb_tables.h\"\n");
+
+    fprintf(f, "\nconst uint32_t pb_crc32_table[PB_CRC32_SLICES][256] = {\n");
+    for (int k = 0; k < CRC32_SLICES; k++) {
+        if (k == 1) fprintf(f, "#if PB_CRC32_SLICES > 1\n");
+        fprintf(f, "    {\n");
+        emit_u32_rows(f, crc32[k], 256, "        ");
+        fprintf(f, "    },\n");
+    }
+    fprintf(f, "#endif\n};\n");
+
+    fprintf(f, "\nconst int32_t pb_dir_sin_q16[PB_DIR_TABLE_SIZE] = {\n");
+    emit_i32_rows(f, dir_sin, DIR_COUNT);
+    fprintf(f, "};\n");
+
+    fprintf(f, "\nconst int32_t pb_dir_cos_q16[PB_DIR_TABLE_SIZE] = {\n");
+    emit_i32_rows(f, dir_cos, DIR_COUNT);
+    fprintf(f, "};\n");
+
+    fprintf(f, "\nconst float pb_srgb8_linear[256] = {\n");
+    for (int i = 0; i < 256; i++) {
+        fprintf(f, "%s%.9ef,", (i % 4 == 0) ? "    " : " ", (double)srgb_linear[i]);
+        if (i % 4 == 3) fputc('\n', f);
+    }
+    fprintf(f, "};\n");
+
+    fprintf(f, "\nconst uint16_t pb_recip_seed_q16[%d] = {\n", RECIP_SEEDS);
+    for (int i = 0; i < RECIP_SEEDS; i++) {
+        fprintf(f, "%s%5u,", (i % 10 == 0) ? "    " : " ", (unsigned)recip_seed[i]);
+        if (i % 10 == 9 || i == RECIP_SEEDS - 1) fputc('\n', f);
+    }
+    fprintf(f, "};\n");
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+static int write_file(const char* path, void (*emit)(FILE*))
+{
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    emit(f);
+    if (fclose(f) != 0) {
+        perror(path);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <pb_tables.h> <pb_tables.c>\n", argv[0]);
+        return 2;
+    }
+
+    compute_tables();
+    if (write_file(argv[1], emit_header)) return 1;
+    if (write_file(argv[2], emit_source)) return 1;
+    return 0;
+}
@@ -0,0 +1,1156 @@
+/*
+ * pb_host.c - Multi-match versus host daemon and load harness
+ *
+ * Usage: pb_host [options]
+ *
+ * Options:
+ *   -p, --port N          UDP port (default 7777, 0 = ephemeral)
+ *   -w, --workers N       Worker threads, one epoll loop each (default: cores)
+ *   -r, --rate N          Simulation ticks per second (default 60)
+ *   -m, --max-matches N   Match slots per worker (default 512)
+ *   -f, --match-frames N  End matches after N frames (default 0 = never)
+ *   -s, --seconds N       Stop after N seconds (default 0 = until SIGINT)
+ *   -d, --replay-dir DIR  Write one replay per player when a match ends
+ *   -c, --clients N       Also run N synthetic clients in-process
+ *       --connect HOST    Run only the synthetic clients, against HOST:port
+ *   -q, --quiet           Only print the final report
+ *
+ * Every worker owns a UDP socket bound to the same port with SO_REUSEPORT,
+ * an epoll instance and a timerfd ticking at the simulation rate. The
+ * kernel hashes each client's address to one socket, so all of a client's
+ * datagrams reach the same worker; players are paired into matches within
+ * a worker, and no match state is ever shared between threads.
+ *
+ * Clients speak the pb_net protocol. The host is each client's peer: it
+ * acknowledges the client's input frames, relays the opponent's inputs,
+ * and piggybacks its own authoritative pb_frame_checksum() values. Match
+ * frames start at 0; the client's frame counters at join are kept as
+ * origins, so a client that outlives its match rolls into the next one
+ * without resetting its pb_net state.
+ *
+ * Each player's inputs are appended to a pb_replay as they become final.
+ * The same replay drives the simulation cursor and the relay window, and
+ * is written to --replay-dir when the match ends.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__) && PB_FEATURE_NET && PB_FEATURE_THREADS
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+
+/*============================================================================
+ * Constants
+ *============================================================================*/
+
+#define HOST_MAX_CATCHUP      4       /* Frames a stalled match may make up per tick */
+#define HOST_RELAY_FRAMES     16      /* Opponent frames per packet */
+#define HOST_TIMEOUT_MS       5000    /* Drop players silent for this long */
+#define HOST_CHECKPOINT_EVERY 300     /* Frames between replay checkpoints */
+#define HOST_TICK_SAMPLES     (1 << 16)
+#define HOST_SUM_HISTORY      32
+
+/*============================================================================
+ * Command Line Parsing
+ *============================================================================*/
+
+typedef struct options {
+    int port;
+    int workers;
+    int rate;
+    int max_matches;
+    int match_frames;
+    int seconds;
+    int clients;
+    const char* replay_dir;
+    const char* connect_host;
+    bool quiet;
+} options;
+
+static void print_usage(const char* prog)
+{
+    fprintf(stderr, "Usage: %s [options]\n\n", prog);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -p, --port N          UDP port (default 7777, 0 = ephemeral)\n");
+    fprintf(stderr, "  -w, --workers N       Worker threads (default: one per core)\n");
+    fprintf(stderr, "  -r, --rate N          Simulation ticks per second (default 60)\n");
+    fprintf(stderr, "  -m, --max-matches N   Match slots per worker (default 512)\n");
+    fprintf(stderr, "  -f, --match-frames N  End matches after N frames (default never)\n");
+    fprintf(stderr, "  -s, --seconds N       Stop after N seconds (default: SIGINT)\n");
+    fprintf(stderr, "  -d, --replay-dir DIR  Write player replays when matches end\n");
+    fprintf(stderr, "  -c, --clients N       Run N synthetic clients in-process\n");
+    fprintf(stderr, "      --connect HOST    Synthetic clients only, against HOST\n");
+    fprintf(stderr, "  -q, --quiet           Only print the final report\n");
+    fprintf(stderr, "\nExamples:\n");
+    fprintf(stderr, "  %s -p 7777\n", prog);
+    fprintf(stderr, "  %s -p 0 -w 4 -c 400 -s 10\n", prog);
+}
+
+static bool parse_int(const char* arg, int max, int* out)
+{
+    char* end = NULL;
+    long v = strtol(arg, &end, 10);
+    if (!arg[0] || *end != '\0' || v < 0 || v > max) {
+        return false;
+    }
+    *out = (int)v;
+    return true;
+}
+
+static bool parse_args(int argc, char** argv, options* opts)
+{
+    memset(opts, 0, sizeof(*opts));
+    opts->port = 7777;
+    opts->rate = 60;
+    opts->max_matches = 512;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        int* target = NULL;
+        int max = 1000000;
+        const char** str_target = NULL;
+
+        if (strcmp(a, "-p") == 0 || strcmp(a, "--port") == 0) {
+            target = &opts->port;
+            max = 65535;
+        } else if (strcmp(a, "-w") == 0 || strcmp(a, "--workers") == 0) {
+            target = &opts->workers;
+            max = 256;
+        } else if (strcmp(a, "-r") == 0 || strcmp(a, "--rate") == 0) {
+            target = &opts->rate;
+            max = 1000;
+        } else if (strcmp(a, "-m") == 0 || strcmp(a, "--max-matches") == 0) {
+            target = &opts->max_matches;
+            max = 65536;
+        } else if (strcmp(a, "-f") == 0 || strcmp(a, "--match-frames") == 0) {
+            target = &opts->match_frames;
+            max = INT32_MAX;
+        } else if (strcmp(a, "-s") == 0 || strcmp(a, "--seconds") == 0) {
+            target = &opts->seconds;
+        } else if (strcmp(a, "-c") == 0 || strcmp(a, "--clients") == 0) {
+            target = &opts->clients;
+            max = 60000;
+        } else if (strcmp(a, "-d") == 0 || strcmp(a, "--replay-dir") == 0) {
+            str_target = &opts->replay_dir;
+        } else if (strcmp(a, "--connect") == 0) {
+            str_target = &opts->connect_host;
+        } else if (strcmp(a, "-q") == 0 || strcmp(a, "--quiet") == 0) {
+            opts->quiet = true;
+            continue;
+        } else if (strcmp(a, "-h") == 0 || strcmp(a, "--help") == 0) {
+            return false;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", a);
+            return false;
+        }
+
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Option %s needs a value\n", a);
+            return false;
+        }
+        i++;
+        if (str_target) {
+            *str_target = argv[i];
+        } else if (!parse_int(argv[i], max, target)) {
+            fprintf(stderr, "Option %s needs a numeric value (0-%d)\n", a, max);
+            return false;
+        }
+    }
+
+    if (opts->rate < 1 || opts->max_matches < 1) {
+        fprintf(stderr, "Error: rate and max-matches must be positive\n");
+        return false;
+    }
+    if (opts->connect_host && opts->clients == 0) {
+        fprintf(stderr, "Error: --connect needs --clients\n");
+        return false;
+    }
+    if (opts->workers == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        opts->workers = cores > 0 ? (int)cores : 1;
+    }
+    return true;
+}
+
+/*============================================================================
+ * Clock and Shutdown
+ *============================================================================*/
+
+static atomic_bool g_stop;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    atomic_store(&g_stop, true);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(now_ns() / 1000000u);
+}
+
+/*============================================================================
+ * Matches
+ *============================================================================*/
+
+typedef struct player {
+    bool joined;
+    struct sockaddr_in addr;
+    pb_game_state* game;
+    uint32_t in_origin;         /* Client input frame that is match frame 0 */
+    uint32_t out_origin;        /* Client's remote frame for match frame 0 */
+    pb_replay inputs;           /* Final inputs in frame order (the replay) */
+    uint32_t frames;            /* Client inputs final for [0, frames) */
+    uint32_t cursor;            /* Next inputs.events[] to simulate */
+    uint32_t acked;             /* Client has opponent frames [0, acked) */
+    uint32_t seq;               /* Our next packet sequence */
+    bool seen;                  /* Client seq/time below are valid */
+    uint32_t client_seq;
+    uint32_t client_send_ms;
+    uint32_t client_recv_ms;
+    uint32_t last_heard_ms;
+    pb_net_checksum sums[HOST_SUM_HISTORY];   /* Indexed by frame */
+} player;
+
+typedef struct match {
+    bool active;
+    uint32_t id;
+    uint64_t seed;
+    uint32_t frame;             /* Next frame to simulate */
+    int list_pos;               /* Index in worker->active */
+    bool record_lost;           /* An input did not fit a player's replay */
+    player p[2];
+} match;
+
+typedef struct conn_slot {
+    uint64_t key;               /* 0 = empty */
+    int ref;                    /* match * 2 + player */
+} conn_slot;
+
+typedef struct worker_stats {
+    uint64_t ticks;
+    uint64_t late_ticks;        /* Timer expirations skipped while busy */
+    uint64_t packets_in;
+    uint64_t packets_out;
+    uint64_t packets_bad;
+    uint64_t joins_rejected;
+    uint64_t matches_started;
+    uint64_t matches_finished;
+    uint64_t frames_simulated;
+    uint64_t desyncs;
+    uint64_t replay_errors;     /* Matches abandoned on a failed record */
+    uint64_t active_sum;        /* Sum of active matches over ticks */
+    int peak_active;
+    uint32_t tick_us[HOST_TICK_SAMPLES];
+    uint32_t tick_samples;
+} worker_stats;
+
+typedef struct worker {
+    int index;
+    const options* opts;
+    int fd;
+    int epoll_fd;
+    int timer_fd;
+    pthread_t thread;
+
+    match* matches;
+    int* active;                /* Dense list of active match indices */
+    int active_count;
+    int* free_list;
+    int free_count;
+    int waiting;                /* Match with one player, or -1 */
+    uint32_t next_id;
+
+    conn_slot* conns;
+    int conn_mask;
+
+    worker_stats stats;
+} worker;
+
+static uint64_t addr_key(const struct sockaddr_in* addr)
+{
+    return ((uint64_t)addr->sin_addr.s_addr << 16) | addr->sin_port | ((uint64_t)1 << 48);
+}
+
+static uint32_t key_hash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (uint32_t)key;
+}
+
+static int conn_find(const worker* w, uint64_t key)
+{
+    for (uint32_t i = key_hash(key);; i++) {
+        const conn_slot* s = &w->conns[i & (uint32_t)w->conn_mask];
+        if (s->key == key) return s->ref;
+        if (s->key == 0) return -1;
+    }
+}
+
+static void conn_insert(worker* w, uint64_t key, int ref)
+{
+    uint32_t i = key_hash(key);
+    while (w->conns[i & (uint32_t)w->conn_mask].key != 0) {
+        i++;
+    }
+    w->conns[i & (uint32_t)w->conn_mask] = (conn_slot){key, ref};
+}
+
+/* Linear-probing delete with backward shift (no tombstones) */
+static void conn_remove(worker* w, uint64_t key)
+{
+    uint32_t mask = (uint32_t)w->conn_mask;
+    uint32_t i = key_hash(key);
+    while (w->conns[i & mask].key != key) {
+        if (w->conns[i & mask].key == 0) return;
+        i++;
+    }
+    for (;;) {
+        w->conns[i & mask].key = 0;
+        uint32_t j = i;
+        for (;;) {
+            j++;
+            conn_slot* s = &w->conns[j & mask];
+            if (s->key == 0) return;
+            uint32_t home = key_hash(s->key);
+            /* Move s back unless its home lies cyclically in (i, j] */
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                w->conns[i & mask] = *s;
+                i = j;
+                break;
+            }
+        }
+    }
+}
+
+static void record_sum(player* p, uint32_t frame, uint32_t value)
+{
+    p->sums[frame % HOST_SUM_HISTORY] = (pb_net_checksum){frame, value};
+}
+
+static bool start_match(worker* w, match* m)
+{
+    pb_ruleset ruleset;
+    pb_ruleset_default(&ruleset, PB_MODE_VERSUS);
+    for (int s = 0; s < 2; s++) {
+        player* p = &m->p[s];
+        p->game = malloc(sizeof(*p->game));
+        if (!p->game || pb_game_init(p->game, &ruleset, m->seed) != PB_OK) {
+            return false;
+        }
+        /* Inputs are already recorded; nothing consumes the event log */
+        pb_game_set_event_log(p->game, false);
+    }
+    w->stats.matches_started++;
+    return true;
+}
+
+static void save_replays(const worker* w, match* m)
+{
+    const char* dir = w->opts->replay_dir;
+    for (int s = 0; s < 2 && dir; s++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/match-%d-%u-p%d.pbr", dir, w->index, m->id, s);
+        if (pb_replay_save(&m->p[s].inputs, path) != PB_OK && !w->opts->quiet) {
+            fprintf(stderr, "pb_host: could not write %s\n", path);
+        }
+    }
+}
+
+static void release_match(worker* w, int idx)
+{
+    match* m = &w->matches[idx];
+    for (int s = 0; s < 2; s++) {
+        player* p = &m->p[s];
+        if (p->joined) {
+            conn_remove(w, addr_key(&p->addr));
+        }
+        free(p->game);
+        pb_replay_free(&p->inputs);
+    }
+    if (w->waiting == idx) {
+        w->waiting = -1;
+    }
+
+    int pos = m->list_pos;
+    w->active[pos] = w->active[--w->active_count];
+    w->matches[w->active[pos]].list_pos = pos;
+    memset(m, 0, sizeof(*m));
+    w->free_list[w->free_count++] = idx;
+}
+
+static void finish_match(worker* w, int idx, pb_outcome outcome0, pb_outcome outcome1)
+{
+    match* m = &w->matches[idx];
+    if (m->p[1].joined) {
+        const pb_outcome outcome[2] = {outcome0, outcome1};
+        for (int s = 0; s < 2; s++) {
+            player* p = &m->p[s];
+            pb_replay_finalize(&p->inputs, m->frame, p->game ? p->game->score : 0,
+                               outcome[s]);
+        }
+        if (!m->record_lost) {
+            save_replays(w, m);
+        }
+        w->stats.matches_finished++;
+    }
+    release_match(w, idx);
+}
+
+/* Returns the player for a datagram source, joining it to a match if new */
+static player* lookup_player(worker* w, const struct sockaddr_in* from,
+                             const pb_net_packet* packet, int* out_match)
+{
+    uint64_t key = addr_key(from);
+    int ref = conn_find(w, key);
+    if (ref >= 0) {
+        *out_match = ref / 2;
+        return &w->matches[ref / 2].p[ref % 2];
+    }
+
+    int idx, slot;
+    if (w->waiting >= 0) {
+        idx = w->waiting;
+        slot = 1;
+    } else if (w->free_count > 0) {
+        idx = w->free_list[--w->free_count];
+        slot = 0;
+        match* m = &w->matches[idx];
+        m->active = true;
+        m->id = w->next_id++;
+        m->seed = ((uint64_t)w->index << 32) ^ m->id ^ 0x9E3779B97F4A7C15ULL;
+        m->list_pos = w->active_count;
+        w->active[w->active_count++] = idx;
+        if (w->active_count > w->stats.peak_active) {
+            w->stats.peak_active = w->active_count;
+        }
+    } else {
+        w->stats.joins_rejected++;
+        return NULL;
+    }
+
+    match* m = &w->matches[idx];
+    player* p = &m->p[slot];
+    p->joined = true;
+    p->addr = *from;
+    p->in_origin = packet->first_frame;
+    p->out_origin = packet->ack_frames;
+    pb_replay_init(&p->inputs, m->seed, "versus", "versus");
+    conn_insert(w, key, idx * 2 + slot);
+
+    if (slot == 0) {
+        w->waiting = idx;
+    } else {
+        w->waiting = -1;
+        if (!start_match(w, m)) {
+            finish_match(w, idx, PB_OUTCOME_ABANDONED, PB_OUTCOME_ABANDONED);
+            return NULL;
+        }
+    }
+    *out_match = idx;
+    return p;
+}
+
+/*============================================================================
+ * Network
+ *============================================================================*/
+
+static void handle_packet(worker* w, const pb_net_packet* packet,
+                          const struct sockaddr_in* from, uint32_t now)
+{
+    int idx;
+    player* p = lookup_player(w, from, packet, &idx);
+    if (!p) {
+        return;
+    }
+    match* m = &w->matches[idx];
+    const player* opp = &m->p[p == &m->p[0] ? 1 : 0];
+    p->last_heard_ms = now;
+
+    if (!p->seen || (int32_t)(packet->seq - p->client_seq) > 0) {
+        p->seen = true;
+        p->client_seq = packet->seq;
+        p->client_send_ms = packet->send_ms;
+        p->client_recv_ms = now;
+    }
+
+    /* Opponent frames the client now holds (match numbering from here) */
+    int32_t ack = (int32_t)(packet->ack_frames - p->out_origin);
+    if (ack > (int32_t)p->acked && ack <= (int32_t)opp->frames) {
+        p->acked = (uint32_t)ack;
+    }
+
+    /* Client inputs: usable if the window covers our first missing frame */
+    int32_t first = (int32_t)(packet->first_frame - p->in_origin);
+    int32_t end = (int32_t)(packet->end_frame - p->in_origin);
+    if (first < 0) first = 0;
+    if (first <= (int32_t)p->frames && end > (int32_t)p->frames) {
+        for (int i = 0; i < packet->input_count; i++) {
+            pb_input_event in = packet->inputs[i];
+            int32_t frame = (int32_t)(in.frame - p->in_origin);
+            if (frame >= (int32_t)p->frames) {
+                in.frame = (uint32_t)frame;
+                if (pb_replay_record_event(&p->inputs, &in) != PB_OK) {
+                    /* A gap would make the replay diverge; end the match */
+                    w->stats.replay_errors++;
+                    if (!w->opts->quiet) {
+                        fprintf(stderr, "pb_host: match %u input record failed, abandoning\n",
+                                m->id);
+                    }
+                    m->record_lost = true;
+                    finish_match(w, idx, PB_OUTCOME_ABANDONED, PB_OUTCOME_ABANDONED);
+                    return;
+                }
+            }
+        }
+        p->frames = (uint32_t)end;
+    }
+
+    /* Compare client checksums with ours */
+    for (int i = 0; i < packet->checksum_count; i++) {
+        int32_t frame = (int32_t)(packet->checksums[i].frame - p->in_origin);
+        if (frame < 0 || (uint32_t)frame >= m->frame || !p->game) {
+            continue;
+        }
+        const pb_net_checksum* mine = &p->sums[(uint32_t)frame % HOST_SUM_HISTORY];
+        if (mine->frame == (uint32_t)frame && mine->value != packet->checksums[i].value) {
+            w->stats.desyncs++;
+        }
+    }
+}
+
+static void drain_socket(worker* w)
+{
+    for (;;) {
+        uint8_t buf[PB_NET_MAX_PACKET + 1];
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t got = recvfrom(w->fd, buf, sizeof(buf), 0,
+                               (struct sockaddr*)&from, &from_len);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        w->stats.packets_in++;
+
+        pb_net_packet packet;
+        if (from_len != sizeof(from) ||
+            pb_net_packet_decode(buf, (int)got, &packet) != PB_OK) {
+            w->stats.packets_bad++;
+            continue;
+        }
+        handle_packet(w, &packet, &from, now_ms());
+    }
+}
+
+/* First event index at or after frame (events are in frame order) */
+static uint32_t lower_bound(const pb_replay* r, uint32_t frame)
+{
+    uint32_t lo = 0, hi = r->event_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (r->events[mid].frame < frame) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void send_update(worker* w, match* m, int slot, uint32_t now)
+{
+    player* p = &m->p[slot];
+    const player* opp = &m->p[1 - slot];
+
+    pb_net_packet packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.seq = p->seq++;
+    packet.send_ms = now;
+    if (p->seen) {
+        packet.flags |= PB_NET_FLAG_ECHO;
+        packet.echo_ms = p->client_send_ms;
+        packet.echo_hold_ms = now - p->client_recv_ms;
+    }
+    packet.ack_frames = p->frames + p->in_origin;
+
+    /* Relay the opponent's inputs the client has not acknowledged */
+    uint32_t first = p->acked;
+    uint32_t end = opp->joined ? opp->frames : p->acked;
+    if (end - first > HOST_RELAY_FRAMES) {
+        end = first + HOST_RELAY_FRAMES;
+    }
+    if (opp->joined) {
+        for (uint32_t i = lower_bound(&opp->inputs, first);
+             i < opp->inputs.event_count; i++) {
+            const pb_input_event* in = &opp->inputs.events[i];
+            if (in->frame >= end) break;
+            if (packet.input_count == PB_NET_PACKET_INPUTS) {
+                end = in->frame;
+                while (packet.input_count > 0 &&
+                       packet.inputs[packet.input_count - 1].frame == in->frame + p->out_origin) {
+                    packet.input_count--;
+                }
+                break;
+            }
+            pb_input_event* out = &packet.inputs[packet.input_count++];
+            *out = *in;
+            out->frame += p->out_origin;
+        }
+    }
+    packet.first_frame = first + p->out_origin;
+    packet.end_frame = end + p->out_origin;
+
+    /* Our latest authoritative checksums for this player */
+    for (uint32_t k = 1; k <= PB_NET_PACKET_CHECKSUMS && k <= m->frame; k++) {
+        pb_net_checksum c = p->sums[(m->frame - k) % HOST_SUM_HISTORY];
+        c.frame += p->in_origin;
+        packet.checksums[packet.checksum_count++] = c;
+    }
+
+    uint8_t buf[PB_NET_MAX_PACKET];
+    int len = pb_net_packet_encode(&packet, buf, (int)sizeof(buf));
+    if (len > 0 && sendto(w->fd, buf, (size_t)len, 0, (const struct sockaddr*)&p->addr,
+                          sizeof(p->addr)) == len) {
+        w->stats.packets_out++;
+    }
+}
+
+/*============================================================================
+ * Tick Scheduler
+ *============================================================================*/
+
+static void apply_input(pb_game_state* game, const pb_input_event* in)
+{
+    /* Same mapping as session playback; pause has no meaning in versus */
+    switch (in->type) {
+        case PB_INPUT_FIRE:
+            pb_game_set_angle(game, in->angle);
+            pb_game_fire(game);
+            break;
+        case PB_INPUT_ROTATE_LEFT:
+            pb_game_rotate(game, PB_FLOAT_TO_FIXED(-0.05f));
+            break;
+        case PB_INPUT_ROTATE_RIGHT:
+            pb_game_rotate(game, PB_FLOAT_TO_FIXED(0.05f));
+            break;
+        case PB_INPUT_SWITCH:
+            pb_game_swap_bubbles(game);
+            break;
+        default:
+            break;
+    }
+}
+
+static void step_frame(worker* w, match* m)
+{
+    for (int s = 0; s < 2; s++) {
+        player* p = &m->p[s];
+        while (p->cursor < p->inputs.event_count &&
+               p->inputs.events[p->cursor].frame == m->frame) {
+            apply_input(p->game, &p->inputs.events[p->cursor++]);
+        }
+        pb_game_tick(p->game);
+    }
+
+    int g0 = pb_game_get_garbage_to_send(m->p[0].game);
+    int g1 = pb_game_get_garbage_to_send(m->p[1].game);
+    if (g0 > 0) pb_game_receive_garbage(m->p[1].game, g0);
+    if (g1 > 0) pb_game_receive_garbage(m->p[0].game, g1);
+
+    for (int s = 0; s < 2; s++) {
+        player* p = &m->p[s];
+        record_sum(p, m->frame, pb_frame_checksum(p->game));
+        if (m->frame % HOST_CHECKPOINT_EVERY == 0) {
+            const pb_game_state* g = p->game;
+            pb_replay_add_checkpoint(&p->inputs, m->frame, pb_state_checksum(g),
+                                     pb_board_checksum(&g->board), &g->rng,
+                                     g->score, g->shots_fired);
+        }
+    }
+    m->frame++;
+    w->stats.frames_simulated++;
+}
+
+static void run_tick(worker* w, uint32_t now)
+{
+    /* Advance every match whose inputs for the next frame are in */
+    for (int i = 0; i < w->active_count; i++) {
+        int idx = w->active[i];
+        match* m = &w->matches[idx];
+
+        bool timed_out = false;
+        for (int s = 0; s < 2; s++) {
+            if (m->p[s].joined && now - m->p[s].last_heard_ms > HOST_TIMEOUT_MS) {
+                timed_out = true;
+            }
+        }
+        if (timed_out) {
+            finish_match(w, idx, PB_OUTCOME_ABANDONED, PB_OUTCOME_ABANDONED);
+            i--;
+            continue;
+        }
+        if (!m->p[1].joined) {
+            continue;
+        }
+
+        for (int k = 0; k < HOST_MAX_CATCHUP; k++) {
+            if ((int32_t)(m->p[0].frames - m->frame) <= 0 ||
+                (int32_t)(m->p[1].frames - m->frame) <= 0) {
+                break;
+            }
+            step_frame(w, m);
+            if (pb_game_is_over(m->p[0].game) || pb_game_is_over(m->p[1].game)) {
+                break;
+            }
+        }
+
+        bool over0 = pb_game_is_over(m->p[0].game);
+        bool over1 = pb_game_is_over(m->p[1].game);
+        bool limit = w->opts->match_frames > 0 &&
+                     m->frame >= (uint32_t)w->opts->match_frames;
+        if (over0 || over1 || limit) {
+            pb_outcome o0 = PB_OUTCOME_INCOMPLETE, o1 = PB_OUTCOME_INCOMPLETE;
+            if (over0 != over1) {
+                bool p0_lost = over0 ? pb_game_is_lost(m->p[0].game)
+                                     : !pb_game_is_lost(m->p[1].game);
+                o0 = p0_lost ? PB_OUTCOME_LOST : PB_OUTCOME_WON;
+                o1 = p0_lost ? PB_OUTCOME_WON : PB_OUTCOME_LOST;
+            }
+            finish_match(w, idx, o0, o1);
+            i--;
+        }
+    }
+
+    /* One update per player per tick */
+    for (int i = 0; i < w->active_count; i++) {
+        match* m = &w->matches[w->active[i]];
+        for (int s = 0; s < 2; s++) {
+            if (m->p[s].joined) {
+                send_update(w, m, s, now);
+            }
+        }
+    }
+
+    w->stats.ticks++;
+    w->stats.active_sum += (uint64_t)w->active_count;
+}
+
+static void* worker_main(void* arg)
+{
+    worker* w = arg;
+    struct epoll_event events[8];
+
+    while (!atomic_load(&g_stop)) {
+        int n = epoll_wait(w->epoll_fd, events, 8, 100);
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.fd == w->fd) {
+                drain_socket(w);
+                continue;
+            }
+
+            uint64_t expirations = 0;
+            if (read(w->timer_fd, &expirations, sizeof(expirations)) !=
+                (ssize_t)sizeof(expirations)) {
+                continue;
+            }
+            /* Ticks missed while busy are dropped, not replayed in a burst */
+            w->stats.late_ticks += expirations - 1;
+
+            uint64_t start = now_ns();
+            run_tick(w, now_ms());
+            uint64_t us = (now_ns() - start) / 1000u;
+            w->stats.tick_us[w->stats.tick_samples++ % HOST_TICK_SAMPLES] =
+                us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+        }
+    }
+
+    /* Record whatever is still running */
+    while (w->active_count > 0) {
+        finish_match(w, w->active[0], PB_OUTCOME_INCOMPLETE, PB_OUTCOME_INCOMPLETE);
+    }
+    return NULL;
+}
+
+static bool worker_open(worker* w, int index, const options* opts, uint16_t* port)
+{
+    memset(w, 0, sizeof(*w));
+    w->index = index;
+    w->opts = opts;
+    w->waiting = -1;
+    w->fd = w->epoll_fd = w->timer_fd = -1;
+
+    int slots = opts->max_matches;
+    int table = 1;
+    while (table < slots * 8) table <<= 1;
+    w->matches = calloc((size_t)slots, sizeof(*w->matches));
+    w->active = calloc((size_t)slots, sizeof(*w->active));
+    w->free_list = calloc((size_t)slots, sizeof(*w->free_list));
+    w->conns = calloc((size_t)table, sizeof(*w->conns));
+    if (!w->matches || !w->active || !w->free_list || !w->conns) {
+        return false;
+    }
+    w->conn_mask = table - 1;
+    for (int i = slots - 1; i >= 0; i--) {
+        w->free_list[w->free_count++] = i;
+    }
+
+    /* All workers share the port; the kernel shards clients by address */
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(*port);
+    socklen_t addr_len = sizeof(addr);
+    int one = 1;
+    w->fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (w->fd < 0 ||
+        setsockopt(w->fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0 ||
+        bind(w->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(w->fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        perror("pb_host: socket");
+        return false;
+    }
+    *port = ntohs(addr.sin_port);
+
+    long period_ns = 1000000000L / opts->rate;
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = period_ns / 1000000000L;
+    spec.it_interval.tv_nsec = period_ns % 1000000000L;
+    spec.it_value = spec.it_interval;
+    w->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    w->epoll_fd = epoll_create1(0);
+    if (w->timer_fd < 0 || w->epoll_fd < 0 ||
+        timerfd_settime(w->timer_fd, 0, &spec, NULL) != 0) {
+        perror("pb_host: timer");
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = w->fd;
+    epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->fd, &ev);
+    ev.data.fd = w->timer_fd;
+    epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->timer_fd, &ev);
+    return true;
+}
+
+static void worker_close(worker* w)
+{
+    if (w->fd >= 0) close(w->fd);
+    if (w->timer_fd >= 0) close(w->timer_fd);
+    if (w->epoll_fd >= 0) close(w->epoll_fd);
+    free(w->matches);
+    free(w->active);
+    free(w->free_list);
+    free(w->conns);
+}
+
+/*============================================================================
+ * Synthetic Clients
+ *============================================================================*/
+
+typedef struct load_run {
+    const options* opts;
+    const char* host;
+    uint16_t port;
+    uint64_t inputs_sent;
+    uint64_t inputs_relayed;
+    float rtt_ms;
+    float jitter_ms;
+    int connected;
+    bool ok;
+} load_run;
+
+static void* load_main(void* arg)
+{
+    load_run* run = arg;
+    int count = run->opts->clients;
+    pb_net** clients = calloc((size_t)count, sizeof(*clients));
+    if (!clients) {
+        return NULL;
+    }
+
+    pb_net_config config;
+    pb_net_config_default(&config);
+    config.frame_ms = (uint32_t)(1000 / run->opts->rate);
+    for (int i = 0; i < count; i++) {
+        clients[i] = pb_net_create(&config);
+        if (!clients[i] || pb_net_bind(clients[i], NULL, 0) != PB_OK ||
+            pb_net_connect(clients[i], run->host, run->port) != PB_OK) {
+            fprintf(stderr, "pb_host: client %d could not connect\n", i);
+            break;
+        }
+        run->connected++;
+    }
+
+    pb_rng rng;
+    pb_rng_seed(&rng, 85);
+    uint64_t period_ns = 1000000000u / (uint64_t)run->opts->rate;
+    uint64_t next = now_ns();
+    for (uint32_t frame = 0; !atomic_load(&g_stop); frame++) {
+        uint32_t now = now_ms();
+        for (int i = 0; i < run->connected; i++) {
+            pb_net* c = clients[i];
+            pb_net_poll(c, now);
+            while (pb_net_pop_input(c, NULL)) {
+                run->inputs_relayed++;
+            }
+
+            /* Aim-and-fire roughly twice a second, swap occasionally */
+            int roll = pb_rng_range_int(&rng, 0, 59);
+            if (roll < 2) {
+                pb_input_event in = {PB_INPUT_FIRE, frame,
+                                     PB_FLOAT_TO_FIXED(0.4f + 0.02f * (float)pb_rng_range_int(&rng, 0, 115))};
+                if (pb_net_add_input(c, &in) == PB_OK) run->inputs_sent++;
+            } else if (roll == 2) {
+                pb_input_event in = {PB_INPUT_SWITCH, frame, 0};
+                if (pb_net_add_input(c, &in) == PB_OK) run->inputs_sent++;
+            }
+            pb_net_commit_frame(c, frame);
+            pb_net_send(c, now);
+        }
+
+        next += period_ns;
+        struct timespec ts = {(time_t)(next / 1000000000u), (long)(next % 1000000000u)};
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+
+    for (int i = 0; i < run->connected; i++) {
+        pb_net_stats stats;
+        pb_net_get_stats(clients[i], &stats);
+        run->rtt_ms += stats.rtt_ms / (float)run->connected;
+        run->jitter_ms += stats.jitter_ms / (float)run->connected;
+    }
+    for (int i = 0; i < count; i++) {
+        pb_net_destroy(clients[i]);
+    }
+    free(clients);
+    run->ok = true;
+    return NULL;
+}
+
+/*============================================================================
+ * Report
+ *============================================================================*/
+
+static int cmp_u32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t* sorted, uint32_t n, double q)
+{
+    if (n == 0) return 0;
+    uint32_t i = (uint32_t)(q * (double)(n - 1) + 0.5);
+    return sorted[i];
+}
+
+static void print_report(const worker* workers, int count, double seconds)
+{
+    printf("\n%-7s %8s %8s %8s %8s %8s %8s %10s %8s\n", "worker", "ticks", "late",
+           "avg-m", "peak-m", "done", "p50us", "p99us", "maxus");
+
+    uint32_t* all = malloc(sizeof(uint32_t) * HOST_TICK_SAMPLES * (size_t)count);
+    uint32_t all_n = 0;
+    uint64_t frames = 0, finished = 0, desyncs = 0, bad = 0, rejected = 0, lost = 0;
+    double avg_total = 0.0;
+
+    for (int i = 0; i < count; i++) {
+        const worker_stats* s = &workers[i].stats;
+        uint32_t n = s->tick_samples < HOST_TICK_SAMPLES ? s->tick_samples : HOST_TICK_SAMPLES;
+        uint32_t* sorted = all ? all + all_n : NULL;
+        if (sorted) {
+            memcpy(sorted, s->tick_us, sizeof(uint32_t) * n);
+            qsort(sorted, n, sizeof(uint32_t), cmp_u32);
+        }
+        double avg = s->ticks ? (double)s->active_sum / (double)s->ticks : 0.0;
+        avg_total += avg;
+        printf("%-7d %8llu %8llu %8.1f %8d %8llu %8u %10u %8u\n", i,
+               (unsigned long long)s->ticks, (unsigned long long)s->late_ticks, avg,
+               s->peak_active, (unsigned long long)s->matches_finished,
+               sorted ? percentile(sorted, n, 0.50) : 0,
+               sorted ? percentile(sorted, n, 0.99) : 0,
+               sorted && n ? sorted[n - 1] : 0);
+        all_n += sorted ? n : 0;
+        frames += s->frames_simulated;
+        finished += s->matches_finished;
+        desyncs += s->desyncs;
+        bad += s->packets_bad;
+        rejected += s->joins_rejected;
+        lost += s->replay_errors;
+    }
+
+    if (all) {
+        qsort(all, all_n, sizeof(uint32_t), cmp_u32);
+        printf("\nTick duration (us): p50 %u  p90 %u  p99 %u  p99.9 %u  max %u\n",
+               percentile(all, all_n, 0.50), percentile(all, all_n, 0.90),
+               percentile(all, all_n, 0.99), percentile(all, all_n, 0.999),
+               all_n ? all[all_n - 1] : 0);
+        free(all);
+    }
+    printf("Matches per core:   %.1f average, %.1f total\n",
+           count ? avg_total / count : 0.0, avg_total);
+    printf("Match frames/s:     %.0f\n", seconds > 0 ? (double)frames / seconds : 0.0);
+    printf("Finished matches:   %llu\n", (unsigned long long)finished);
+    printf("Desyncs:            %llu\n", (unsigned long long)desyncs);
+    printf("Bad packets:        %llu\n", (unsigned long long)bad);
+    printf("Rejected joins:     %llu\n", (unsigned long long)rejected);
+    printf("Replay errors:      %llu\n", (unsigned long long)lost);
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+/* Failure after workers started: stop and join them, then clean up */
+static int abort_workers(worker* workers, int started, int count)
+{
+    atomic_store(&g_stop, true);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    for (int i = 0; i < count; i++) {
+        worker_close(&workers[i]);
+    }
+    free(workers);
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    options opts;
+    if (!parse_args(argc, argv, &opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    if (opts.connect_host && opts.seconds == 0) {
+        opts.seconds = 10;
+    }
+
+    int worker_count = opts.connect_host ? 0 : opts.workers;
+    worker* workers = calloc((size_t)(worker_count ? worker_count : 1), sizeof(*workers));
+    if (!workers) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    uint16_t port = (uint16_t)opts.port;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int i = 0; i < worker_count; i++) {
+        if (!worker_open(&workers[i], i, &opts, &port)) {
+            for (int j = 0; j <= i; j++) worker_close(&workers[j]);
+            free(workers);
+            return 1;
+        }
+    }
+    for (int i = 0; i < worker_count; i++) {
+        int err = pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]);
+        if (err != 0) {
+            fprintf(stderr, "Error: could not start worker %d: %s\n", i, strerror(err));
+            return abort_workers(workers, i, worker_count);
+        }
+        if (cores > 0 && worker_count <= cores) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i, &set);
+            pthread_setaffinity_np(workers[i].thread, sizeof(set), &set);
+        }
+    }
+    if (!opts.quiet && worker_count > 0) {
+        printf("pb_host: %d workers on UDP port %u, %d Hz, %d matches/worker\n",
+               worker_count, port, opts.rate, opts.max_matches);
+    }
+
+    load_run load;
+    memset(&load, 0, sizeof(load));
+    pthread_t load_thread;
+    if (opts.clients > 0) {
+        load.opts = &opts;
+        load.host = opts.connect_host ? opts.connect_host : "127.0.0.1";
+        load.port = port;
+        int err = pthread_create(&load_thread, NULL, load_main, &load);
+        if (err != 0) {
+            fprintf(stderr, "Error: could not start clients: %s\n", strerror(err));
+            return abort_workers(workers, worker_count, worker_count);
+        }
+    }
+
+    uint64_t start = now_ns();
+    while (!atomic_load(&g_stop)) {
+        struct timespec ts = {0, 100000000L};
+        nanosleep(&ts, NULL);
+        if (opts.seconds > 0 && now_ns() - start >= (uint64_t)opts.seconds * 1000000000u) {
+            atomic_store(&g_stop, true);
+        }
+    }
+    double seconds = (double)(now_ns() - start) / 1e9;
+
+    if (opts.clients > 0) {
+        pthread_join(load_thread, NULL);
+    }
+    for (int i = 0; i < worker_count; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    if (worker_count > 0) {
+        print_report(workers, worker_count, seconds);
+    }
+    if (opts.clients > 0) {
+        printf("Clients:            %d connected, %llu inputs sent, %llu relayed\n",
+               load.connected, (unsigned long long)load.inputs_sent,
+               (unsigned long long)load.inputs_relayed);
+        printf("Client RTT/jitter:  %.2f / %.2f ms\n", (double)load.rtt_ms,
+               (double)load.jitter_ms);
+    }
+
+    for (int i = 0; i < worker_count; i++) {
+        worker_close(&workers[i]);
+    }
+    free(workers);
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    fprintf(stderr, "pb_host requires Linux with PB_FEATURE_NET and PB_FEATURE_THREADS\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * pb_tbgen.c - Endgame tablebase generator
+ *
+ * Usage: pb_tbgen <output.pbtb> [options]
+ *
+ * Options:
+ *   -k, --bubbles N  Largest board to solve (default 3)
+ *   -H, --horizon N  Queue window length (default 3)
+ *   -c, --colors N   Distinct colors per window (default 4)
+ *   -t, --threshold N Match threshold (default 3)
+ *   -q, --quiet      Only show errors
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pb/pb_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*============================================================================
+ * Command Line Parsing
+ *============================================================================*/
+
+typedef struct options {
+    const char* output_path;
+    pb_tablebase_config config;
+    bool quiet;
+} options;
+
+static void print_usage(const char* prog)
+{
+    fprintf(stderr, "Usage: %s <output.pbtb> [options]\n\n", prog);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -k, --bubbles N   Largest board to solve (1-%d, default 3)\n",
+            PB_TB_MAX_BUBBLES);
+    fprintf(stderr, "  -H, --horizon N   Queue window length (1-%d, default 3)\n",
+            PB_TB_MAX_HORIZON);
+    fprintf(stderr, "  -c, --colors N    Distinct colors per window (2-%d, default 4)\n",
+            PB_TB_MAX_COLORS);
+    fprintf(stderr, "  -t, --threshold N Match threshold (default %d)\n",
+            PB_DEFAULT_MATCH_THRESHOLD);
+    fprintf(stderr, "  -q, --quiet       Only show errors\n");
+    fprintf(stderr, "\nExamples:\n");
+    fprintf(stderr, "  %s endgame.pbtb\n", prog);
+    fprintf(stderr, "  %s endgame.pbtb -k 4 -H 3 -c 3\n", prog);
+}
+
+static bool parse_int(const char* arg, int* out)
+{
+    char* end = NULL;
+    long v = strtol(arg, &end, 10);
+    if (!arg[0] || *end != '\0' || v < 0 || v > 255) {
+        return false;
+    }
+    *out = (int)v;
+    return true;
+}
+
+static bool parse_args(int argc, char** argv, options* opts)
+{
+    memset(opts, 0, sizeof(*opts));
+    pb_tablebase_config_default(&opts->config);
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') {
+            int* target = NULL;
+            if (strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--bubbles") == 0) {
+                target = &opts->config.max_bubbles;
+            } else if (strcmp(argv[i], "-H") == 0 || strcmp(argv[i], "--horizon") == 0) {
+                target = &opts->config.horizon;
+            } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--colors") == 0) {
+                target = &opts->config.colors;
+            } else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threshold") == 0) {
+                target = &opts->config.match_threshold;
+            } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
+                opts->quiet = true;
+                continue;
+            } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+                return false;
+            } else {
+                fprintf(stderr, "Unknown option: %s\n", argv[i]);
+                return false;
+            }
+
+            if (i + 1 >= argc || !parse_int(argv[i + 1], target)) {
+                fprintf(stderr, "Option %s needs a numeric value\n", argv[i]);
+                return false;
+            }
+            i++;
+        } else {
+            if (opts->output_path) {
+                fprintf(stderr, "Multiple output files not supported\n");
+                return false;
+            }
+            opts->output_path = argv[i];
+        }
+    }
+
+    if (!opts->output_path) {
+        fprintf(stderr, "Error: No output file specified\n");
+        return false;
+    }
+
+    return true;
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(int argc, char** argv)
+{
+    options opts;
+    if (!parse_args(argc, argv, &opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!opts.quiet) {
+        printf("Generating tablebase: K=%d, horizon=%d, colors=%d, threshold=%d\n",
+               opts.config.max_bubbles, opts.config.horizon,
+               opts.config.colors, opts.config.match_threshold);
+    }
+
+    clock_t start = clock();
+    pb_tablebase tb;
+    pb_result r = pb_tablebase_generate(&tb, &opts.config);
+    if (r != PB_OK) {
+        fprintf(stderr, "Error: generation failed (%d)\n", (int)r);
+        return 1;
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    /* Summarize the distribution of stored values */
+    const pb_tablebase_header* h = tb.header;
+    uint32_t histogram[PB_TB_MAX_HORIZON + 2] = {0};
+    for (size_t i = 0; i < (size_t)h->entry_count * h->value_stride; i++) {
+        uint8_t v = tb.values[i];
+        if (v == PB_TB_NOT_STORED) continue;
+        histogram[v == PB_TB_UNSOLVED ? h->horizon + 1 : v]++;
+    }
+
+    r = pb_tablebase_save(&tb, opts.output_path);
+    if (r != PB_OK) {
+        fprintf(stderr, "Error: could not write %s\n", opts.output_path);
+        pb_tablebase_close(&tb);
+        return 1;
+    }
+
+    if (!opts.quiet) {
+        printf("Boards:   %u\n", h->entry_count);
+        printf("Windows:  %u per board\n", h->value_stride);
+        printf("Size:     %zu bytes\n", tb.storage_size);
+        printf("Time:     %.2f s\n", seconds);
+        for (int d = 1; d <= h->horizon; d++) {
+            printf("  %d shot%s: %u\n", d, d == 1 ? " " : "s", histogram[d]);
+        }
+        printf("  > %d:     %u\n", h->horizon, histogram[h->horizon + 1]);
+        printf("Wrote %s\n", opts.output_path);
+    }
+
+    pb_tablebase_close(&tb);
+    return 0;
+}